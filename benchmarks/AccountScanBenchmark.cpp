@@ -0,0 +1,176 @@
+/**
+ * @file AccountScanBenchmark.cpp
+ * @brief 账户全表扫描基准：列式表与按行存储对比
+ *
+ * 同一批账户分别存放在改动前 JsonAccountRepository 使用的 QMap<QString, Account>、
+ * 连续的 QVector<Account> 和列式 AccountTable 中，测量全行余额汇总、管理员筛选
+ * （锁定或低余额账户计数）和组装完整账户列表的耗时，并检查三者结果一致。
+ * 另在同样规模的表上测量开户和销户（卡号落在已有卡号之间）的单次耗时，以 QMap 为对照，
+ * 以及销户打乱行序后按卡号顺序组装账户列表的额外排序代价。
+ */
+#include <QMap>
+#include <QRandomGenerator>
+#include "Benchmarks.h"
+#include "models/AccountTable.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "account-scan";
+
+//!< 默认账户数
+const qint64 kDefaultAccounts = 1000000;
+
+//!< 每隔多少个账户锁定一个
+const int kLockedEvery = 97;
+
+//!< 管理员筛选的低余额阈值
+const double kLowBalance = 1100.0;
+
+//!< 开户和销户各测量的次数
+const int kChurnOperations = 10000;
+
+} // namespace
+
+int runAccountScanBenchmark(const BenchmarkOptions& options)
+{
+    const qint64 count = bench::sizeOr(options, kDefaultAccounts);
+    QVector<Account> rows = bench::makeAccounts(count);
+    for (qint64 i = 0; i < count; i += kLockedEvery) {
+        rows[i].isLocked = true;
+    }
+
+    QMap<QString, Account> map;
+    AccountTable table;
+    table.reserve(int(count));
+    for (const Account& account : rows) {
+        map.insert(account.cardNumber, account);
+        table.upsert(account);
+    }
+
+    // 余额汇总：三种存储都按卡号顺序累加，结果应完全相同
+    double mapTotal = 0.0;
+    double rowTotal = 0.0;
+    double tableTotal = 0.0;
+    bench::reportThroughput(kName, "total-balance.qmap", count, bench::bestOf(options.repeat, [&] {
+        mapTotal = 0.0;
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            mapTotal += it.value().balance;
+        }
+    }));
+    bench::reportThroughput(kName, "total-balance.rows", count, bench::bestOf(options.repeat, [&] {
+        rowTotal = 0.0;
+        for (const Account& account : rows) {
+            rowTotal += account.balance;
+        }
+    }));
+    bench::reportThroughput(kName, "total-balance.table", count, bench::bestOf(options.repeat, [&] {
+        tableTotal = table.totalBalance();
+    }));
+
+    // 管理员筛选：锁定或余额低于阈值的账户数
+    int mapMatches = 0;
+    int rowMatches = 0;
+    int tableMatches = 0;
+    bench::reportThroughput(kName, "filter.qmap", count, bench::bestOf(options.repeat, [&] {
+        mapMatches = 0;
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            mapMatches += (it.value().isLocked || it.value().balance < kLowBalance) ? 1 : 0;
+        }
+    }));
+    bench::reportThroughput(kName, "filter.rows", count, bench::bestOf(options.repeat, [&] {
+        rowMatches = 0;
+        for (const Account& account : rows) {
+            rowMatches += (account.isLocked || account.balance < kLowBalance) ? 1 : 0;
+        }
+    }));
+    bench::reportThroughput(kName, "filter.table", count, bench::bestOf(options.repeat, [&] {
+        tableMatches = 0;
+        const QVector<quint8>& flags = table.flags();
+        const QVector<double>& balances = table.balances();
+        for (int row = 0; row < table.size(); ++row) {
+            tableMatches += ((flags.at(row) & AccountTable::Locked) || balances.at(row) < kLowBalance) ? 1 : 0;
+        }
+    }));
+
+    // 组装完整账户列表（getAllAccounts 的代价）：列式表需要逐行组装，是这种布局付出的代价
+    qsizetype mapListed = 0;
+    qsizetype tableListed = 0;
+    bench::reportThroughput(kName, "all-accounts.qmap", count, bench::bestOf(options.repeat, [&] {
+        mapListed = map.values().size();
+    }));
+    bench::reportThroughput(kName, "all-accounts.table", count, bench::bestOf(options.repeat, [&] {
+        tableListed = table.allAccounts().size();
+    }));
+
+    bool passed = bench::check(kName, mapTotal == rowTotal && rowTotal == tableTotal,
+                               QString("余额汇总不一致: %1 / %2 / %3")
+                                   .arg(mapTotal, 0, 'f', 2).arg(rowTotal, 0, 'f', 2).arg(tableTotal, 0, 'f', 2));
+    passed = bench::check(kName, mapMatches == rowMatches && rowMatches == tableMatches,
+                          QString("筛选结果不一致: %1 / %2 / %3").arg(mapMatches).arg(rowMatches).arg(tableMatches))
+             && passed;
+    passed = bench::check(kName, mapListed == count && tableListed == count, "组装的账户数不一致") && passed;
+
+    // 开户和销户：表中为偶数序号的卡号，新开的奇数序号卡号落在已有卡号之间，销户随机选取
+    {
+        AccountTable churnTable;
+        QMap<QString, Account> churnMap;
+        churnTable.reserve(int(count + kChurnOperations));
+        for (qint64 i = 0; i < count; ++i) {
+            Account account = rows.at(i);
+            account.cardNumber = bench::cardNumber(2 * i);
+            churnTable.upsert(account);
+            churnMap.insert(account.cardNumber, account);
+        }
+
+        QRandomGenerator random(55);
+        QVector<Account> created;
+        QVector<QString> removed;
+        for (int i = 0; i < kChurnOperations; ++i) {
+            Account account = rows.at(i % count);
+            account.cardNumber = bench::cardNumber(2 * random.bounded(count) + 1);
+            created.append(account);
+            removed.append(bench::cardNumber(2 * random.bounded(count)));
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        for (const Account& account : std::as_const(created)) {
+            churnTable.upsert(account);
+        }
+        bench::reportThroughput(kName, "create.table", kChurnOperations, timer.nsecsElapsed());
+        timer.restart();
+        for (const Account& account : std::as_const(created)) {
+            churnMap.insert(account.cardNumber, account);
+        }
+        bench::reportThroughput(kName, "create.qmap", kChurnOperations, timer.nsecsElapsed());
+
+        timer.restart();
+        for (const QString& cardNumber : std::as_const(removed)) {
+            churnTable.remove(cardNumber);
+        }
+        bench::reportThroughput(kName, "delete.table", kChurnOperations, timer.nsecsElapsed());
+        timer.restart();
+        for (const QString& cardNumber : std::as_const(removed)) {
+            churnMap.remove(cardNumber);
+        }
+        bench::reportThroughput(kName, "delete.qmap", kChurnOperations, timer.nsecsElapsed());
+
+        // 行序已被打乱：按卡号顺序组装需要先排序行号
+        QVector<Account> listed;
+        bench::reportThroughput(kName, "all-accounts.table-after-churn", churnTable.size(),
+                                bench::bestOf(options.repeat, [&] {
+                                    listed = churnTable.allAccounts();
+                                }));
+        const QVector<Account> expected = churnMap.values();
+        bool sameOrder = listed.size() == expected.size();
+        for (int i = 0; sameOrder && i < listed.size(); ++i) {
+            sameOrder = listed.at(i).cardNumber == expected.at(i).cardNumber
+                        && churnTable.indexOf(listed.at(i).cardNumber) >= 0
+                        && churnTable.account(churnTable.indexOf(listed.at(i).cardNumber)).balance
+                               == expected.at(i).balance;
+        }
+        passed = bench::check(kName, sameOrder, "开户和销户后的账户列表与 QMap 不一致") && passed;
+    }
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+/**
+ * @file BenchmarkSupport.cpp
+ * @brief 基准测试公共工具实现
+ *
+ * 实现了测试数据生成、结果输出、内存统计和线程数序列。
+ */
+#include "BenchmarkSupport.h"
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+#include <algorithm>
+#include "models/TransactionIdGenerator.h"
+
+namespace {
+
+//!< 测试卡号的前两位
+const char kCardPrefix[] = "62";
+
+//!< 所有测试账户共用的 PIN
+const char kPin[] = "123456";
+
+//!< 测试交易的起始时间
+const qint64 kFirstTransactionMs = 1735689600000LL; // 2025-01-01T00:00:00Z
+
+/**
+ * @brief 计算 Luhn 校验位
+ * @param digits 不含校验位的数字串
+ * @return 校验位
+ */
+QChar luhnCheckDigit(const QString& digits)
+{
+    int sum = 0;
+    bool doubleIt = true; // 校验位左边第一位乘2
+    for (int i = digits.size() - 1; i >= 0; --i) {
+        int digit = digits.at(i).digitValue();
+        if (doubleIt) {
+            digit *= 2;
+            if (digit > 9) {
+                digit -= 9;
+            }
+        }
+        sum += digit;
+        doubleIt = !doubleIt;
+    }
+    return QChar('0' + (10 - sum % 10) % 10);
+}
+
+/**
+ * @brief 获取标准输出流
+ * @return 输出流
+ */
+QTextStream& out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+/**
+ * @brief 读取 /proc/self/status 中的内存字段
+ * @param field 字段名（如 "VmRSS"）
+ * @return 字节数，不支持时返回-1
+ */
+qint64 procStatusBytes(const char* field)
+{
+#ifdef Q_OS_LINUX
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QByteArray prefix = QByteArray(field) + ':';
+    for (const QByteArray& line : status.readAll().split('\n')) {
+        if (line.startsWith(prefix)) {
+            // 格式为 "VmRSS:     123456 kB"
+            return line.mid(prefix.size()).trimmed().split(' ').value(0).toLongLong() * 1024;
+        }
+    }
+#else
+    Q_UNUSED(field);
+#endif
+    return -1;
+}
+
+} // namespace
+
+namespace bench {
+
+qint64 sizeOr(const BenchmarkOptions& options, qint64 defaultSize)
+{
+    return options.size > 0 ? options.size : defaultSize;
+}
+
+QString cardNumber(qint64 index)
+{
+    const QString body = kCardPrefix + QString::number(index).rightJustified(13, '0');
+    return body + luhnCheckDigit(body);
+}
+
+Account makeAccount(qint64 index, double balance)
+{
+    static const QString salt = Account::generateSalt();
+    static const QString pinHash = Account::hashPin(kPin, salt);
+
+    Account account;
+    account.cardNumber = cardNumber(index);
+    account.pinHash = pinHash;
+    account.salt = salt;
+    account.holderName = QString("测试用户%1").arg(index);
+    account.balance = balance;
+    account.withdrawLimit = 5000.0;
+    account.isLocked = false;
+    account.isAdmin = false;
+    account.failedLoginAttempts = 0;
+    return account;
+}
+
+QVector<Account> makeAccounts(qint64 count)
+{
+    QVector<Account> accounts;
+    accounts.reserve(count);
+    for (qint64 i = 0; i < count; ++i) {
+        accounts.append(makeAccount(i, 1000.0 + double(i % 1000)));
+    }
+    return accounts;
+}
+
+QVector<Transaction> makeTransactions(qint64 count, qint64 accountCount)
+{
+    TransactionIdGenerator ids;
+    QVector<Transaction> transactions;
+    transactions.reserve(count);
+    for (qint64 i = 0; i < count; ++i) {
+        Transaction transaction;
+        transaction.id = ids.next();
+        transaction.cardNumber = cardNumber(i % accountCount);
+        transaction.timestamp = QDateTime::fromMSecsSinceEpoch(kFirstTransactionMs + i * 1000, Qt::UTC);
+        transaction.type = (i % 3 == 0) ? TransactionType::Withdrawal : TransactionType::Deposit;
+        transaction.amount = 10.0 + double(i % 90);
+        transaction.balanceAfter = 1000.0;
+        transaction.description = (i % 3 == 0) ? "ATM取款" : "柜台存款";
+        transactions.append(transaction);
+    }
+    return transactions;
+}
+
+bool sameTransaction(const Transaction& a, const Transaction& b)
+{
+    return a.id == b.id && a.cardNumber == b.cardNumber && a.timestamp == b.timestamp && a.type == b.type
+           && a.amount == b.amount && a.balanceAfter == b.balanceAfter && a.description == b.description
+           && a.targetCardNumber == b.targetCardNumber && a.hasTargetLeg == b.hasTargetLeg;
+}
+
+void reportThroughput(const QString& benchmark, const QString& metric, qint64 operations, qint64 elapsedNs)
+{
+    const double seconds = double(qMax<qint64>(1, elapsedNs)) / 1e9;
+    out() << benchmark << '\t' << metric << '\t'
+          << operations << " 次\t"
+          << QString::number(double(elapsedNs) / 1e6, 'f', 2) << " ms\t"
+          << QString::number(double(operations) / seconds, 'f', 0) << " 次/秒\t"
+          << QString::number(double(elapsedNs) / double(qMax<qint64>(1, operations)), 'f', 1) << " ns/次"
+          << Qt::endl;
+}
+
+void reportValue(const QString& benchmark, const QString& metric, double value, const QString& unit)
+{
+    out() << benchmark << '\t' << metric << '\t' << QString::number(value, 'g', 6) << ' ' << unit << Qt::endl;
+}
+
+qint64 reportLatency(const QString& benchmark, const QString& metric, QVector<qint64>& samplesNs)
+{
+    if (samplesNs.isEmpty()) {
+        return 0;
+    }
+    std::sort(samplesNs.begin(), samplesNs.end());
+    const auto at = [&samplesNs](double fraction) {
+        return samplesNs.at(qMin(samplesNs.size() - 1, qsizetype(fraction * double(samplesNs.size()))));
+    };
+    reportValue(benchmark, metric + ".p50", double(at(0.5)) / 1e3, "µs");
+    reportValue(benchmark, metric + ".p99", double(at(0.99)) / 1e3, "µs");
+    reportValue(benchmark, metric + ".p99.9", double(at(0.999)) / 1e3, "µs");
+    reportValue(benchmark, metric + ".max", double(samplesNs.last()) / 1e3, "µs");
+    return at(0.99);
+}
+
+bool check(const QString& benchmark, bool passed, const QString& message)
+{
+    if (!passed) {
+        out() << benchmark << "\t检查失败\t" << message << Qt::endl;
+    }
+    return passed;
+}
+
+bool resetPeakMemory()
+{
+#ifdef Q_OS_LINUX
+    // 写入5把 VmHWM 重置为当前常驻内存
+    QFile clearRefs("/proc/self/clear_refs");
+    return clearRefs.open(QIODevice::WriteOnly) && clearRefs.write("5") == 1;
+#else
+    return false;
+#endif
+}
+
+qint64 residentMemory()
+{
+    return procStatusBytes("VmRSS");
+}
+
+qint64 peakResidentMemory()
+{
+    return procStatusBytes("VmHWM");
+}
+
+QVector<int> threadCounts(const BenchmarkOptions& options)
+{
+    if (options.threads > 0) {
+        return {options.threads};
+    }
+
+    const int cores = qMax(1, QThread::idealThreadCount());
+    QVector<int> counts;
+    for (int threads = 1; threads < cores; threads *= 2) {
+        counts.append(threads);
+    }
+    counts.append(cores);
+    return counts;
+}
+
+} // namespace bench
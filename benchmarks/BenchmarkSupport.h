@@ -0,0 +1,187 @@
+/**
+ * @file BenchmarkSupport.h
+ * @brief 基准测试公共工具
+ *
+ * 定义了各基准测试共用的运行参数、计时、结果输出和测试数据生成函数。
+ */
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QVector>
+#include "models/Account.h"
+#include "models/Transaction.h"
+
+/**
+ * @brief 基准测试运行参数
+ *
+ * 由命令行解析得到，各基准测试在参数为0时使用自己的默认值。
+ */
+struct BenchmarkOptions {
+    qint64 size = 0;    //!< 数据规模（账户数或记录数），0表示使用默认值
+    int threads = 0;    //!< 线程数，0表示按基准测试的默认方式（通常逐级测量多个线程数）
+    int repeat = 3;     //!< 每项计时的重复次数，输出最快的一次
+};
+
+/**
+ * @brief 基准测试入口函数
+ * @return 0 表示运行成功且所有正确性检查通过
+ */
+using BenchmarkFunction = int (*)(const BenchmarkOptions& options);
+
+namespace bench {
+
+/**
+ * @brief 取数据规模
+ * @param options 运行参数
+ * @param defaultSize 默认规模
+ * @return 命令行指定的规模，未指定时为默认规模
+ */
+qint64 sizeOr(const BenchmarkOptions& options, qint64 defaultSize);
+
+/**
+ * @brief 生成确定的、通过 Luhn 校验的16位卡号
+ *
+ * 相同的序号总是生成相同的卡号，不同的序号生成不同的卡号。
+ *
+ * @param index 序号（0 ~ 10^14-1）
+ * @return 卡号
+ */
+QString cardNumber(qint64 index);
+
+/**
+ * @brief 生成测试账户
+ *
+ * 直接填写字段，所有账户共用同一个 PIN 哈希，避免生成大量账户时的哈希开销。
+ *
+ * @param index 序号，决定卡号和持卡人姓名
+ * @param balance 余额
+ * @return 账户
+ */
+Account makeAccount(qint64 index, double balance);
+
+/**
+ * @brief 生成一批测试账户
+ * @param count 账户数
+ * @return 账户列表，第 i 个账户的卡号为 cardNumber(i)
+ */
+QVector<Account> makeAccounts(qint64 count);
+
+/**
+ * @brief 生成测试交易记录
+ *
+ * 交易依次分配给各账户的存款或取款，时间戳从固定起点每条递增1秒，编号按时间递增。
+ *
+ * @param count 记录数
+ * @param accountCount 账户数（卡号为 cardNumber(0) ~ cardNumber(accountCount-1)）
+ * @return 交易记录
+ */
+QVector<Transaction> makeTransactions(qint64 count, qint64 accountCount);
+
+/**
+ * @brief 比较两条交易记录的持久化字段
+ * @param a 交易记录
+ * @param b 交易记录
+ * @return 如果所有字段相同返回true
+ */
+bool sameTransaction(const Transaction& a, const Transaction& b);
+
+/**
+ * @brief 多次运行并返回最快一次的耗时
+ * @param repeat 运行次数
+ * @param body 被测代码
+ * @return 最短耗时（纳秒）
+ */
+template <typename Body>
+qint64 bestOf(int repeat, Body body)
+{
+    qint64 best = -1;
+    for (int i = 0; i < qMax(1, repeat); ++i) {
+        QElapsedTimer timer;
+        timer.start();
+        body();
+        const qint64 elapsed = timer.nsecsElapsed();
+        if (best < 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief 输出吞吐量结果
+ *
+ * 一行一项，以制表符分隔：基准名、指标、操作数、耗时、吞吐量、单次耗时。
+ *
+ * @param benchmark 基准名
+ * @param metric 指标名
+ * @param operations 操作数
+ * @param elapsedNs 耗时（纳秒）
+ */
+void reportThroughput(const QString& benchmark, const QString& metric, qint64 operations, qint64 elapsedNs);
+
+/**
+ * @brief 输出数值结果
+ * @param benchmark 基准名
+ * @param metric 指标名
+ * @param value 数值
+ * @param unit 单位
+ */
+void reportValue(const QString& benchmark, const QString& metric, double value, const QString& unit);
+
+/**
+ * @brief 输出单次操作耗时的分布
+ *
+ * 输出 p50、p99、p99.9 和最大值（微秒），样本会被排序。
+ *
+ * @param benchmark 基准名
+ * @param metric 指标名
+ * @param samplesNs 每次操作的耗时（纳秒）
+ * @return p99 耗时（纳秒），没有样本时为0
+ */
+qint64 reportLatency(const QString& benchmark, const QString& metric, QVector<qint64>& samplesNs);
+
+/**
+ * @brief 记录一项正确性检查
+ *
+ * 检查失败时输出原因；基准测试据此返回非零退出码。
+ *
+ * @param benchmark 基准名
+ * @param passed 是否通过
+ * @param message 检查内容
+ * @return passed
+ */
+bool check(const QString& benchmark, bool passed, const QString& message);
+
+/**
+ * @brief 重置进程的峰值内存统计
+ *
+ * 只在 Linux 上支持（写 /proc/self/clear_refs），其他平台返回false。
+ *
+ * @return 如果成功重置返回true
+ */
+bool resetPeakMemory();
+
+/**
+ * @brief 获取当前常驻内存
+ * @return 字节数，不支持时返回-1
+ */
+qint64 residentMemory();
+
+/**
+ * @brief 获取自上次重置以来的峰值常驻内存
+ * @return 字节数，不支持时返回-1
+ */
+qint64 peakResidentMemory();
+
+/**
+ * @brief 获取要测量的线程数序列
+ *
+ * 指定了线程数时只测量该线程数；否则为 1、2、4 …… 直到本机的逻辑核数（含）。
+ *
+ * @param options 运行参数
+ * @return 线程数序列
+ */
+QVector<int> threadCounts(const BenchmarkOptions& options);
+
+} // namespace bench
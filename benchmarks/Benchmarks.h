@@ -0,0 +1,84 @@
+/**
+ * @file Benchmarks.h
+ * @brief 基准测试入口声明
+ *
+ * 每个基准测试对应一个入口函数，由 main.cpp 中的基准表按名称调用。
+ */
+#pragma once
+
+#include "BenchmarkSupport.h"
+
+/**
+ * @brief SQLite 与 JSON 后端对比：整批保存、打开、按卡号查询、单笔更新和账本追加
+ */
+int runStorageBenchmark(const BenchmarkOptions& options);
+
+/**
+ * @brief 流式 JSON 读写与 DOM 读写对比：耗时和峰值内存增量
+ */
+int runJsonStreamBenchmark(const BenchmarkOptions& options);
+
+/**
+ * @brief 账户全表扫描：列式表与按行存储的余额汇总、筛选和组装
+ */
+int runAccountScanBenchmark(const BenchmarkOptions& options);
+
+/**
+ * @brief 登录失败吞吐量：改动前逐次写回与内存限流表的对比，以及存储库写入次数
+ */
+int runLoginThrottleBenchmark(const BenchmarkOptions& options);
+
+/**
+ * @brief 卡号布隆过滤器：实际误判率、查询吞吐量，以及 SQLite 上不存在卡号的查找
+ */
+int runCardBloomFilterBenchmark(const BenchmarkOptions& options);
+
+/**
+ * @brief 卡号解析：改动前的 isDigit 循环、标量实现与 SWAR 实现对比
+ */
+int runCardNumberBenchmark(const BenchmarkOptions& options);
+
+/**
+ * @brief 请求去重：去重表的吞吐量，以及带请求编号的存款在非重试路径上的额外开销
+ */
+int runDedupeBenchmark(const BenchmarkOptions& options);
+
+/**
+ * @brief 风控规则：百万级卡状态下的单次评估延迟分布，检查 50 微秒的预算
+ */
+int runFraudBenchmark(const BenchmarkOptions& options);
+
+/**
+ * @brief 账本一致性校验：不同线程数下的重放吞吐量，以及不一致能否被找到
+ */
+int runLedgerVerifierBenchmark(const BenchmarkOptions& options);
+
+/**
+ * @brief 交易描述全文检索：建索引吞吐量和各类查询的单次延迟分布
+ */
+int runDescriptionSearchBenchmark(const BenchmarkOptions& options);
+
+/**
+ * @brief 排行榜：增量维护的开销、top-100 查询与全量排序或扫描的对比，以及取款热路径上的额外开销
+ */
+int runLeaderboardBenchmark(const BenchmarkOptions& options);
+
+/**
+ * @brief 定期转账：时间轮在月末集中到期时的开销，以及调度器按不同批大小执行月末转账的吞吐量
+ */
+int runStandingOrderBenchmark(const BenchmarkOptions& options);
+
+/**
+ * @brief 批量计息与管理费：余额列上的计算内核、不同线程数下的整个作业，以及与逐个账户保存的对比
+ */
+int runInterestAccrualBenchmark(const BenchmarkOptions& options);
+
+/**
+ * @brief 日终清算：不同线程数和每线程行块数下的汇总吞吐量、写清算文件，以及清算期间登记新交易
+ */
+int runSettlementBenchmark(const BenchmarkOptions& options);
+
+/**
+ * @brief JSON 并行分块加载：1 ~ 16 个线程的加载吞吐量和加速比，以及分块加载与单线程加载的结果一致
+ */
+int runJsonLoadBenchmark(const BenchmarkOptions& options);
@@ -0,0 +1,302 @@
+/**
+ * @file CardBloomFilterBenchmark.cpp
+ * @brief 卡号布隆过滤器基准
+ *
+ * 测量 CardBloomFilter 的实际误判率（与估算值对比）、插入和查询吞吐量，
+ * 并在 SQLite 存储库上对比不存在卡号的查找：经过滤器直接拒绝与每次查询数据库。
+ * 以删除为主的混合操作对比两种维护策略：每次删除都重建过滤器，与只累计过期卡号、
+ * 过期占比超过阈值才重建；并在 SQLite 存储库上批量删除账户，检查删除后的存在判断。
+ */
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QSet>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include "Benchmarks.h"
+#include "models/CardBloomFilter.h"
+#include "models/SqliteAccountRepository.h"
+#include "models/SqlitePersistenceManager.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "bloom";
+
+//!< 默认卡号数
+const qint64 kDefaultCards = 1000000;
+
+//!< SQLite 部分的账户数上限（控制建库时间）
+const qint64 kMaxSqliteAccounts = 100000;
+
+//!< SQLite 部分查询的不存在卡号数
+const int kSqliteProbes = 20000;
+
+//!< 卡号序号上限（13位）
+const qint64 kMaxIndex = 10000000000000LL;
+
+//!< 允许的最大实际误判率（目标约1%）
+const double kMaxFalsePositiveRate = 0.02;
+
+//!< 删除混合操作的卡号数上限（每次删除都重建的对照组是 O(N)）
+const qint64 kMaxChurnCards = 50000;
+
+//!< 删除混合操作的操作数
+const int kChurnOperations = 2000;
+
+//!< 删除混合操作中每次插入对应的删除次数
+const int kChurnDeletesPerInsert = 3;
+
+//!< SQLite 部分删除的账户占比（超过过滤器的过期阈值，至少触发一次重建）
+const int kSqliteDeletePercent = 30;
+
+/**
+ * @brief 删除混合操作的结果
+ */
+struct ChurnResult {
+    qint64 elapsedNs = 0;        //!< 全部操作耗时（纳秒）
+    int rebuilds = 0;            //!< 过滤器重建次数
+    QVector<QString> live;       //!< 操作后仍存在的卡号
+    QVector<QString> removed;    //!< 操作中删除的卡号
+    qint64 nextIndex = 0;        //!< 下一个未使用的卡号序号
+};
+
+/**
+ * @brief 在过滤器和精确集合上执行以删除为主的混合操作
+ *
+ * 两种策略使用相同的随机种子，因此执行完全相同的操作序列。
+ *
+ * @param cards 初始卡号数
+ * @param rebuildOnEveryDelete true 时每次删除都重建，否则只记录过期卡号、由 needsRebuild() 决定
+ * @param filter 输出参数，操作后的过滤器
+ * @return 操作结果
+ */
+ChurnResult runDeleteHeavyChurn(int cards, bool rebuildOnEveryDelete, CardBloomFilter& filter)
+{
+    ChurnResult result;
+    QSet<QString> exact;
+    for (int i = 0; i < cards; ++i) {
+        result.live.append(bench::cardNumber(i));
+        exact.insert(result.live.last());
+    }
+    result.nextIndex = cards;
+
+    // 与存储库的 rebuildCardFilter() 相同：按当前卡号数预留一倍余量
+    auto rebuild = [&] {
+        filter.reset(int(exact.size()) * 2);
+        for (const QString& card : exact) {
+            filter.add(card);
+        }
+        ++result.rebuilds;
+    };
+    rebuild();
+    result.rebuilds = 0;
+
+    QRandomGenerator random(11);
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kChurnOperations; ++i) {
+        if (random.bounded(kChurnDeletesPerInsert + 1) < kChurnDeletesPerInsert && !result.live.isEmpty()) {
+            const int at = random.bounded(int(result.live.size()));
+            const QString card = result.live.at(at);
+            result.live[at] = result.live.last();
+            result.live.removeLast();
+            exact.remove(card);
+            result.removed.append(card);
+            if (rebuildOnEveryDelete) {
+                rebuild();
+            } else {
+                filter.markRemoved();
+                if (filter.needsRebuild()) {
+                    rebuild();
+                }
+            }
+        } else {
+            const QString card = bench::cardNumber(result.nextIndex++);
+            result.live.append(card);
+            exact.insert(card);
+            if (filter.needsRebuild()) {
+                rebuild();
+            } else {
+                filter.add(card);
+            }
+        }
+    }
+    result.elapsedNs = timer.nsecsElapsed();
+    return result;
+}
+
+/**
+ * @brief 生成不存在的卡号
+ * @param count 卡号数
+ * @param firstAbsentIndex 已存在卡号的序号上界（不含），生成的卡号序号都不小于它
+ * @return 卡号列表
+ */
+QVector<QString> absentCards(int count, qint64 firstAbsentIndex)
+{
+    QRandomGenerator random(7);
+    QVector<QString> cards;
+    cards.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        cards.append(bench::cardNumber(random.bounded(firstAbsentIndex, kMaxIndex)));
+    }
+    return cards;
+}
+
+} // namespace
+
+int runCardBloomFilterBenchmark(const BenchmarkOptions& options)
+{
+    const qint64 count = bench::sizeOr(options, kDefaultCards);
+    QVector<QString> present;
+    present.reserve(count);
+    for (qint64 i = 0; i < count; ++i) {
+        present.append(bench::cardNumber(i));
+    }
+    const QVector<QString> absent = absentCards(int(count), count);
+
+    // 建立过滤器，并以 QSet 作为精确集合的对照
+    CardBloomFilter filter(int(count));
+    bench::reportThroughput(kName, "filter.add", count, bench::bestOf(options.repeat, [&] {
+        filter.reset(int(count));
+        for (const QString& card : present) {
+            filter.add(card);
+        }
+    }));
+    QSet<QString> exact(present.cbegin(), present.cend());
+
+    int falseNegatives = 0;
+    for (const QString& card : present) {
+        falseNegatives += filter.mightContain(card) ? 0 : 1;
+    }
+
+    int falsePositives = 0;
+    bench::reportThroughput(kName, "filter.lookup-absent", absent.size(), bench::bestOf(options.repeat, [&] {
+        falsePositives = 0;
+        for (const QString& card : absent) {
+            falsePositives += filter.mightContain(card) ? 1 : 0;
+        }
+    }));
+    int exactHits = 0;
+    bench::reportThroughput(kName, "qset.lookup-absent", absent.size(), bench::bestOf(options.repeat, [&] {
+        exactHits = 0;
+        for (const QString& card : absent) {
+            exactHits += exact.contains(card) ? 1 : 0;
+        }
+    }));
+
+    const double falsePositiveRate = double(falsePositives) / double(qMax(1, absent.size()));
+    bench::reportValue(kName, "filter.bits-per-card", double(filter.bitCount()) / double(count), "位");
+    bench::reportValue(kName, "filter.false-positive-rate", falsePositiveRate * 100.0, "%");
+    bench::reportValue(kName, "filter.estimated-false-positive-rate",
+                       filter.estimatedFalsePositiveRate() * 100.0, "%");
+
+    bool passed = bench::check(kName, falseNegatives == 0, QString("过滤器漏报 %1 个卡号").arg(falseNegatives));
+    passed = bench::check(kName, exactHits == 0, "生成的不存在卡号与已有卡号重复") && passed;
+    passed = bench::check(kName, falsePositiveRate <= kMaxFalsePositiveRate,
+                          QString("误判率 %1% 超过 %2%")
+                              .arg(falsePositiveRate * 100.0, 0, 'f', 3).arg(kMaxFalsePositiveRate * 100.0))
+             && passed;
+
+    // SQLite 存储库：不存在的卡号经过滤器拒绝，对照组直接执行同样的主键查询
+    QTemporaryDir directory;
+    if (!bench::check(kName, directory.isValid(), "无法创建临时目录")) {
+        return 1;
+    }
+    const qint64 sqliteAccounts = qMin(count, kMaxSqliteAccounts);
+    SqlitePersistenceManager manager(nullptr, directory.path());
+    SqliteAccountRepository repository(&manager);
+    passed = bench::check(kName, repository.saveAccountsBatch(bench::makeAccounts(sqliteAccounts)).success,
+                          "保存测试账户失败") && passed;
+    const QVector<QString> probes = absentCards(kSqliteProbes, sqliteAccounts);
+
+    int repositoryHits = 0;
+    bench::reportThroughput(kName, "sqlite.find-absent.filtered", probes.size(), bench::bestOf(options.repeat, [&] {
+        repositoryHits = 0;
+        for (const QString& card : probes) {
+            repositoryHits += repository.findByCardNumber(card) ? 1 : 0;
+        }
+    }));
+
+    QSqlQuery select(manager.database());
+    select.setForwardOnly(true);
+    select.prepare("SELECT card_number, pin_hash, salt, holder_name, balance, withdraw_limit, is_locked, "
+                   "is_admin, failed_login_attempts, last_failed_login, temporary_lock_time "
+                   "FROM accounts WHERE card_number = :cardNumber");
+    int queryHits = 0;
+    bench::reportThroughput(kName, "sqlite.find-absent.query", probes.size(), bench::bestOf(options.repeat, [&] {
+        queryHits = 0;
+        for (const QString& card : probes) {
+            select.bindValue(":cardNumber", card);
+            if (select.exec() && select.next()) {
+                ++queryHits;
+            }
+            select.finish();
+        }
+    }));
+    passed = bench::check(kName, repositoryHits == 0 && queryHits == 0, "查到了不存在的卡号") && passed;
+
+    // 以删除为主的混合操作：每次删除都重建与按过期占比重建
+    const int churnCards = int(qMin(count, kMaxChurnCards));
+    CardBloomFilter rebuildingFilter;
+    const ChurnResult rebuilding = runDeleteHeavyChurn(churnCards, true, rebuildingFilter);
+    bench::reportThroughput(kName, "churn.rebuild-every-delete", kChurnOperations, rebuilding.elapsedNs);
+    bench::reportValue(kName, "churn.rebuild-every-delete.rebuilds", rebuilding.rebuilds, "次");
+
+    CardBloomFilter staleFilter;
+    const ChurnResult stale = runDeleteHeavyChurn(churnCards, false, staleFilter);
+    bench::reportThroughput(kName, "churn.stale-threshold", kChurnOperations, stale.elapsedNs);
+    bench::reportValue(kName, "churn.stale-threshold.rebuilds", stale.rebuilds, "次");
+    bench::reportValue(kName, "churn.stale-threshold.stale-cards", staleFilter.staleCount(), "个");
+
+    int churnFalseNegatives = 0;
+    for (const QString& card : stale.live) {
+        churnFalseNegatives += staleFilter.mightContain(card) ? 0 : 1;
+    }
+    // 已删除的卡号仍可能命中过期位，由存储库的精确查找拒绝
+    int staleHits = 0;
+    for (const QString& card : stale.removed) {
+        staleHits += staleFilter.mightContain(card) ? 1 : 0;
+    }
+    const QVector<QString> churnAbsent = absentCards(kSqliteProbes, stale.nextIndex);
+    int churnFalsePositives = 0;
+    for (const QString& card : churnAbsent) {
+        churnFalsePositives += staleFilter.mightContain(card) ? 1 : 0;
+    }
+    const double churnFalsePositiveRate = double(churnFalsePositives) / double(qMax(1, churnAbsent.size()));
+    bench::reportValue(kName, "churn.stale-threshold.removed-card-hit-rate",
+                       100.0 * staleHits / double(qMax(1, stale.removed.size())), "%");
+    bench::reportValue(kName, "churn.stale-threshold.false-positive-rate", churnFalsePositiveRate * 100.0, "%");
+    passed = bench::check(kName, rebuilding.live == stale.live, "两种策略执行的操作序列不同") && passed;
+    passed = bench::check(kName, churnFalseNegatives == 0,
+                          QString("删除混合操作后过滤器漏报 %1 个卡号").arg(churnFalseNegatives)) && passed;
+    passed = bench::check(kName, churnFalsePositiveRate <= kMaxFalsePositiveRate,
+                          QString("删除混合操作后误判率 %1% 超过 %2%")
+                              .arg(churnFalsePositiveRate * 100.0, 0, 'f', 3).arg(kMaxFalsePositiveRate * 100.0))
+             && passed;
+
+    // SQLite 存储库批量删除：删除的卡号不再存在，其余卡号仍然存在
+    QVector<QString> deleted;
+    QVector<QString> kept;
+    for (qint64 i = 0; i < sqliteAccounts; ++i) {
+        (i % 100 < kSqliteDeletePercent ? deleted : kept).append(bench::cardNumber(i));
+    }
+    int deleteFailures = 0;
+    QElapsedTimer deleteTimer;
+    deleteTimer.start();
+    for (const QString& card : deleted) {
+        deleteFailures += repository.deleteAccount(card).success ? 0 : 1;
+    }
+    bench::reportThroughput(kName, "sqlite.delete", deleted.size(), deleteTimer.nsecsElapsed());
+    int wrongExists = 0;
+    for (const QString& card : deleted) {
+        wrongExists += repository.accountExists(card) || repository.findByCardNumber(card) ? 1 : 0;
+    }
+    for (const QString& card : kept) {
+        wrongExists += repository.accountExists(card) ? 0 : 1;
+    }
+    passed = bench::check(kName, deleteFailures == 0, QString("删除 %1 个账户失败").arg(deleteFailures)) && passed;
+    passed = bench::check(kName, wrongExists == 0,
+                          QString("删除后 %1 个卡号的存在判断错误").arg(wrongExists)) && passed;
+
+    return passed ? 0 : 1;
+}
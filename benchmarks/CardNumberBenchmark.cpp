@@ -0,0 +1,162 @@
+/**
+ * @file CardNumberBenchmark.cpp
+ * @brief 卡号解析微基准
+ *
+ * 对比改动前 Account::isValidCardNumber 的 QChar::isDigit 循环、逐字符标量实现
+ * （格式 + Luhn + 转换为整数）和 CardNumber::parse 的 SWAR 实现，
+ * 输入为有效卡号、校验位错误的卡号和格式错误的卡号的混合，并检查各实现的结果一致。
+ */
+#include <QRandomGenerator>
+#include "Benchmarks.h"
+#include "models/CardNumber.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "card-number";
+
+//!< 默认输入数
+const qint64 kDefaultInputs = 1000000;
+
+/**
+ * @brief 改动前的卡号格式检查
+ * @param cardNumber 卡号
+ * @return 如果为16位数字返回true
+ */
+bool legacyIsValidCardNumber(const QString& cardNumber)
+{
+    if (cardNumber.length() != 16) {
+        return false;
+    }
+    for (const QChar& c : cardNumber) {
+        if (!c.isDigit()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 逐字符的标量实现，输出与 CardNumber::parse 相同
+ * @param text 卡号
+ * @return 解析结果
+ */
+CardNumber::Parsed scalarParse(const QString& text)
+{
+    CardNumber::Parsed result;
+    if (text.size() != CardNumber::LENGTH) {
+        return result;
+    }
+    quint64 packed = 0;
+    int sum = 0;
+    for (int i = 0; i < CardNumber::LENGTH; ++i) {
+        const ushort c = text.at(i).unicode();
+        if (c < '0' || c > '9') {
+            return result;
+        }
+        int digit = c - '0';
+        packed = packed * 10 + digit;
+        if (i % 2 == 0) {
+            digit *= 2;
+            if (digit > 9) {
+                digit -= 9;
+            }
+        }
+        sum += digit;
+    }
+    result.wellFormed = true;
+    result.packed = packed;
+    result.luhnValid = sum % 10 == 0;
+    return result;
+}
+
+/**
+ * @brief 生成测试输入
+ *
+ * 一半为有效卡号，四分之一为校验位错误的卡号，其余为在随机位置替换了一个非数字字符的卡号。
+ *
+ * @param count 输入数
+ * @return 卡号列表
+ */
+QVector<QString> makeInputs(qint64 count)
+{
+    static const QChar kBadChars[] = {QChar('/'), QChar(':'), QChar('a'), QChar(' '), QChar(0xFF10)};
+    QRandomGenerator random(59);
+    QVector<QString> inputs;
+    inputs.reserve(count);
+    for (qint64 i = 0; i < count; ++i) {
+        QString card = bench::cardNumber(random.bounded(qint64(0), qint64(10000000000000LL)));
+        switch (i % 4) {
+        case 0:
+        case 1:
+            break;
+        case 2:
+            card[15] = QChar('0' + (card.at(15).digitValue() + 1) % 10);
+            break;
+        default:
+            card[random.bounded(CardNumber::LENGTH)] = kBadChars[random.bounded(5)];
+            break;
+        }
+        inputs.append(card);
+    }
+    return inputs;
+}
+
+} // namespace
+
+int runCardNumberBenchmark(const BenchmarkOptions& options)
+{
+    const QVector<QString> inputs = makeInputs(bench::sizeOr(options, kDefaultInputs));
+
+    int legacyValid = 0;
+    bench::reportThroughput(kName, "legacy.is-digit", inputs.size(), bench::bestOf(options.repeat, [&] {
+        legacyValid = 0;
+        for (const QString& input : inputs) {
+            legacyValid += legacyIsValidCardNumber(input) ? 1 : 0;
+        }
+    }));
+
+    quint64 scalarChecksum = 0;
+    bench::reportThroughput(kName, "scalar.parse", inputs.size(), bench::bestOf(options.repeat, [&] {
+        scalarChecksum = 0;
+        for (const QString& input : inputs) {
+            const CardNumber::Parsed parsed = scalarParse(input);
+            scalarChecksum += parsed.packed + (parsed.wellFormed ? 1 : 0) + (parsed.luhnValid ? 2 : 0);
+        }
+    }));
+
+    quint64 swarChecksum = 0;
+    bench::reportThroughput(kName, "swar.parse", inputs.size(), bench::bestOf(options.repeat, [&] {
+        swarChecksum = 0;
+        for (const QString& input : inputs) {
+            const CardNumber::Parsed parsed = CardNumber::parse(input);
+            swarChecksum += parsed.packed + (parsed.wellFormed ? 1 : 0) + (parsed.luhnValid ? 2 : 0);
+        }
+    }));
+
+    int swarValid = 0;
+    bench::reportThroughput(kName, "swar.is-well-formed", inputs.size(), bench::bestOf(options.repeat, [&] {
+        swarValid = 0;
+        for (const QString& input : inputs) {
+            swarValid += CardNumber::isWellFormed(input) ? 1 : 0;
+        }
+    }));
+
+    // 逐条核对；全角数字 U+FF10 改动前被 isDigit 接受，现在被拒绝，不参与格式计数的比较
+    int mismatches = 0;
+    int unicodeDigits = 0;
+    for (const QString& input : inputs) {
+        const CardNumber::Parsed swar = CardNumber::parse(input);
+        const CardNumber::Parsed scalar = scalarParse(input);
+        if (swar.wellFormed != scalar.wellFormed || swar.packed != scalar.packed
+            || swar.luhnValid != scalar.luhnValid) {
+            ++mismatches;
+        }
+        unicodeDigits += (legacyIsValidCardNumber(input) && !scalar.wellFormed) ? 1 : 0;
+    }
+
+    bool passed = bench::check(kName, mismatches == 0, QString("SWAR 与标量实现有 %1 处不一致").arg(mismatches));
+    passed = bench::check(kName, scalarChecksum == swarChecksum, "SWAR 与标量实现的校验和不一致") && passed;
+    passed = bench::check(kName, legacyValid - unicodeDigits == swarValid, "格式检查结果与改动前不一致") && passed;
+    return passed ? 0 : 1;
+}
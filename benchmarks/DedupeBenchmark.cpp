@@ -0,0 +1,169 @@
+/**
+ * @file DedupeBenchmark.cpp
+ * @brief 请求去重开销基准
+ *
+ * 测量非重试路径上请求去重的开销：
+ * - RequestDeduplicator 的 claim + complete（新请求）和重复请求的回放，单线程及多线程
+ * - AccountService::depositAmount 带请求编号与不带请求编号的耗时差（内存存储库，不含 I/O）
+ * 并检查重复的请求编号只执行一次。
+ */
+#include <QThread>
+#include <memory>
+#include <vector>
+#include "Benchmarks.h"
+#include "MemoryAccountRepository.h"
+#include "models/AccountService.h"
+#include "models/AccountValidator.h"
+#include "models/RequestDeduplicator.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "dedupe";
+
+//!< 默认请求数
+const qint64 kDefaultRequests = 1000000;
+
+//!< 回放测量的请求数（远小于默认容量，各分片都不会淘汰）
+const int kReplayRequests = 1000;
+
+//!< 服务层测量的账户数
+const int kAccounts = 1000;
+
+//!< 服务层测量的存款次数上限（每次都组装和保存账户）
+const qint64 kMaxServiceRequests = 200000;
+
+//!< 存款金额
+const double kAmount = 100.0;
+
+/**
+ * @brief 生成请求键（与 AccountService 的组装方式相同：卡号/请求编号）
+ * @param thread 线程序号
+ * @param count 键数
+ * @return 请求键
+ */
+QVector<QString> makeKeys(int thread, qint64 count)
+{
+    const QString card = bench::cardNumber(thread);
+    QVector<QString> keys;
+    keys.reserve(count);
+    for (qint64 i = 0; i < count; ++i) {
+        keys.append(card + QLatin1Char('/') + QString("req-%1").arg(i));
+    }
+    return keys;
+}
+
+} // namespace
+
+int runDedupeBenchmark(const BenchmarkOptions& options)
+{
+    const qint64 count = bench::sizeOr(options, kDefaultRequests);
+    const QString fingerprint = QStringLiteral("deposit|%1").arg(kAmount, 0, 'f', 2);
+    const OperationResult success = OperationResult::Success();
+    bool passed = true;
+
+    // 单线程：新请求和重复请求
+    {
+        const QVector<QString> keys = makeKeys(0, count);
+        bench::reportThroughput(kName, "table.claim-complete", count, bench::bestOf(options.repeat, [&] {
+            RequestDeduplicator table;
+            for (const QString& key : keys) {
+                table.claim(key, fingerprint);
+                table.complete(key, success);
+            }
+        }));
+
+        // 回放：表中的请求全部已完成，每次 claim 都返回首次执行的结果
+        const QVector<QString> recent = keys.mid(0, qMin<qsizetype>(kReplayRequests, keys.size()));
+        RequestDeduplicator replayTable;
+        for (const QString& key : recent) {
+            replayTable.claim(key, fingerprint);
+            replayTable.complete(key, success);
+        }
+        int replayed = 0;
+        bench::reportThroughput(kName, "table.replay", recent.size(), bench::bestOf(options.repeat, [&] {
+            replayed = 0;
+            for (const QString& key : recent) {
+                replayed += replayTable.claim(key, fingerprint).status == RequestDeduplicator::Status::Replayed
+                                ? 1 : 0;
+            }
+        }));
+        passed = bench::check(kName, replayed == recent.size(),
+                              QString("应回放 %1 个请求，实际 %2 个").arg(recent.size()).arg(replayed)) && passed;
+    }
+
+    // 多线程：各线程使用不同卡号的请求键，分片锁下的总吞吐量
+    for (int threads : bench::threadCounts(options)) {
+        const qint64 perThread = qMax<qint64>(1, count / threads);
+        std::vector<QVector<QString>> keys;
+        for (int t = 0; t < threads; ++t) {
+            keys.push_back(makeKeys(t, perThread));
+        }
+        const qint64 ns = bench::bestOf(options.repeat, [&] {
+            RequestDeduplicator table;
+            std::vector<std::unique_ptr<QThread>> workers;
+            for (int t = 0; t < threads; ++t) {
+                workers.emplace_back(QThread::create([&table, &keys, &fingerprint, &success, t] {
+                    for (const QString& key : keys[t]) {
+                        table.claim(key, fingerprint);
+                        table.complete(key, success);
+                    }
+                }));
+                workers.back()->start();
+            }
+            for (auto& worker : workers) {
+                worker->wait();
+            }
+        });
+        bench::reportThroughput(kName, QString("table.claim-complete.threads-%1").arg(threads),
+                                perThread * threads, ns);
+    }
+
+    // 服务层：同样的存款，带请求编号（每次不同，不命中）与不带请求编号
+    MemoryAccountRepository repository;
+    repository.saveAccountsBatch(bench::makeAccounts(kAccounts));
+    AccountValidator validator(&repository);
+    AccountService service(&repository, &validator);
+
+    const qint64 serviceRequests = qMin(count, kMaxServiceRequests);
+    QVector<QString> cards;
+    for (int i = 0; i < kAccounts; ++i) {
+        cards.append(bench::cardNumber(i));
+    }
+    QVector<QString> requestIds;
+    requestIds.reserve(serviceRequests);
+    for (qint64 i = 0; i < serviceRequests; ++i) {
+        requestIds.append(QString("req-%1").arg(i));
+    }
+
+    const double before = service.getBalance(cards.at(0));
+    int failures = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (qint64 i = 0; i < serviceRequests; ++i) {
+        failures += service.depositAmount(cards.at(int(i % kAccounts)), kAmount).success ? 0 : 1;
+    }
+    const qint64 plainNs = timer.nsecsElapsed();
+    timer.restart();
+    for (qint64 i = 0; i < serviceRequests; ++i) {
+        failures += service.depositAmount(cards.at(int(i % kAccounts)), kAmount, requestIds.at(i)).success ? 0 : 1;
+    }
+    const qint64 idempotentNs = timer.nsecsElapsed();
+    bench::reportThroughput(kName, "service.deposit", serviceRequests, plainNs);
+    bench::reportThroughput(kName, "service.deposit-with-request-id", serviceRequests, idempotentNs);
+    bench::reportValue(kName, "service.overhead-per-request",
+                       double(idempotentNs - plainNs) / double(serviceRequests), "ns");
+    passed = bench::check(kName, failures == 0, QString("%1 笔存款失败").arg(failures)) && passed;
+
+    // 重试：同一请求编号的第二次调用不再执行
+    const double afterRuns = service.getBalance(cards.at(0));
+    service.depositAmount(cards.at(0), kAmount, "retry");
+    service.depositAmount(cards.at(0), kAmount, "retry");
+    const qint64 depositsOnFirstCard = 2 * ((serviceRequests + kAccounts - 1) / kAccounts);
+    passed = bench::check(kName, afterRuns == before + kAmount * double(depositsOnFirstCard),
+                          "存款后的余额不正确") && passed;
+    passed = bench::check(kName, service.getBalance(cards.at(0)) == afterRuns + kAmount,
+                          "重复的请求编号被执行了两次") && passed;
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file DescriptionSearchBenchmark.cpp
+ * @brief 交易描述全文检索基准
+ *
+ * 在 10^7 条交易描述上建立 DescriptionIndex，测量建索引吞吐量和各类查询的单次延迟分布：
+ * - 全行检索常见词（倒排表为数百万条）
+ * - 全行检索收款人（"转账给 李四"，倒排表交集较小）
+ * - 全行检索管理员操作记录中的卡号（极少命中）
+ * - 单卡检索（只在该卡约100条交易中检索）
+ * 并用暴力扫描核对收款人查询的命中数和命中内容。
+ */
+#include <QRandomGenerator>
+#include <algorithm>
+#include <limits>
+#include "Benchmarks.h"
+#include "models/DescriptionIndex.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "description-search";
+
+//!< 默认交易数
+const qint64 kDefaultRows = 10000000;
+
+//!< 平均每张卡的交易数
+const qint64 kRowsPerCard = 100;
+
+//!< 每类查询的次数
+const int kQueries = 200;
+
+//!< 常见词查询的次数（每次要为数百万条倒排记录打分）
+const int kCommonQueries = 20;
+
+//!< 每次查询返回的结果数
+const int kLimit = 20;
+
+//!< 姓
+const QString kSurnames = QStringLiteral("王李张刘陈杨黄赵吴周徐孙马朱胡郭何高林罗");
+
+//!< 名
+const QString kGivenNames = QStringLiteral("伟芳娜敏静丽强磊军洋勇艳杰娟涛明超秀霞平刚桂英华玉兰萍红鹏辉"
+                                           "建国文斌宇浩凯俊峰琳雪梅莉燕晶倩颖慧婷欣然博睿泽轩航宁佳楠阳晨"
+                                           "旭琪瑶思怡雯璐菲嘉鑫淼昊宏毅志远海波鸿飞松柏林森坤鹤龙虎凤麟瑞祥福安康乐");
+
+/**
+ * @brief 收款人序号（打散分布）
+ * @param row 交易下标
+ * @return 序号（0 ~ 姓数×名数-1）
+ */
+int payeeOf(qint64 row)
+{
+    return int((quint64(row) * 2654435761ULL) % quint64(kSurnames.size() * kGivenNames.size()));
+}
+
+/**
+ * @brief 收款人姓名
+ * @param payee 序号
+ * @return 二字姓名
+ */
+QString payeeName(int payee)
+{
+    return QString(kSurnames.at(payee % kSurnames.size())) + kGivenNames.at(payee / kSurnames.size());
+}
+
+/**
+ * @brief 生成一条交易描述
+ *
+ * 四成为取款，两成为存款，两成为转出，一成为转入，其余为利息和少量管理员操作。
+ *
+ * @param row 交易下标
+ * @param cardCount 卡数
+ * @return 描述
+ */
+QString describe(qint64 row, qint64 cardCount)
+{
+    switch (row % 10) {
+    case 0: case 1: case 2: case 3:
+        return QStringLiteral("ATM取款");
+    case 4: case 5:
+        return QStringLiteral("柜台存款");
+    case 6: case 7:
+        return QStringLiteral("转账给 ") + payeeName(payeeOf(row));
+    case 8:
+        return QStringLiteral("转账来自 ") + payeeName(payeeOf(row));
+    default:
+        if (row % 100 == 9) {
+            return QStringLiteral("管理员操作：解锁账户 ") + bench::cardNumber(row % cardCount);
+        }
+        return QStringLiteral("利息");
+    }
+}
+
+/**
+ * @brief 多次查询并输出单次延迟分布
+ * @param index 索引
+ * @param metric 指标名
+ * @param queries 查询文本
+ * @param rows 每次查询的检索范围，为空时全行检索
+ */
+void measure(const DescriptionIndex& index, const QString& metric, const QVector<QString>& queries,
+             const QVector<QVector<int>>& rows = QVector<QVector<int>>())
+{
+    QVector<qint64> samples;
+    samples.reserve(queries.size());
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < queries.size(); ++i) {
+        const qint64 start = timer.nsecsElapsed();
+        index.search(queries.at(i), kLimit, rows.isEmpty() ? nullptr : &rows.at(i));
+        samples.append(timer.nsecsElapsed() - start);
+    }
+    bench::reportLatency(kName, metric, samples);
+}
+
+} // namespace
+
+int runDescriptionSearchBenchmark(const BenchmarkOptions& options)
+{
+    const qint64 count = qMin<qint64>(bench::sizeOr(options, kDefaultRows), std::numeric_limits<int>::max());
+    // 卡数不为10的倍数，使同一张卡的交易类型各不相同
+    const qint64 cardCount = count / kRowsPerCard + 1;
+
+    DescriptionIndex index;
+    QElapsedTimer timer;
+    timer.start();
+    for (qint64 row = 0; row < count; ++row) {
+        index.add(int(row), describe(row, cardCount));
+    }
+    bench::reportThroughput(kName, "index.add", count, timer.nsecsElapsed());
+    bench::reportValue(kName, "index.terms", index.termCount(), "个");
+
+    QRandomGenerator random(67);
+    const int payees = kSurnames.size() * kGivenNames.size();
+    QVector<QString> common;
+    QVector<QString> payeeQueries;
+    QVector<QString> adminQueries;
+    QVector<QString> cardQueries;
+    QVector<QVector<int>> cardRows;
+    for (int i = 0; i < kQueries; ++i) {
+        if (i < kCommonQueries) {
+            common.append(i % 2 == 0 ? QStringLiteral("ATM取款") : QStringLiteral("存款"));
+        }
+        payeeQueries.append(QStringLiteral("转账给 ") + payeeName(random.bounded(payees)));
+        adminQueries.append(QStringLiteral("解锁 ") + bench::cardNumber(random.bounded(cardCount)));
+        cardQueries.append(i % 2 == 0 ? QStringLiteral("转账") : QStringLiteral("取款"));
+
+        // 单卡的交易下标：card, card + cardCount, ...（递增）
+        const qint64 card = random.bounded(cardCount);
+        QVector<int> rows;
+        for (qint64 row = card; row < count; row += cardCount) {
+            rows.append(int(row));
+        }
+        cardRows.append(rows);
+    }
+
+    measure(index, "search.common-term", common);
+    measure(index, "search.payee", payeeQueries);
+    measure(index, "search.admin-card", adminQueries);
+    measure(index, "search.per-card", cardQueries, cardRows);
+
+    // 核对一个收款人查询：命中数与暴力扫描一致，命中的描述都是转给该收款人
+    const int payee = payeeOf(6);
+    const QString name = payeeName(payee);
+    int expected = 0;
+    for (qint64 row = 0; row < count; ++row) {
+        const int kind = int(row % 10);
+        expected += (kind == 6 || kind == 7) && payeeOf(row) == payee ? 1 : 0;
+    }
+    const QVector<DescriptionIndex::Hit> hits =
+        index.search(QStringLiteral("转账给 ") + name, std::numeric_limits<int>::max());
+    bool passed = bench::check(kName, hits.size() == expected,
+                               QString("\"转账给 %1\" 命中 %2 条，应为 %3 条").arg(name).arg(hits.size()).arg(expected));
+    int wrong = 0;
+    for (const DescriptionIndex::Hit& hit : hits) {
+        wrong += describe(hit.row, cardCount) == QStringLiteral("转账给 ") + name ? 0 : 1;
+    }
+    passed = bench::check(kName, wrong == 0, QString("%1 条命中的描述不符").arg(wrong)) && passed;
+
+    // 单卡检索只返回该卡的交易
+    const QVector<DescriptionIndex::Hit> cardHits =
+        index.search(QStringLiteral("取款"), std::numeric_limits<int>::max(), &cardRows.at(0));
+    int outside = 0;
+    for (const DescriptionIndex::Hit& hit : cardHits) {
+        outside += std::binary_search(cardRows.at(0).cbegin(), cardRows.at(0).cend(), hit.row) ? 0 : 1;
+    }
+    passed = bench::check(kName, !cardHits.isEmpty() && outside == 0, "单卡检索返回了其他卡的交易") && passed;
+
+    return passed ? 0 : 1;
+}
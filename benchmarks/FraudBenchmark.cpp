@@ -0,0 +1,123 @@
+/**
+ * @file FraudBenchmark.cpp
+ * @brief 风控规则评估延迟基准
+ *
+ * 在百万级卡的风控状态下测量：
+ * - FraudRuleEngine::record 的吞吐量（建立状态）
+ * - FraudRuleEngine::evaluate 的单次延迟分布，检查 p99 不超过 50 微秒的预算
+ * - 挂接了规则引擎的 AccountValidator::validateWithdrawal 的单次延迟分布（内存存储库，不含 I/O）
+ * 并检查频率规则在阈值处命中。
+ */
+#include <QRandomGenerator>
+#include "Benchmarks.h"
+#include "MemoryAccountRepository.h"
+#include "models/AccountValidator.h"
+#include "models/FraudRuleEngine.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "fraud";
+
+//!< 默认卡数
+const qint64 kDefaultCards = 1000000;
+
+//!< 测量延迟的评估次数
+const int kSamples = 200000;
+
+//!< 每张卡的历史取款笔数
+const int kHistoryPerCard = 6;
+
+//!< 历史取款的间隔（大于频率窗口，不会触发频率规则）
+const qint64 kHistorySpacingMs = 20 * 60 * 1000;
+
+//!< 单次评估的延迟预算（纳秒）
+const qint64 kBudgetNs = 50 * 1000;
+
+} // namespace
+
+int runFraudBenchmark(const BenchmarkOptions& options)
+{
+    const qint64 count = bench::sizeOr(options, kDefaultCards);
+    VirtualClock clock(QDateTime::fromMSecsSinceEpoch(1735689600000LL, Qt::UTC));
+
+    MemoryAccountRepository repository;
+    repository.saveAccountsBatch(bench::makeAccounts(count));
+    AccountValidator validator(&repository);
+    validator.setClock(&clock);
+    FraudRuleEngine* engine = validator.fraudRules();
+
+    QVector<QString> cards;
+    cards.reserve(count);
+    for (qint64 i = 0; i < count; ++i) {
+        cards.append(bench::cardNumber(i));
+    }
+
+    // 建立状态：每张卡若干笔间隔较长的取款，每四张卡中有一张另有两笔转账
+    const qint64 now = clock.utcMs();
+    QElapsedTimer timer;
+    timer.start();
+    qint64 events = 0;
+    for (qint64 i = 0; i < count; ++i) {
+        const QString& card = cards.at(i);
+        const double amount = 100.0 + double(i % 50);
+        for (int k = kHistoryPerCard; k > 0; --k) {
+            engine->record(FraudEvent{card, TransactionType::Withdrawal, amount, QString(),
+                                      now - k * kHistorySpacingMs});
+            ++events;
+        }
+        if (i % 4 == 0) {
+            for (int k = 1; k <= 2; ++k) {
+                engine->record(FraudEvent{card, TransactionType::Transfer, amount, cards.at((i + k) % count),
+                                          now - kHistorySpacingMs / 2 - k});
+                ++events;
+            }
+        }
+    }
+    bench::reportThroughput(kName, "engine.record", events, timer.nsecsElapsed());
+    bool passed = bench::check(kName, engine->trackedCards() == count,
+                               QString("有状态的卡数 %1，应为 %2").arg(engine->trackedCards()).arg(count));
+
+    // 评估：随机卡号，四分之三为取款，四分之一为向已知或新卡号的转账；每次单独计时（含约数十纳秒的计时开销）
+    QRandomGenerator random(63);
+    QVector<qint64> engineNs;
+    QVector<qint64> validatorNs;
+    engineNs.reserve(kSamples);
+    validatorNs.reserve(kSamples);
+    int rejected = 0;
+    for (int s = 0; s < kSamples; ++s) {
+        const qint64 i = random.bounded(count);
+        const QString& card = cards.at(i);
+        const bool transfer = s % 4 == 3;
+        const QString target = transfer ? cards.at((i + 1 + random.bounded(4)) % count) : QString();
+
+        qint64 start = timer.nsecsElapsed();
+        const OperationResult result =
+            engine->evaluate(card, transfer ? TransactionType::Transfer : TransactionType::Withdrawal, 120.0, target);
+        engineNs.append(timer.nsecsElapsed() - start);
+        rejected += result.success ? 0 : 1;
+
+        start = timer.nsecsElapsed();
+        const OperationResult validated = validator.validateWithdrawal(card, 120.0);
+        validatorNs.append(timer.nsecsElapsed() - start);
+        rejected += validated.success ? 0 : 1;
+    }
+    const qint64 engineP99 = bench::reportLatency(kName, "engine.evaluate", engineNs);
+    bench::reportLatency(kName, "validator.validate-withdrawal", validatorNs);
+    passed = bench::check(kName, rejected == 0, QString("%1 次正常交易被拒绝").arg(rejected)) && passed;
+    passed = bench::check(kName, engineP99 <= kBudgetNs,
+                          QString("评估 p99 为 %1 µs，超过 %2 µs 的预算")
+                              .arg(double(engineP99) / 1e3, 0, 'f', 2).arg(kBudgetNs / 1000))
+             && passed;
+
+    // 频率规则：窗口内达到上限后的下一笔取款被拒绝
+    const QString busy = cards.at(0);
+    const FraudRuleEngine::Config config;
+    for (int k = 0; k < config.maxOutflows; ++k) {
+        engine->record(busy, TransactionType::Withdrawal, 100.0);
+    }
+    passed = bench::check(kName, !engine->evaluate(busy, TransactionType::Withdrawal, 100.0).success,
+                          "达到次数上限后的取款未被拒绝") && passed;
+
+    return passed ? 0 : 1;
+}
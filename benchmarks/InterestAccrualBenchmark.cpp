@@ -0,0 +1,189 @@
+/**
+ * @file InterestAccrualBenchmark.cpp
+ * @brief 批量计息与管理费基准
+ *
+ * 在 10^6 个账户上测量：
+ * - InterestAccrualJob::accrue 在连续余额列上的吞吐量，对照逐个账户对象计算的做法
+ * - 整个作业（计算、生成账本记录、一次提交）在不同线程数下的耗时（内存存储库）
+ * - JSON 存储库上整个作业的耗时，对照改动前逐个账户 saveAccount（每次重写整个账户文件）的单次耗时
+ * 并检查计算结果与逐个账户计算一致、入账笔数和余额变化与报告一致。
+ */
+#include <QTemporaryDir>
+#include <cmath>
+#include "Benchmarks.h"
+#include "MemoryAccountRepository.h"
+#include "models/InterestAccrualJob.h"
+#include "models/JsonAccountRepository.h"
+#include "models/JsonPersistenceManager.h"
+#include "models/TransactionModel.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "interest";
+
+//!< 默认账户数
+const qint64 kDefaultAccounts = 1000000;
+
+//!< 改动前做法测量的 saveAccount 次数（每次重写整个账户文件）
+const int kLegacySaves = 5;
+
+//!< 计息日
+const QDate kDate(2025, 1, 31);
+
+/**
+ * @brief 生成账户：多数余额较高，五分之一低于免收管理费的余额，少量零余额和管理员账户
+ * @param count 账户数
+ * @return 账户列表
+ */
+QVector<Account> makeAccrualAccounts(qint64 count)
+{
+    QVector<Account> accounts = bench::makeAccounts(count);
+    for (qint64 i = 0; i < count; ++i) {
+        Account& account = accounts[i];
+        if (i % 97 == 0) {
+            account.balance = 0.0;
+        } else if (i % 5 == 0) {
+            account.balance = 100.0 + double(i % 200);
+        }
+        account.isAdmin = i % 1000 == 1;
+    }
+    return accounts;
+}
+
+/**
+ * @brief 改动前的做法：逐个账户对象计算利息和管理费
+ * @param accounts 账户
+ * @param policy 计息与收费规则
+ * @param interest 输出参数，各账户利息
+ * @param fees 输出参数，各账户管理费
+ */
+void accrueRowwise(const QVector<Account>& accounts, const AccrualPolicy& policy,
+                   QVector<double>& interest, QVector<double>& fees)
+{
+    const double rate = policy.annualRate / policy.daysPerYear;
+    interest.resize(accounts.size());
+    fees.resize(accounts.size());
+    for (int i = 0; i < accounts.size(); ++i) {
+        const Account& account = accounts.at(i);
+        interest[i] = 0.0;
+        fees[i] = 0.0;
+        if (account.isAdmin) {
+            continue;
+        }
+        if (account.balance > 0.0) {
+            interest[i] = std::floor(account.balance * rate * 100.0 + 0.5) / 100.0;
+        }
+        const double after = account.balance + interest.at(i);
+        if (after > 0.0 && after < policy.feeWaiverBalance) {
+            fees[i] = qMin(policy.monthlyFee, after);
+        }
+    }
+}
+
+/**
+ * @brief 计算余额之和
+ * @param repository 存储库
+ * @return 余额之和
+ */
+double totalBalance(const IAccountRepository& repository)
+{
+    double total = 0.0;
+    for (const Account& account : repository.getAllAccounts()) {
+        total += account.balance;
+    }
+    return total;
+}
+
+} // namespace
+
+int runInterestAccrualBenchmark(const BenchmarkOptions& options)
+{
+    const qint64 count = bench::sizeOr(options, kDefaultAccounts);
+    const QVector<Account> accounts = makeAccrualAccounts(count);
+    const AccrualPolicy policy;
+    bool passed = true;
+
+    // 计算内核：连续的余额列和标志列，对照逐个账户对象
+    AccountTable table;
+    table.reserve(int(count));
+    for (const Account& account : accounts) {
+        table.upsert(account);
+    }
+    const double rate = policy.annualRate / policy.daysPerYear;
+    QVector<double> interest(int(count));
+    QVector<double> fees(int(count));
+    bench::reportThroughput(kName, "kernel.accrue", count, bench::bestOf(options.repeat, [&] {
+        InterestAccrualJob::accrue(table.balances().constData(), table.flags().constData(), table.size(), rate,
+                                   policy.monthlyFee, policy.feeWaiverBalance, interest.data(), fees.data());
+    }));
+    QVector<double> rowInterest;
+    QVector<double> rowFees;
+    bench::reportThroughput(kName, "rowwise.accrue", count, bench::bestOf(options.repeat, [&] {
+        accrueRowwise(accounts, policy, rowInterest, rowFees);
+    }));
+    int expectedInterest = 0;
+    int expectedFees = 0;
+    int mismatches = 0;
+    for (int i = 0; i < int(count); ++i) {
+        mismatches += (interest.at(i) != rowInterest.at(i) || fees.at(i) != rowFees.at(i)) ? 1 : 0;
+        expectedInterest += interest.at(i) > 0.0 ? 1 : 0;
+        expectedFees += fees.at(i) > 0.0 ? 1 : 0;
+    }
+    passed = bench::check(kName, mismatches == 0, QString("%1 个账户的计算结果与逐个计算不一致").arg(mismatches))
+             && passed;
+
+    QTemporaryDir directory;
+    if (!bench::check(kName, directory.isValid(), "无法创建临时目录")) {
+        return 1;
+    }
+    JsonPersistenceManager manager(nullptr, directory.path());
+
+    // 整个作业：内存存储库，不同线程数
+    for (int threads : bench::threadCounts(options)) {
+        MemoryAccountRepository repository;
+        repository.saveAccountsBatch(accounts);
+        TransactionModel transactions(&manager, QString("transactions-%1.json").arg(threads));
+        const double before = totalBalance(repository);
+
+        QElapsedTimer timer;
+        timer.start();
+        const AccrualReport report = InterestAccrualJob(policy, threads).run(
+            repository, transactions, nullptr, kDate, 1, true);
+        const qint64 elapsed = timer.nsecsElapsed();
+        bench::reportThroughput(kName, QString("job.threads-%1").arg(threads), count, elapsed);
+        bench::reportValue(kName, QString("job.threads-%1.compute").arg(threads), report.computeMs, "ms");
+
+        passed = bench::check(kName, report.committed && report.interestPostings == expectedInterest
+                                         && report.feePostings == expectedFees,
+                              report.summary()) && passed;
+        passed = bench::check(kName, transactions.getAllTransactions().size() == expectedInterest + expectedFees,
+                              "账本记录数与入账笔数不一致") && passed;
+        const double delta = totalBalance(repository) - before;
+        passed = bench::check(kName, std::abs(delta - (report.interestTotal - report.feeTotal)) < 0.01,
+                              QString("余额变化 %1 与报告的利息减管理费不一致").arg(delta, 0, 'f', 2)) && passed;
+    }
+
+    // JSON 存储库：整个作业一次提交，对照改动前逐个账户保存
+    {
+        JsonAccountRepository repository(&manager, "accounts.json");
+        passed = bench::check(kName, repository.saveAccountsBatch(accounts).success, "保存测试账户失败") && passed;
+        TransactionModel transactions(&manager, "transactions-json.json");
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < kLegacySaves; ++i) {
+            Account account = accounts.at(i + 1);
+            account.balance += interest.at(i + 1);
+            repository.saveAccount(account);
+        }
+        bench::reportThroughput(kName, "json.legacy-save-account", kLegacySaves, timer.nsecsElapsed());
+
+        timer.restart();
+        const AccrualReport report = InterestAccrualJob(policy).run(repository, transactions, nullptr, kDate, 1, true);
+        bench::reportThroughput(kName, "json.job", count, timer.nsecsElapsed());
+        passed = bench::check(kName, report.committed, report.summary()) && passed;
+    }
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file JsonLoadBenchmark.cpp
+ * @brief JSON 并行分块加载基准
+ *
+ * 写出一份大的 transactions.json，用 1、2、4、8、16 个线程（JsonPersistenceManager::setLoadThreadCount）
+ * 分别加载，输出吞吐量和相对单线程的加速比，并检查每次分块加载的记录与单线程加载的逐条相同、顺序一致。
+ */
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include "Benchmarks.h"
+#include "models/JsonPersistenceManager.h"
+#include "models/JsonTransactionStore.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "json-load";
+
+//!< 默认交易记录数
+const qint64 kDefaultTransactions = 2000000;
+
+//!< 账户数（决定卡号的重复程度）
+const qint64 kAccounts = 100000;
+
+//!< 测量的线程数
+const int kThreadCounts[] = {1, 2, 4, 8, 16};
+
+/**
+ * @brief 检查两次加载的记录逐条相同、顺序一致
+ * @param loaded 分块加载的结果
+ * @param expected 单线程加载的结果
+ * @return 第一条不同记录的下标，全部相同时为 -1
+ */
+int firstDifference(const QVector<Transaction>& loaded, const QVector<Transaction>& expected)
+{
+    const int count = int(qMin(loaded.size(), expected.size()));
+    for (int i = 0; i < count; ++i) {
+        if (!bench::sameTransaction(loaded.at(i), expected.at(i))) {
+            return i;
+        }
+    }
+    return loaded.size() == expected.size() ? -1 : count;
+}
+
+} // namespace
+
+int runJsonLoadBenchmark(const BenchmarkOptions& options)
+{
+    QTemporaryDir directory;
+    if (!bench::check(kName, directory.isValid(), "无法创建临时目录")) {
+        return 1;
+    }
+
+    const qint64 count = bench::sizeOr(options, kDefaultTransactions);
+    JsonPersistenceManager manager(nullptr, directory.path());
+    JsonTransactionStore store(&manager, "transactions.json");
+    {
+        const QVector<Transaction> transactions = bench::makeTransactions(count, qMin(count, kAccounts));
+        if (!bench::check(kName, store.saveTransactions(transactions), "保存交易记录失败")) {
+            return 1;
+        }
+    }
+    const double megabytes = double(QFileInfo(directory.filePath("transactions.json")).size()) / (1024.0 * 1024.0);
+    bench::reportValue(kName, "file-size", megabytes, "MiB");
+
+    // 指定 --threads 时只与单线程对比
+    QVector<int> threadCounts;
+    if (options.threads > 0) {
+        threadCounts = {1, options.threads};
+    } else {
+        for (int threads : kThreadCounts) {
+            threadCounts.append(threads);
+        }
+    }
+
+    bool passed = true;
+    QVector<Transaction> expected;
+    qint64 singleThreadNs = 0;
+    for (int threads : threadCounts) {
+        JsonPersistenceManager::setLoadThreadCount(threads);
+        QVector<Transaction> loaded;
+        bool loadedOk = true;
+        const qint64 elapsed = bench::bestOf(options.repeat, [&] {
+            loaded.clear();
+            loadedOk = store.loadTransactions(loaded) && loadedOk;
+        });
+        const QString metric = QString("load.threads-%1").arg(threads);
+        bench::reportThroughput(kName, metric, count, elapsed);
+        bench::reportValue(kName, metric + ".bandwidth", megabytes / (double(elapsed) / 1e9), "MiB/s");
+        passed = bench::check(kName, loadedOk && loaded.size() == count,
+                              QString("%1 个线程加载了 %2 条记录，应为 %3 条").arg(threads).arg(loaded.size()).arg(count))
+                 && passed;
+
+        if (threads == 1) {
+            singleThreadNs = elapsed;
+            expected = std::move(loaded);
+            continue;
+        }
+        bench::reportValue(kName, metric + ".speedup", double(singleThreadNs) / double(qMax<qint64>(1, elapsed)), "倍");
+        const int difference = firstDifference(loaded, expected);
+        passed = bench::check(kName, difference < 0,
+                              QString("%1 个线程加载的第 %2 条记录与单线程加载的不同").arg(threads).arg(difference))
+                 && passed;
+    }
+
+    JsonPersistenceManager::setLoadThreadCount(0); // 恢复为自动
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file JsonStreamBenchmark.cpp
+ * @brief 流式 JSON 读写与 DOM 读写对比基准
+ *
+ * 用同一份账本分别测量流式写入/解析（JsonTransactionStore）和改动前的 DOM 方式
+ * （逐条 toJson 组成 QJsonArray，再由 QJsonDocument 整体编码/解析）的耗时和峰值内存增量，
+ * 并检查流式写入的文件能完整读回。
+ */
+#include <QTemporaryDir>
+#include "Benchmarks.h"
+#include "models/JsonPersistenceManager.h"
+#include "models/JsonTransactionStore.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "json-stream";
+
+//!< 默认交易记录数
+const qint64 kDefaultTransactions = 500000;
+
+//!< 账户数（决定卡号的重复程度）
+const qint64 kAccounts = 10000;
+
+/**
+ * @brief 运行一段代码并输出耗时和峰值内存增量
+ *
+ * 峰值内存增量为执行期间常驻内存的最高值减去执行前的常驻内存，只运行一次；
+ * 不支持内存统计的平台只输出耗时。
+ *
+ * @param metric 指标名
+ * @param operations 操作数
+ * @param body 被测代码
+ */
+template <typename Body>
+void measureOnce(const QString& metric, qint64 operations, Body body)
+{
+    const bool tracksMemory = bench::resetPeakMemory();
+    const qint64 before = bench::residentMemory();
+    QElapsedTimer timer;
+    timer.start();
+    body();
+    const qint64 elapsed = timer.nsecsElapsed();
+    bench::reportThroughput(kName, metric, operations, elapsed);
+    if (tracksMemory && before >= 0) {
+        bench::reportValue(kName, metric + ".peak-memory",
+                           double(bench::peakResidentMemory() - before) / (1024.0 * 1024.0), "MiB");
+    }
+}
+
+} // namespace
+
+int runJsonStreamBenchmark(const BenchmarkOptions& options)
+{
+    QTemporaryDir directory;
+    if (!bench::check(kName, directory.isValid(), "无法创建临时目录")) {
+        return 1;
+    }
+
+    const qint64 count = bench::sizeOr(options, kDefaultTransactions);
+    const QVector<Transaction> transactions = bench::makeTransactions(count, qMin(count, kAccounts));
+    JsonPersistenceManager manager(nullptr, directory.path());
+    JsonTransactionStore store(&manager, "transactions.json");
+
+    // 与 DOM 方式比较单线程解析；并行分块加载的收益不计入本项
+    JsonPersistenceManager::setLoadThreadCount(1);
+
+    // 先测流式方式：DOM 方式释放的内存可能留在进程中被复用，先测会低估后测一方的内存增量
+    bool passed = true;
+    bool saved = false;
+    measureOnce("stream.save", count, [&] {
+        saved = store.saveTransactions(transactions);
+    });
+    passed = bench::check(kName, saved, "流式保存失败") && passed;
+
+    QVector<Transaction> loaded;
+    measureOnce("stream.load", count, [&] {
+        store.loadTransactions(loaded);
+    });
+    bool roundTrip = loaded.size() == transactions.size();
+    for (int i = 0; roundTrip && i < loaded.size(); ++i) {
+        roundTrip = bench::sameTransaction(loaded.at(i), transactions.at(i));
+    }
+    passed = bench::check(kName, roundTrip, "流式读回的交易与写入的不一致") && passed;
+    loaded.clear();
+    loaded.squeeze();
+
+    // DOM 方式：改动前 saveToFile/loadFromFile 的用法
+    measureOnce("dom.save", count, [&] {
+        QJsonArray array;
+        for (const Transaction& transaction : transactions) {
+            array.append(transaction.toJson());
+        }
+        saved = manager.saveToFile("transactions-dom.json", array);
+    });
+    passed = bench::check(kName, saved, "DOM 方式保存失败") && passed;
+
+    measureOnce("dom.load", count, [&] {
+        QJsonArray array;
+        if (manager.loadFromFile("transactions-dom.json", array)) {
+            loaded.reserve(array.size());
+            for (const QJsonValue& value : array) {
+                loaded.append(Transaction::fromJson(value.toObject()));
+            }
+        }
+    });
+    passed = bench::check(kName, loaded.size() == transactions.size(), "DOM 方式读回的交易数不一致") && passed;
+
+    JsonPersistenceManager::setLoadThreadCount(0); // 恢复为自动
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,240 @@
+/**
+ * @file LeaderboardBenchmark.cpp
+ * @brief 排行榜基准
+ *
+ * 测量增量排行榜的维护开销和查询耗时，并与改动前的做法对比：
+ * - 余额排行榜：BalanceLeaderboard::set 的吞吐量，top(100) 与 getAllAccounts() 后部分排序
+ * - 活跃度排行榜：ActivityLeaderboard::record 的吞吐量（含过期），top(100) 与扫描近24小时账本
+ * - 取款热路径：AccountService::withdrawAmount 启用与不启用全行汇总（含余额排行榜）的单笔耗时差
+ * 并检查增量结果与从头计算的结果一致。
+ */
+#include <QRandomGenerator>
+#include <algorithm>
+#include "Benchmarks.h"
+#include "MemoryAccountRepository.h"
+#include "models/AccountService.h"
+#include "models/AccountValidator.h"
+#include "models/BankAggregates.h"
+#include "models/Leaderboards.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "leaderboard";
+
+//!< 默认账户数
+const qint64 kDefaultAccounts = 1000000;
+
+//!< 排行榜长度
+const int kTopN = 100;
+
+//!< 查询次数
+const int kQueries = 100;
+
+//!< 活跃度排行榜的事件数
+const qint64 kActivityEvents = 2000000;
+
+//!< 活跃度排行榜相邻事件的间隔（毫秒），使窗口内约有 86400 / 0.1 = 864000 个事件
+const qint64 kActivitySpacingMs = 100;
+
+//!< 活跃度排行榜的窗口（毫秒）
+const qint64 kActivityWindowMs = 24LL * 60 * 60 * 1000;
+
+//!< 取款热路径的账户数
+const int kServiceAccounts = 1000;
+
+//!< 取款热路径的取款笔数
+const int kServiceWithdrawals = 200000;
+
+//!< 取款金额
+const double kAmount = 10.0;
+
+/**
+ * @brief 改动前的余额排行：复制全部账户后部分排序
+ * @param accounts 全部账户
+ * @param n 名次数
+ * @return 排行（余额降序，相同时卡号升序）
+ */
+QVector<LeaderboardEntry> sortTopBalances(QVector<Account> accounts, int n)
+{
+    const int count = qMin(n, accounts.size());
+    std::partial_sort(accounts.begin(), accounts.begin() + count, accounts.end(),
+                      [](const Account& a, const Account& b) {
+                          if (a.balance != b.balance) {
+                              return a.balance > b.balance;
+                          }
+                          return a.cardNumber < b.cardNumber;
+                      });
+    QVector<LeaderboardEntry> result;
+    for (int i = 0; i < count; ++i) {
+        result.append(LeaderboardEntry{accounts.at(i).cardNumber, accounts.at(i).balance});
+    }
+    return result;
+}
+
+/**
+ * @brief 比较两个排行
+ * @param a 排行
+ * @param b 排行
+ * @return 卡号和排序值都相同返回true
+ */
+bool sameRanking(const QVector<LeaderboardEntry>& a, const QVector<LeaderboardEntry>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (int i = 0; i < a.size(); ++i) {
+        if (a.at(i).cardNumber != b.at(i).cardNumber || a.at(i).value != b.at(i).value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int runLeaderboardBenchmark(const BenchmarkOptions& options)
+{
+    const qint64 count = bench::sizeOr(options, kDefaultAccounts);
+    QRandomGenerator random(70);
+    bool passed = true;
+
+    // 余额排行榜：初始建立、随机更新，对照组每次查询都复制全部账户并部分排序
+    {
+        MemoryAccountRepository repository;
+        repository.saveAccountsBatch(bench::makeAccounts(count));
+        BalanceLeaderboard board;
+        QElapsedTimer timer;
+        timer.start();
+        for (qint64 i = 0; i < count; ++i) {
+            board.set(bench::cardNumber(i), 1000.0 + double(i % 1000));
+        }
+        bench::reportThroughput(kName, "balance.build", count, timer.nsecsElapsed());
+
+        QVector<QString> cards;
+        QVector<double> balances;
+        for (qint64 i = 0; i < count; ++i) {
+            cards.append(bench::cardNumber(random.bounded(count)));
+            balances.append(double(random.bounded(1000000)) / 100.0);
+        }
+        timer.restart();
+        for (qint64 i = 0; i < count; ++i) {
+            board.set(cards.at(i), balances.at(i));
+        }
+        bench::reportThroughput(kName, "balance.set", count, timer.nsecsElapsed());
+        for (qint64 i = 0; i < count; ++i) {
+            std::optional<Account> account = repository.findByCardNumber(cards.at(i));
+            account->balance = balances.at(i);
+            repository.saveAccount(*account);
+        }
+
+        QVector<LeaderboardEntry> incremental;
+        bench::reportThroughput(kName, "balance.top-100", kQueries, bench::bestOf(options.repeat, [&] {
+            for (int q = 0; q < kQueries; ++q) {
+                incremental = board.top(kTopN);
+            }
+        }));
+        QVector<LeaderboardEntry> sorted;
+        bench::reportThroughput(kName, "balance.sort-all-accounts", 1, bench::bestOf(options.repeat, [&] {
+            sorted = sortTopBalances(repository.getAllAccounts(), kTopN);
+        }));
+        passed = bench::check(kName, sameRanking(incremental, sorted), "余额排行榜与排序结果不一致") && passed;
+    }
+
+    // 活跃度排行榜：事件按时间推进，窗口外的事件在查询时过期；对照组扫描窗口内的账本计数
+    {
+        ActivityLeaderboard board(kActivityWindowMs);
+        QVector<QString> eventCards;
+        eventCards.reserve(kActivityEvents);
+        for (qint64 i = 0; i < kActivityEvents; ++i) {
+            // 少数卡远比其他卡活跃
+            const qint64 card = random.bounded(8) == 0 ? random.bounded(qint64(kTopN)) : random.bounded(count);
+            eventCards.append(bench::cardNumber(card));
+        }
+        const qint64 startMs = 1735689600000LL;
+        QElapsedTimer timer;
+        timer.start();
+        for (qint64 i = 0; i < kActivityEvents; ++i) {
+            const qint64 atMs = startMs + i * kActivitySpacingMs;
+            board.record(eventCards.at(i), atMs, atMs);
+        }
+        bench::reportThroughput(kName, "activity.record", kActivityEvents, timer.nsecsElapsed());
+
+        const qint64 nowMs = startMs + (kActivityEvents - 1) * kActivitySpacingMs;
+        QVector<LeaderboardEntry> incremental;
+        bench::reportThroughput(kName, "activity.top-100", kQueries, bench::bestOf(options.repeat, [&] {
+            for (int q = 0; q < kQueries; ++q) {
+                incremental = board.top(kTopN, nowMs);
+            }
+        }));
+
+        QVector<LeaderboardEntry> scanned;
+        bench::reportThroughput(kName, "activity.scan-ledger", 1, bench::bestOf(options.repeat, [&] {
+            QHash<QString, int> counts;
+            for (qint64 i = kActivityEvents - 1; i >= 0; --i) {
+                if (startMs + i * kActivitySpacingMs <= nowMs - kActivityWindowMs) {
+                    break;
+                }
+                ++counts[eventCards.at(i)];
+            }
+            QVector<LeaderboardEntry> entries;
+            entries.reserve(counts.size());
+            for (auto it = counts.cbegin(); it != counts.cend(); ++it) {
+                entries.append(LeaderboardEntry{it.key(), double(it.value())});
+            }
+            const int n = qMin(kTopN, entries.size());
+            std::partial_sort(entries.begin(), entries.begin() + n, entries.end(),
+                              [](const LeaderboardEntry& a, const LeaderboardEntry& b) {
+                                  if (a.value != b.value) {
+                                      return a.value > b.value;
+                                  }
+                                  return a.cardNumber < b.cardNumber;
+                              });
+            entries.resize(n);
+            scanned = entries;
+        }));
+        passed = bench::check(kName, sameRanking(incremental, scanned), "活跃度排行榜与扫描结果不一致") && passed;
+    }
+
+    // 取款热路径：同样的取款，启用与不启用全行汇总
+    {
+        QVector<Account> accounts = bench::makeAccounts(kServiceAccounts);
+        for (Account& account : accounts) {
+            account.balance = 1000000.0;
+        }
+        MemoryAccountRepository repository;
+        repository.saveAccountsBatch(accounts);
+        VirtualClock clock(QDateTime::fromMSecsSinceEpoch(1735689600000LL, Qt::UTC));
+        AccountValidator validator(&repository);
+        validator.setClock(&clock);
+        AccountService service(&repository, &validator);
+        service.setClock(&clock);
+        // 每笔间隔1秒，同一张卡每 1000 秒取款一次，不触发风控和累计限额
+        const auto run = [&]() {
+            int failures = 0;
+            QElapsedTimer timer;
+            timer.start();
+            for (int i = 0; i < kServiceWithdrawals; ++i) {
+                failures += service.withdrawAmount(bench::cardNumber(i % kServiceAccounts), kAmount).success ? 0 : 1;
+                clock.advance(1000);
+            }
+            passed = bench::check(kName, failures == 0, QString("%1 笔取款失败").arg(failures)) && passed;
+            return timer.nsecsElapsed();
+        };
+        const qint64 plainNs = run();
+        AccountAggregates aggregates;
+        aggregates.reset(repository.getAllAccounts(), clock.utcMs());
+        service.setAggregates(&aggregates);
+        const qint64 rankedNs = run();
+        bench::reportThroughput(kName, "withdraw.plain", kServiceWithdrawals, plainNs);
+        bench::reportThroughput(kName, "withdraw.with-aggregates", kServiceWithdrawals, rankedNs);
+        bench::reportValue(kName, "withdraw.overhead-per-withdrawal",
+                           double(rankedNs - plainNs) / double(kServiceWithdrawals), "ns");
+
+        const AccountAggregates expected = AccountAggregates::compute(repository.getAllAccounts(), clock.utcMs());
+        const QStringList differences = aggregates.differences(expected, clock.utcMs());
+        passed = bench::check(kName, differences.isEmpty(), differences.join("; ")) && passed;
+    }
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file LedgerVerifierBenchmark.cpp
+ * @brief 账本一致性校验基准
+ *
+ * 生成一条 balanceAfter 链完全一致的账本（含双边转账和余额查询），
+ * 测量 LedgerVerifier 在不同线程数下的重放吞吐量（笔/秒），
+ * 并检查一致的账本没有误报、人为制造的断链和余额不符都被找到。
+ */
+#include "Benchmarks.h"
+#include "models/LedgerVerifier.h"
+#include "models/TransactionIdGenerator.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "ledger";
+
+//!< 默认交易数
+const qint64 kDefaultTransactions = 10000000;
+
+//!< 平均每张卡的交易数
+const qint64 kTransactionsPerCard = 100;
+
+//!< 第一笔交易的时间
+const qint64 kFirstTransactionMs = 1735689600000LL; // 2025-01-01T00:00:00Z
+
+/**
+ * @brief 生成一致的账本和对应的账户
+ *
+ * 交易轮流分配给各卡：每50笔中一笔为转给下一张卡的双边转账，每10笔中一笔为余额查询，
+ * 其余存取款交替；每笔的 balanceAfter 按金额推算，账户余额等于最后一笔的余额。
+ *
+ * @param count 交易数
+ * @param accounts 输出参数，账户
+ * @return 交易记录
+ */
+QVector<Transaction> makeLedger(qint64 count, QVector<Account>& accounts)
+{
+    const qint64 cardCount = qMax<qint64>(2, count / kTransactionsPerCard);
+    accounts = bench::makeAccounts(cardCount);
+    QVector<QString> cards;
+    QVector<double> balances;
+    cards.reserve(cardCount);
+    balances.reserve(cardCount);
+    for (const Account& account : accounts) {
+        cards.append(account.cardNumber);
+        balances.append(account.balance);
+    }
+
+    const QString depositText = QStringLiteral("柜台存款");
+    const QString withdrawalText = QStringLiteral("ATM取款");
+    const QString inquiryText = QStringLiteral("余额查询");
+    const QString transferText = QStringLiteral("转账");
+
+    TransactionIdGenerator ids;
+    QVector<Transaction> transactions;
+    transactions.reserve(count);
+    for (qint64 i = 0; i < count; ++i) {
+        const int card = int(i % cardCount);
+        const double amount = 10.0 + double(i % 90);
+        Transaction transaction;
+        transaction.id = ids.next();
+        transaction.cardNumber = cards.at(card);
+        transaction.timestamp = QDateTime::fromMSecsSinceEpoch(kFirstTransactionMs + i * 1000, Qt::UTC);
+        transaction.amount = amount;
+        if (i % 50 == 49) {
+            const int target = int((card + 1) % cardCount);
+            transaction.type = TransactionType::Transfer;
+            transaction.description = transferText;
+            transaction.targetCardNumber = cards.at(target);
+            transaction.hasTargetLeg = true;
+            balances[card] -= amount;
+            balances[target] += amount;
+            transaction.targetBalanceAfter = balances.at(target);
+        } else if (i % 10 == 9) {
+            transaction.type = TransactionType::BalanceInquiry;
+            transaction.amount = 0.0;
+            transaction.description = inquiryText;
+        } else if ((i / cardCount) % 2 == 0) {
+            transaction.type = TransactionType::Deposit;
+            transaction.description = depositText;
+            balances[card] += amount;
+        } else {
+            transaction.type = TransactionType::Withdrawal;
+            transaction.description = withdrawalText;
+            balances[card] -= amount;
+        }
+        transaction.balanceAfter = balances.at(card);
+        transactions.append(transaction);
+    }
+
+    for (int card = 0; card < accounts.size(); ++card) {
+        accounts[card].balance = balances.at(card);
+    }
+    return transactions;
+}
+
+/**
+ * @brief 统计某类不一致的数量
+ * @param report 校验报告
+ * @param kind 类型
+ * @return 数量
+ */
+int countKind(const LedgerReport& report, LedgerDiscrepancy::Kind kind)
+{
+    int count = 0;
+    for (const LedgerDiscrepancy& discrepancy : report.discrepancies) {
+        count += discrepancy.kind == kind ? 1 : 0;
+    }
+    return count;
+}
+
+} // namespace
+
+int runLedgerVerifierBenchmark(const BenchmarkOptions& options)
+{
+    const qint64 count = bench::sizeOr(options, kDefaultTransactions);
+    QVector<Account> accounts;
+    QVector<Transaction> transactions = makeLedger(count, accounts);
+    bench::reportValue(kName, "cards", accounts.size(), "张");
+
+    bool passed = true;
+    for (int threads : bench::threadCounts(options)) {
+        const LedgerVerifier verifier(threads);
+        LedgerReport report;
+        const qint64 ns = bench::bestOf(options.repeat, [&] {
+            report = verifier.verify(transactions, accounts);
+        });
+        bench::reportThroughput(kName, QString("verify.threads-%1").arg(threads), count, ns);
+        passed = bench::check(kName, report.isConsistent(),
+                              QString("%1 个线程时一致的账本报告了 %2 处不一致")
+                                  .arg(threads).arg(report.discrepancies.size()))
+                 && passed;
+    }
+
+    // 制造不一致：改动中间一笔存取款的金额（一处断链），改动一个账户的余额（一处余额不符）
+    qint64 tampered = transactions.size() / 2;
+    while (tampered < transactions.size() && (transactions.at(tampered).type == TransactionType::BalanceInquiry
+                                              || transactions.at(tampered).hasTargetLeg)) {
+        ++tampered;
+    }
+    transactions[tampered].amount += 1.0;
+    accounts[0].balance += 1.0;
+
+    const LedgerReport report = LedgerVerifier().verify(transactions, accounts);
+    passed = bench::check(kName, countKind(report, LedgerDiscrepancy::Kind::ChainBreak) == 1,
+                          "未找到（或多报了）被改动金额的交易") && passed;
+    passed = bench::check(kName, countKind(report, LedgerDiscrepancy::Kind::BalanceMismatch) == 1,
+                          "未找到（或多报了）余额不符的账户") && passed;
+    passed = bench::check(kName, report.discrepancies.size() == 2,
+                          QString("应报告 2 处不一致，实际 %1 处").arg(report.discrepancies.size())) && passed;
+
+    return passed ? 0 : 1;
+}
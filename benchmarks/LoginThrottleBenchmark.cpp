@@ -0,0 +1,162 @@
+/**
+ * @file LoginThrottleBenchmark.cpp
+ * @brief 登录失败吞吐量基准
+ *
+ * 在 JSON 存储库上测量 PIN 错误的处理吞吐量和存储库写入次数：
+ * - legacy：改动前的做法，每次 PIN 错误都 recordFailedLogin 后 saveAccount（重写整个账户文件）
+ * - spread：AccountValidator 处理分散在不同卡号上的 PIN 错误，最后一次性写回
+ * - burst：AccountValidator 处理针对同一卡号、轮换终端的暴力尝试，只在触发锁定时写回
+ * 时间由虚拟时钟推进，每次尝试间隔1秒。
+ */
+#include <QTemporaryDir>
+#include <memory>
+#include "Benchmarks.h"
+#include "models/AccountValidator.h"
+#include "models/JsonAccountRepository.h"
+#include "models/JsonPersistenceManager.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "failed-login";
+
+//!< 默认账户数
+const qint64 kDefaultAccounts = 100000;
+
+//!< 改动前做法的尝试次数（每次都重写整个账户文件）
+const int kLegacyAttempts = 50;
+
+//!< 暴力尝试的次数
+const int kBurstAttempts = 100000;
+
+//!< 轮换使用的终端数
+const int kTerminals = 64;
+
+//!< 错误的 PIN
+const char kWrongPin[] = "000000";
+
+/**
+ * @brief 统计写操作次数的存储库装饰器
+ */
+class CountingAccountRepository : public IAccountRepository {
+public:
+    explicit CountingAccountRepository(IAccountRepository* repository) : m_repository(repository) {}
+
+    OperationResult saveAccount(const Account& account) override
+    {
+        ++writes;
+        return m_repository->saveAccount(account);
+    }
+    OperationResult saveAccountsBatch(const QVector<Account>& accounts) override
+    {
+        ++writes;
+        return m_repository->saveAccountsBatch(accounts);
+    }
+    OperationResult deleteAccount(const QString& cardNumber) override
+    {
+        ++writes;
+        return m_repository->deleteAccount(cardNumber);
+    }
+    std::optional<Account> findByCardNumber(const QString& cardNumber) const override
+    {
+        return m_repository->findByCardNumber(cardNumber);
+    }
+    QVector<Account> getAllAccounts() const override { return m_repository->getAllAccounts(); }
+    bool saveAccounts() override { return m_repository->saveAccounts(); }
+    bool loadAccounts() override { return m_repository->loadAccounts(); }
+    bool accountExists(const QString& cardNumber) const override
+    {
+        return m_repository->accountExists(cardNumber);
+    }
+    const AccountTable* accountTable() const override { return m_repository->accountTable(); }
+
+    int writes = 0; //!< 写操作次数
+
+private:
+    //!< 被包装的存储库
+    IAccountRepository* m_repository;
+};
+
+/**
+ * @brief 输出一个场景的吞吐量和写入次数
+ * @param metric 指标名
+ * @param attempts 尝试次数
+ * @param elapsedNs 耗时（纳秒）
+ * @param writes 存储库写操作次数
+ */
+void reportScenario(const QString& metric, qint64 attempts, qint64 elapsedNs, int writes)
+{
+    bench::reportThroughput(kName, metric, attempts, elapsedNs);
+    bench::reportValue(kName, metric + ".writes", writes, "次");
+}
+
+} // namespace
+
+int runLoginThrottleBenchmark(const BenchmarkOptions& options)
+{
+    QTemporaryDir directory;
+    if (!bench::check(kName, directory.isValid(), "无法创建临时目录")) {
+        return 1;
+    }
+
+    const qint64 accountCount = bench::sizeOr(options, kDefaultAccounts);
+    JsonPersistenceManager manager(nullptr, directory.path());
+    JsonAccountRepository repository(&manager, "accounts.json");
+    bool passed = bench::check(kName, repository.saveAccountsBatch(bench::makeAccounts(accountCount)).success,
+                               "保存测试账户失败");
+
+    CountingAccountRepository counting(&repository);
+    VirtualClock clock(QDateTime::fromMSecsSinceEpoch(1735689600000LL, Qt::UTC));
+
+    // 改动前：每次 PIN 错误都写回账户
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kLegacyAttempts; ++i) {
+        std::optional<Account> account = counting.findByCardNumber(bench::cardNumber(i % accountCount));
+        if (account && !account->isTemporarilyLocked(&clock) && !account->verifyPin(kWrongPin)) {
+            account->recordFailedLogin(&clock);
+            counting.saveAccount(*account);
+        }
+        clock.advance(1000);
+    }
+    reportScenario("legacy", kLegacyAttempts, timer.nsecsElapsed(), counting.writes);
+
+    {
+        // 分散：每张卡一次 PIN 错误，不触发锁定，只在最后写回一次
+        AccountValidator validator(&counting);
+        validator.setClock(&clock);
+        counting.writes = 0;
+        int rejected = 0;
+        timer.restart();
+        for (qint64 i = 0; i < accountCount; ++i) {
+            const OperationResult result = validator.validateCredentials(
+                bench::cardNumber(i), kWrongPin, QString("atm-%1").arg(i % kTerminals));
+            rejected += result.success ? 0 : 1;
+            clock.advance(1000);
+        }
+        passed = bench::check(kName, validator.flushLoginFailures().success, "写回登录失败状态失败") && passed;
+        reportScenario("spread", accountCount, timer.nsecsElapsed(), counting.writes);
+        passed = bench::check(kName, rejected == accountCount, "错误的 PIN 被接受") && passed;
+
+        const std::optional<Account> last = repository.findByCardNumber(bench::cardNumber(accountCount - 1));
+        passed = bench::check(kName, last && last->failedLoginAttempts == 1, "写回后的失败次数不正确") && passed;
+    }
+
+    {
+        // 暴力尝试：同一卡号、轮换终端；锁定期内直接拒绝，只在触发锁定时写回
+        AccountValidator validator(&counting);
+        validator.setClock(&clock);
+        const QString target = bench::cardNumber(0);
+        counting.writes = 0;
+        timer.restart();
+        for (int i = 0; i < kBurstAttempts; ++i) {
+            validator.validateCredentials(target, kWrongPin, QString("atm-%1").arg(i % kTerminals));
+            clock.advance(1000);
+        }
+        const qint64 elapsed = timer.nsecsElapsed();
+        passed = bench::check(kName, validator.temporaryLockUntilMs(target) > 0, "暴力尝试未触发临时锁定") && passed;
+        reportScenario("burst", kBurstAttempts, elapsed, counting.writes);
+    }
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file MemoryAccountRepository.cpp
+ * @brief 只在内存中保存账户的存储库实现
+ *
+ * 实现了MemoryAccountRepository类中定义的内存读写方法。
+ */
+#include "MemoryAccountRepository.h"
+
+OperationResult MemoryAccountRepository::saveAccount(const Account& account)
+{
+    if (!account.isValid()) {
+        return OperationResult::Failure("账户数据无效");
+    }
+    m_table.upsert(account);
+    ++m_writes;
+    return OperationResult::Success();
+}
+
+OperationResult MemoryAccountRepository::saveAccountsBatch(const QVector<Account>& accounts)
+{
+    for (const Account& account : accounts) {
+        if (!account.isValid()) {
+            return OperationResult::Failure("账户数据无效");
+        }
+    }
+    m_table.reserve(m_table.size() + accounts.size());
+    for (const Account& account : accounts) {
+        m_table.upsert(account);
+    }
+    ++m_writes;
+    return OperationResult::Success();
+}
+
+OperationResult MemoryAccountRepository::deleteAccount(const QString& cardNumber)
+{
+    if (!m_table.remove(cardNumber)) {
+        return OperationResult::Failure("账户不存在");
+    }
+    ++m_writes;
+    return OperationResult::Success();
+}
+
+std::optional<Account> MemoryAccountRepository::findByCardNumber(const QString& cardNumber) const
+{
+    const int row = m_table.indexOf(cardNumber);
+    if (row < 0) {
+        return std::nullopt;
+    }
+    return m_table.account(row);
+}
+
+QVector<Account> MemoryAccountRepository::getAllAccounts() const
+{
+    return m_table.allAccounts();
+}
+
+bool MemoryAccountRepository::saveAccounts()
+{
+    return true;
+}
+
+bool MemoryAccountRepository::loadAccounts()
+{
+    return true;
+}
+
+bool MemoryAccountRepository::accountExists(const QString& cardNumber) const
+{
+    return m_table.contains(cardNumber);
+}
+
+const AccountTable* MemoryAccountRepository::accountTable() const
+{
+    return &m_table;
+}
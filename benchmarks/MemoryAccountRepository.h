@@ -0,0 +1,40 @@
+/**
+ * @file MemoryAccountRepository.h
+ * @brief 只在内存中保存账户的存储库
+ *
+ * 基准测试用于把业务逻辑的开销与文件或数据库写入隔离开。
+ */
+#pragma once
+
+#include "models/IAccountRepository.h"
+
+/**
+ * @brief 只在内存中保存账户的存储库
+ *
+ * 账户保存在列式表中，写操作只更新内存并计数，不做任何 I/O；校验规则与 JSON 存储库相同。
+ */
+class MemoryAccountRepository : public IAccountRepository {
+public:
+    OperationResult saveAccount(const Account& account) override;
+    OperationResult saveAccountsBatch(const QVector<Account>& accounts) override;
+    OperationResult deleteAccount(const QString& cardNumber) override;
+    std::optional<Account> findByCardNumber(const QString& cardNumber) const override;
+    QVector<Account> getAllAccounts() const override;
+    bool saveAccounts() override;
+    bool loadAccounts() override;
+    bool accountExists(const QString& cardNumber) const override;
+    const AccountTable* accountTable() const override;
+
+    /**
+     * @brief 获取写操作次数
+     * @return saveAccount、saveAccountsBatch 和 deleteAccount 成功的次数
+     */
+    int writes() const { return m_writes; }
+
+private:
+    //!< 账户表
+    AccountTable m_table;
+
+    //!< 写操作次数
+    int m_writes = 0;
+};
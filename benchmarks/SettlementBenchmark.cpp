@@ -0,0 +1,299 @@
+/**
+ * @file SettlementBenchmark.cpp
+ * @brief 日终清算基准
+ *
+ * 在一天 5×10^6 笔交易（10^5 张卡）上测量：
+ * - 不同线程数下的汇总吞吐量（默认每线程 4 个行块）
+ * - 最大线程数下每线程行块数为 1、2、4、8、16 时的汇总吞吐量，用于确定默认值
+ * - 汇总并写出 CSV 文件的吞吐量
+ * - 后台清算快照的同时在前台登记新交易，清算结果不受影响
+ * 并用单线程逐笔汇总核对各卡借贷和卡号对轧差结果。
+ */
+#include <QFileInfo>
+#include <QHash>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QtConcurrent/QtConcurrentRun>
+#include <cmath>
+#include "Benchmarks.h"
+#include "models/SettlementBatch.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "settlement";
+
+//!< 默认交易数
+const qint64 kDefaultTransactions = 5000000;
+
+//!< 平均每张卡的交易数
+const qint64 kTransactionsPerCard = 50;
+
+//!< 测量的每线程行块数
+const int kChunksPerThread[] = {1, 2, 4, 8, 16};
+
+//!< 清算日
+const QDate kDate(2025, 1, 31);
+
+//!< 金额比较的容差
+const double kTolerance = 0.005;
+
+/**
+ * @brief 单线程逐笔汇总的结果
+ */
+struct ExpectedSettlement {
+    qint64 settled = 0;                             //!< 纳入清算的交易数
+    QHash<QString, CardPosition> positions;         //!< 各卡借贷汇总
+    QHash<QPair<QString, QString>, NetTransferPosition> pairs; //!< 卡号对往来（按卡号升序为键，未轧差）
+};
+
+/**
+ * @brief 生成一天的交易
+ *
+ * 四成为取款，两成为存款，两成为双边转账，其余为旧格式的转出与转入、利息与管理费和余额查询；
+ * 另有 2% 落在前一天，不应纳入清算。金额为整数，各种累加顺序的结果都精确相等。
+ *
+ * @param count 交易数
+ * @param cards 卡号
+ * @return 交易列表
+ */
+QVector<Transaction> makeSettlementDay(qint64 count, const QVector<QString>& cards)
+{
+    QRandomGenerator random(73);
+    const qint64 dayStartMs = QDateTime(kDate, QTime(0, 0)).toMSecsSinceEpoch();
+    const qint64 dayMs = 24LL * 60 * 60 * 1000;
+    QVector<Transaction> transactions;
+    transactions.reserve(count);
+    for (qint64 i = 0; i < count; ++i) {
+        Transaction transaction;
+        transaction.id = quint64(i + 1);
+        const int card = random.bounded(cards.size());
+        // 收款方集中在附近几张卡，使同一卡号对有双向往来
+        const int target = (card + 1 + random.bounded(4)) % cards.size();
+        transaction.cardNumber = cards.at(card);
+        transaction.timestamp = QDateTime::fromMSecsSinceEpoch(
+            i % 50 == 49 ? dayStartMs - 1 - i % dayMs : dayStartMs + i * dayMs / count);
+        transaction.amount = double(10 + random.bounded(990));
+        transaction.balanceAfter = 1000.0;
+
+        switch (i % 20) {
+        case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7:
+            transaction.type = TransactionType::Withdrawal;
+            break;
+        case 8: case 9: case 10: case 11:
+            transaction.type = TransactionType::Deposit;
+            break;
+        case 12: case 13: case 14: case 15:
+            transaction.type = TransactionType::Transfer;
+            transaction.targetCardNumber = cards.at(target);
+            transaction.hasTargetLeg = true;
+            break;
+        case 16:
+            transaction.type = TransactionType::Transfer;
+            transaction.targetCardNumber = cards.at(target);
+            break;
+        case 17:
+            transaction.type = TransactionType::TransferIn;
+            transaction.targetCardNumber = cards.at(target);
+            break;
+        case 18:
+            transaction.type = i % 40 == 18 ? TransactionType::Interest : TransactionType::Fee;
+            break;
+        default:
+            transaction.type = TransactionType::BalanceInquiry;
+            transaction.amount = 0.0;
+            break;
+        }
+        transactions.append(transaction);
+    }
+    return transactions;
+}
+
+/**
+ * @brief 计入一张卡的借记或贷记
+ * @param positions 各卡借贷汇总
+ * @param cardNumber 卡号
+ * @param amount 金额
+ * @param debit 借记为true，贷记为false
+ */
+void post(QHash<QString, CardPosition>& positions, const QString& cardNumber, double amount, bool debit)
+{
+    CardPosition& position = positions[cardNumber];
+    position.cardNumber = cardNumber;
+    if (debit) {
+        ++position.debitCount;
+        position.debitAmount += amount;
+    } else {
+        ++position.creditCount;
+        position.creditAmount += amount;
+    }
+}
+
+/**
+ * @brief 单线程逐笔汇总
+ * @param transactions 交易
+ * @return 汇总结果
+ */
+ExpectedSettlement settleSerially(const QVector<Transaction>& transactions)
+{
+    const qint64 dayStartMs = QDateTime(kDate, QTime(0, 0)).toMSecsSinceEpoch();
+    const qint64 dayEndMs = QDateTime(kDate.addDays(1), QTime(0, 0)).toMSecsSinceEpoch();
+    ExpectedSettlement expected;
+    for (const Transaction& transaction : transactions) {
+        const qint64 timestampMs = transaction.timestamp.toMSecsSinceEpoch();
+        if (timestampMs < dayStartMs || timestampMs >= dayEndMs
+            || transaction.type == TransactionType::BalanceInquiry || transaction.type == TransactionType::Other) {
+            continue;
+        }
+        ++expected.settled;
+
+        const bool debit = transaction.type == TransactionType::Withdrawal || transaction.type == TransactionType::Fee
+                           || transaction.type == TransactionType::Transfer;
+        post(expected.positions, transaction.cardNumber, transaction.amount, debit);
+        if (transaction.type == TransactionType::Transfer && transaction.hasTargetLeg) {
+            post(expected.positions, transaction.targetCardNumber, transaction.amount, false);
+        }
+
+        if ((transaction.type == TransactionType::Transfer || transaction.type == TransactionType::TransferIn)
+            && transaction.targetCardNumber != transaction.cardNumber) {
+            const QString& payer = transaction.type == TransactionType::Transfer
+                ? transaction.cardNumber : transaction.targetCardNumber;
+            const QString& payee = transaction.type == TransactionType::Transfer
+                ? transaction.targetCardNumber : transaction.cardNumber;
+            const bool lowerPays = payer < payee;
+            NetTransferPosition& pair = expected.pairs[lowerPays ? qMakePair(payer, payee) : qMakePair(payee, payer)];
+            if (lowerPays) {
+                ++pair.paidCount;
+                pair.paidAmount += transaction.amount;
+            } else {
+                ++pair.receivedCount;
+                pair.receivedAmount += transaction.amount;
+            }
+        }
+    }
+    return expected;
+}
+
+/**
+ * @brief 核对清算结果与逐笔汇总一致
+ * @param report 清算结果
+ * @param expected 逐笔汇总结果
+ * @return 不一致之处的说明，一致时为空
+ */
+QString compare(const SettlementReport& report, const ExpectedSettlement& expected)
+{
+    if (report.transactionsSettled != expected.settled) {
+        return QString("纳入清算 %1 笔，应为 %2 笔").arg(report.transactionsSettled).arg(expected.settled);
+    }
+    if (report.positions.size() != expected.positions.size()
+        || report.netTransfers.size() != expected.pairs.size()) {
+        return QString("%1 张卡、%2 对往来，应为 %3 张卡、%4 对往来")
+            .arg(report.positions.size()).arg(report.netTransfers.size())
+            .arg(expected.positions.size()).arg(expected.pairs.size());
+    }
+    for (const CardPosition& position : report.positions) {
+        const CardPosition card = expected.positions.value(position.cardNumber);
+        if (card.debitCount != position.debitCount || card.creditCount != position.creditCount
+            || std::abs(card.debitAmount - position.debitAmount) > kTolerance
+            || std::abs(card.creditAmount - position.creditAmount) > kTolerance) {
+            return QString("卡 %1 的借贷汇总不一致").arg(position.cardNumber);
+        }
+    }
+    for (const NetTransferPosition& pair : report.netTransfers) {
+        const bool lowerPays = pair.payerCard < pair.payeeCard;
+        const auto key = lowerPays ? qMakePair(pair.payerCard, pair.payeeCard)
+                                   : qMakePair(pair.payeeCard, pair.payerCard);
+        const auto it = expected.pairs.constFind(key);
+        if (it == expected.pairs.cend() || pair.net() < -kTolerance
+            || std::abs(pair.net() - std::abs(it->paidAmount - it->receivedAmount)) > kTolerance
+            || pair.paidCount + pair.receivedCount != it->paidCount + it->receivedCount) {
+            return QString("卡号对 %1 → %2 的轧差结果不一致").arg(pair.payerCard, pair.payeeCard);
+        }
+    }
+    return QString();
+}
+
+} // namespace
+
+int runSettlementBenchmark(const BenchmarkOptions& options)
+{
+    const qint64 count = bench::sizeOr(options, kDefaultTransactions);
+    QVector<QString> cards;
+    for (qint64 i = 0; i < qMax<qint64>(2, count / kTransactionsPerCard); ++i) {
+        cards.append(bench::cardNumber(i));
+    }
+    const QVector<Transaction> transactions = makeSettlementDay(count, cards);
+
+    QElapsedTimer timer;
+    timer.start();
+    const ExpectedSettlement expected = settleSerially(transactions);
+    bench::reportThroughput(kName, "serial-hash", count, timer.nsecsElapsed());
+    bool passed = true;
+
+    // 不同线程数，默认行块数，只汇总不写文件
+    const QVector<int> threadCounts = bench::threadCounts(options);
+    for (int threads : threadCounts) {
+        SettlementReport report;
+        bench::reportThroughput(kName, QString("compute.threads-%1").arg(threads), count,
+                                bench::bestOf(options.repeat, [&] {
+                                    report = SettlementBatch(threads).run(transactions, kDate, QString());
+                                }));
+        const QString difference = compare(report, expected);
+        passed = bench::check(kName, difference.isEmpty(), difference) && passed;
+    }
+
+    // 最大线程数下的每线程行块数：行块越多负载越均衡，分区桶数（行块数 × 分区数）也越多
+    const int maxThreads = threadCounts.last();
+    for (int chunks : kChunksPerThread) {
+        SettlementReport report;
+        bench::reportThroughput(kName, QString("compute.threads-%1.chunks-%2").arg(maxThreads).arg(chunks), count,
+                                bench::bestOf(options.repeat, [&] {
+                                    report = SettlementBatch(maxThreads, chunks).run(transactions, kDate, QString());
+                                }));
+        const QString difference = compare(report, expected);
+        passed = bench::check(kName, difference.isEmpty(), difference) && passed;
+    }
+
+    QTemporaryDir directory;
+    if (!bench::check(kName, directory.isValid(), "无法创建临时目录")) {
+        return 1;
+    }
+
+    // 汇总并写出清算文件
+    {
+        const QString filePath = directory.filePath("settlement.csv");
+        SettlementReport report;
+        bench::reportThroughput(kName, QString("csv.threads-%1").arg(maxThreads), count,
+                                bench::bestOf(options.repeat, [&] {
+                                    report = SettlementBatch(maxThreads).run(transactions, kDate, filePath);
+                                }));
+        bench::reportValue(kName, "csv.write", report.writeMs, "ms");
+        bench::reportValue(kName, "csv.bytes", double(report.bytesWritten), "字节");
+        passed = bench::check(kName, report.success && QFileInfo(filePath).size() == report.bytesWritten,
+                              report.summary()) && passed;
+    }
+
+    // 后台清算快照，前台同时登记新交易（与 AppController::startSettlement 相同）
+    // 第一次登记时账本另行分配，这次复制也计入登记的耗时
+    {
+        QVector<Transaction> live = transactions;
+        const QVector<Transaction> snapshot = live;
+        QFuture<SettlementReport> future = QtConcurrent::run([snapshot]() {
+            return SettlementBatch().run(snapshot, kDate, QString());
+        });
+        qint64 appended = 0;
+        timer.restart();
+        while (!future.isFinished()) {
+            Transaction transaction = transactions.at(appended % count);
+            transaction.id = quint64(count + appended + 1);
+            live.append(transaction);
+            ++appended;
+        }
+        bench::reportThroughput(kName, "live.append-during-settlement", appended, timer.nsecsElapsed());
+        const QString difference = compare(future.result(), expected);
+        passed = bench::check(kName, difference.isEmpty(), "登记新交易影响了清算快照: " + difference) && passed;
+        passed = bench::check(kName, live.size() == count + appended, "前台登记的交易数不正确") && passed;
+    }
+
+    return passed ? 0 : 1;
+}
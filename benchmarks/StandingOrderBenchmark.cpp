@@ -0,0 +1,202 @@
+/**
+ * @file StandingOrderBenchmark.cpp
+ * @brief 定期转账月末集中到期基准
+ *
+ * 分两部分：
+ * - 时间轮：10^6 个定时器（六成在月末同一刻度到期，其余分散在一个月内），测量添加、取消、
+ *   按天推进和月末一次取出的耗时，以 QMultiMap 为对照，并检查每个定时器恰好在到期的那次推进中取出
+ * - 调度器：从文件加载月末到期的指令，在内存存储库上按不同批大小执行月末集中转账，
+ *   测量加载和执行的吞吐量；每批执行前都要重写整个指令文件，批越小写文件的次数越多
+ */
+#include <QMultiMap>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include "Benchmarks.h"
+#include "MemoryAccountRepository.h"
+#include "models/AccountService.h"
+#include "models/AccountValidator.h"
+#include "models/JsonPersistenceManager.h"
+#include "models/StandingOrderScheduler.h"
+#include "models/TimerWheel.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "standing-orders";
+
+//!< 默认定时器数
+const qint64 kDefaultTimers = 1000000;
+
+//!< 调度器部分的指令数上限（每批都重写整个指令文件）
+const int kMaxSchedulerOrders = 20000;
+
+//!< 一个月的刻度数（分钟）
+const qint64 kMonthTicks = 31LL * 24 * 60;
+
+//!< 一天的刻度数（分钟）
+const qint64 kDayTicks = 24LL * 60;
+
+//!< 测量的批大小（500 为调度器默认值）
+const int kBatchSizes[] = {500, 5000};
+
+//!< 每笔定期转账的金额
+const double kAmount = 100.0;
+
+//!< 指令文件名
+const char kOrdersFile[] = "standing_orders.json";
+
+} // namespace
+
+int runStandingOrderBenchmark(const BenchmarkOptions& options)
+{
+    const qint64 count = bench::sizeOr(options, kDefaultTimers);
+    bool passed = true;
+
+    // 时间轮：六成在月末刻度到期，其余随机分散；取消一成
+    {
+        const qint64 start = 29000000; // 约为 2025 年初的 UTC 分钟数
+        const qint64 monthEnd = start + kMonthTicks - 1;
+        QRandomGenerator random(71);
+        QVector<qint64> dueTicks;
+        dueTicks.reserve(count);
+        for (qint64 i = 0; i < count; ++i) {
+            dueTicks.append(i % 10 < 6 ? monthEnd : start + 1 + random.bounded(kMonthTicks - 1));
+        }
+
+        TimerWheel wheel(start);
+        QElapsedTimer timer;
+        timer.start();
+        for (qint64 i = 0; i < count; ++i) {
+            wheel.schedule(quint64(i), dueTicks.at(i));
+        }
+        bench::reportThroughput(kName, "wheel.schedule", count, timer.nsecsElapsed());
+
+        timer.restart();
+        for (qint64 i = 9; i < count; i += 10) {
+            wheel.cancel(quint64(i));
+        }
+        bench::reportThroughput(kName, "wheel.cancel", count / 10, timer.nsecsElapsed());
+
+        // 按天推进到月末前一刻度，再单独测量月末的集中到期
+        // 每次推进取出的定时器都应满足 上次推进的刻度 < 到期刻度 <= 本次推进的刻度
+        qint64 fired = 0;
+        int misplaced = 0;
+        qint64 previous = start;
+        const auto collect = [&](const QVector<quint64>& ids, qint64 to) {
+            for (quint64 id : ids) {
+                const qint64 due = dueTicks.at(qint64(id));
+                misplaced += (due <= previous || due > to) ? 1 : 0;
+            }
+            fired += ids.size();
+            previous = to;
+        };
+        timer.restart();
+        while (previous < monthEnd - 1) {
+            const qint64 to = qMin(previous + kDayTicks, monthEnd - 1);
+            collect(wheel.advance(to), to);
+        }
+        bench::reportValue(kName, "wheel.advance-month", double(timer.nsecsElapsed()) / 1e6, "ms");
+        timer.restart();
+        const QVector<quint64> burst = wheel.advance(monthEnd);
+        bench::reportThroughput(kName, "wheel.month-end-burst", burst.size(), timer.nsecsElapsed());
+        collect(burst, monthEnd);
+
+        const qint64 expected = count - count / 10;
+        passed = bench::check(kName, fired == expected && wheel.size() == 0,
+                              QString("取出 %1 个定时器，应为 %2 个").arg(fired).arg(expected)) && passed;
+        passed = bench::check(kName, misplaced == 0,
+                              QString("%1 个定时器不在到期的那次推进中取出").arg(misplaced)) && passed;
+
+        // 对照：按到期刻度排序的 QMultiMap
+        QMultiMap<qint64, quint64> queue;
+        timer.restart();
+        for (qint64 i = 0; i < count; ++i) {
+            queue.insert(dueTicks.at(i), quint64(i));
+        }
+        bench::reportThroughput(kName, "map.schedule", count, timer.nsecsElapsed());
+        timer.restart();
+        qint64 drained = 0;
+        while (!queue.isEmpty() && queue.firstKey() <= monthEnd) {
+            queue.erase(queue.begin());
+            ++drained;
+        }
+        bench::reportThroughput(kName, "map.drain-month", drained, timer.nsecsElapsed());
+    }
+
+    // 调度器：月末到期的指令从文件加载后按不同批大小执行
+    QTemporaryDir directory;
+    if (!bench::check(kName, directory.isValid(), "无法创建临时目录")) {
+        return 1;
+    }
+    const int orderCount = int(qMin<qint64>(count, kMaxSchedulerOrders));
+    QVector<Account> accounts = bench::makeAccounts(orderCount + 1);
+    for (Account& account : accounts) {
+        account.balance = 1000000.0;
+    }
+    MemoryAccountRepository repository;
+    repository.saveAccountsBatch(accounts);
+
+    const QDate monthEnd(2025, 1, 31);
+    VirtualClock clock(QDateTime(monthEnd.addDays(-1), QTime(12, 0)));
+    AccountValidator validator(&repository);
+    validator.setClock(&clock);
+    AccountService service(&repository, &validator);
+    service.setClock(&clock);
+    JsonPersistenceManager manager(nullptr, directory.path());
+
+    // 每张卡一条指令，转给下一张卡，不触发风控的新收款人限制
+    QVector<StandingOrder> orders;
+    orders.reserve(orderCount);
+    for (int i = 0; i < orderCount; ++i) {
+        StandingOrder order;
+        order.id = quint64(i + 1);
+        order.fromCardNumber = bench::cardNumber(i);
+        order.toCardNumber = bench::cardNumber(i + 1);
+        order.amount = kAmount;
+        order.frequency = StandingOrderFrequency::Monthly;
+        order.dayOfMonth = 31;
+        order.nextRunDate = monthEnd;
+        orders.append(order);
+    }
+
+    for (int batchSize : kBatchSizes) {
+        passed = bench::check(kName,
+            manager.saveRecords(kOrdersFile, StandingOrderScheduler::FORMAT_NAME,
+                                StandingOrderScheduler::FORMAT_VERSION,
+                                [&orders](JsonStreamWriter& writer) {
+                                    for (const StandingOrder& order : orders) {
+                                        order.writeJson(writer);
+                                    }
+                                }),
+            "写入指令文件失败") && passed;
+
+        QElapsedTimer timer;
+        timer.start();
+        StandingOrderScheduler scheduler(&service, &manager, kOrdersFile);
+        scheduler.setClock(&clock);
+        bench::reportThroughput(kName, QString("scheduler.load.batch-%1").arg(batchSize), orderCount,
+                                timer.nsecsElapsed());
+
+        // 月末零点过后，全部指令同时到期（第二轮在第一轮之后一分钟）
+        const QDateTime dueTime(monthEnd, QTime(0, 1));
+        if (clock.utcMs() < dueTime.toMSecsSinceEpoch()) {
+            clock.setUtc(dueTime);
+        } else {
+            clock.advance(60 * 1000);
+        }
+        timer.restart();
+        const StandingOrderRunReport report = scheduler.runDueOrders(batchSize);
+        bench::reportThroughput(kName, QString("scheduler.month-end.batch-%1").arg(batchSize), report.executed,
+                                timer.nsecsElapsed());
+        bench::reportValue(kName, QString("scheduler.month-end.batch-%1.batches").arg(batchSize), report.batches,
+                           "批");
+        passed = bench::check(kName, report.dueOrders == orderCount && report.executed == orderCount,
+                              report.summary()) && passed;
+
+        const std::optional<StandingOrder> first = scheduler.findOrder(1);
+        passed = bench::check(kName, first && first->nextRunDate == QDate(2025, 2, 28),
+                              "执行后的下一次执行日不正确") && passed;
+    }
+
+    return passed ? 0 : 1;
+}
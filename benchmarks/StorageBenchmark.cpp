@@ -0,0 +1,181 @@
+/**
+ * @file StorageBenchmark.cpp
+ * @brief SQLite 与 JSON 存储后端对比基准
+ *
+ * 在临时目录中分别用两种后端保存同一批账户和账本，测量整批保存、重新打开、按卡号查询、
+ * 单笔更新和账本追加的耗时，并检查读回的数据与写入的一致。
+ */
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <functional>
+#include <memory>
+#include "Benchmarks.h"
+#include "models/JsonAccountRepository.h"
+#include "models/JsonPersistenceManager.h"
+#include "models/JsonTransactionStore.h"
+#include "models/SqliteAccountRepository.h"
+#include "models/SqlitePersistenceManager.h"
+#include "models/SqliteTransactionStore.h"
+#include "models/TransactionIdGenerator.h"
+
+namespace {
+
+//!< 基准名
+const char kName[] = "storage";
+
+//!< 默认账户数
+const qint64 kDefaultAccounts = 100000;
+
+//!< 随机查询次数
+const int kLookups = 100000;
+
+//!< 单笔更新和账本追加的次数（JSON 后端每次都重写整个文件，次数不宜过多）
+const int kSingleWrites = 20;
+
+/**
+ * @brief 一种存储后端
+ *
+ * 每次调用工厂函数都重新打开数据目录中的数据，用于测量打开耗时。
+ */
+struct Backend {
+    QString name;                                                   //!< 后端名
+    std::function<std::unique_ptr<IAccountRepository>()> accounts;  //!< 打开账户存储库
+    std::function<std::unique_ptr<ITransactionStore>()> ledger;     //!< 打开交易存储
+};
+
+/**
+ * @brief 测量一种后端
+ * @param backend 后端
+ * @param accounts 测试账户
+ * @param transactions 测试账本
+ * @param options 运行参数
+ * @return 所有检查通过时返回true
+ */
+bool measure(const Backend& backend, const QVector<Account>& accounts, const QVector<Transaction>& transactions,
+             const BenchmarkOptions& options)
+{
+    const QString prefix = backend.name + '.';
+    bool passed = true;
+
+    // 整批保存：两种后端都只提交一次
+    {
+        std::unique_ptr<IAccountRepository> repository = backend.accounts();
+        bool saved = true;
+        const qint64 ns = bench::bestOf(options.repeat, [&] {
+            saved = repository->saveAccountsBatch(accounts).success && saved;
+        });
+        passed = bench::check(kName, saved, backend.name + " 整批保存账户失败") && passed;
+        bench::reportThroughput(kName, prefix + "accounts.save-batch", accounts.size(), ns);
+    }
+
+    // 重新打开：JSON 解析整个文件，SQLite 只建立语句和卡号过滤器
+    std::unique_ptr<IAccountRepository> repository;
+    const qint64 openNs = bench::bestOf(options.repeat, [&] {
+        repository.reset();
+        repository = backend.accounts();
+    });
+    bench::reportThroughput(kName, prefix + "accounts.open", accounts.size(), openNs);
+
+    // 随机按卡号查询，并核对读回的账户
+    QRandomGenerator random(42);
+    QVector<int> picks(kLookups);
+    for (int& pick : picks) {
+        pick = random.bounded(int(accounts.size()));
+    }
+    int mismatches = 0;
+    const qint64 lookupNs = bench::bestOf(options.repeat, [&] {
+        mismatches = 0;
+        for (int pick : picks) {
+            const std::optional<Account> found = repository->findByCardNumber(accounts.at(pick).cardNumber);
+            if (!found || found->balance != accounts.at(pick).balance) {
+                ++mismatches;
+            }
+        }
+    });
+    passed = bench::check(kName, mismatches == 0,
+                          QString("%1 查询结果与写入不一致: %2 个").arg(backend.name).arg(mismatches)) && passed;
+    bench::reportThroughput(kName, prefix + "accounts.lookup", picks.size(), lookupNs);
+
+    // 单笔更新：每次都是一次独立提交
+    QElapsedTimer timer;
+    timer.start();
+    bool updated = true;
+    for (int i = 0; i < kSingleWrites; ++i) {
+        Account account = accounts.at(picks.at(i));
+        account.balance += 1.0;
+        updated = repository->saveAccount(account).success && updated;
+    }
+    bench::reportThroughput(kName, prefix + "accounts.update-one", kSingleWrites, timer.nsecsElapsed());
+    passed = bench::check(kName, updated, backend.name + " 单笔更新失败") && passed;
+    repository.reset();
+
+    // 账本：整批保存、加载和逐笔追加
+    std::unique_ptr<ITransactionStore> ledger = backend.ledger();
+    bool ledgerSaved = true;
+    const qint64 saveNs = bench::bestOf(options.repeat, [&] {
+        ledgerSaved = ledger->saveTransactions(transactions) && ledgerSaved;
+    });
+    passed = bench::check(kName, ledgerSaved, backend.name + " 保存账本失败") && passed;
+    bench::reportThroughput(kName, prefix + "ledger.save", transactions.size(), saveNs);
+
+    QVector<Transaction> loaded;
+    const qint64 loadNs = bench::bestOf(options.repeat, [&] {
+        loaded.clear();
+        ledger = backend.ledger();
+        ledger->loadTransactions(loaded);
+    });
+    passed = bench::check(kName, loaded.size() == transactions.size(),
+                          QString("%1 读回 %2 条交易，应为 %3 条")
+                              .arg(backend.name).arg(loaded.size()).arg(transactions.size())) && passed;
+    bench::reportThroughput(kName, prefix + "ledger.load", transactions.size(), loadNs);
+
+    TransactionIdGenerator ids;
+    for (const Transaction& transaction : loaded) {
+        ids.observe(transaction.id);
+    }
+    timer.restart();
+    bool appended = true;
+    for (int i = 0; i < kSingleWrites; ++i) {
+        Transaction transaction = transactions.at(i);
+        transaction.id = ids.next();
+        transaction.timestamp = QDateTime::currentDateTimeUtc();
+        loaded.append(transaction);
+        appended = ledger->appendTransactions(loaded, loaded.size() - 1) && appended;
+    }
+    bench::reportThroughput(kName, prefix + "ledger.append-one", kSingleWrites, timer.nsecsElapsed());
+    passed = bench::check(kName, appended, backend.name + " 追加交易失败") && passed;
+
+    return passed;
+}
+
+} // namespace
+
+int runStorageBenchmark(const BenchmarkOptions& options)
+{
+    QTemporaryDir directory;
+    if (!bench::check(kName, directory.isValid(), "无法创建临时目录")) {
+        return 1;
+    }
+
+    const qint64 accountCount = bench::sizeOr(options, kDefaultAccounts);
+    const QVector<Account> accounts = bench::makeAccounts(accountCount);
+    const QVector<Transaction> transactions = bench::makeTransactions(accountCount, accountCount);
+
+    JsonPersistenceManager jsonManager(nullptr, directory.filePath("json"));
+    SqlitePersistenceManager sqliteManager(nullptr, directory.filePath("sqlite"));
+
+    const Backend backends[] = {
+        {"json",
+         [&] { return std::make_unique<JsonAccountRepository>(&jsonManager, "accounts.json"); },
+         [&] { return std::make_unique<JsonTransactionStore>(&jsonManager, "transactions.json"); }},
+        {"sqlite",
+         [&] { return std::make_unique<SqliteAccountRepository>(&sqliteManager); },
+         [&] { return std::make_unique<SqliteTransactionStore>(&sqliteManager); }},
+    };
+
+    bool passed = true;
+    for (const Backend& backend : backends) {
+        passed = measure(backend, accounts, transactions, options) && passed;
+    }
+    return passed ? 0 : 1;
+}
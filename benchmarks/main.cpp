@@ -0,0 +1,123 @@
+/**
+ * @file main.cpp
+ * @brief 基准测试程序入口
+ *
+ * 解析命令行参数，按名称运行一个或多个基准测试，所有基准测试和正确性检查通过时返回0。
+ */
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QLoggingCategory>
+#include <QTextStream>
+#include "Benchmarks.h"
+
+namespace {
+
+/**
+ * @brief 基准表中的一项
+ */
+struct BenchmarkCase {
+    const char* name;           //!< 命令行中使用的名称
+    const char* description;    //!< 说明
+    BenchmarkFunction run;      //!< 入口函数
+};
+
+//!< 全部基准测试，按添加顺序排列
+const BenchmarkCase kBenchmarks[] = {
+    {"storage", "SQLite 与 JSON 后端：整批保存、打开、查询、单笔更新和账本追加（默认 100000 个账户）",
+     runStorageBenchmark},
+    {"json-stream", "流式 JSON 读写与 DOM 读写：耗时和峰值内存增量（默认 500000 条交易）",
+     runJsonStreamBenchmark},
+    {"account-scan", "账户全表扫描：列式表与按行存储的余额汇总、筛选和组装（默认 1000000 个账户）",
+     runAccountScanBenchmark},
+    {"failed-login", "登录失败吞吐量和存储库写入次数：逐次写回、分散错误和暴力尝试（默认 100000 个账户）",
+     runLoginThrottleBenchmark},
+    {"bloom", "卡号布隆过滤器：实际误判率、查询吞吐量和 SQLite 上不存在卡号的查找（默认 1000000 个卡号）",
+     runCardBloomFilterBenchmark},
+    {"card-number", "卡号解析：改动前的 isDigit 循环、标量实现与 SWAR 实现（默认 1000000 个输入）",
+     runCardNumberBenchmark},
+    {"dedupe", "请求去重：去重表吞吐量和带请求编号存款的额外开销（默认 1000000 个请求）", runDedupeBenchmark},
+    {"fraud", "风控规则：单次评估延迟分布和取款校验延迟（默认 1000000 张卡）", runFraudBenchmark},
+    {"ledger", "账本一致性校验：不同线程数下的重放吞吐量（默认 10000000 笔交易）", runLedgerVerifierBenchmark},
+    {"description-search", "交易描述全文检索：建索引吞吐量和查询延迟（默认 10000000 条描述）",
+     runDescriptionSearchBenchmark},
+    {"leaderboard", "排行榜：增量维护开销、top-100 查询和取款热路径上的额外开销（默认 1000000 个账户）",
+     runLeaderboardBenchmark},
+    {"standing-orders", "定期转账月末集中到期：时间轮和调度器（默认 1000000 个定时器）", runStandingOrderBenchmark},
+    {"interest", "批量计息与管理费：计算内核和整个作业（默认 1000000 个账户）", runInterestAccrualBenchmark},
+    {"settlement", "日终清算：线程数和每线程行块数、写清算文件（默认 5000000 笔交易）", runSettlementBenchmark},
+    {"json-load", "JSON 并行分块加载：1、2、4、8、16 个线程的加载耗时（默认 2000000 条交易）", runJsonLoadBenchmark},
+};
+
+} // namespace
+
+/**
+ * @brief 基准测试程序主函数
+ * @param argc 命令行参数个数
+ * @param argv 命令行参数数组
+ * @return 0 表示全部通过
+ */
+int main(int argc, char* argv[])
+{
+    QCoreApplication::setOrganizationName("ATMSimulator");
+    QCoreApplication::setApplicationName("ATM Simulator Benchmarks");
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("ATM 模拟器基准测试。不指定名称时依次运行全部基准测试。");
+    parser.addHelpOption();
+    QCommandLineOption listOption(QStringList() << "l" << "list", "列出全部基准测试");
+    parser.addOption(listOption);
+    QCommandLineOption sizeOption(QStringList() << "size", "数据规模 (账户数或记录数，0 表示使用默认值)", "count", "0");
+    parser.addOption(sizeOption);
+    QCommandLineOption threadsOption(QStringList() << "threads", "线程数 (0 表示逐级测量 1、2、4 …… 直到逻辑核数)",
+                                     "count", "0");
+    parser.addOption(threadsOption);
+    QCommandLineOption repeatOption(QStringList() << "repeat", "每项计时的重复次数，输出最快的一次", "count", "3");
+    parser.addOption(repeatOption);
+    QCommandLineOption verboseOption(QStringList() << "verbose", "输出被测代码的调试日志");
+    parser.addOption(verboseOption);
+    parser.addPositionalArgument("name", "要运行的基准测试名称", "[name...]");
+    parser.process(app);
+
+    QTextStream out(stdout);
+    if (parser.isSet(listOption)) {
+        for (const BenchmarkCase& benchmark : kBenchmarks) {
+            out << benchmark.name << '\t' << benchmark.description << Qt::endl;
+        }
+        return 0;
+    }
+
+    // 被测代码在每次读写时输出调试日志，默认关闭以免影响计时
+    if (!parser.isSet(verboseOption)) {
+        QLoggingCategory::setFilterRules("*.debug=false");
+    }
+
+    BenchmarkOptions options;
+    options.size = parser.value(sizeOption).toLongLong();
+    options.threads = parser.value(threadsOption).toInt();
+    options.repeat = qMax(1, parser.value(repeatOption).toInt());
+
+    const QStringList names = parser.positionalArguments();
+    for (const QString& name : names) {
+        bool known = false;
+        for (const BenchmarkCase& benchmark : kBenchmarks) {
+            known = known || name == QLatin1String(benchmark.name);
+        }
+        if (!known) {
+            QTextStream(stderr) << "未知的基准测试: " << name << "（用 --list 查看全部）" << Qt::endl;
+            return 2;
+        }
+    }
+
+    int failures = 0;
+    for (const BenchmarkCase& benchmark : kBenchmarks) {
+        if (!names.isEmpty() && !names.contains(QLatin1String(benchmark.name))) {
+            continue;
+        }
+        out << "== " << benchmark.name << ": " << benchmark.description << Qt::endl;
+        if (benchmark.run(options) != 0) {
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
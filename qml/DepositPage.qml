@@ -244,7 +244,7 @@ Page {
         footer: DialogButtonBox {
             Button {
                 text: "打印回单"
-                visible: resultDialog.success
+                visible: resultDialog.success && controller.accountViewModel.completedTransactionId !== ""
                 DialogButtonBox.buttonRole: DialogButtonBox.HelpRole
                 onClicked: {
                     receiptPrinter.printDepositReceipt(
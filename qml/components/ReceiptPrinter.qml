@@ -17,16 +17,20 @@ Item {
     property string targetCardNumber: ""
     property string targetCardHolder: ""
     property date transactionDate: new Date()
-    property string transactionId: generateTransactionId()
+    property string transactionId: ""
     
-    // 生成交易ID
-    function generateTransactionId() {
-        var chars = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
-        var result = "";
-        for (var i = 0; i < 10; i++) {
-            result += chars.charAt(Math.floor(Math.random() * chars.length));
+    // 获取刚完成的取款、存款或转账在账本中的编号（由该次操作返回，定时作业写入的记录不会影响）
+    function ledgerTransactionId() {
+        return controller.accountViewModel.completedTransactionId;
+    }
+    
+    // 打开回单对话框；没有账本编号时不显示回单
+    function openReceipt() {
+        if (transactionId === "") {
+            console.warn("缺少交易编号，不显示回单");
+            return;
         }
-        return result;
+        receiptDialog.open();
     }
     
     // 打印存款回单
@@ -37,9 +41,9 @@ Item {
         amount = depositAmount;
         balanceAfter = balance;
         transactionDate = new Date();
-        transactionId = generateTransactionId();
+        transactionId = ledgerTransactionId();
         
-        receiptDialog.open();
+        openReceipt();
     }
     
     // 打印取款回单
@@ -50,9 +54,9 @@ Item {
         amount = withdrawAmount;
         balanceAfter = balance;
         transactionDate = new Date();
-        transactionId = generateTransactionId();
+        transactionId = ledgerTransactionId();
         
-        receiptDialog.open();
+        openReceipt();
     }
     
     // 打印转账回单
@@ -65,9 +69,9 @@ Item {
         targetCardNumber = targetCard;
         targetCardHolder = targetHolder;
         transactionDate = new Date();
-        transactionId = generateTransactionId();
+        transactionId = ledgerTransactionId();
         
-        receiptDialog.open();
+        openReceipt();
     }
     
     // 格式化日期时间
@@ -10,31 +10,87 @@
 #include "viewmodels/AccountViewModel.h"
 #include "viewmodels/TransactionViewModel.h"
 #include "viewmodels/PrinterViewModel.h"
+#include "models/SqliteAccountRepository.h"
+#include "models/SqliteTransactionStore.h"
 #include "models/JsonAccountRepository.h"
+#include "models/JsonTransactionStore.h"
+#include "models/ReplicatingAccountRepository.h"
+#include "models/ReplicatingTransactionStore.h"
+#include "models/ChangeFeedAccountRepository.h"
 #include <QDebug>
+#include <QFile>
+#include <QtConcurrent/QtConcurrentRun>
 #include <QQmlComponent> // 包含 QQmlComponent 头文件
 
+namespace {
+
+//!< 检查到期计息和定期转账的间隔（毫秒），与调度器的刻度一致
+const int kJobIntervalMs = 60 * 1000;
+
+} // namespace
+
 /**
  * @brief 构造函数
  * @param parent 父对象
+ * @param storageBackend 存储后端名称（"json" 或 "sqlite"）
+ * @param dataPath 数据目录
+ * @param replicationServer 主备复制的本地套接字名称
+ * @param changeFeed 是否输出变更数据捕获流
  */
-AppController::AppController(QObject *parent)
+AppController::AppController(QObject *parent, const QString &storageBackend,
+                             const QString &dataPath, const QString &replicationServer, bool changeFeed)
     : QObject(parent)
 {
     // 首先创建持久化管理器，它将被其他组件使用
-    m_persistenceManager = new JsonPersistenceManager(this);
-    
-    // 创建账户存储库，使用持久化管理器
-    JsonAccountRepository* accountRepository = new JsonAccountRepository(m_persistenceManager, "accounts.json");
-    
-    // 创建交易模型，使用持久化管理器
-    m_transactionModel = new TransactionModel(m_persistenceManager, "transactions.json", this);
+    m_persistenceManager = new JsonPersistenceManager(this, dataPath);
+    if (!replicationServer.isEmpty()) {
+        m_replicationLog = new ReplicationLog(8 * 1024 * 1024, this);
+    }
+    if (changeFeed) {
+        m_changeFeed = new ChangeFeed(m_persistenceManager->getDataPath() + "/changes.jsonl", this);
+    }
     
-    // 创建 ViewModel 实例，并设置 AppController 为它们的父对象
-    m_accountViewModel = new AccountViewModel(this);
+    std::unique_ptr<ITransactionStore> transactionStore;
+    std::unique_ptr<IAccountRepository> accountRepository;
+    if (storageBackend.compare("sqlite", Qt::CaseInsensitive) == 0) {
+        // SQLite 后端：账户和交易共用同一个数据库文件
+        m_sqlitePersistenceManager = new SqlitePersistenceManager(this, m_persistenceManager->getDataPath());
+        transactionStore = std::make_unique<SqliteTransactionStore>(m_sqlitePersistenceManager);
+        accountRepository = std::make_unique<SqliteAccountRepository>(m_sqlitePersistenceManager);
+        qDebug() << "使用 SQLite 存储后端";
+    } else {
+        // 默认 JSON 后端：账户和交易都保存在持久化管理器的数据目录中
+        transactionStore = std::make_unique<JsonTransactionStore>(m_persistenceManager, "transactions.json");
+        accountRepository = std::make_unique<JsonAccountRepository>(m_persistenceManager, "accounts.json");
+        qDebug() << "使用 JSON 存储后端";
+    }
+
+    // 输出变更流时在账户存储库外面包一层，与存储后端无关
+    if (m_changeFeed) {
+        accountRepository = std::make_unique<ChangeFeedAccountRepository>(std::move(accountRepository), m_changeFeed);
+    }
+
+    // 启用复制时在存储外面包一层，每次成功提交后把变更写入复制日志
+    if (m_replicationLog) {
+        transactionStore = std::make_unique<ReplicatingTransactionStore>(std::move(transactionStore), m_replicationLog);
+        accountRepository = std::make_unique<ReplicatingAccountRepository>(std::move(accountRepository), m_replicationLog);
+    }
+    IAccountRepository* replicatedRepository = accountRepository.get();
+
+    m_transactionModel = new TransactionModel(std::move(transactionStore), this);
+    m_transactionModel->setChangeFeed(m_changeFeed);
+
+    // 创建 ViewModel 实例，并设置 AppController 为它们的父对象；账户存储库在构造时注入，
+    // 不会先在默认目录加载一份账户数据
+    m_accountViewModel = new AccountViewModel(std::move(accountRepository), m_persistenceManager, this);
     m_transactionViewModel = new TransactionViewModel(this);
     m_printerViewModel = new PrinterViewModel(this);
 
+    if (m_replicationLog) {
+        m_replicationPrimary = new ReplicationPrimary(m_replicationLog, replicatedRepository, m_transactionModel, this);
+        m_replicationPrimary->listen(replicationServer);
+    }
+
     // 连接信号槽
     // 当 AccountViewModel 发出 loggedOut 信号时，切换页面到 LoginLoginPage
     connect(m_accountViewModel, &AccountViewModel::loggedOut,
@@ -52,17 +108,156 @@ AppController::AppController(QObject *parent)
     // 将同一个 TransactionModel 实例也设置到 TransactionViewModel
     // TransactionViewModel 需要 TransactionModel 来获取交易记录并格式化
     m_transactionViewModel->setTransactionModel(m_transactionModel);
+
+    // 计息、定期转账和日终清算检查定时器，在 initialize() 中启动，命令行离线模式不启动
+    // 先计息再转账，使当天的利息按转账前的余额计算
+    m_jobTimer = new QTimer(this);
+    m_jobTimer->setInterval(kJobIntervalMs);
+    connect(m_jobTimer, &QTimer::timeout, this, [this]() {
+        runInterestAccrual();
+        runStandingOrders();
+        settlePreviousDay();
+        if (m_replicationPrimary) {
+            qDebug() << replicationStatus().summary();
+        }
+    });
+
+    m_settlementWatcher = new QFutureWatcher<SettlementReport>(this);
+    connect(m_settlementWatcher, &QFutureWatcher<SettlementReport>::finished, this, [this]() {
+        emit settlementFinished(m_settlementWatcher->result().summary());
+    });
 }
 
 /**
  * @brief 析构函数
  *
- * QObject 的父子关系会自动处理子对象的内存释放，因此在此无需手动删除 ViewModel 和 Model 指针。
+ * 子对象按创建顺序释放，而持久化管理器最先创建。存储库和交易模型在析构时
+ * 可能还要写入数据，因此先显式释放它们，再由父子关系释放持久化管理器。
  */
 AppController::~AppController()
 {
-    // JsonPersistenceManager现在是QObject的子对象，会自动被父对象删除
-    // QObject 父子关系会自动处理内存清理
+    // 后台清算只读取自己的快照，但仍需等它写完文件
+    m_settlementWatcher->waitForFinished();
+    // 复制服务会读取存储库和交易模型，先于它们释放
+    delete m_replicationPrimary;
+    delete m_accountViewModel;
+    delete m_transactionViewModel;
+    delete m_transactionModel;
+    // 其余子对象（包括持久化管理器）由 QObject 父子关系自动清理
+}
+
+/**
+ * @brief 设置所有模型共用的时间来源
+ * @param clock 时钟
+ */
+void AppController::setClock(const Clock* clock)
+{
+    m_transactionModel->setClock(clock);
+    m_accountViewModel->setClock(clock);
+}
+
+/**
+ * @brief 校验账本与账户余额的一致性
+ * @param threads 线程数
+ * @return 校验报告
+ */
+LedgerReport AppController::verifyLedger(int threads) const
+{
+    return m_accountViewModel->verifyLedger(threads);
+}
+
+/**
+ * @brief 回测全部余额预测模型并选出默认模型
+ * @param horizonDays 预测天数
+ * @param threads 线程数
+ * @return 回测报告
+ */
+ForecastBacktestReport AppController::backtestForecasters(int horizonDays, int threads) const
+{
+    return m_accountViewModel->backtestForecasters(horizonDays, threads);
+}
+
+/**
+ * @brief 执行全部到期的定期转账
+ * @param batchSize 每批的指令数
+ * @return 执行结果
+ */
+StandingOrderRunReport AppController::runStandingOrders(int batchSize)
+{
+    return m_accountViewModel->runStandingOrders(batchSize);
+}
+
+/**
+ * @brief 执行到期的批量计息与收费
+ * @param threads 线程数
+ * @return 作业结果
+ */
+AccrualReport AppController::runInterestAccrual(int threads)
+{
+    return m_accountViewModel->runInterestAccrual(threads);
+}
+
+/**
+ * @brief 对指定日期执行日终清算（同步）
+ * @param date 清算日
+ * @param threads 线程数
+ * @return 清算结果
+ */
+SettlementReport AppController::runSettlement(const QDate& date, int threads)
+{
+    return SettlementBatch(threads).run(m_transactionModel->getAllTransactions(), date,
+                                        settlementFilePath(date));
+}
+
+/**
+ * @brief 在后台线程对指定日期执行日终清算
+ * @param date 清算日
+ * @return 如果已开始清算返回true
+ */
+bool AppController::startSettlement(const QDate& date)
+{
+    if (m_settlementWatcher->isRunning()) {
+        return false;
+    }
+
+    // 复制只增加引用计数；之后登记的交易会让账本另行分配，快照不受影响
+    const QVector<Transaction> snapshot = m_transactionModel->getAllTransactions();
+    const QString filePath = settlementFilePath(date);
+    m_settlementWatcher->setFuture(QtConcurrent::run([snapshot, date, filePath]() {
+        return SettlementBatch().run(snapshot, date, filePath);
+    }));
+    qDebug() << "开始后台日终清算:" << date << "快照" << snapshot.size() << "笔交易";
+    return true;
+}
+
+/**
+ * @brief 获取清算文件路径
+ * @param date 清算日
+ * @return 清算文件路径
+ */
+QString AppController::settlementFilePath(const QDate& date) const
+{
+    return m_persistenceManager->getDataPath() + "/settlement_" + date.toString("yyyyMMdd") + ".csv";
+}
+
+/**
+ * @brief 获取主备复制状态
+ * @return 复制状态
+ */
+ReplicationStatus AppController::replicationStatus() const
+{
+    return m_replicationPrimary ? m_replicationPrimary->status() : ReplicationStatus();
+}
+
+/**
+ * @brief 前一天的清算文件不存在时在后台执行清算
+ */
+void AppController::settlePreviousDay()
+{
+    const QDate previousDay = m_transactionModel->clock()->today().addDays(-1);
+    if (!QFile::exists(settlementFilePath(previousDay))) {
+        startSettlement(previousDay);
+    }
 }
 
 /**
@@ -87,6 +282,12 @@ void AppController::initialize(QQmlEngine* engine)
     if (component.isError()) {
         qDebug() << "组件加载错误:" << component.errorString();
     }
+
+    // 先补计停机期间的利息、补执行到期的定期转账、补做前一天的清算，之后每分钟检查一次
+    runInterestAccrual();
+    runStandingOrders();
+    settlePreviousDay();
+    m_jobTimer->start();
 }
 
 /**
@@ -11,13 +11,21 @@
 
 #include <QObject>
 #include <QQmlEngine> // 包含 QQmlEngine 头文件
+#include <QDate>
+#include <QFutureWatcher>
 #include <QString>
+#include <QTimer>
 // 包含各个 ViewModel 和 Model 的头文件
 #include "viewmodels/AccountViewModel.h"
 #include "viewmodels/TransactionViewModel.h"
 #include "viewmodels/PrinterViewModel.h"
 #include "models/TransactionModel.h" // AppController 需要创建 TransactionModel
 #include "models/JsonPersistenceManager.h" // 添加JsonPersistenceManager头文件
+#include "models/SqlitePersistenceManager.h" // SQLite 存储后端
+#include "models/SettlementBatch.h" // 日终清算
+#include "models/ReplicationLog.h" // 主备复制
+#include "models/ReplicationPrimary.h"
+#include "models/ChangeFeed.h" // 变更数据捕获
 
 // 将类型声明为Qt元对象系统的已知类型，以便QML可以使用这些类型
 Q_DECLARE_METATYPE(AccountViewModel*)
@@ -45,8 +53,14 @@ public:
     /**
      * @brief 构造函数
      * @param parent 父对象
+     * @param storageBackend 存储后端名称（"json" 或 "sqlite"），为空时使用 JSON 文件
+     * @param dataPath 数据目录，为空时使用应用程序的本地数据目录
+     * @param replicationServer 主备复制的本地套接字名称，非空时把账户和账本变更发送给备用节点
+     * @param changeFeed 是否把账户和账本变更写入数据目录下的 changes.jsonl（变更数据捕获）
      */
-    explicit AppController(QObject *parent = nullptr);
+    explicit AppController(QObject *parent = nullptr, const QString &storageBackend = QString(),
+                           const QString &dataPath = QString(), const QString &replicationServer = QString(),
+                           bool changeFeed = false);
     /**
      * @brief 析构函数
      */
@@ -61,6 +75,92 @@ public:
      */
     void initialize(QQmlEngine* engine);
 
+    /**
+     * @brief 设置所有模型共用的时间来源
+     *
+     * 传入 VirtualClock 即可以模拟时间运行，无需等待真实时间流逝。
+     *
+     * @param clock 时钟，为空时使用系统时钟
+     */
+    void setClock(const Clock* clock);
+
+    /**
+     * @brief 校验账本与账户余额的一致性
+     *
+     * 可在运行中随时调用；命令行 --verify-ledger 在加载数据后调用一次并退出。
+     *
+     * @param threads 线程数，0 表示自动
+     * @return 校验报告
+     */
+    LedgerReport verifyLedger(int threads = 0) const;
+
+    /**
+     * @brief 回测全部余额预测模型并选出默认模型
+     *
+     * 命令行 --backtest-forecasts 在加载数据后调用一次，输出各模型的误差后退出。
+     *
+     * @param horizonDays 预测天数
+     * @param threads 线程数，0 表示自动
+     * @return 回测报告
+     */
+    ForecastBacktestReport backtestForecasters(int horizonDays = 7, int threads = 0) const;
+
+    /**
+     * @brief 执行全部到期的定期转账
+     *
+     * 界面运行时由定时器每分钟调用；命令行 --run-standing-orders 在加载数据后调用一次并退出。
+     *
+     * @param batchSize 每批的指令数，不大于0时使用默认值
+     * @return 执行结果
+     */
+    StandingOrderRunReport runStandingOrders(int batchSize = 0);
+
+    /**
+     * @brief 执行到期的批量计息与收费
+     *
+     * 界面运行时由定时器在定期转账之前调用，每天只入账一次；
+     * 命令行 --accrue-interest 在加载数据后调用一次并退出。
+     *
+     * @param threads 线程数，0 表示自动
+     * @return 作业结果
+     */
+    AccrualReport runInterestAccrual(int threads = 0);
+
+    /**
+     * @brief 对指定日期执行日终清算（同步）
+     *
+     * 命令行 --settle 在加载数据后调用一次并退出。
+     *
+     * @param date 清算日
+     * @param threads 线程数，0 表示自动
+     * @return 清算结果
+     */
+    SettlementReport runSettlement(const QDate& date, int threads = 0);
+
+    /**
+     * @brief 在后台线程对指定日期执行日终清算
+     *
+     * 在调用线程复制交易记录快照后立即返回，清算与在线交易同时进行，
+     * 完成时发出 settlementFinished()。已有清算在进行时忽略本次调用。
+     *
+     * @param date 清算日
+     * @return 如果已开始清算返回true
+     */
+    bool startSettlement(const QDate& date);
+
+    /**
+     * @brief 获取清算文件路径
+     * @param date 清算日
+     * @return 数据目录下的 settlement_yyyyMMdd.csv
+     */
+    QString settlementFilePath(const QDate& date) const;
+
+    /**
+     * @brief 获取主备复制状态
+     * @return 复制状态，未启用复制时为默认值
+     */
+    ReplicationStatus replicationStatus() const;
+
     // --- 属性获取方法 ---
     /**
      * @brief 获取 AccountViewModel 实例指针
@@ -100,11 +200,24 @@ signals:
      */
     void currentPageChanged();
 
+    /**
+     * @brief 后台日终清算完成时发出的信号
+     * @param summary 清算结果摘要
+     */
+    void settlementFinished(const QString &summary);
+
 private:
+    /**
+     * @brief 前一天的清算文件不存在时在后台执行清算
+     */
+    void settlePreviousDay();
+
     //!< 当前页面名称
     QString m_currentPage = "LoginPage";
     //!< JsonPersistenceManager 实例指针 (由 AppController 持有并注入到存储库)
     JsonPersistenceManager* m_persistenceManager;
+    //!< SqlitePersistenceManager 实例指针 (仅在使用 SQLite 后端时创建)
+    SqlitePersistenceManager* m_sqlitePersistenceManager = nullptr;
     //!< AccountViewModel 实例指针
     AccountViewModel* m_accountViewModel;
     //!< TransactionViewModel 实例指针
@@ -113,4 +226,14 @@ private:
     PrinterViewModel* m_printerViewModel;
     //!< TransactionModel 实例指针 (由 AppController 持有并注入到 ViewModel)
     TransactionModel* m_transactionModel;
+    //!< 计息、定期转账和日终清算检查定时器 (仅在界面运行时启动)
+    QTimer* m_jobTimer;
+    //!< 后台日终清算的完成通知
+    QFutureWatcher<SettlementReport>* m_settlementWatcher;
+    //!< 主备复制变更日志 (仅在启用复制时创建)
+    ReplicationLog* m_replicationLog = nullptr;
+    //!< 主备复制服务 (仅在启用复制时创建)
+    ReplicationPrimary* m_replicationPrimary = nullptr;
+    //!< 变更数据捕获输出 (仅在启用时创建)
+    ChangeFeed* m_changeFeed = nullptr;
 };
\ No newline at end of file
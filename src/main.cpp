@@ -12,9 +12,19 @@
 #include <QtQuickControls2/QQuickStyle> // 包含 QQuickStyle 头文件
 #include <QDir> // 包含 QDir 头文件
 #include <QStandardPaths> // 包含 QStandardPaths 头文件
+#include <QCommandLineParser> // 包含 QCommandLineParser 头文件
+#include <QTextStream> // 用于输出账本校验和预测回测结果
 
 // 包含应用程序控制器的头文件
 #include "AppController.h"
+#include "models/ReplicationStandby.h"
+
+namespace {
+
+//!< 备用节点输出复制状态的间隔（毫秒）
+const int kStandbyStatusIntervalMs = 5000;
+
+} // namespace
 
 /**
  * @brief 应用程序主函数
@@ -32,6 +42,82 @@ int main(int argc, char *argv[])
     // 创建 QGuiApplication 实例
     QGuiApplication app(argc, argv);
 
+    // 解析命令行参数
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption storageOption(QStringList() << "s" << "storage",
+                                     "数据存储后端: json (默认) 或 sqlite", "backend", "json");
+    parser.addOption(storageOption);
+    QCommandLineOption loadThreadsOption(QStringList() << "load-threads",
+                                         "加载 JSON 数据时使用的解析线程数 (0 表示自动)", "count", "0");
+    parser.addOption(loadThreadsOption);
+    QCommandLineOption terminalIdOption(QStringList() << "terminal-id",
+                                        "本终端编号 (0-1023)，写入交易编号以区分不同终端", "id", "0");
+    parser.addOption(terminalIdOption);
+    QCommandLineOption verifyLedgerOption(QStringList() << "verify-ledger",
+                                          "校验账本与账户余额的一致性，输出报告后退出 (0 一致, 1 不一致)");
+    parser.addOption(verifyLedgerOption);
+    QCommandLineOption backtestOption(QStringList() << "backtest-forecasts",
+                                      "回测各余额预测模型，输出误差 (MAE/MAPE) 和吞吐量后退出", "days", "7");
+    parser.addOption(backtestOption);
+    QCommandLineOption standingOrdersOption(QStringList() << "run-standing-orders",
+                                            "执行全部到期的定期转账，输出执行结果后退出");
+    parser.addOption(standingOrdersOption);
+    QCommandLineOption accrueInterestOption(QStringList() << "accrue-interest",
+                                            "执行到期的批量计息与月度管理费扣收，输出结果和吞吐量后退出");
+    parser.addOption(accrueInterestOption);
+    QCommandLineOption settleOption(QStringList() << "settle",
+                                    "对指定日期 (yyyy-MM-dd) 执行日终清算，写出清算文件并输出吞吐量后退出", "date");
+    parser.addOption(settleOption);
+    QCommandLineOption dataDirOption(QStringList() << "data-dir",
+                                     "数据目录 (默认为应用程序的本地数据目录)", "path");
+    parser.addOption(dataDirOption);
+    QCommandLineOption replicateOption(QStringList() << "replicate",
+                                       "作为主节点在指定名称的本地套接字上向备用节点发送账户和账本变更", "name");
+    parser.addOption(replicateOption);
+    QCommandLineOption standbyOption(QStringList() << "standby",
+                                     "作为备用节点连接指定名称的主节点套接字，持续应用变更 (需同时指定 --data-dir)", "name");
+    parser.addOption(standbyOption);
+    QCommandLineOption promoteAfterOption(QStringList() << "promote-after",
+                                          "备用节点与主节点断开超过指定秒数后自动提升为主节点并启动界面 (0 表示不自动提升)",
+                                          "seconds", "0");
+    parser.addOption(promoteAfterOption);
+    QCommandLineOption cdcOption(QStringList() << "cdc",
+                                 "把每次提交的账户变更 (变更前后) 和新增账本记录追加到数据目录下的 changes.jsonl");
+    parser.addOption(cdcOption);
+    parser.process(app);
+
+    // 必须在创建任何模型之前设置，模型在构造时即加载数据
+    JsonPersistenceManager::setLoadThreadCount(parser.value(loadThreadsOption).toInt());
+    TransactionIdGenerator::setDefaultTerminalId(parser.value(terminalIdOption).toInt());
+    const QString dataPath = parser.value(dataDirOption);
+
+    // 备用节点不加载界面，持续应用主节点的变更；提升后以同一数据目录作为主节点继续启动
+    if (parser.isSet(standbyOption)) {
+        if (dataPath.isEmpty()) {
+            QTextStream(stderr) << "备用节点必须用 --data-dir 指定与主节点不同的数据目录" << Qt::endl;
+            return 1;
+        }
+
+        JsonPersistenceManager standbyPersistence(nullptr, dataPath);
+        ReplicationStandby standby(&standbyPersistence, parser.value(standbyOption),
+                                   parser.value(promoteAfterOption).toInt() * 1000);
+        QTimer statusTimer;
+        QObject::connect(&statusTimer, &QTimer::timeout, &standby, [&standby]() {
+            QTextStream(stdout) << standby.status().summary() << Qt::endl;
+        });
+        QObject::connect(&standby, &ReplicationStandby::promoted, &app, &QCoreApplication::quit);
+        statusTimer.start(kStandbyStatusIntervalMs);
+        standby.start();
+        app.exec();
+
+        const StandbyStatus status = standby.status();
+        QTextStream(stdout) << status.summary() << Qt::endl;
+        if (!status.promoted) {
+            return 0;
+        }
+    }
+
     // 设置 Qt Quick Controls 2 的样式
     QQuickStyle::setStyle("Material"); // 使用 Material 风格
 
@@ -44,7 +130,54 @@ int main(int argc, char *argv[])
 
     // 创建并初始化 AppController
     // AppController 负责 Model/ViewModel 的生命周期管理和信号连接
-    AppController controller;
+    AppController controller(nullptr, parser.value(storageOption), dataPath, parser.value(replicateOption),
+                             parser.isSet(cdcOption));
+
+    // 离线校验：数据已在控制器构造时加载，校验完成后直接退出，不加载界面
+    if (parser.isSet(verifyLedgerOption)) {
+        const LedgerReport report = controller.verifyLedger(JsonPersistenceManager::loadThreadCount());
+        QTextStream out(stdout);
+        for (const LedgerDiscrepancy& discrepancy : report.discrepancies) {
+            out << discrepancy.toString() << Qt::endl;
+        }
+        out << report.summary() << Qt::endl;
+        return report.isConsistent() ? 0 : 1;
+    }
+
+    if (parser.isSet(backtestOption)) {
+        const ForecastBacktestReport report = controller.backtestForecasters(
+            parser.value(backtestOption).toInt(), JsonPersistenceManager::loadThreadCount());
+        QTextStream out(stdout);
+        for (const ForecastScore& score : report.scores) {
+            out << score.toString() << Qt::endl;
+        }
+        out << report.summary() << Qt::endl;
+        return 0;
+    }
+
+    if (parser.isSet(standingOrdersOption)) {
+        const StandingOrderRunReport report = controller.runStandingOrders();
+        QTextStream(stdout) << report.summary() << Qt::endl;
+        return report.failed == 0 ? 0 : 1;
+    }
+
+    if (parser.isSet(accrueInterestOption)) {
+        const AccrualReport report = controller.runInterestAccrual(JsonPersistenceManager::loadThreadCount());
+        QTextStream(stdout) << report.summary() << Qt::endl;
+        return report.committed ? 0 : 1;
+    }
+
+    if (parser.isSet(settleOption)) {
+        const QDate date = QDate::fromString(parser.value(settleOption), Qt::ISODate);
+        if (!date.isValid()) {
+            QTextStream(stderr) << "无效的清算日期: " << parser.value(settleOption) << Qt::endl;
+            return 1;
+        }
+        const SettlementReport report = controller.runSettlement(date, JsonPersistenceManager::loadThreadCount());
+        QTextStream(stdout) << report.summary() << Qt::endl;
+        return report.success ? 0 : 1;
+    }
+
     controller.initialize(&engine); // 初始化控制器，例如注册 QML 类型
 
     // 将 AppController 实例设置为 QML 上下文属性，使其在 QML 中可访问
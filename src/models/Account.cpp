@@ -5,6 +5,9 @@
  * 实现了Account类中定义的方法。
  */
 #include "Account.h"
+#include "JsonStreamWriter.h"
+#include "JsonStreamReader.h"
+#include "CardNumber.h"
 #include <QDebug>
 #include <QRandomGenerator>
 #include <QDateTime>
@@ -34,18 +37,8 @@ Account::Account(const QString& cardNumber, const QString& pin, const QString& h
  */
 bool Account::isValidCardNumber(const QString& cardNumber)
 {
-    // 卡号必须为16位数字
-    if (cardNumber.length() != 16) {
-        return false;
-    }
-    
-    for (const QChar &c : cardNumber) {
-        if (!c.isDigit()) {
-            return false;
-        }
-    }
-    
-    return true;
+    // 卡号必须为16位ASCII数字；校验位只在开户时检查，已有卡号不要求通过Luhn校验
+    return CardNumber::isWellFormed(cardNumber);
 }
 
 /**
@@ -162,18 +155,19 @@ void Account::setPin(const QString& pin)
 
 /**
  * @brief 记录登录失败
+ * @param clock 时间来源
  * @return 是否触发了临时锁定
  */
-bool Account::recordFailedLogin()
+bool Account::recordFailedLogin(const Clock* clock)
 {
     failedLoginAttempts++;
-    lastFailedLogin = QDateTime::currentDateTime();
+    lastFailedLogin = clock->nowUtc();
     
     // 检查是否需要临时锁定
     if (failedLoginAttempts >= MAX_FAILED_ATTEMPTS) {
         temporaryLockTime = lastFailedLogin.addSecs(TEMP_LOCK_DURATION * 60);
         qDebug() << "账户" << cardNumber << "因连续登录失败被临时锁定，锁定至" 
-                 << temporaryLockTime.toString();
+                 << temporaryLockTime.toLocalTime().toString();
         return true;
     }
     
@@ -191,16 +185,17 @@ void Account::resetFailedLoginAttempts()
 
 /**
  * @brief 检查是否临时锁定
+ * @param clock 时间来源
  * @return 如果账户被临时锁定返回 true
  */
-bool Account::isTemporarilyLocked() const
+bool Account::isTemporarilyLocked(const Clock* clock) const
 {
     if (!temporaryLockTime.isValid()) {
         return false;
     }
     
-    // 检查临时锁定是否已过期
-    return QDateTime::currentDateTime() < temporaryLockTime;
+    // 检查临时锁定是否已过期（按UTC毫秒比较，不做时区换算）
+    return clock->utcMs() < temporaryLockTime.toMSecsSinceEpoch();
 }
 
 /**
@@ -273,4 +268,139 @@ Account Account::fromJson(const QJsonObject &json)
     }
     
     return account;
-} 
\ No newline at end of file
+} 
+
+/**
+ * @brief 将账户直接写入流式JSON写入器
+ * @param writer 流式JSON写入器
+ */
+void Account::writeJson(JsonStreamWriter &writer) const
+{
+    // 字段顺序必须与 QJsonObject 的键名排序一致
+    writer.beginObject();
+    writer.writeDouble("balance", balance);
+    writer.writeString("cardNumber", cardNumber);
+    writer.writeInteger("failedLoginAttempts", failedLoginAttempts);
+    writer.writeString("holderName", holderName);
+    writer.writeBool("isAdmin", isAdmin);
+    writer.writeBool("isLocked", isLocked);
+    if (lastFailedLogin.isValid()) {
+        writer.writeString("lastFailedLogin", lastFailedLogin.toString(Qt::ISODate));
+    }
+    writer.writeString("pinHash", pinHash);
+    writer.writeString("salt", salt);
+    if (temporaryLockTime.isValid()) {
+        writer.writeString("temporaryLockTime", temporaryLockTime.toString(Qt::ISODate));
+    }
+    writer.writeDouble("withdrawLimit", withdrawLimit);
+    writer.endObject();
+}
+
+namespace {
+
+/**
+ * @brief 创建字段均为默认值的账户，作为流式解码的起点
+ * @return 账户对象
+ */
+Account emptyAccount()
+{
+    Account account;
+    account.balance = 0.0;
+    account.withdrawLimit = 0.0;
+    account.isLocked = false;
+    account.isAdmin = false;
+    account.failedLoginAttempts = 0;
+    return account;
+}
+
+/**
+ * @brief 解码当前格式中的一个账户字段
+ * @param account 目标账户
+ * @param key 字段名
+ * @param reader 位于字段值记号的读取器
+ * @return 如果是已知字段返回true
+ */
+bool readAccountField(Account &account, QByteArrayView key, JsonStreamReader &reader)
+{
+    if (key == "cardNumber") {
+        account.cardNumber = reader.stringValue();
+    } else if (key == "pinHash") {
+        account.pinHash = reader.stringValue();
+    } else if (key == "salt") {
+        account.salt = reader.stringValue();
+    } else if (key == "holderName") {
+        account.holderName = reader.stringValue();
+    } else if (key == "balance") {
+        account.balance = reader.numberValue();
+    } else if (key == "withdrawLimit") {
+        account.withdrawLimit = reader.numberValue();
+    } else if (key == "isLocked") {
+        account.isLocked = reader.boolValue();
+    } else if (key == "isAdmin") {
+        account.isAdmin = reader.boolValue();
+    } else if (key == "failedLoginAttempts") {
+        account.failedLoginAttempts = static_cast<int>(reader.integerValue());
+    } else if (key == "lastFailedLogin") {
+        account.lastFailedLogin = QDateTime::fromString(reader.stringValue(), Qt::ISODate);
+    } else if (key == "temporaryLockTime") {
+        account.temporaryLockTime = QDateTime::fromString(reader.stringValue(), Qt::ISODate);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief 从流式JSON读取器读取一个账户（当前格式）
+ * @param reader 位于对象起始记号（StartObject）的读取器
+ * @return 创建的 Account 对象
+ */
+Account Account::readJson(JsonStreamReader &reader)
+{
+    Account account = emptyAccount();
+    
+    while (reader.readNext() == JsonStreamReader::Name) {
+        const QByteArrayView key = reader.name();
+        if (reader.readNext() == JsonStreamReader::Invalid) {
+            break;
+        }
+        if (!readAccountField(account, key, reader)) {
+            reader.skipCurrentValue();
+        }
+    }
+    
+    return account;
+}
+
+/**
+ * @brief 从流式JSON读取器读取一个旧格式（版本1）账户
+ * @param reader 位于对象起始记号（StartObject）的读取器
+ * @return 创建的 Account 对象
+ */
+Account Account::readJsonV1(JsonStreamReader &reader)
+{
+    Account account = emptyAccount();
+    QString plainPin;
+    
+    while (reader.readNext() == JsonStreamReader::Name) {
+        const QByteArrayView key = reader.name();
+        if (reader.readNext() == JsonStreamReader::Invalid) {
+            break;
+        }
+        if (key == "pin") {
+            plainPin = reader.stringValue();
+        } else if (!readAccountField(account, key, reader)) {
+            reader.skipCurrentValue();
+        }
+    }
+    
+    // 版本1允许明文PIN，需要转换为哈希格式
+    if ((account.pinHash.isEmpty() || account.salt.isEmpty()) && !plainPin.isEmpty()) {
+        account.salt = generateSalt();
+        account.pinHash = hashPin(plainPin, account.salt);
+    }
+    
+    return account;
+}
@@ -10,6 +10,10 @@
 #include <QJsonObject>
 #include <QDateTime>
 #include <QCryptographicHash>
+#include "Clock.h"
+
+class JsonStreamWriter;
+class JsonStreamReader;
 
 /**
  * @brief 账户数据类
@@ -101,9 +105,10 @@ public:
     
     /**
      * @brief 记录登录失败
+     * @param clock 时间来源，失败时间和锁定到期时间均以UTC记录
      * @return 是否触发了临时锁定
      */
-    bool recordFailedLogin();
+    bool recordFailedLogin(const Clock* clock = Clock::system());
     
     /**
      * @brief 重置登录失败次数
@@ -112,9 +117,10 @@ public:
     
     /**
      * @brief 检查是否临时锁定
+     * @param clock 时间来源
      * @return 如果账户被临时锁定返回 true
      */
-    bool isTemporarilyLocked() const;
+    bool isTemporarilyLocked(const Clock* clock = Clock::system()) const;
 
     /**
      * @brief 将 Account 对象转换为 QJsonObject
@@ -128,4 +134,31 @@ public:
      * @return 创建的 Account 对象
      */
     static Account fromJson(const QJsonObject &json);
+
+    /**
+     * @brief 将账户直接写入流式JSON写入器
+     *
+     * 输出与 toJson() 经 QJsonDocument 序列化后的结果一致（字段按键名排序）。
+     *
+     * @param writer 流式JSON写入器
+     */
+    void writeJson(JsonStreamWriter &writer) const;
+
+    /**
+     * @brief 从流式JSON读取器读取一个账户（当前格式）
+     * @param reader 位于对象起始记号（StartObject）的读取器
+     * @return 创建的 Account 对象
+     */
+    static Account readJson(JsonStreamReader &reader);
+
+    /**
+     * @brief 从流式JSON读取器读取一个旧格式（版本1）账户
+     *
+     * 版本1的记录可能仍包含明文 "pin" 字段，读取时会生成盐值并转换为哈希；
+     * 调用方应在加载后将文件迁移到当前格式，避免每次启动重复转换。
+     *
+     * @param reader 位于对象起始记号（StartObject）的读取器
+     * @return 创建的 Account 对象
+     */
+    static Account readJsonV1(JsonStreamReader &reader);
 }; 
\ No newline at end of file
@@ -10,6 +10,26 @@
 #include <algorithm>
 #include <numeric>
 #include <cmath>
+#include "BalanceForecasters.h"
+
+namespace {
+
+//!< 预测使用的最长历史天数
+const int kHistoryDays = 180;
+
+//!< 历史不足以使用默认模型时退回的模型
+const char* const kFallbackForecaster = "WeightedAverage";
+
+//!< 自动选择默认模型时回测的预测天数
+const int kSelectionHorizonDays = 7;
+
+//!< 回测时相邻预测起点的间隔天数
+const int kBacktestStride = 7;
+
+//!< 回测时每张卡最多的预测起点数
+const int kBacktestOriginsPerCard = 8;
+
+} // namespace
 
 /**
  * @brief 构造函数
@@ -20,7 +40,25 @@ AccountAnalyticsService::AccountAnalyticsService(IAccountRepository* repository,
                                                TransactionModel* transactionModel)
     : m_repository(repository)
     , m_transactionModel(transactionModel)
+    , m_clock(Clock::system())
+    , m_defaultForecaster(kFallbackForecaster)
+    , m_forecasterSelected(false)
 {
+    // 内置模型，默认模型在首次预测前由回测选出
+    addForecaster(std::make_unique<WeightedAverageForecaster>(90, 0.05));
+    addForecaster(std::make_unique<LinearRegressionForecaster>(90));
+    addForecaster(std::make_unique<EwmaForecaster>(0.3, 90));
+    addForecaster(std::make_unique<HoltWintersForecaster>(0.3, 0.05, 0.2));
+    addForecaster(std::make_unique<QuantileBandForecaster>(0.1, 0.9, 90));
+}
+
+/**
+ * @brief 设置时间来源
+ * @param clock 时钟，为空时使用系统时钟
+ */
+void AccountAnalyticsService::setClock(const Clock* clock)
+{
+    m_clock = clock ? clock : Clock::system();
 }
 
 /**
@@ -34,8 +72,11 @@ AccountAnalyticsService::AccountAnalyticsService(IAccountRepository* repository,
  */
 double AccountAnalyticsService::predictBalance(const QString& cardNumber, int daysInFuture) const
 {
-    // 优先使用加权平均方法进行预测
-    return predictBalanceWithWeightedAverage(cardNumber, daysInFuture);
+    // 首次预测前先回测，按历史误差选出默认模型
+    if (!m_forecasterSelected) {
+        backtestForecasters(kSelectionHorizonDays);
+    }
+    return forecastBalance(cardNumber, daysInFuture).balance;
 }
 
 /**
@@ -143,97 +184,7 @@ OperationResult AccountAnalyticsService::predictBalanceMultiDays(const QString&
  */
 double AccountAnalyticsService::predictBalanceWithRegression(const QString& cardNumber, int daysInFuture) const
 {
-    if (!m_transactionModel) {
-        qWarning() << "TransactionModel 为空，无法预测余额。";
-        std::optional<Account> accountOpt = m_repository->findByCardNumber(cardNumber);
-        return accountOpt ? accountOpt.value().balance : 0.0;
-    }
-
-    // 获取当前余额
-    std::optional<Account> accountOpt = m_repository->findByCardNumber(cardNumber);
-    if (!accountOpt) {
-        return 0.0;
-    }
-    double currentBalance = accountOpt.value().balance;
-    
-    // 获取交易记录
-    QVector<Transaction> transactions = m_transactionModel->getTransactionsForCard(cardNumber);
-    if (transactions.size() < 5) { // 需要至少5条记录进行回归
-        qWarning() << "交易记录不足，无法使用回归方法预测卡号为:" << cardNumber << " 的余额。";
-        return currentBalance;
-    }
-
-    // 按日期排序交易记录（最新的在后）
-    std::sort(transactions.begin(), transactions.end(), [](const Transaction& a, const Transaction& b) {
-        return a.timestamp < b.timestamp;
-    });
-
-    // 准备回归分析数据
-    QVector<double> xValues; // 日期（转换为距今天数）
-    QVector<double> yValues; // 每日余额
-    
-    // 基准日期为当前日期
-    QDate currentDate = QDate::currentDate();
-    
-    // 每日余额记录
-    QMap<QDate, double> dailyBalances;
-    
-    // 初始化初始日期和余额
-    QDate firstTransactionDate = transactions.first().timestamp.date();
-    double runningBalance = currentBalance;
-    
-    // 倒序计算历史余额
-    for (int i = transactions.size() - 1; i >= 0; --i) {
-        const Transaction& tx = transactions[i];
-        QDate txDate = tx.timestamp.date();
-        
-        // 根据交易类型计算历史余额
-        if (tx.type == TransactionType::Deposit) {
-            runningBalance -= tx.amount; // 存款前余额会减少
-        } else if (tx.type == TransactionType::Withdrawal || tx.type == TransactionType::Transfer) {
-            runningBalance += tx.amount; // 取款或转账前余额会增加
-        }
-        
-        // 记录该日期的余额
-        dailyBalances[txDate] = runningBalance;
-    }
-    
-    // 将余额数据转换为回归分析所需的格式
-    for (auto it = dailyBalances.constBegin(); it != dailyBalances.constEnd(); ++it) {
-        // x值为日期距离今天的天数
-        int daysFromToday = it.key().daysTo(currentDate);
-        xValues.append(daysFromToday);
-        
-        // y值为当日余额
-        yValues.append(it.value());
-    }
-    
-    // 如果数据点太少，回退到简单方法
-    if (xValues.size() < 2) {
-        return predictBalanceWithWeightedAverage(cardNumber, daysInFuture);
-    }
-    
-    // 计算线性回归参数
-    double slope = 0.0;
-    double intercept = 0.0;
-    calculateLinearRegression(xValues, yValues, slope, intercept);
-    
-    // 使用回归方程预测未来余额
-    // x是未来距离今天的天数（负值表示未来的日期）
-    double futureDays = -static_cast<double>(daysInFuture);
-    double predictedBalance = slope * futureDays + intercept;
-    
-    // 确保预测余额不为负
-    if (predictedBalance < 0) {
-        predictedBalance = 0;
-    }
-    
-    qDebug() << "线性回归预测: 账户:" << cardNumber 
-             << "当前余额:" << currentBalance 
-             << "预测" << daysInFuture << "天后余额:" << predictedBalance
-             << "斜率:" << slope << "截距:" << intercept;
-    
-    return predictedBalance;
+    return forecastBalance(cardNumber, daysInFuture, "LinearRegression").balance;
 }
 
 /**
@@ -247,91 +198,184 @@ double AccountAnalyticsService::predictBalanceWithRegression(const QString& card
  */
 double AccountAnalyticsService::predictBalanceWithWeightedAverage(const QString& cardNumber, int daysInFuture) const
 {
+    return forecastBalance(cardNumber, daysInFuture, "WeightedAverage").balance;
+}
+
+/**
+ * @brief 使用指定模型预测未来余额
+ * @param cardNumber 卡号
+ * @param daysInFuture 预测未来天数
+ * @param model 模型名称，为空时使用默认模型
+ * @return 预测结果，无法预测时为当前余额
+ */
+BalanceForecast AccountAnalyticsService::forecastBalance(const QString& cardNumber, int daysInFuture,
+                                                         const QString& model) const
+{
+    std::optional<Account> accountOpt = m_repository->findByCardNumber(cardNumber);
+    if (!accountOpt) {
+        return BalanceForecast();
+    }
+    const double currentBalance = accountOpt.value().balance;
+    const BalanceForecast unchanged{currentBalance, currentBalance, currentBalance};
+
     if (!m_transactionModel) {
         qWarning() << "TransactionModel 为空，无法预测余额。";
-        std::optional<Account> accountOpt = m_repository->findByCardNumber(cardNumber);
-        return accountOpt ? accountOpt.value().balance : 0.0;
+        return unchanged;
     }
 
-    // 获取交易记录
-    QVector<Transaction> transactions = m_transactionModel->getTransactionsForCard(cardNumber);
-    if (transactions.size() < 2) {
-        qWarning() << "交易记录不足，无法预测卡号为:" << cardNumber << " 的余额。";
-        std::optional<Account> accountOpt = m_repository->findByCardNumber(cardNumber);
-        return accountOpt ? accountOpt.value().balance : 0.0;
+    const IBalanceForecaster* forecaster = findForecaster(model.isEmpty() ? m_defaultForecaster : model);
+    if (!forecaster) {
+        qWarning() << "未知的预测模型:" << model;
+        return unchanged;
     }
 
-    // 按日期排序交易记录（最新的在后）
-    std::sort(transactions.begin(), transactions.end(), [](const Transaction& a, const Transaction& b) {
-        return a.timestamp < b.timestamp;
-    });
+    const BalanceHistory history = getBalanceHistory(cardNumber);
+    const int count = history.balances.size();
+    if (count < forecaster->minimumHistory()) {
+        // 历史不够长时退回需要历史最少的加权平均模型
+        forecaster = findForecaster(kFallbackForecaster);
+        if (!forecaster || count < forecaster->minimumHistory()) {
+            qWarning() << "交易记录不足，无法预测卡号为:" << cardNumber << " 的余额。";
+            return unchanged;
+        }
+    }
 
-    // 获取当前余额
+    const BalanceForecast result = forecaster->forecast(history, count, qMax(1, daysInFuture));
+    qDebug() << forecaster->name() << "预测: 账户:" << cardNumber
+             << "当前余额:" << currentBalance
+             << "预测" << daysInFuture << "天后余额:" << result.balance
+             << "区间:" << result.lower << "-" << result.upper;
+    return result;
+}
+
+/**
+ * @brief 获取一张卡的每日余额序列
+ * @param cardNumber 卡号
+ * @return 每日余额序列，账户不存在时为空
+ */
+BalanceHistory AccountAnalyticsService::getBalanceHistory(const QString& cardNumber) const
+{
     std::optional<Account> accountOpt = m_repository->findByCardNumber(cardNumber);
-    if (!accountOpt) {
-        return 0.0;
+    if (!accountOpt || !m_transactionModel) {
+        return BalanceHistory{cardNumber, QDate(), {}};
     }
-    double currentBalance = accountOpt.value().balance;
-    
-    // 使用加权平均法分析交易数据
-    // 最近的交易数据权重更高
-    double totalIncome = 0.0;
-    double totalExpense = 0.0;
-    double totalIncomeWeight = 0.0;
-    double totalExpenseWeight = 0.0;
-    
-    QDate currentDate = QDate::currentDate();
-    
-    // 分析过去90天的交易
-    const int analysisPeriod = 90;
-    QDate startDate = currentDate.addDays(-analysisPeriod);
-    
-    for (const auto& transaction : transactions) {
-        QDate txDate = transaction.timestamp.date();
-        
-        // 只分析指定日期范围内的交易
-        if (txDate >= startDate && txDate <= currentDate) {
-            // 计算权重 - 越近的交易权重越高
-            double daysAgo = txDate.daysTo(currentDate);
-            double weight = 1.0 / (1.0 + daysAgo * 0.05); // 权重随时间衰减
-            
-            if (transaction.type == TransactionType::Deposit) {
-                totalIncome += transaction.amount * weight;
-                totalIncomeWeight += weight;
-            } else if (transaction.type == TransactionType::Withdrawal ||
-                      transaction.type == TransactionType::Transfer) {
-                totalExpense += transaction.amount * weight;
-                totalExpenseWeight += weight;
+
+    QMap<QDate, double> dailyChanges;
+    for (const Transaction& transaction : m_transactionModel->getTransactionsForCard(cardNumber)) {
+        const double change = balanceChange(transaction.type, transaction.amount);
+        if (change != 0.0) {
+            dailyChanges[transaction.timestamp.toLocalTime().date()] += change;
+        }
+    }
+    return makeBalanceHistory(cardNumber, dailyChanges, accountOpt.value().balance);
+}
+
+/**
+ * @brief 注册预测模型
+ * @param forecaster 预测模型（名称与已有模型相同时替换）
+ */
+void AccountAnalyticsService::addForecaster(std::unique_ptr<IBalanceForecaster> forecaster)
+{
+    if (!forecaster) {
+        return;
+    }
+    for (auto& existing : m_forecasters) {
+        if (existing->name() == forecaster->name()) {
+            existing = std::move(forecaster);
+            return;
+        }
+    }
+    m_forecasters.push_back(std::move(forecaster));
+}
+
+/**
+ * @brief 获取已注册的预测模型名称
+ * @return 模型名称列表（按注册顺序）
+ */
+QStringList AccountAnalyticsService::forecasterNames() const
+{
+    QStringList names;
+    for (const auto& forecaster : m_forecasters) {
+        names.append(forecaster->name());
+    }
+    return names;
+}
+
+/**
+ * @brief 获取默认预测模型名称
+ * @return 模型名称
+ */
+QString AccountAnalyticsService::defaultForecaster() const
+{
+    return m_defaultForecaster;
+}
+
+/**
+ * @brief 指定默认预测模型
+ *
+ * 指定后 predictBalance() 不再自动回测选择模型。
+ *
+ * @param model 模型名称
+ * @return 模型存在时返回true
+ */
+bool AccountAnalyticsService::setDefaultForecaster(const QString& model)
+{
+    if (!findForecaster(model)) {
+        qWarning() << "未知的预测模型:" << model;
+        return false;
+    }
+    m_defaultForecaster = model;
+    m_forecasterSelected = true;
+    return true;
+}
+
+/**
+ * @brief 回测全部预测模型并选出默认模型
+ * @param horizonDays 预测天数
+ * @param threads 线程数，0 表示自动
+ * @return 回测报告
+ */
+ForecastBacktestReport AccountAnalyticsService::backtestForecasters(int horizonDays, int threads) const
+{
+    QVector<BalanceHistory> histories;
+    if (m_transactionModel) {
+        // 扫描一遍账本，按卡号汇总每日余额变化；双边转账同时计入收款方
+        QHash<QString, QMap<QDate, double>> dailyChanges;
+        for (const Transaction& transaction : m_transactionModel->getAllTransactions()) {
+            const QDate date = transaction.timestamp.toLocalTime().date();
+            const double change = balanceChange(transaction.type, transaction.amount);
+            if (change != 0.0) {
+                dailyChanges[transaction.cardNumber][date] += change;
+            }
+            if (transaction.hasTargetLeg && transaction.targetCardNumber != transaction.cardNumber) {
+                dailyChanges[transaction.targetCardNumber][date] += transaction.amount;
+            }
+        }
+
+        for (const Account& account : m_repository->getAllAccounts()) {
+            auto found = dailyChanges.constFind(account.cardNumber);
+            if (found != dailyChanges.constEnd()) {
+                histories.append(makeBalanceHistory(account.cardNumber, found.value(), account.balance));
             }
         }
+    } else {
+        qWarning() << "TransactionModel 为空，无法回测预测模型。";
     }
-    
-    // 计算加权平均日收入和支出
-    double dailyIncome = (totalIncomeWeight > 0) ? (totalIncome / totalIncomeWeight) / analysisPeriod : 0.0;
-    double dailyExpense = (totalExpenseWeight > 0) ? (totalExpense / totalExpenseWeight) / analysisPeriod : 0.0;
-    
-    // 根据交易频率调整日收支
-    double frequency = getTransactionFrequency(cardNumber, analysisPeriod);
-    if (frequency > 0) {
-        dailyIncome = dailyIncome * std::min(frequency, 1.0);
-        dailyExpense = dailyExpense * std::min(frequency, 1.0);
+
+    QVector<const IBalanceForecaster*> forecasters;
+    for (const auto& forecaster : m_forecasters) {
+        forecasters.append(forecaster.get());
     }
-    
-    // 预测未来余额
-    double predictedDailyChange = dailyIncome - dailyExpense;
-    double predictedBalance = currentBalance + (predictedDailyChange * daysInFuture);
-    
-    // 确保预测余额不为负
-    if (predictedBalance < 0) {
-        predictedBalance = 0;
+    const ForecastBacktestReport report =
+        ForecastBacktester(horizonDays, kBacktestStride, kBacktestOriginsPerCard, threads).run(histories, forecasters);
+
+    const QString best = report.bestModel();
+    if (!best.isEmpty()) {
+        m_defaultForecaster = best;
     }
-    
-    qDebug() << "加权平均预测: 账户:" << cardNumber 
-             << "当前余额:" << currentBalance 
-             << "预测" << daysInFuture << "天后余额:" << predictedBalance
-             << "日均收入:" << dailyIncome << "日均支出:" << dailyExpense;
-    
-    return predictedBalance;
+    m_forecasterSelected = true;
+    qDebug() << "默认余额预测模型:" << m_defaultForecaster;
+    return report;
 }
 
 /**
@@ -380,7 +424,7 @@ OperationResult AccountAnalyticsService::getAccountTrend(const QString& cardNumb
     outExpenseTrend.clear();
     
     // 计算起始日期
-    QDate endDate = QDate::currentDate();
+    QDate endDate = m_clock->today();
     QDate startDate = endDate.addDays(-days + 1); // +1 包含今天
     
     // 初始化日期范围内的所有日期为0
@@ -391,17 +435,16 @@ OperationResult AccountAnalyticsService::getAccountTrend(const QString& cardNumb
     
     // 按日期对交易进行分组和汇总
     for (const auto& transaction : transactions) {
-        QDate transactionDate = transaction.timestamp.date();
+        QDate transactionDate = transaction.timestamp.toLocalTime().date();
         
         // 只考虑指定日期范围内的交易
         if (transactionDate >= startDate && transactionDate <= endDate) {
             // 根据交易类型分类为收入或支出
-            if (transaction.type == TransactionType::Deposit) {
-                // 存款视为收入
+            if (balanceChange(transaction.type, transaction.amount) > 0) {
+                // 存款、转入和利息视为收入
                 outIncomeTrend[transactionDate] += transaction.amount;
-            } else if (transaction.type == TransactionType::Withdrawal || 
-                      transaction.type == TransactionType::Transfer) {
-                // 取款和转账视为支出
+            } else if (balanceChange(transaction.type, transaction.amount) < 0) {
+                // 取款、转账和管理费视为支出
                 outExpenseTrend[transactionDate] += transaction.amount;
             }
         }
@@ -438,13 +481,13 @@ double AccountAnalyticsService::getTransactionFrequency(const QString& cardNumbe
     }
     
     // 计算日期范围
-    QDate endDate = QDate::currentDate();
+    QDate endDate = m_clock->today();
     QDate startDate = endDate.addDays(-days + 1); // +1 包含今天
     
     // 统计日期范围内的交易次数
     int transactionCount = 0;
     for (const auto& transaction : transactions) {
-        QDate transactionDate = transaction.timestamp.date();
+        QDate transactionDate = transaction.timestamp.toLocalTime().date();
         if (transactionDate >= startDate && transactionDate <= endDate) {
             transactionCount++;
         }
@@ -454,6 +497,174 @@ double AccountAnalyticsService::getTransactionFrequency(const QString& cardNumbe
     return static_cast<double>(transactionCount) / days;
 }
 
+/**
+ * @brief 获取转账往来最多的对方卡号
+ * @param cardNumber 卡号
+ * @param limit 最多返回的对方数
+ * @return 按双向转账总额降序排列的汇总
+ */
+QVector<CounterpartySummary> AccountAnalyticsService::getTopCounterparties(const QString& cardNumber, int limit) const
+{
+    if (cardNumber.isEmpty() || limit <= 0 || !m_transactionModel) {
+        return {};
+    }
+    
+    // 按对方卡号汇总双向转账
+    QHash<QString, CounterpartySummary> summaries;
+    QString from;
+    QString to;
+    for (const Transaction& transaction : m_transactionModel->getTransfersInvolving(cardNumber)) {
+        if (!TransferGraph::transferEdge(transaction, from, to)) {
+            continue;
+        }
+        const bool sent = (from == cardNumber);
+        CounterpartySummary& summary = summaries[sent ? to : from];
+        if (sent) {
+            summary.sentAmount += transaction.amount;
+            ++summary.sentCount;
+        } else {
+            summary.receivedAmount += transaction.amount;
+            ++summary.receivedCount;
+        }
+    }
+    
+    QVector<CounterpartySummary> result;
+    result.reserve(summaries.size());
+    for (auto it = summaries.begin(); it != summaries.end(); ++it) {
+        it.value().cardNumber = it.key();
+        result.append(it.value());
+    }
+    
+    // 只需要前 limit 名，部分排序即可
+    const int count = qMin(limit, int(result.size()));
+    std::partial_sort(result.begin(), result.begin() + count, result.end(),
+                      [](const CounterpartySummary& a, const CounterpartySummary& b) {
+                          if (a.totalAmount() != b.totalAmount()) {
+                              return a.totalAmount() > b.totalAmount();
+                          }
+                          return a.cardNumber < b.cardNumber;
+                      });
+    result.resize(count);
+    return result;
+}
+
+/**
+ * @brief 获取两张卡之间的双向转账流量
+ * @param cardA 卡号A
+ * @param cardB 卡号B
+ * @return 转账流量
+ */
+TransferFlow AccountAnalyticsService::getTransferFlow(const QString& cardA, const QString& cardB) const
+{
+    TransferFlow flow;
+    if (cardA.isEmpty() || cardB.isEmpty() || !m_transactionModel) {
+        return flow;
+    }
+    
+    QString from;
+    QString to;
+    for (const Transaction& transaction : m_transactionModel->getTransfersInvolving(cardA)) {
+        if (!TransferGraph::transferEdge(transaction, from, to)) {
+            continue;
+        }
+        if (from == cardA && to == cardB) {
+            flow.aToB += transaction.amount;
+            ++flow.aToBCount;
+        } else if (from == cardB && to == cardA) {
+            flow.bToA += transaction.amount;
+            ++flow.bToACount;
+        }
+    }
+    return flow;
+}
+
+/**
+ * @brief 构建全部卡号的转账关系图
+ * @return 转账关系图（CSR）
+ */
+TransferGraph AccountAnalyticsService::buildTransferGraph() const
+{
+    if (!m_transactionModel) {
+        return TransferGraph();
+    }
+    return TransferGraph::build(m_transactionModel->getAllTransactions());
+}
+
+/**
+ * @brief 计算转账关系图的连通分量
+ * @param minSize 最小分量大小
+ * @param threads 线程数，0 表示自动
+ * @return 各分量的卡号列表（按分量大小降序）
+ */
+QVector<QStringList> AccountAnalyticsService::getTransferComponents(int minSize, int threads) const
+{
+    return buildTransferGraph().components(minSize, threads);
+}
+
+/**
+ * @brief 查找预测模型
+ * @param model 模型名称
+ * @return 预测模型，不存在时返回nullptr
+ */
+const IBalanceForecaster* AccountAnalyticsService::findForecaster(const QString& model) const
+{
+    for (const auto& forecaster : m_forecasters) {
+        if (forecaster->name() == model) {
+            return forecaster.get();
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief 计算交易对余额的影响
+ * @param type 交易类型
+ * @param amount 交易金额
+ * @return 余额变化量（收入为正，支出为负，其他为0）
+ */
+double AccountAnalyticsService::balanceChange(TransactionType type, double amount)
+{
+    switch (type) {
+    case TransactionType::Deposit:
+    case TransactionType::TransferIn:
+    case TransactionType::Interest:
+        return amount;
+    case TransactionType::Withdrawal:
+    case TransactionType::Transfer:
+    case TransactionType::Fee:
+        return -amount;
+    default:
+        return 0.0;
+    }
+}
+
+/**
+ * @brief 由每日余额变化倒推每日余额序列
+ * @param cardNumber 卡号
+ * @param dailyChanges 每日余额变化之和
+ * @param currentBalance 当前余额
+ * @return 每日余额序列（从第一笔交易的前一天起，最长 kHistoryDays 天，到今天为止）
+ */
+BalanceHistory AccountAnalyticsService::makeBalanceHistory(const QString& cardNumber,
+                                                           const QMap<QDate, double>& dailyChanges,
+                                                           double currentBalance) const
+{
+    const QDate today = m_clock->today();
+    QDate firstDate = today;
+    if (!dailyChanges.isEmpty()) {
+        firstDate = qBound(today.addDays(1 - kHistoryDays), dailyChanges.firstKey().addDays(-1), today);
+    }
+
+    // 从今天的余额倒推：前一天日终余额 = 当天日终余额 - 当天的变化
+    const int days = int(firstDate.daysTo(today)) + 1;
+    QVector<double> balances(days);
+    balances[days - 1] = currentBalance;
+    for (int i = days - 1; i > 0; --i) {
+        balances[i - 1] = balances[i] - dailyChanges.value(firstDate.addDays(i), 0.0);
+    }
+    return BalanceHistory{cardNumber, firstDate, balances};
+}
+
 /**
  * @brief 根据历史交易计算日均收支
  * @param transactions 交易记录列表
@@ -477,12 +688,11 @@ void AccountAnalyticsService::calculateDailyAverages(const QVector<Transaction>&
     
     // 计算总收入和总支出
     for (const auto& transaction : transactions) {
-        if (transaction.type == TransactionType::Deposit) {
-            // 存款视为收入
+        if (balanceChange(transaction.type, transaction.amount) > 0) {
+            // 存款、转入和利息视为收入
             totalIncome += transaction.amount;
-        } else if (transaction.type == TransactionType::Withdrawal || 
-                  transaction.type == TransactionType::Transfer) {
-            // 取款和转账视为支出
+        } else if (balanceChange(transaction.type, transaction.amount) < 0) {
+            // 取款、转账和管理费视为支出
             totalExpense += transaction.amount;
         }
     }
@@ -491,47 +701,3 @@ void AccountAnalyticsService::calculateDailyAverages(const QVector<Transaction>&
     outDailyIncome = totalIncome / days;
     outDailyExpense = totalExpense / days;
 }
-
-/**
- * @brief 计算线性回归参数
- * @param xValues x值列表（时间点）
- * @param yValues y值列表（余额变化）
- * @param outSlope 输出参数，回归直线斜率
- * @param outIntercept 输出参数，回归直线截距
- */
-void AccountAnalyticsService::calculateLinearRegression(const QVector<double>& xValues,
-                                                      const QVector<double>& yValues,
-                                                      double& outSlope,
-                                                      double& outIntercept) const
-{
-    if (xValues.size() != yValues.size() || xValues.isEmpty()) {
-        outSlope = 0.0;
-        outIntercept = 0.0;
-        return;
-    }
-    
-    // 计算均值
-    double xMean = std::accumulate(xValues.begin(), xValues.end(), 0.0) / xValues.size();
-    double yMean = std::accumulate(yValues.begin(), yValues.end(), 0.0) / yValues.size();
-    
-    // 计算回归参数
-    double numerator = 0.0;
-    double denominator = 0.0;
-    
-    for (int i = 0; i < xValues.size(); ++i) {
-        double xDiff = xValues[i] - xMean;
-        numerator += xDiff * (yValues[i] - yMean);
-        denominator += xDiff * xDiff;
-    }
-    
-    // 防止除零错误
-    if (denominator == 0.0) {
-        outSlope = 0.0;
-        outIntercept = yMean;
-        return;
-    }
-    
-    // 计算斜率和截距
-    outSlope = numerator / denominator;
-    outIntercept = yMean - outSlope * xMean;
-} 
\ No newline at end of file
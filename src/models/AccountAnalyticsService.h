@@ -11,14 +11,58 @@
 #include <QDateTime>
 #include <QMap>
 #include <QVector>
+#include <QStringList>
+#include <memory>
+#include <vector>
 #include "IAccountRepository.h"
 #include "TransactionModel.h"
 #include "OperationResult.h"
+#include "Clock.h"
+#include "TransferGraph.h"
+#include "IBalanceForecaster.h"
+#include "ForecastBacktester.h"
+
+/**
+ * @brief 与某一对方卡号之间的转账汇总
+ */
+struct CounterpartySummary {
+    QString cardNumber;         //!< 对方卡号
+    double sentAmount = 0.0;    //!< 转给对方的金额
+    double receivedAmount = 0.0; //!< 从对方收到的金额
+    int sentCount = 0;          //!< 转给对方的笔数
+    int receivedCount = 0;      //!< 从对方收到的笔数
+
+    /**
+     * @brief 双向转账总额
+     * @return 总额
+     */
+    double totalAmount() const { return sentAmount + receivedAmount; }
+};
+
+/**
+ * @brief 两张卡之间的双向转账流量
+ */
+struct TransferFlow {
+    double aToB = 0.0;      //!< A 转给 B 的金额
+    double bToA = 0.0;      //!< B 转给 A 的金额
+    int aToBCount = 0;      //!< A 转给 B 的笔数
+    int bToACount = 0;      //!< B 转给 A 的笔数
+
+    /**
+     * @brief A 相对 B 的净流出
+     * @return aToB - bToA
+     */
+    double net() const { return aToB - bToA; }
+};
 
 /**
  * @brief 账户分析服务类
  *
  * 实现与账户分析相关的功能，包括余额预测和交易趋势分析。
+ *
+ * 余额预测由可替换的预测模型（IBalanceForecaster）完成，内置加权平均、线性回归、
+ * EWMA、Holt-Winters 和分位数区间五个模型。首次预测前在全部卡号的历史上回测一次，
+ * 以平均绝对误差最小的模型作为 predictBalance() 的默认模型。
  */
 class AccountAnalyticsService {
 public:
@@ -30,10 +74,16 @@ public:
     AccountAnalyticsService(IAccountRepository* repository, 
                            TransactionModel* transactionModel);
     
+    /**
+     * @brief 设置时间来源
+     * @param clock 时钟，为空时使用系统时钟
+     */
+    void setClock(const Clock* clock);
+    
     /**
      * @brief 预测未来余额
      * 
-     * 根据历史交易记录预测未来一定天数后的余额。
+     * 根据历史交易记录预测未来一定天数后的余额。首次调用时先回测全部模型选出默认模型。
      *
      * @param cardNumber 卡号
      * @param daysInFuture 预测未来天数（默认为7天）
@@ -91,6 +141,68 @@ public:
      */
     double predictBalanceWithWeightedAverage(const QString& cardNumber, int daysInFuture) const;
     
+    /**
+     * @brief 使用指定模型预测未来余额
+     * 
+     * 历史天数不足以使用该模型时退回加权平均模型，仍不足时返回当前余额。
+     *
+     * @param cardNumber 卡号
+     * @param daysInFuture 预测未来天数
+     * @param model 模型名称，为空时使用默认模型
+     * @return 预测结果（分位数区间模型带上下界）
+     */
+    BalanceForecast forecastBalance(const QString& cardNumber, int daysInFuture,
+                                    const QString& model = QString()) const;
+    
+    /**
+     * @brief 获取一张卡的每日余额序列
+     * 
+     * 由当前余额和交易记录倒推，从第一笔交易的前一天开始，最长180天。
+     *
+     * @param cardNumber 卡号
+     * @return 每日余额序列，账户不存在时为空
+     */
+    BalanceHistory getBalanceHistory(const QString& cardNumber) const;
+    
+    /**
+     * @brief 注册预测模型
+     * @param forecaster 预测模型（名称与已有模型相同时替换）
+     */
+    void addForecaster(std::unique_ptr<IBalanceForecaster> forecaster);
+    
+    /**
+     * @brief 获取已注册的预测模型名称
+     * @return 模型名称列表（按注册顺序）
+     */
+    QStringList forecasterNames() const;
+    
+    /**
+     * @brief 获取默认预测模型名称
+     * @return 模型名称
+     */
+    QString defaultForecaster() const;
+    
+    /**
+     * @brief 指定默认预测模型
+     * 
+     * 指定后 predictBalance() 不再自动回测选择模型。
+     *
+     * @param model 模型名称
+     * @return 模型存在时返回true
+     */
+    bool setDefaultForecaster(const QString& model);
+    
+    /**
+     * @brief 回测全部预测模型并选出默认模型
+     * 
+     * 在全部卡号的每日余额序列上并行回测，以平均绝对误差最小的模型作为默认模型。
+     *
+     * @param horizonDays 预测天数
+     * @param threads 线程数，0 表示自动
+     * @return 回测报告（含各模型的MAE/MAPE和每秒回测的卡数）
+     */
+    ForecastBacktestReport backtestForecasters(int horizonDays = 7, int threads = 0) const;
+    
     /**
      * @brief 获取账户收支趋势
      * 
@@ -117,6 +229,42 @@ public:
      * @return 平均每天交易次数
      */
     double getTransactionFrequency(const QString& cardNumber, int days = 30) const;
+    
+    /**
+     * @brief 获取转账往来最多的对方卡号
+     * 
+     * 通过交易模型的卡号索引和反向索引取出涉及该卡的转账，不扫描整个账本。
+     *
+     * @param cardNumber 卡号
+     * @param limit 最多返回的对方数
+     * @return 按双向转账总额降序排列的汇总
+     */
+    QVector<CounterpartySummary> getTopCounterparties(const QString& cardNumber, int limit = 10) const;
+    
+    /**
+     * @brief 获取两张卡之间的双向转账流量
+     * @param cardA 卡号A
+     * @param cardB 卡号B
+     * @return 转账流量
+     */
+    TransferFlow getTransferFlow(const QString& cardA, const QString& cardB) const;
+    
+    /**
+     * @brief 构建全部卡号的转账关系图
+     * @return 转账关系图（CSR）
+     */
+    TransferGraph buildTransferGraph() const;
+    
+    /**
+     * @brief 计算转账关系图的连通分量
+     * 
+     * 同一分量内的卡号之间直接或间接发生过转账，可用于识别资金往来群组。
+     *
+     * @param minSize 最小分量大小
+     * @param threads 线程数，0 表示自动
+     * @return 各分量的卡号列表（按分量大小降序）
+     */
+    QVector<QStringList> getTransferComponents(int minSize = 2, int threads = 0) const;
 
 private:
     /**
@@ -132,20 +280,46 @@ private:
                                double& outDailyExpense) const;
                                
     /**
-     * @brief 计算线性回归参数
-     * @param xValues x值列表（时间点）
-     * @param yValues y值列表（余额变化）
-     * @param outSlope 输出参数，回归直线斜率
-     * @param outIntercept 输出参数，回归直线截距
+     * @brief 查找预测模型
+     * @param model 模型名称
+     * @return 预测模型，不存在时返回nullptr
      */
-    void calculateLinearRegression(const QVector<double>& xValues,
-                                  const QVector<double>& yValues,
-                                  double& outSlope,
-                                  double& outIntercept) const;
+    const IBalanceForecaster* findForecaster(const QString& model) const;
+    
+    /**
+     * @brief 计算交易对余额的影响
+     * @param type 交易类型
+     * @param amount 交易金额
+     * @return 余额变化量（收入为正，支出为负，其他为0）
+     */
+    static double balanceChange(TransactionType type, double amount);
+    
+    /**
+     * @brief 由每日余额变化倒推每日余额序列
+     * @param cardNumber 卡号
+     * @param dailyChanges 每日余额变化之和
+     * @param currentBalance 当前余额
+     * @return 每日余额序列
+     */
+    BalanceHistory makeBalanceHistory(const QString& cardNumber,
+                                      const QMap<QDate, double>& dailyChanges,
+                                      double currentBalance) const;
     
     //!< 账户存储库
     IAccountRepository* m_repository;
     
     //!< 交易记录模型
     TransactionModel* m_transactionModel;
+    
+    //!< 时间来源
+    const Clock* m_clock;
+    
+    //!< 已注册的预测模型
+    std::vector<std::unique_ptr<IBalanceForecaster>> m_forecasters;
+    
+    //!< 默认预测模型名称（回测后更新）
+    mutable QString m_defaultForecaster;
+    
+    //!< 是否已选定默认模型（回测过或手动指定）
+    mutable bool m_forecasterSelected;
 }; 
\ No newline at end of file
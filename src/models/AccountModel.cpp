@@ -15,11 +15,25 @@
  * @param parent 父对象指针
  */
 AccountModel::AccountModel(QObject *parent)
+    // 未指定存储库时才创建默认的账户存储库（它会自行管理JsonPersistenceManager）
+    : AccountModel(std::make_unique<JsonAccountRepository>(), nullptr, parent)
+{
+}
+
+/**
+ * @brief 构造函数
+ * @param repository 账户存储库
+ * @param persistenceManager 数据目录的JSON持久化管理器，为空时使用默认数据目录
+ * @param parent 父对象指针
+ */
+AccountModel::AccountModel(std::unique_ptr<IAccountRepository> repository,
+                           JsonPersistenceManager* persistenceManager, QObject *parent)
     : QObject(parent)
+    , m_repository(std::move(repository))
     , m_transactionModel(nullptr)
+    , m_clock(Clock::system())
 {
-    // 创建账户存储库（使用默认构造函数，它会自行管理JsonPersistenceManager）
-    m_repository = std::make_unique<JsonAccountRepository>();
+    Q_ASSERT(m_repository != nullptr);
     
     // 创建验证器
     m_validator = std::make_unique<AccountValidator>(m_repository.get());
@@ -27,6 +41,11 @@ AccountModel::AccountModel(QObject *parent)
     // 创建各种服务
     m_accountService = std::make_unique<AccountService>(m_repository.get(), m_validator.get());
     m_adminService = std::make_unique<AdminService>(m_repository.get(), m_validator.get());
+    attachAggregates();
+    
+    // 定期转账调度器通过账户服务执行转账，指令与账户保存在同一数据目录，
+    // 同一台机器上的主备节点各自维护自己的指令，不会重复付款
+    m_standingOrders = std::make_unique<StandingOrderScheduler>(m_accountService.get(), persistenceManager);
     
     qDebug() << "AccountModel 门面类初始化完成";
 }
@@ -43,6 +62,7 @@ AccountModel::~AccountModel() = default;
 void AccountModel::setTransactionModel(TransactionModel* transactionModel)
 {
     m_transactionModel = transactionModel;
+    m_accrualStateLoaded = false;
     
     if (m_accountService) {
         m_accountService->setTransactionModel(transactionModel);
@@ -58,33 +78,78 @@ void AccountModel::setTransactionModel(TransactionModel* transactionModel)
             m_repository.get(), 
             transactionModel
         );
+        m_analyticsService->setClock(m_clock);
     }
     
     qDebug() << "设置交易模型完成";
 }
 
+/**
+ * @brief 设置时间来源
+ * @param clock 时钟，为空时使用系统时钟
+ */
+void AccountModel::setClock(const Clock* clock)
+{
+    m_clock = clock ? clock : Clock::system();
+    
+    if (m_validator) {
+        m_validator->setClock(m_clock);
+    }
+    
+    if (m_accountService) {
+        m_accountService->setClock(m_clock);
+    }
+    
+    if (m_analyticsService) {
+        m_analyticsService->setClock(m_clock);
+    }
+    
+    m_standingOrders->setClock(m_clock);
+    
+    // 临时锁定是否有效取决于当前时间
+    attachAggregates();
+}
+
+/**
+ * @brief 以存储库中的全部账户重建账户汇总，并交给服务层维护
+ */
+void AccountModel::attachAggregates()
+{
+    m_aggregates.reset(m_repository->getAllAccounts(), m_clock->utcMs());
+    if (m_accountService) {
+        m_accountService->setAggregates(&m_aggregates);
+    }
+    if (m_adminService) {
+        m_adminService->setAggregates(&m_aggregates);
+    }
+}
+
 // =============================
 // === AccountService 委托方法 ===
 // =============================
 
-LoginResult AccountModel::performLogin(const QString &cardNumber, const QString &pin)
+LoginResult AccountModel::performLogin(const QString &cardNumber, const QString &pin,
+                                      const QString &terminalId)
 {
-    return m_accountService->performLogin(cardNumber, pin);
+    return m_accountService->performLogin(cardNumber, pin, terminalId);
 }
 
-OperationResult AccountModel::withdrawAmount(const QString &cardNumber, double amount)
+OperationResult AccountModel::withdrawAmount(const QString &cardNumber, double amount,
+                                            const QString &requestId)
 {
-    return m_accountService->withdrawAmount(cardNumber, amount);
+    return m_accountService->withdrawAmount(cardNumber, amount, requestId);
 }
 
-OperationResult AccountModel::depositAmount(const QString &cardNumber, double amount)
+OperationResult AccountModel::depositAmount(const QString &cardNumber, double amount,
+                                           const QString &requestId)
 {
-    return m_accountService->depositAmount(cardNumber, amount);
+    return m_accountService->depositAmount(cardNumber, amount, requestId);
 }
 
-OperationResult AccountModel::transferAmount(const QString &fromCardNumber, const QString &toCardNumber, double amount)
+OperationResult AccountModel::transferAmount(const QString &fromCardNumber, const QString &toCardNumber, double amount,
+                                            const QString &requestId)
 {
-    return m_accountService->transferAmount(fromCardNumber, toCardNumber, amount);
+    return m_accountService->transferAmount(fromCardNumber, toCardNumber, amount, requestId);
 }
 
 OperationResult AccountModel::changePin(const QString &cardNumber, const QString &currentPin, 
@@ -117,9 +182,10 @@ bool AccountModel::isAccountLocked(const QString &cardNumber) const
 // === AdminService 委托方法 ===
 // =============================
 
-LoginResult AccountModel::performAdminLogin(const QString &cardNumber, const QString &pin)
+LoginResult AccountModel::performAdminLogin(const QString &cardNumber, const QString &pin,
+                                           const QString &terminalId)
 {
-    return m_adminService->performAdminLogin(cardNumber, pin);
+    return m_adminService->performAdminLogin(cardNumber, pin, terminalId);
 }
 
 OperationResult AccountModel::createAccount(const QString &cardNumber, const QString &pin, 
@@ -137,7 +203,12 @@ OperationResult AccountModel::updateAccount(const QString &cardNumber, const QSt
 
 OperationResult AccountModel::deleteAccount(const QString &cardNumber)
 {
-    return m_adminService->deleteAccount(cardNumber);
+    OperationResult result = m_adminService->deleteAccount(cardNumber);
+    if (result.success) {
+        // 付款或收款账户已删除的定期转账指令不会再成功，一并取消
+        m_standingOrders->cancelOrdersForCard(cardNumber);
+    }
+    return result;
 }
 
 OperationResult AccountModel::setAccountLockStatus(const QString &cardNumber, bool locked)
@@ -160,6 +231,137 @@ QVector<Account> AccountModel::getAllAccounts() const
     return m_adminService->getAllAccounts();
 }
 
+LedgerReport AccountModel::verifyLedger(int threads) const
+{
+    if (!m_transactionModel) {
+        qWarning() << "未设置交易模型，无法校验账本";
+        return LedgerReport();
+    }
+    return LedgerVerifier(threads).verify(m_transactionModel->getAllTransactions(),
+                                          m_repository->getAllAccounts());
+}
+
+QVariantMap AccountModel::bankSummary() const
+{
+    const qint64 now = m_clock->utcMs();
+    QVariantMap summary;
+    summary["accountCount"] = m_aggregates.accountCount();
+    summary["totalBalance"] = m_aggregates.totalBalance();
+    summary["lockedCount"] = m_aggregates.lockedCount();
+    summary["temporarilyLockedCount"] = m_aggregates.temporarilyLockedCount(now);
+    summary["adminCount"] = m_aggregates.adminCount();
+    
+    DailyActivityTotals today;
+    today.date = m_clock->today();
+    if (m_transactionModel) {
+        today = m_transactionModel->todayActivity();
+    }
+    summary["date"] = today.date;
+    summary["depositCount"] = today.depositCount;
+    summary["depositVolume"] = today.depositVolume;
+    summary["withdrawalCount"] = today.withdrawalCount;
+    summary["withdrawalVolume"] = today.withdrawalVolume;
+    summary["transferCount"] = today.transferCount;
+    summary["transferVolume"] = today.transferVolume;
+    return summary;
+}
+
+OperationResult AccountModel::verifyAggregates() const
+{
+    const qint64 now = m_clock->utcMs();
+    QStringList differences = m_aggregates.differences(
+        AccountAggregates::compute(m_repository->getAllAccounts(), now), now);
+    if (m_transactionModel) {
+        differences += m_transactionModel->verifyTodayActivity();
+    }
+    
+    if (!differences.isEmpty()) {
+        qWarning() << "全行汇总与全量计算不一致:" << differences;
+        return OperationResult::Failure(differences.join("; "));
+    }
+    return OperationResult::Success();
+}
+
+QVector<LeaderboardEntry> AccountModel::getTopBalances(int n) const
+{
+    return m_aggregates.topBalances(n);
+}
+
+QVector<LeaderboardEntry> AccountModel::getMostActiveCards(int n) const
+{
+    if (!m_transactionModel) {
+        return QVector<LeaderboardEntry>();
+    }
+    return m_transactionModel->getMostActiveCards(n);
+}
+
+// ====================================
+// === StandingOrderScheduler 委托方法 ===
+// ====================================
+
+OperationResult AccountModel::addStandingOrder(StandingOrder& order)
+{
+    return m_standingOrders->addOrder(order);
+}
+
+OperationResult AccountModel::cancelStandingOrder(quint64 id, const QString& cardNumber)
+{
+    return m_standingOrders->cancelOrder(id, cardNumber);
+}
+
+QVector<StandingOrder> AccountModel::getStandingOrders(const QString& cardNumber) const
+{
+    return m_standingOrders->ordersForCard(cardNumber);
+}
+
+StandingOrderRunReport AccountModel::runStandingOrders(int batchSize)
+{
+    return m_standingOrders->runDueOrders(batchSize);
+}
+
+// ====================================
+// === InterestAccrualJob 委托方法 ===
+// ====================================
+
+AccrualReport AccountModel::runInterestAccrual(int threads)
+{
+    const QDate today = m_clock->today();
+    AccrualReport report;
+    report.date = today;
+    if (!m_transactionModel) {
+        qWarning() << "未设置交易模型，无法计息";
+        report.error = "未设置交易模型";
+        return report;
+    }
+    
+    if (!m_accrualStateLoaded) {
+        const QVector<Transaction>& transactions = m_transactionModel->getAllTransactions();
+        m_lastAccrualDate = InterestAccrualJob::lastPostingDate(transactions, TransactionType::Interest);
+        m_lastFeeDate = InterestAccrualJob::lastPostingDate(transactions, TransactionType::Fee);
+        m_accrualStateLoaded = true;
+    }
+    
+    const int accrualDays = m_lastAccrualDate.isValid() ? qMax(0, int(m_lastAccrualDate.daysTo(today))) : 1;
+    const bool chargeFees = !m_lastFeeDate.isValid()
+        || m_lastFeeDate.year() != today.year() || m_lastFeeDate.month() != today.month();
+    if (accrualDays == 0 && !chargeFees) {
+        report.committed = true;
+        return report;
+    }
+    
+    report = InterestAccrualJob(m_accrualPolicy, threads).run(
+        *m_repository, *m_transactionModel, &m_aggregates, today, accrualDays, chargeFees);
+    if (report.committed) {
+        if (accrualDays > 0) {
+            m_lastAccrualDate = today;
+        }
+        if (chargeFees) {
+            m_lastFeeDate = today;
+        }
+    }
+    return report;
+}
+
 // ====================================
 // === AccountAnalyticsService 委托方法 ===
 // ====================================
@@ -217,9 +419,35 @@ double AccountModel::getTransactionFrequency(const QString &cardNumber, int days
     return m_analyticsService->getTransactionFrequency(cardNumber, days);
 }
 
+ForecastBacktestReport AccountModel::backtestForecasters(int horizonDays, int threads) const
+{
+    if (!m_analyticsService) {
+        qWarning() << "分析服务不可用，无法回测预测模型";
+        return ForecastBacktestReport();
+    }
+    return m_analyticsService->backtestForecasters(horizonDays, threads);
+}
+
 QVariantList AccountModel::getAllAccountsAsVariantList() const
 {
     QVariantList result;
+
+    // 列式表可用时直接按列读取，不组装包含PIN哈希、盐值等冷字段的完整账户
+    if (const AccountTable* table = m_repository->accountTable()) {
+        result.reserve(table->size());
+        for (int row : table->rowsByCardNumber()) {
+            QVariantMap accountMap;
+            accountMap["cardNumber"] = table->cardNumbers().at(row);
+            accountMap["holderName"] = table->coldData().at(row).holderName;
+            accountMap["balance"] = table->balances().at(row);
+            accountMap["withdrawLimit"] = table->withdrawLimits().at(row);
+            accountMap["isLocked"] = table->hasFlag(row, AccountTable::Locked);
+            accountMap["isAdmin"] = table->hasFlag(row, AccountTable::Admin);
+            result.append(accountMap);
+        }
+        return result;
+    }
+
     QVector<Account> accounts = getAllAccounts();
     
     for (const Account& account : accounts) {
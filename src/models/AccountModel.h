@@ -15,8 +15,11 @@
 #include "AccountService.h"
 #include "AdminService.h"
 #include "AccountAnalyticsService.h"
+#include "StandingOrderScheduler.h"
+#include "InterestAccrualJob.h"
 #include "TransactionModel.h"
 #include "LoginResult.h"
+#include "LedgerVerifier.h"
 #include "OperationResult.h"
 
 /**
@@ -32,9 +35,23 @@ class AccountModel : public QObject
 public:
     /**
      * @brief 构造函数
+     *
+     * 使用默认数据目录下的 JSON 账户存储库；启动时选择了存储后端或数据目录时应改用下面的构造函数，
+     * 避免先在默认目录加载（或初始化）一份账户数据。
+     *
      * @param parent 父对象指针
      */
     explicit AccountModel(QObject *parent = nullptr);
+
+    /**
+     * @brief 构造函数
+     * @param repository 账户存储库（所有权转移给 AccountModel）
+     * @param persistenceManager 数据目录的JSON持久化管理器，定期转账指令保存在该目录中；
+     *                           为空时使用默认数据目录
+     * @param parent 父对象指针
+     */
+    AccountModel(std::unique_ptr<IAccountRepository> repository, JsonPersistenceManager* persistenceManager,
+                 QObject *parent = nullptr);
     
     /**
      * @brief 析构函数
@@ -47,6 +64,15 @@ public:
      */
     void setTransactionModel(TransactionModel* transactionModel);
 
+    /**
+     * @brief 设置时间来源
+     *
+     * 登录锁定判断和分析服务均使用该时钟。
+     *
+     * @param clock 时钟，为空时使用系统时钟
+     */
+    void setClock(const Clock* clock);
+
     /**
      * @brief 获取账户存储库指针
      * @return 账户存储库接口指针
@@ -61,34 +87,42 @@ public:
      * @brief 执行用户登录
      * @param cardNumber 卡号
      * @param pin PIN码
+     * @param terminalId 终端标识，为空时视为本机终端
      * @return 登录结果
      */
-    LoginResult performLogin(const QString &cardNumber, const QString &pin);
+    LoginResult performLogin(const QString &cardNumber, const QString &pin,
+                             const QString &terminalId = QString());
     
     /**
      * @brief 执行取款操作
      * @param cardNumber 卡号
      * @param amount 取款金额
+     * @param requestId 客户端请求编号，重复的编号直接返回首次结果；为空时不去重
      * @return 操作结果
      */
-    OperationResult withdrawAmount(const QString &cardNumber, double amount);
+    OperationResult withdrawAmount(const QString &cardNumber, double amount,
+                                   const QString &requestId = QString());
     
     /**
      * @brief 执行存款操作
      * @param cardNumber 卡号
      * @param amount 存款金额
+     * @param requestId 客户端请求编号，为空时不去重
      * @return 操作结果
      */
-    OperationResult depositAmount(const QString &cardNumber, double amount);
+    OperationResult depositAmount(const QString &cardNumber, double amount,
+                                  const QString &requestId = QString());
     
     /**
      * @brief 执行转账操作
      * @param fromCardNumber 源卡号
      * @param toCardNumber 目标卡号
      * @param amount 转账金额
+     * @param requestId 客户端请求编号，为空时不去重
      * @return 操作结果
      */
-    OperationResult transferAmount(const QString &fromCardNumber, const QString &toCardNumber, double amount);
+    OperationResult transferAmount(const QString &fromCardNumber, const QString &toCardNumber, double amount,
+                                   const QString &requestId = QString());
     
     /**
      * @brief 修改PIN码
@@ -137,9 +171,11 @@ public:
      * @brief 执行管理员登录
      * @param cardNumber 卡号
      * @param pin PIN码
+     * @param terminalId 终端标识，为空时视为本机终端
      * @return 登录结果
      */
-    LoginResult performAdminLogin(const QString &cardNumber, const QString &pin);
+    LoginResult performAdminLogin(const QString &cardNumber, const QString &pin,
+                                  const QString &terminalId = QString());
     
     /**
      * @brief 创建新账户
@@ -204,6 +240,87 @@ public:
      */
     QVector<Account> getAllAccounts() const;
     
+    /**
+     * @brief 校验账本与账户余额的一致性
+     * @param threads 线程数，0 表示使用 QThread::idealThreadCount()
+     * @return 校验报告，未设置交易模型时为空报告
+     */
+    LedgerReport verifyLedger(int threads = 0) const;
+    
+    /**
+     * @brief 获取全行汇总
+     *
+     * 账户部分由服务层在每次修改后增量更新，当日交易部分由交易模型在登记交易时累加，
+     * 读取时不遍历账户或账本。
+     *
+     * @return 汇总数据（总余额、账户数、锁定账户数、今日存取款及转账笔数和金额等）
+     */
+    QVariantMap bankSummary() const;
+    
+    /**
+     * @brief 以全量重新计算核对全行汇总
+     * @return 一致时成功，否则失败并列出不一致的字段
+     */
+    OperationResult verifyAggregates() const;
+    
+    /**
+     * @brief 获取余额最高的账户
+     * @param n 数量
+     * @return 按余额降序排列的卡号和余额
+     */
+    QVector<LeaderboardEntry> getTopBalances(int n = 100) const;
+    
+    /**
+     * @brief 获取最近 24 小时交易次数最多的卡号
+     * @param n 数量
+     * @return 按交易次数降序排列的卡号和次数，未设置交易模型时为空
+     */
+    QVector<LeaderboardEntry> getMostActiveCards(int n = 100) const;
+    
+    // =========================================
+    // === StandingOrderScheduler 对应的方法 ===
+    // =========================================
+    
+    /**
+     * @brief 添加定期转账指令
+     * @param order 指令，成功时写入分配的指令编号
+     * @return 操作结果
+     */
+    OperationResult addStandingOrder(StandingOrder& order);
+    
+    /**
+     * @brief 取消定期转账指令
+     * @param id 指令编号
+     * @param cardNumber 操作者卡号，非空时只能取消该卡付款的指令
+     * @return 操作结果
+     */
+    OperationResult cancelStandingOrder(quint64 id, const QString& cardNumber = QString());
+    
+    /**
+     * @brief 获取某卡付款的定期转账指令
+     * @param cardNumber 付款卡号
+     * @return 指令列表
+     */
+    QVector<StandingOrder> getStandingOrders(const QString& cardNumber) const;
+    
+    /**
+     * @brief 执行全部到期的定期转账
+     * @param batchSize 每批的指令数，不大于0时使用默认值
+     * @return 执行结果
+     */
+    StandingOrderRunReport runStandingOrders(int batchSize = 0);
+    
+    /**
+     * @brief 执行到期的批量计息与收费
+     *
+     * 计息天数为上次计息日到今天的天数（从未计息时为1天），今天已计息时不再计息；
+     * 本月尚未扣收管理费时同时扣收。上次计息和收费的日期在首次调用时从账本恢复。
+     *
+     * @param threads 线程数，0 表示自动
+     * @return 作业结果，未设置交易模型或今天无需执行时没有入账
+     */
+    AccrualReport runInterestAccrual(int threads = 0);
+    
     // =========================================
     // === AccountAnalyticsService 对应的方法 ===
     // =========================================
@@ -258,6 +375,14 @@ public:
      * @return 平均每天交易次数
      */
     double getTransactionFrequency(const QString &cardNumber, int days = 30) const;
+    
+    /**
+     * @brief 回测全部余额预测模型并选出默认模型
+     * @param horizonDays 预测天数
+     * @param threads 线程数，0 表示自动
+     * @return 回测报告，分析服务不可用时为空报告
+     */
+    ForecastBacktestReport backtestForecasters(int horizonDays = 7, int threads = 0) const;
 
     /**
      * @brief 获取所有账户列表的变体形式
@@ -287,6 +412,11 @@ public:
     QString getTargetCardHolderName(const QString &targetCardNumber) const;
 
 private:
+    /**
+     * @brief 以存储库中的全部账户重建账户汇总，并交给服务层维护
+     */
+    void attachAggregates();
+    
     //!< 账户存储库
     std::unique_ptr<IAccountRepository> m_repository;
     
@@ -302,6 +432,27 @@ private:
     //!< 账户分析服务
     std::unique_ptr<AccountAnalyticsService> m_analyticsService;
     
+    //!< 定期转账调度器
+    std::unique_ptr<StandingOrderScheduler> m_standingOrders;
+    
     //!< 交易模型
     TransactionModel* m_transactionModel;
+    
+    //!< 时间来源
+    const Clock* m_clock;
+    
+    //!< 全行账户汇总（由 AccountService 和 AdminService 增量更新）
+    AccountAggregates m_aggregates;
+    
+    //!< 计息与收费规则
+    AccrualPolicy m_accrualPolicy;
+    
+    //!< 是否已从账本恢复上次计息和收费的日期
+    bool m_accrualStateLoaded = false;
+    
+    //!< 上次计息日
+    QDate m_lastAccrualDate;
+    
+    //!< 上次扣收管理费的日期
+    QDate m_lastFeeDate;
 };
\ No newline at end of file
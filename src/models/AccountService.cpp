@@ -20,6 +20,7 @@ AccountService::AccountService(IAccountRepository* repository,
     : m_repository(repository)
     , m_validator(validator)
     , m_transactionModel(transactionModel)
+    , m_deduplicator(validator ? validator->clock() : Clock::system())
 {
     // 验证参数
     Q_ASSERT(repository != nullptr);
@@ -35,18 +36,51 @@ AccountService::AccountService(IAccountRepository* repository,
 void AccountService::setTransactionModel(TransactionModel* transactionModel)
 {
     m_transactionModel = transactionModel;
+    
+    // 累计取款计数器和风控状态只保存在内存中，从账本最近30天的记录重建
+    // （累计取款计数器只使用其中最近24小时的部分）
+    if (m_transactionModel) {
+        const QDateTime since = m_validator->clock()->nowUtc().addDays(-30);
+        m_validator->rebuildRecentActivity(m_transactionModel->getTransactionsSince(since));
+    }
+}
+
+/**
+ * @brief 设置全行账户汇总
+ * @param aggregates 账户汇总，为空时不更新
+ */
+void AccountService::setAggregates(AccountAggregates* aggregates)
+{
+    m_aggregates = aggregates;
+}
+
+/**
+ * @brief 设置时间来源
+ * @param clock 时钟，为空时使用系统时钟
+ */
+void AccountService::setClock(const Clock* clock)
+{
+    m_deduplicator.setClock(clock);
 }
 
 /**
  * @brief 执行用户登录
  * @param cardNumber 卡号
  * @param pin PIN码
+ * @param terminalId 终端标识
  * @return 登录结果，包含成功状态和账户信息
  */
-LoginResult AccountService::performLogin(const QString& cardNumber, const QString& pin)
+LoginResult AccountService::performLogin(const QString& cardNumber, const QString& pin,
+                                         const QString& terminalId)
 {
     // 验证凭据
-    OperationResult validationResult = m_validator->validateCredentials(cardNumber, pin);
+    OperationResult validationResult = m_validator->validateCredentials(cardNumber, pin, terminalId);
+    if (m_aggregates) {
+        // 登录失败可能触发临时锁定，成功则解除
+        m_aggregates->setTemporaryLock(cardNumber,
+                                       validationResult.success ? 0 : m_validator->temporaryLockUntilMs(cardNumber),
+                                       m_validator->clock()->utcMs());
+    }
     if (!validationResult.success) {
         return LoginResult::Failure(validationResult.errorMessage);
     }
@@ -80,9 +114,194 @@ LoginResult AccountService::performLogin(const QString& cardNumber, const QStrin
  * @brief 执行取款操作
  * @param cardNumber 卡号
  * @param amount 取款金额
+ * @param requestId 客户端请求编号，为空时不去重
+ * @return 操作结果
+ */
+OperationResult AccountService::withdrawAmount(const QString& cardNumber, double amount,
+                                               const QString& requestId)
+{
+    return runIdempotent(requestId, cardNumber,
+                         QStringLiteral("withdraw|%1").arg(amount, 0, 'f', 2),
+                         [&]() { return doWithdraw(cardNumber, amount); });
+}
+
+/**
+ * @brief 执行存款操作
+ * @param cardNumber 卡号
+ * @param amount 存款金额
+ * @param requestId 客户端请求编号，为空时不去重
+ * @return 操作结果
+ */
+OperationResult AccountService::depositAmount(const QString& cardNumber, double amount,
+                                              const QString& requestId)
+{
+    return runIdempotent(requestId, cardNumber,
+                         QStringLiteral("deposit|%1").arg(amount, 0, 'f', 2),
+                         [&]() { return doDeposit(cardNumber, amount); });
+}
+
+/**
+ * @brief 执行转账操作
+ * @param fromCardNumber 源卡号
+ * @param toCardNumber 目标卡号
+ * @param amount 转账金额
+ * @param requestId 客户端请求编号，为空时不去重
+ * @return 操作结果
+ */
+OperationResult AccountService::transferAmount(const QString& fromCardNumber,
+                                              const QString& toCardNumber,
+                                              double amount,
+                                              const QString& requestId)
+{
+    return runIdempotent(requestId, fromCardNumber,
+                         QStringLiteral("transfer|%1|%2").arg(toCardNumber, QString::number(amount, 'f', 2)),
+                         [&]() { return doTransfer(fromCardNumber, toCardNumber, amount); });
+}
+
+/**
+ * @brief 批量执行转账
+ * @param requests 转账列表（按执行顺序）
+ * @return 与 requests 一一对应的操作结果
+ */
+QVector<OperationResult> AccountService::transferBatch(const QVector<TransferRequest>& requests)
+{
+    QVector<OperationResult> results(requests.size());
+    
+    // 待提交的账户（修改后）及其修改前的状态
+    QHash<QString, Account> pending;
+    QHash<QString, Account> originals;
+    
+    // 待提交的转账及各自完成后的双方余额
+    struct Applied {
+        int index;
+        double fromBalanceAfter;
+        double toBalanceAfter;
+        QString description;
+    };
+    QVector<Applied> applied;
+    
+    auto commit = [&]() {
+        if (applied.isEmpty()) {
+            return;
+        }
+        
+        OperationResult saveResult = m_repository->saveAccountsBatch(QVector<Account>(pending.begin(), pending.end()));
+        if (!saveResult.success) {
+            for (const Applied& transfer : std::as_const(applied)) {
+                results[transfer.index] = saveResult;
+            }
+        } else {
+            if (m_aggregates) {
+                for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+                    m_aggregates->accountUpdated(originals.value(it.key()), it.value());
+                }
+            }
+            if (m_transactionModel) {
+                m_transactionModel->beginBatch();
+            }
+            for (const Applied& transfer : std::as_const(applied)) {
+                const TransferRequest& request = requests.at(transfer.index);
+                m_validator->recordWithdrawal(request.fromCardNumber, request.amount, request.toCardNumber);
+                quint64 transactionId = 0;
+                if (m_transactionModel) {
+                    transactionId = m_transactionModel->recordTransfer(request.fromCardNumber, request.toCardNumber,
+                                                                       request.amount, transfer.fromBalanceAfter,
+                                                                       transfer.toBalanceAfter, transfer.description);
+                }
+                results[transfer.index] = OperationResult::Success(transactionId);
+            }
+            if (m_transactionModel) {
+                m_transactionModel->commitBatch();
+            }
+        }
+        
+        pending.clear();
+        originals.clear();
+        applied.clear();
+    };
+    
+    auto workingCopy = [&](const QString& cardNumber) -> Account& {
+        auto it = pending.find(cardNumber);
+        if (it == pending.end()) {
+            const Account account = m_repository->findByCardNumber(cardNumber).value();
+            originals.insert(cardNumber, account);
+            it = pending.insert(cardNumber, account);
+        }
+        return it.value();
+    };
+    
+    for (int i = 0; i < requests.size(); ++i) {
+        const TransferRequest& request = requests.at(i);
+        
+        // 校验读取的是存储库中的余额和累计限额，源卡号有未提交的修改时先提交
+        if (pending.contains(request.fromCardNumber)) {
+            commit();
+        }
+        
+        OperationResult validationResult = m_validator->validateTransfer(
+            request.fromCardNumber, request.toCardNumber, request.amount);
+        if (!validationResult.success) {
+            results[i] = validationResult;
+            continue;
+        }
+        
+        Account& fromAccount = workingCopy(request.fromCardNumber);
+        fromAccount.balance -= request.amount;
+        const double fromBalanceAfter = fromAccount.balance;
+        
+        Account& toAccount = workingCopy(request.toCardNumber);
+        toAccount.balance += request.amount;
+        
+        applied.append(Applied{
+            i,
+            fromBalanceAfter,
+            toAccount.balance,
+            request.description.isEmpty() ? QString("转账给 %1").arg(toAccount.holderName) : request.description
+        });
+    }
+    commit();
+    
+    return results;
+}
+
+/**
+ * @brief 以请求编号去重执行操作
+ *
+ * 请求编号以发起卡号为作用域，不同卡号可以使用相同的请求编号。
+ *
+ * @param requestId 客户端请求编号，为空时直接执行
+ * @param cardNumber 发起操作的卡号
+ * @param fingerprint 操作参数摘要
+ * @param operation 实际执行的操作
+ * @return 操作结果
+ */
+OperationResult AccountService::runIdempotent(const QString& requestId, const QString& cardNumber,
+                                             const QString& fingerprint,
+                                             const std::function<OperationResult()>& operation)
+{
+    // 未提供请求编号的调用（如本机界面）不经过去重表
+    if (requestId.isEmpty()) {
+        return operation();
+    }
+    
+    const QString key = cardNumber + QLatin1Char('/') + requestId;
+    RequestDeduplicator::Claim claim = m_deduplicator.claim(key, fingerprint);
+    if (claim.status != RequestDeduplicator::Status::Started) {
+        return claim.result;
+    }
+    
+    OperationResult result = operation();
+    m_deduplicator.complete(key, result);
+    return result;
+}
+
+/**
+ * @brief 执行取款操作（不去重）
+ * @param cardNumber 卡号
+ * @param amount 取款金额
  * @return 操作结果
  */
-OperationResult AccountService::withdrawAmount(const QString& cardNumber, double amount)
+OperationResult AccountService::doWithdraw(const QString& cardNumber, double amount)
 {
     // 验证取款操作 - 使用单一验证方法
     OperationResult validationResult = m_validator->validateWithdrawal(cardNumber, amount);
@@ -102,10 +321,16 @@ OperationResult AccountService::withdrawAmount(const QString& cardNumber, double
     if (!saveResult.success) {
         return saveResult;
     }
+    if (m_aggregates) {
+        m_aggregates->accountUpdated(accountOpt.value(), account);
+    }
+    
+    m_validator->recordWithdrawal(cardNumber, amount);
     
-    // 记录取款交易
+    // 记录取款交易，回单打印的是这里返回的编号
+    quint64 transactionId = 0;
     if (m_transactionModel) {
-        m_transactionModel->recordTransaction(
+        transactionId = m_transactionModel->recordTransaction(
             cardNumber,
             TransactionType::Withdrawal,
             amount,
@@ -115,16 +340,16 @@ OperationResult AccountService::withdrawAmount(const QString& cardNumber, double
         );
     }
     
-    return OperationResult::Success();
+    return OperationResult::Success(transactionId);
 }
 
 /**
- * @brief 执行存款操作
+ * @brief 执行存款操作（不去重）
  * @param cardNumber 卡号
  * @param amount 存款金额
  * @return 操作结果
  */
-OperationResult AccountService::depositAmount(const QString& cardNumber, double amount)
+OperationResult AccountService::doDeposit(const QString& cardNumber, double amount)
 {
     // 验证存款操作 - 使用单一验证方法
     OperationResult validationResult = m_validator->validateDeposit(cardNumber, amount);
@@ -144,10 +369,14 @@ OperationResult AccountService::depositAmount(const QString& cardNumber, double
     if (!saveResult.success) {
         return saveResult;
     }
+    if (m_aggregates) {
+        m_aggregates->accountUpdated(accountOpt.value(), account);
+    }
     
-    // 记录存款交易
+    // 记录存款交易，回单打印的是这里返回的编号
+    quint64 transactionId = 0;
     if (m_transactionModel) {
-        m_transactionModel->recordTransaction(
+        transactionId = m_transactionModel->recordTransaction(
             cardNumber,
             TransactionType::Deposit,
             amount,
@@ -157,19 +386,19 @@ OperationResult AccountService::depositAmount(const QString& cardNumber, double
         );
     }
     
-    return OperationResult::Success();
+    return OperationResult::Success(transactionId);
 }
 
 /**
- * @brief 执行转账操作
+ * @brief 执行转账操作（不去重）
  * @param fromCardNumber 源卡号
  * @param toCardNumber 目标卡号
  * @param amount 转账金额
  * @return 操作结果
  */
-OperationResult AccountService::transferAmount(const QString& fromCardNumber, 
-                                              const QString& toCardNumber, 
-                                              double amount)
+OperationResult AccountService::doTransfer(const QString& fromCardNumber,
+                                          const QString& toCardNumber,
+                                          double amount)
 {
     // 验证转账操作 - 使用单一验证方法
     OperationResult validationResult = m_validator->validateTransfer(fromCardNumber, toCardNumber, amount);
@@ -201,31 +430,27 @@ OperationResult AccountService::transferAmount(const QString& fromCardNumber,
         m_repository->saveAccount(fromAccount);
         return saveToResult;
     }
+    if (m_aggregates) {
+        m_aggregates->accountUpdated(fromAccountOpt.value(), fromAccount);
+        m_aggregates->accountUpdated(toAccountOpt.value(), toAccount);
+    }
+    
+    m_validator->recordWithdrawal(fromCardNumber, amount, toCardNumber);
     
-    // 记录转账交易
+    // 记录转账交易：付款方和收款方共用一条双边记录
+    quint64 transactionId = 0;
     if (m_transactionModel) {
-        // 记录源账户的转出交易
-        m_transactionModel->recordTransaction(
+        transactionId = m_transactionModel->recordTransfer(
             fromCardNumber,
-            TransactionType::Transfer,
-            amount,
-            fromAccount.balance,
-            QString("转账给 %1").arg(toAccount.holderName),
-            toCardNumber
-        );
-        
-        // 记录目标账户的转入交易
-        m_transactionModel->recordTransaction(
             toCardNumber,
-            TransactionType::Deposit,
             amount,
+            fromAccount.balance,
             toAccount.balance,
-            QString("来自 %1 的转账").arg(fromAccount.holderName),
-            fromCardNumber
+            QString("转账给 %1").arg(toAccount.holderName)
         );
     }
     
-    return OperationResult::Success();
+    return OperationResult::Success(transactionId);
 }
 
 /**
@@ -323,7 +548,7 @@ bool AccountService::isAccountLocked(const QString& cardNumber) const
     const Account& account = accountOpt.value();
     
     // 检查永久锁定和临时锁定
-    return account.isLocked || account.isTemporarilyLocked();
+    return account.isLocked || m_validator->isTemporarilyLocked(account);
 }
 
 /**
@@ -335,4 +560,14 @@ OperationResult AccountService::validateTargetAccount(const QString& targetCardN
 {
     // 使用验证器验证目标账户
     return m_validator->validateTargetAccount(targetCardNumber);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 检查账户是否存在
+ * @param cardNumber 卡号
+ * @return 如果账户存在返回true
+ */
+bool AccountService::accountExists(const QString& cardNumber) const
+{
+    return m_repository->accountExists(cardNumber);
+}
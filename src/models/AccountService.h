@@ -7,11 +7,25 @@
 #pragma once
 
 #include <QString>
+#include <QVector>
+#include <functional>
 #include "IAccountRepository.h"
 #include "AccountValidator.h"
 #include "TransactionModel.h"
+#include "BankAggregates.h"
 #include "LoginResult.h"
 #include "OperationResult.h"
+#include "RequestDeduplicator.h"
+
+/**
+ * @brief 批量转账中的一笔转账
+ */
+struct TransferRequest {
+    QString fromCardNumber;     //!< 源卡号
+    QString toCardNumber;       //!< 目标卡号
+    double amount = 0.0;        //!< 转账金额
+    QString description;        //!< 付款方一侧的交易描述，为空时使用"转账给 <收款人>"
+};
 
 /**
  * @brief 账户服务类
@@ -37,40 +51,79 @@ public:
      */
     void setTransactionModel(TransactionModel* transactionModel);
     
+    /**
+     * @brief 设置全行账户汇总
+     *
+     * 设置后每次成功修改账户都会同步更新汇总。
+     *
+     * @param aggregates 账户汇总，为空时不更新
+     */
+    void setAggregates(AccountAggregates* aggregates);
+    
+    /**
+     * @brief 设置时间来源（用于请求去重表的过期计算）
+     * @param clock 时钟，为空时使用系统时钟
+     */
+    void setClock(const Clock* clock);
+    
     /**
      * @brief 执行用户登录
      * @param cardNumber 卡号
      * @param pin PIN码
+     * @param terminalId 终端标识，为空时视为本机终端
      * @return 登录结果，包含成功状态和账户信息
      */
-    LoginResult performLogin(const QString& cardNumber, const QString& pin);
+    LoginResult performLogin(const QString& cardNumber, const QString& pin,
+                             const QString& terminalId = QString());
     
     /**
      * @brief 执行取款操作
+     *
+     * 提供请求编号时操作是幂等的：同一卡号下重复的请求编号直接返回首次执行的结果。
+     *
      * @param cardNumber 卡号
      * @param amount 取款金额
-     * @return 操作结果
+     * @param requestId 客户端请求编号，为空时不去重
+     * @return 操作结果，成功时 transactionId 为账本中新交易的编号
      */
-    OperationResult withdrawAmount(const QString& cardNumber, double amount);
+    OperationResult withdrawAmount(const QString& cardNumber, double amount,
+                                   const QString& requestId = QString());
     
     /**
      * @brief 执行存款操作
      * @param cardNumber 卡号
      * @param amount 存款金额
-     * @return 操作结果
+     * @param requestId 客户端请求编号，为空时不去重
+     * @return 操作结果，成功时 transactionId 为账本中新交易的编号
      */
-    OperationResult depositAmount(const QString& cardNumber, double amount);
+    OperationResult depositAmount(const QString& cardNumber, double amount,
+                                  const QString& requestId = QString());
     
     /**
      * @brief 执行转账操作
      * @param fromCardNumber 源卡号
      * @param toCardNumber 目标卡号
      * @param amount 转账金额
-     * @return 操作结果
+     * @param requestId 客户端请求编号，为空时不去重
+     * @return 操作结果，成功时 transactionId 为账本中新交易的编号
      */
     OperationResult transferAmount(const QString& fromCardNumber, 
                                   const QString& toCardNumber, 
-                                  double amount);
+                                  double amount,
+                                  const QString& requestId = QString());
+    
+    /**
+     * @brief 批量执行转账
+     *
+     * 每笔转账的校验与 transferAmount() 相同，但整批的账户余额只通过一次
+     * saveAccountsBatch() 提交，交易记录也只写入一次存储。某笔转账的源卡号
+     * 已被批内之前的转账修改时，先提交之前的部分，保证校验读到的余额是最新的。
+     * 单笔校验失败不影响其他转账。
+     *
+     * @param requests 转账列表（按执行顺序）
+     * @return 与 requests 一一对应的操作结果
+     */
+    QVector<OperationResult> transferBatch(const QVector<TransferRequest>& requests);
     
     /**
      * @brief 修改PIN码
@@ -120,7 +173,41 @@ public:
      */
     OperationResult validateTargetAccount(const QString& targetCardNumber) const;
 
+    /**
+     * @brief 检查账户是否存在
+     * @param cardNumber 卡号
+     * @return 如果账户存在返回true
+     */
+    bool accountExists(const QString& cardNumber) const;
+
 private:
+    /**
+     * @brief 以请求编号去重执行操作
+     * @param requestId 客户端请求编号，为空时直接执行
+     * @param cardNumber 发起操作的卡号（请求编号的作用域）
+     * @param fingerprint 操作参数摘要
+     * @param operation 实际执行的操作
+     * @return 操作结果
+     */
+    OperationResult runIdempotent(const QString& requestId, const QString& cardNumber,
+                                  const QString& fingerprint,
+                                  const std::function<OperationResult()>& operation);
+    
+    /**
+     * @brief 执行取款操作（不去重）
+     */
+    OperationResult doWithdraw(const QString& cardNumber, double amount);
+    
+    /**
+     * @brief 执行存款操作（不去重）
+     */
+    OperationResult doDeposit(const QString& cardNumber, double amount);
+    
+    /**
+     * @brief 执行转账操作（不去重）
+     */
+    OperationResult doTransfer(const QString& fromCardNumber, const QString& toCardNumber, double amount);
+    
     //!< 账户存储库
     IAccountRepository* m_repository;
     
@@ -129,4 +216,10 @@ private:
     
     //!< 交易记录模型
     TransactionModel* m_transactionModel;
+    
+    //!< 全行账户汇总（可为空）
+    AccountAggregates* m_aggregates = nullptr;
+    
+    //!< 请求去重表
+    RequestDeduplicator m_deduplicator;
 }; 
\ No newline at end of file
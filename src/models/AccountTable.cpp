@@ -0,0 +1,183 @@
+/**
+ * @file AccountTable.cpp
+ * @brief 账户列式存储表实现
+ *
+ * 实现了AccountTable类中定义的行维护和账户组装方法。
+ */
+#include "AccountTable.h"
+#include <algorithm>
+#include <numeric>
+
+int AccountTable::size() const
+{
+    return m_cardNumbers.size();
+}
+
+bool AccountTable::isEmpty() const
+{
+    return m_cardNumbers.isEmpty();
+}
+
+void AccountTable::clear()
+{
+    m_index.clear();
+    m_cardNumbers.clear();
+    m_balances.clear();
+    m_withdrawLimits.clear();
+    m_flags.clear();
+    m_failedAttempts.clear();
+    m_lockExpiry.clear();
+    m_cold.clear();
+    m_rowsSorted = true;
+}
+
+void AccountTable::reserve(int capacity)
+{
+    m_index.reserve(capacity);
+    m_cardNumbers.reserve(capacity);
+    m_balances.reserve(capacity);
+    m_withdrawLimits.reserve(capacity);
+    m_flags.reserve(capacity);
+    m_failedAttempts.reserve(capacity);
+    m_lockExpiry.reserve(capacity);
+    m_cold.reserve(capacity);
+}
+
+int AccountTable::indexOf(const QString& cardNumber) const
+{
+    return m_index.value(cardNumber, -1);
+}
+
+bool AccountTable::contains(const QString& cardNumber) const
+{
+    return m_index.contains(cardNumber);
+}
+
+int AccountTable::upsert(const Account& account)
+{
+    const int existing = indexOf(account.cardNumber);
+    if (existing >= 0) {
+        assign(existing, account);
+        return existing;
+    }
+
+    // 新卡号追加到末尾，已有行不移动；按卡号顺序批量加载时行号仍然有序
+    if (!m_cardNumbers.isEmpty() && account.cardNumber < m_cardNumbers.last()) {
+        m_rowsSorted = false;
+    }
+    const int row = m_cardNumbers.size();
+    m_cardNumbers.append(account.cardNumber);
+    m_balances.append(0.0);
+    m_withdrawLimits.append(0.0);
+    m_flags.append(0);
+    m_failedAttempts.append(0);
+    m_lockExpiry.append(0);
+    m_cold.append(ColdData());
+
+    assign(row, account);
+    m_index.insert(account.cardNumber, row);
+    return row;
+}
+
+bool AccountTable::remove(const QString& cardNumber)
+{
+    const int row = indexOf(cardNumber);
+    if (row < 0) {
+        return false;
+    }
+
+    // 最后一行移入空位，只有被移动的卡号需要更新索引
+    m_index.remove(cardNumber);
+    const int last = m_cardNumbers.size() - 1;
+    if (row != last) {
+        moveRow(last, row);
+        m_rowsSorted = false;
+    }
+    m_cardNumbers.removeLast();
+    m_balances.removeLast();
+    m_withdrawLimits.removeLast();
+    m_flags.removeLast();
+    m_failedAttempts.removeLast();
+    m_lockExpiry.removeLast();
+    m_cold.removeLast();
+    return true;
+}
+
+Account AccountTable::account(int row) const
+{
+    const ColdData& cold = m_cold.at(row);
+
+    Account account;
+    account.cardNumber = m_cardNumbers.at(row);
+    account.pinHash = cold.pinHash;
+    account.salt = cold.salt;
+    account.holderName = cold.holderName;
+    account.balance = m_balances.at(row);
+    account.withdrawLimit = m_withdrawLimits.at(row);
+    account.isLocked = hasFlag(row, Locked);
+    account.isAdmin = hasFlag(row, Admin);
+    account.failedLoginAttempts = m_failedAttempts.at(row);
+    account.lastFailedLogin = cold.lastFailedLogin;
+    if (m_lockExpiry.at(row) != 0) {
+        account.temporaryLockTime = QDateTime::fromMSecsSinceEpoch(m_lockExpiry.at(row), Qt::UTC);
+    }
+    return account;
+}
+
+QVector<Account> AccountTable::allAccounts() const
+{
+    QVector<Account> accounts;
+    accounts.reserve(size());
+    for (int row : rowsByCardNumber()) {
+        accounts.append(account(row));
+    }
+    return accounts;
+}
+
+QVector<int> AccountTable::rowsByCardNumber() const
+{
+    QVector<int> rows(size());
+    std::iota(rows.begin(), rows.end(), 0);
+    if (!m_rowsSorted) {
+        std::sort(rows.begin(), rows.end(), [this](int a, int b) {
+            return m_cardNumbers.at(a) < m_cardNumbers.at(b);
+        });
+    }
+    return rows;
+}
+
+double AccountTable::totalBalance() const
+{
+    double total = 0.0;
+    for (double balance : m_balances) {
+        total += balance;
+    }
+    return total;
+}
+
+void AccountTable::assign(int row, const Account& account)
+{
+    m_balances[row] = account.balance;
+    m_withdrawLimits[row] = account.withdrawLimit;
+    m_flags[row] = static_cast<quint8>((account.isLocked ? Locked : 0) | (account.isAdmin ? Admin : 0));
+    m_failedAttempts[row] = account.failedLoginAttempts;
+    m_lockExpiry[row] = account.temporaryLockTime.isValid() ? account.temporaryLockTime.toMSecsSinceEpoch() : 0;
+
+    ColdData& cold = m_cold[row];
+    cold.pinHash = account.pinHash;
+    cold.salt = account.salt;
+    cold.holderName = account.holderName;
+    cold.lastFailedLogin = account.lastFailedLogin;
+}
+
+void AccountTable::moveRow(int from, int to)
+{
+    m_cardNumbers[to] = std::move(m_cardNumbers[from]);
+    m_balances[to] = m_balances.at(from);
+    m_withdrawLimits[to] = m_withdrawLimits.at(from);
+    m_flags[to] = m_flags.at(from);
+    m_failedAttempts[to] = m_failedAttempts.at(from);
+    m_lockExpiry[to] = m_lockExpiry.at(from);
+    m_cold[to] = std::move(m_cold[from]);
+    m_index.insert(m_cardNumbers.at(to), to);
+}
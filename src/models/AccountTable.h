@@ -0,0 +1,189 @@
+/**
+ * @file AccountTable.h
+ * @brief 账户列式存储表
+ *
+ * 以结构数组（struct-of-arrays）方式保存账户：全表扫描常用的数值字段
+ * 各自连续存放，PIN哈希、盐值、姓名等堆数据单独存放，按需组装 Account。
+ */
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <QDateTime>
+#include "Account.h"
+
+/**
+ * @brief 账户列式存储表
+ *
+ * 新账户追加到末尾，删除时用最后一行填补空位，插入和删除都只改动常数个索引项；
+ * 行号因此不保证按卡号排列，需要按卡号顺序时使用 rowsByCardNumber()。
+ * 卡号到行号的映射由哈希索引维护。
+ * 热字段（余额、限额、状态标志、失败次数、临时锁定到期时间）每列一个连续数组，
+ * 全表扫描只需遍历所需的列；冷字段集中存放在 ColdData 中，仅在组装 Account 时访问。
+ */
+class AccountTable {
+public:
+    /**
+     * @brief 账户状态标志位
+     */
+    enum Flag : quint8 {
+        Locked = 0x01,  //!< 账户被锁定
+        Admin = 0x02    //!< 管理员账户
+    };
+
+    /**
+     * @brief 冷字段
+     */
+    struct ColdData {
+        QString pinHash;            //!< PIN 码的哈希值
+        QString salt;               //!< 盐值
+        QString holderName;         //!< 持卡人姓名
+        QDateTime lastFailedLogin;  //!< 最后一次登录失败时间
+    };
+
+    /**
+     * @brief 获取行数
+     * @return 账户数量
+     */
+    int size() const;
+
+    /**
+     * @brief 检查表是否为空
+     * @return 如果没有账户返回true
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief 清空表
+     */
+    void clear();
+
+    /**
+     * @brief 预留容量
+     * @param capacity 预计的账户数量
+     */
+    void reserve(int capacity);
+
+    /**
+     * @brief 查找卡号所在行
+     * @param cardNumber 卡号
+     * @return 行号，未找到时返回-1
+     */
+    int indexOf(const QString& cardNumber) const;
+
+    /**
+     * @brief 检查卡号是否存在
+     * @param cardNumber 卡号
+     * @return 如果存在返回true
+     */
+    bool contains(const QString& cardNumber) const;
+
+    /**
+     * @brief 插入或更新账户
+     *
+     * 已存在的卡号原地覆盖；新卡号追加到末尾。
+     *
+     * @param account 账户
+     * @return 账户所在行号
+     */
+    int upsert(const Account& account);
+
+    /**
+     * @brief 删除账户
+     *
+     * 最后一行移入被删除的行，其他行的行号不变。
+     *
+     * @param cardNumber 卡号
+     * @return 如果账户存在并已删除返回true
+     */
+    bool remove(const QString& cardNumber);
+
+    /**
+     * @brief 按行组装完整的账户对象
+     * @param row 行号
+     * @return 账户对象
+     */
+    Account account(int row) const;
+
+    /**
+     * @brief 按卡号顺序组装全部账户
+     * @return 账户列表（按卡号升序）
+     */
+    QVector<Account> allAccounts() const;
+
+    /**
+     * @brief 获取按卡号升序排列的行号
+     *
+     * 行号本身有序时（按卡号顺序加载且之后只追加更大的卡号、只删除最后一行）直接返回，
+     * 否则按卡号排序一次，代价为 O(N log N)。
+     *
+     * @return 行号列表
+     */
+    QVector<int> rowsByCardNumber() const;
+
+    // 列访问
+    const QVector<QString>& cardNumbers() const { return m_cardNumbers; }       //!< 卡号列
+    const QVector<double>& balances() const { return m_balances; }              //!< 余额列
+    const QVector<double>& withdrawLimits() const { return m_withdrawLimits; }  //!< 取款限额列
+    const QVector<quint8>& flags() const { return m_flags; }                    //!< 状态标志列
+    const QVector<int>& failedAttempts() const { return m_failedAttempts; }     //!< 登录失败次数列
+    const QVector<qint64>& lockExpiry() const { return m_lockExpiry; }          //!< 临时锁定到期时间列（UTC毫秒，0表示未锁定）
+    const QVector<ColdData>& coldData() const { return m_cold; }                //!< 冷字段
+
+    /**
+     * @brief 检查行是否带有指定标志
+     * @param row 行号
+     * @param flag 标志位
+     * @return 如果带有该标志返回true
+     */
+    bool hasFlag(int row, Flag flag) const { return (m_flags.at(row) & flag) != 0; }
+
+    /**
+     * @brief 计算全部账户的余额总和
+     * @return 余额总和
+     */
+    double totalBalance() const;
+
+private:
+    /**
+     * @brief 将账户字段写入指定行
+     * @param row 行号
+     * @param account 账户
+     */
+    void assign(int row, const Account& account);
+
+    /**
+     * @brief 把一行的各列移到另一行，并更新该卡号的索引
+     * @param from 源行号
+     * @param to 目标行号
+     */
+    void moveRow(int from, int to);
+
+    //!< 卡号到行号的索引
+    QHash<QString, int> m_index;
+
+    //!< 卡号列
+    QVector<QString> m_cardNumbers;
+
+    //!< 余额列
+    QVector<double> m_balances;
+
+    //!< 取款限额列
+    QVector<double> m_withdrawLimits;
+
+    //!< 状态标志列
+    QVector<quint8> m_flags;
+
+    //!< 登录失败次数列
+    QVector<int> m_failedAttempts;
+
+    //!< 临时锁定到期时间列（UTC毫秒，0表示未锁定）
+    QVector<qint64> m_lockExpiry;
+
+    //!< 冷字段列
+    QVector<ColdData> m_cold;
+
+    //!< 行号是否按卡号升序
+    bool m_rowsSorted = true;
+};
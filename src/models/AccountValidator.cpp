@@ -6,6 +6,7 @@
  * 实现了AccountValidator类中定义的所有验证方法。
  */
 #include "AccountValidator.h"
+#include "CardNumber.h"
 #include <QDebug>
 
 /**
@@ -14,16 +15,44 @@
  */
 AccountValidator::AccountValidator(IAccountRepository* repository)
     : m_repository(repository)
+    , m_clock(Clock::system())
+    , m_throttle(std::make_unique<LoginThrottle>(m_clock))
+    , m_withdrawalLimits(std::make_unique<WithdrawalLimitTracker>(m_clock))
+    , m_fraudRules(std::make_unique<FraudRuleEngine>(m_clock))
 {
 }
 
+/**
+ * @brief 析构函数
+ */
+AccountValidator::~AccountValidator()
+{
+    if (m_throttle->hasPendingChanges()) {
+        flushLoginFailures();
+    }
+}
+
+/**
+ * @brief 设置时间来源
+ * @param clock 时钟，为空时使用系统时钟
+ */
+void AccountValidator::setClock(const Clock* clock)
+{
+    m_clock = clock ? clock : Clock::system();
+    m_throttle->setClock(m_clock);
+    m_withdrawalLimits->setClock(m_clock);
+    m_fraudRules->setClock(m_clock);
+}
+
 /**
  * @brief 验证账户凭据
  * @param cardNumber 卡号
  * @param pin PIN码
+ * @param terminalId 终端标识
  * @return 操作结果
  */
-OperationResult AccountValidator::validateCredentials(const QString& cardNumber, const QString& pin) const
+OperationResult AccountValidator::validateCredentials(const QString& cardNumber, const QString& pin,
+                                                      const QString& terminalId) const
 {
     // 验证输入参数
     if (cardNumber.isEmpty()) {
@@ -40,15 +69,21 @@ OperationResult AccountValidator::validateCredentials(const QString& cardNumber,
         return cardNumberResult;
     }
 
+    // 终端尝试额度耗尽时不再校验PIN
+    if (!m_throttle->allowTerminal(terminalId)) {
+        qDebug() << "验证失败: 终端尝试过于频繁:" << terminalId;
+        return OperationResult::Failure("尝试次数过多，请稍后再试");
+    }
+
     // 查找账户
     std::optional<Account> accountOpt = m_repository->findByCardNumber(cardNumber);
     if (!accountOpt) {
         qDebug() << "验证失败: 卡号不存在:" << cardNumber;
+        m_throttle->recordTerminalFailure(terminalId);
         return OperationResult::Failure("卡号或PIN码错误");
     }
 
-    // 获取可修改的账户副本
-    Account account = accountOpt.value();
+    const Account& account = accountOpt.value();
     
     // 检查账户是否被永久锁定
     if (account.isLocked) {
@@ -57,9 +92,8 @@ OperationResult AccountValidator::validateCredentials(const QString& cardNumber,
     }
     
     // 检查账户是否被临时锁定
-    if (account.isTemporarilyLocked()) {
-        qDebug() << "验证失败: 账户已临时锁定:" << cardNumber 
-                 << "锁定至:" << account.temporaryLockTime.toString();
+    if (m_throttle->isCardLocked(account)) {
+        qDebug() << "验证失败: 账户已临时锁定:" << cardNumber;
         
         return OperationResult::Failure(
             QString("由于多次登录失败，账户已临时锁定，请%1分钟后再试")
@@ -71,13 +105,13 @@ OperationResult AccountValidator::validateCredentials(const QString& cardNumber,
     qDebug() << "PIN验证结果:" << pinMatches << "卡号:" << cardNumber;
     
     if (!pinMatches) {
-        // 记录登录失败
-        bool lockedNow = account.recordFailedLogin();
-        
-        // 保存更新后的账户状态
-        m_repository->saveAccount(account);
+        // 记录登录失败（仅更新内存，触发锁定时才写回）
+        LoginThrottle::FailureOutcome outcome = m_throttle->recordFailure(account, terminalId);
+        if (m_throttle->hasUrgentChanges()) {
+            flushLoginFailures();
+        }
         
-        if (lockedNow) {
+        if (outcome.lockedNow) {
             return OperationResult::Failure(
                 QString("PIN码错误，由于多次登录失败，账户已临时锁定，请%1分钟后再试")
                     .arg(Account::TEMP_LOCK_DURATION));
@@ -85,28 +119,69 @@ OperationResult AccountValidator::validateCredentials(const QString& cardNumber,
         
         return OperationResult::Failure(
             QString("卡号或PIN码错误，剩余尝试次数: %1")
-                .arg(Account::MAX_FAILED_ATTEMPTS - account.failedLoginAttempts));
+                .arg(Account::MAX_FAILED_ATTEMPTS - outcome.failedAttempts));
     }
     
-    // 登录成功，重置失败计数
-    if (account.failedLoginAttempts > 0) {
-        account.resetFailedLoginAttempts();
-        m_repository->saveAccount(account);
+    // 登录成功，清除失败计数（之前有失败记录时才需要写回）
+    m_throttle->recordSuccess(account);
+    if (m_throttle->hasUrgentChanges()) {
+        flushLoginFailures();
     }
     
     return OperationResult::Success();
 }
 
+/**
+ * @brief 检查账户是否处于临时锁定
+ * @param account 账户
+ * @return 如果临时锁定返回true
+ */
+bool AccountValidator::isTemporarilyLocked(const Account& account) const
+{
+    return m_throttle->isCardLocked(account);
+}
+
+/**
+ * @brief 获取卡号的临时锁定到期时间
+ * @param cardNumber 卡号
+ * @return 到期时间（UTC毫秒），账户不存在或从未锁定时为0
+ */
+qint64 AccountValidator::temporaryLockUntilMs(const QString& cardNumber) const
+{
+    std::optional<Account> accountOpt = m_repository->findByCardNumber(cardNumber);
+    return accountOpt ? m_throttle->lockedUntilMs(accountOpt.value()) : 0;
+}
+
+/**
+ * @brief 清除卡号在限流表中的状态
+ * @param cardNumber 卡号
+ */
+void AccountValidator::clearLoginFailures(const QString& cardNumber) const
+{
+    m_throttle->forget(cardNumber);
+}
+
+/**
+ * @brief 将限流表中尚未写回的状态写入存储库
+ * @return 操作结果
+ */
+OperationResult AccountValidator::flushLoginFailures() const
+{
+    return m_throttle->flush(m_repository);
+}
+
 /**
  * @brief 验证管理员登录
  * @param cardNumber 卡号
  * @param pin PIN码
+ * @param terminalId 终端标识
  * @return 操作结果
  */
-OperationResult AccountValidator::validateAdminLogin(const QString& cardNumber, const QString& pin) const
+OperationResult AccountValidator::validateAdminLogin(const QString& cardNumber, const QString& pin,
+                                                     const QString& terminalId) const
 {
     // 首先验证基本凭据
-    OperationResult credResult = validateCredentials(cardNumber, pin);
+    OperationResult credResult = validateCredentials(cardNumber, pin, terminalId);
     if (!credResult.success) {
         return credResult;
     }
@@ -162,7 +237,7 @@ OperationResult AccountValidator::validateAccountNotLocked(const QString& cardNu
     }
     
     // 检查账户是否被临时锁定
-    if (account.isTemporarilyLocked()) {
+    if (m_throttle->isCardLocked(account)) {
         return OperationResult::Failure(
             QString("由于多次登录失败，账户已临时锁定，请%1分钟后再试")
                 .arg(Account::TEMP_LOCK_DURATION));
@@ -227,6 +302,62 @@ OperationResult AccountValidator::validateWithdrawLimit(const QString& cardNumbe
     return OperationResult::Success();
 }
 
+/**
+ * @brief 验证每小时和每日累计取款限额
+ * @param cardNumber 卡号
+ * @param amount 本次金额
+ * @return 操作结果
+ */
+OperationResult AccountValidator::validateCumulativeWithdrawLimit(const QString& cardNumber, double amount) const
+{
+    std::optional<Account> accountOpt = m_repository->findByCardNumber(cardNumber);
+    if (!accountOpt) {
+        return OperationResult::Failure("账户不存在");
+    }
+    
+    // 计数器只推进窗口并读取合计，与交易量无关
+    return m_withdrawalLimits->check(accountOpt.value(), amount);
+}
+
+/**
+ * @brief 按风控规则评估取款或转账
+ * @param cardNumber 卡号
+ * @param type 交易类型
+ * @param amount 金额
+ * @param targetCard 收款卡号（转账时有效）
+ * @return 操作结果
+ */
+OperationResult AccountValidator::validateFraudRules(const QString& cardNumber, TransactionType type,
+                                                     double amount, const QString& targetCard) const
+{
+    return m_fraudRules->evaluate(cardNumber, type, amount, targetCard);
+}
+
+/**
+ * @brief 记录一笔成功的取款或转出，计入累计限额和风控状态
+ * @param cardNumber 卡号
+ * @param amount 金额
+ * @param targetCard 收款卡号，为空表示现金取款
+ */
+void AccountValidator::recordWithdrawal(const QString& cardNumber, double amount,
+                                        const QString& targetCard) const
+{
+    m_withdrawalLimits->record(cardNumber, amount);
+    m_fraudRules->record(cardNumber,
+                         targetCard.isEmpty() ? TransactionType::Withdrawal : TransactionType::Transfer,
+                         amount, targetCard);
+}
+
+/**
+ * @brief 从账本重建累计取款计数器和风控状态
+ * @param transactions 近期交易记录（按时间顺序）
+ */
+void AccountValidator::rebuildRecentActivity(const QVector<Transaction>& transactions) const
+{
+    m_withdrawalLimits->rebuild(transactions);
+    m_fraudRules->rebuild(transactions);
+}
+
 /**
  * @brief 通用验证方法，按顺序执行多个验证步骤
  * @param validations 验证函数列表
@@ -278,6 +409,14 @@ OperationResult AccountValidator::validateWithdrawal(const QString& cardNumber,
         [this, cardNumber, amount]() {
             return validateWithdrawLimit(cardNumber, amount);
         },
+        // 验证累计取款限额
+        [this, cardNumber, amount]() {
+            return validateCumulativeWithdrawLimit(cardNumber, amount);
+        },
+        // 风控规则
+        [this, cardNumber, amount]() {
+            return validateFraudRules(cardNumber, TransactionType::Withdrawal, amount);
+        },
         // 验证余额是否足够
         [this, cardNumber, amount]() {
             return validateSufficientBalance(cardNumber, amount);
@@ -364,6 +503,14 @@ OperationResult AccountValidator::validateTransfer(const QString& fromCardNumber
         [this, toCardNumber]() {
             return validateAccountNotLocked(toCardNumber);
         },
+        // 验证累计取款限额（转出与取款合并计算）
+        [this, fromCardNumber, amount]() {
+            return validateCumulativeWithdrawLimit(fromCardNumber, amount);
+        },
+        // 风控规则
+        [this, fromCardNumber, toCardNumber, amount]() {
+            return validateFraudRules(fromCardNumber, TransactionType::Transfer, amount, toCardNumber);
+        },
         // 验证源账户余额是否足够
         [this, fromCardNumber, amount]() {
             return validateSufficientBalance(fromCardNumber, amount);
@@ -481,9 +628,9 @@ OperationResult AccountValidator::validateCreateAccount(const QString& cardNumbe
 {
     // 使用通用验证方法，构建验证步骤序列
     return validateOperation({
-        // 验证卡号格式
+        // 验证卡号格式和校验位
         [this, cardNumber]() {
-            return validateCardNumberFormat(cardNumber);
+            return validateNewCardNumber(cardNumber);
         },
         // 验证卡号是否已存在
         [this, cardNumber]() {
@@ -586,6 +733,26 @@ OperationResult AccountValidator::validateCardNumberFormat(const QString& cardNu
     return OperationResult::Success();
 }
 
+/**
+ * @brief 验证新开卡号的格式和Luhn校验位
+ * @param cardNumber 卡号
+ * @return 操作结果
+ */
+OperationResult AccountValidator::validateNewCardNumber(const QString& cardNumber) const
+{
+    // 一次解析同时得到格式和校验位结果
+    const CardNumber::Parsed parsed = CardNumber::parse(cardNumber);
+    if (!parsed.wellFormed) {
+        return OperationResult::Failure("卡号格式无效，必须为16位数字");
+    }
+    
+    if (!parsed.luhnValid) {
+        return OperationResult::Failure("卡号校验位无效");
+    }
+    
+    return OperationResult::Success();
+}
+
 /**
  * @brief 验证目标账户
  * @param targetCardNumber 目标卡号
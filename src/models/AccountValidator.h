@@ -11,6 +11,11 @@
 #include <vector>
 #include "IAccountRepository.h"
 #include "OperationResult.h"
+#include "Clock.h"
+#include "LoginThrottle.h"
+#include "WithdrawalLimitTracker.h"
+#include "FraudRuleEngine.h"
+#include <memory>
 
 /**
  * @brief 账户验证器类
@@ -26,21 +31,98 @@ public:
      */
     explicit AccountValidator(IAccountRepository* repository);
     
+    /**
+     * @brief 析构函数
+     *
+     * 将尚未写回的登录失败状态写入存储库。
+     */
+    ~AccountValidator();
+    
+    /**
+     * @brief 设置时间来源
+     * @param clock 时钟，为空时使用系统时钟
+     */
+    void setClock(const Clock* clock);
+    
+    /**
+     * @brief 获取时间来源
+     * @return 时钟
+     */
+    const Clock* clock() const { return m_clock; }
+    
     /**
      * @brief 验证账户凭据
+     *
+     * 登录失败次数和临时锁定由内存中的限流表维护，PIN错误不会立即写文件；
+     * 触发锁定或成功登录清除计数时才批量写回。
+     *
      * @param cardNumber 卡号
      * @param pin PIN码
+     * @param terminalId 终端标识，为空时视为本机终端
      * @return 操作结果
      */
-    OperationResult validateCredentials(const QString& cardNumber, const QString& pin) const;
+    OperationResult validateCredentials(const QString& cardNumber, const QString& pin,
+                                        const QString& terminalId = QString()) const;
     
     /**
      * @brief 验证管理员登录
      * @param cardNumber 卡号
      * @param pin PIN码
+     * @param terminalId 终端标识，为空时视为本机终端
+     * @return 操作结果
+     */
+    OperationResult validateAdminLogin(const QString& cardNumber, const QString& pin,
+                                       const QString& terminalId = QString()) const;
+    
+    /**
+     * @brief 检查账户是否处于临时锁定
+     * @param account 账户
+     * @return 如果临时锁定返回true
+     */
+    bool isTemporarilyLocked(const Account& account) const;
+    
+    /**
+     * @brief 获取卡号的临时锁定到期时间
+     * @param cardNumber 卡号
+     * @return 到期时间（UTC毫秒），账户不存在或从未锁定时为0
+     */
+    qint64 temporaryLockUntilMs(const QString& cardNumber) const;
+    
+    /**
+     * @brief 清除卡号在限流表中的状态
+     *
+     * 管理员解锁、重置PIN或删除账户后调用，之后以存储库中的数据为准。
+     *
+     * @param cardNumber 卡号
+     */
+    void clearLoginFailures(const QString& cardNumber) const;
+    
+    /**
+     * @brief 将限流表中尚未写回的状态写入存储库
      * @return 操作结果
      */
-    OperationResult validateAdminLogin(const QString& cardNumber, const QString& pin) const;
+    OperationResult flushLoginFailures() const;
+    
+    /**
+     * @brief 记录一笔成功的取款或转出，计入累计限额和风控状态
+     * @param cardNumber 卡号
+     * @param amount 金额
+     * @param targetCard 收款卡号，为空表示现金取款
+     */
+    void recordWithdrawal(const QString& cardNumber, double amount,
+                          const QString& targetCard = QString()) const;
+    
+    /**
+     * @brief 从账本重建累计取款计数器和风控状态
+     * @param transactions 近期交易记录（按时间顺序）
+     */
+    void rebuildRecentActivity(const QVector<Transaction>& transactions) const;
+    
+    /**
+     * @brief 获取风控规则引擎（用于添加自定义规则）
+     * @return 规则引擎
+     */
+    FraudRuleEngine* fraudRules() const { return m_fraudRules.get(); }
     
     /**
      * @brief 验证取款操作
@@ -140,6 +222,16 @@ public:
      */
     OperationResult validateCardNumberFormat(const QString& cardNumber) const;
     
+    /**
+     * @brief 验证新开卡号的格式和Luhn校验位
+     *
+     * 只用于开户；已有账户的卡号（包括测试账户）不要求通过校验位检查。
+     *
+     * @param cardNumber 卡号
+     * @return 操作结果
+     */
+    OperationResult validateNewCardNumber(const QString& cardNumber) const;
+    
     /**
      * @brief 验证账户是否存在
      * @param cardNumber 卡号
@@ -170,6 +262,25 @@ public:
      */
     OperationResult validateWithdrawLimit(const QString& cardNumber, double amount) const;
     
+    /**
+     * @brief 验证每小时和每日累计取款限额（取款和转出合计）
+     * @param cardNumber 卡号
+     * @param amount 本次金额
+     * @return 操作结果
+     */
+    OperationResult validateCumulativeWithdrawLimit(const QString& cardNumber, double amount) const;
+    
+    /**
+     * @brief 按风控规则评估取款或转账
+     * @param cardNumber 卡号
+     * @param type 交易类型
+     * @param amount 金额
+     * @param targetCard 收款卡号（转账时有效）
+     * @return 操作结果
+     */
+    OperationResult validateFraudRules(const QString& cardNumber, TransactionType type,
+                                       double amount, const QString& targetCard = QString()) const;
+    
     /**
      * @brief 验证金额是否为100的倍数
      * @param amount 金额
@@ -202,4 +313,16 @@ private:
     
     //!< 账户存储库接口指针
     IAccountRepository* m_repository;
+    
+    //!< 时间来源
+    const Clock* m_clock;
+    
+    //!< 登录限流表（验证方法为const，限流状态属于可变的缓存）
+    std::unique_ptr<LoginThrottle> m_throttle;
+    
+    //!< 累计取款计数器（同样属于可变的缓存）
+    std::unique_ptr<WithdrawalLimitTracker> m_withdrawalLimits;
+    
+    //!< 风控规则引擎（每卡滑动窗口状态同样属于可变的缓存）
+    std::unique_ptr<FraudRuleEngine> m_fraudRules;
 }; 
\ No newline at end of file
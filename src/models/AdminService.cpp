@@ -32,16 +32,32 @@ void AdminService::setTransactionModel(TransactionModel* transactionModel)
     m_transactionModel = transactionModel;
 }
 
+/**
+ * @brief 设置全行账户汇总
+ * @param aggregates 账户汇总，为空时不更新
+ */
+void AdminService::setAggregates(AccountAggregates* aggregates)
+{
+    m_aggregates = aggregates;
+}
+
 /**
  * @brief 执行管理员登录
  * @param cardNumber 卡号
  * @param pin PIN码
+ * @param terminalId 终端标识
  * @return 登录结果，包含成功状态和账户信息
  */
-LoginResult AdminService::performAdminLogin(const QString& cardNumber, const QString& pin)
+LoginResult AdminService::performAdminLogin(const QString& cardNumber, const QString& pin,
+                                            const QString& terminalId)
 {
     // 验证管理员账户凭据
-    OperationResult validationResult = m_validator->validateAdminLogin(cardNumber, pin);
+    OperationResult validationResult = m_validator->validateAdminLogin(cardNumber, pin, terminalId);
+    if (m_aggregates) {
+        // 凭据错误可能触发临时锁定；凭据正确（包括非管理员账户被拒绝）则已解除
+        m_aggregates->setTemporaryLock(cardNumber, m_validator->temporaryLockUntilMs(cardNumber),
+                                       m_validator->clock()->utcMs());
+    }
     if (!validationResult.success) {
         return LoginResult::Failure(validationResult.errorMessage);
     }
@@ -99,6 +115,9 @@ OperationResult AdminService::createAccount(const QString& cardNumber,
     if (!saveResult.success) {
         return saveResult;
     }
+    if (m_aggregates) {
+        m_aggregates->accountAdded(newAccount, m_validator->clock()->utcMs());
+    }
     
     // 记录创建账户操作
     logAdminOperation("", "创建账户", cardNumber, 
@@ -144,6 +163,9 @@ OperationResult AdminService::updateAccount(const QString& cardNumber,
     if (!saveResult.success) {
         return saveResult;
     }
+    if (m_aggregates) {
+        m_aggregates->accountUpdated(accountOpt.value(), account);
+    }
     
     // 记录更新账户操作
     logAdminOperation("", "更新账户", cardNumber, 
@@ -179,6 +201,10 @@ OperationResult AdminService::deleteAccount(const QString& cardNumber)
     if (!deleteResult.success) {
         return deleteResult;
     }
+    m_validator->clearLoginFailures(cardNumber);
+    if (m_aggregates) {
+        m_aggregates->accountRemoved(account);
+    }
     
     // 如果有交易记录模型，清除相关交易记录
     if (m_transactionModel) {
@@ -229,6 +255,18 @@ OperationResult AdminService::setAccountLockStatus(const QString& cardNumber, bo
         return saveResult;
     }
     
+    if (m_aggregates) {
+        m_aggregates->accountUpdated(accountOpt.value(), account);
+    }
+    
+    // 解锁后以存储库中已清除的状态为准
+    if (!locked) {
+        m_validator->clearLoginFailures(cardNumber);
+        if (m_aggregates) {
+            m_aggregates->setTemporaryLock(cardNumber, 0, m_validator->clock()->utcMs());
+        }
+    }
+    
     // 记录锁定/解锁操作
     QString operationType = locked ? "锁定账户" : "解锁账户";
     logAdminOperation("", operationType, cardNumber, 
@@ -272,6 +310,10 @@ OperationResult AdminService::resetPin(const QString& cardNumber, const QString&
     if (!saveResult.success) {
         return saveResult;
     }
+    m_validator->clearLoginFailures(cardNumber);
+    if (m_aggregates) {
+        m_aggregates->setTemporaryLock(cardNumber, 0, m_validator->clock()->utcMs());
+    }
     
     // 记录重置PIN码操作
     logAdminOperation("", "重置安全信息", cardNumber, 
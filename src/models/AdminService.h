@@ -11,6 +11,7 @@
 #include "IAccountRepository.h"
 #include "AccountValidator.h"
 #include "TransactionModel.h"
+#include "BankAggregates.h"
 #include "LoginResult.h"
 #include "OperationResult.h"
 
@@ -38,13 +39,24 @@ public:
      */
     void setTransactionModel(TransactionModel* transactionModel);
     
+    /**
+     * @brief 设置全行账户汇总
+     *
+     * 设置后每次成功修改账户都会同步更新汇总。
+     *
+     * @param aggregates 账户汇总，为空时不更新
+     */
+    void setAggregates(AccountAggregates* aggregates);
+    
     /**
      * @brief 执行管理员登录
      * @param cardNumber 卡号
      * @param pin PIN码
+     * @param terminalId 终端标识，为空时视为本机终端
      * @return 登录结果，包含成功状态和账户信息
      */
-    LoginResult performAdminLogin(const QString& cardNumber, const QString& pin);
+    LoginResult performAdminLogin(const QString& cardNumber, const QString& pin,
+                                  const QString& terminalId = QString());
     
     /**
      * @brief 创建新账户
@@ -143,4 +155,7 @@ private:
     
     //!< 交易记录模型
     TransactionModel* m_transactionModel;
+    
+    //!< 全行账户汇总（可为空）
+    AccountAggregates* m_aggregates = nullptr;
 }; 
\ No newline at end of file
@@ -0,0 +1,237 @@
+/**
+ * @file BalanceForecasters.cpp
+ * @brief 内置余额预测模型实现
+ *
+ * 实现了BalanceForecasters.h中定义的各个预测模型。
+ */
+#include "BalanceForecasters.h"
+#include <algorithm>
+#include <array>
+
+namespace {
+
+/**
+ * @brief 生成不带区间的预测结果（余额不会为负）
+ * @param balance 预测余额
+ * @return 预测结果
+ */
+BalanceForecast pointForecast(double balance)
+{
+    const double clamped = qMax(0.0, balance);
+    return BalanceForecast{clamped, clamped, clamped};
+}
+
+/**
+ * @brief 计算已排序数据的分位数（相邻两项线性插值）
+ * @param sorted 升序数据（不能为空）
+ * @param quantile 分位数（0-1）
+ * @return 分位数值
+ */
+double quantileOf(const QVector<double>& sorted, double quantile)
+{
+    const double position = qBound(0.0, quantile, 1.0) * (sorted.size() - 1);
+    const int below = int(position);
+    const int above = qMin(below + 1, int(sorted.size()) - 1);
+    const double fraction = position - below;
+    return sorted.at(below) + (sorted.at(above) - sorted.at(below)) * fraction;
+}
+
+} // namespace
+
+WeightedAverageForecaster::WeightedAverageForecaster(int window, double decay)
+    : m_window(qMax(1, window))
+    , m_decay(qMax(0.0, decay))
+{
+}
+
+QString WeightedAverageForecaster::name() const
+{
+    return "WeightedAverage";
+}
+
+int WeightedAverageForecaster::minimumHistory() const
+{
+    return 2;
+}
+
+BalanceForecast WeightedAverageForecaster::forecast(const BalanceHistory& history, int count, int daysAhead) const
+{
+    const QVector<double>& y = history.balances;
+    const int start = qMax(1, count - m_window);
+
+    double weightedChange = 0.0;
+    double totalWeight = 0.0;
+    for (int i = count - 1; i >= start; --i) {
+        const double weight = 1.0 / (1.0 + m_decay * (count - 1 - i));
+        weightedChange += (y.at(i) - y.at(i - 1)) * weight;
+        totalWeight += weight;
+    }
+
+    const double dailyChange = totalWeight > 0 ? weightedChange / totalWeight : 0.0;
+    return pointForecast(y.at(count - 1) + dailyChange * daysAhead);
+}
+
+LinearRegressionForecaster::LinearRegressionForecaster(int window)
+    : m_window(qMax(2, window))
+{
+}
+
+QString LinearRegressionForecaster::name() const
+{
+    return "LinearRegression";
+}
+
+int LinearRegressionForecaster::minimumHistory() const
+{
+    return 5;
+}
+
+BalanceForecast LinearRegressionForecaster::forecast(const BalanceHistory& history, int count, int daysAhead) const
+{
+    const QVector<double>& y = history.balances;
+    const int points = qMin(count, m_window);
+    const int base = count - points;
+
+    // x 为窗口内的天序号（0 到 points - 1）
+    double sumX = 0.0;
+    double sumY = 0.0;
+    double sumXY = 0.0;
+    double sumXX = 0.0;
+    for (int x = 0; x < points; ++x) {
+        const double value = y.at(base + x);
+        sumX += x;
+        sumY += value;
+        sumXY += x * value;
+        sumXX += double(x) * x;
+    }
+
+    const double denominator = points * sumXX - sumX * sumX;
+    if (denominator == 0.0) {
+        return pointForecast(y.at(count - 1));
+    }
+    const double slope = (points * sumXY - sumX * sumY) / denominator;
+    const double intercept = (sumY - slope * sumX) / points;
+    return pointForecast(intercept + slope * (points - 1 + daysAhead));
+}
+
+EwmaForecaster::EwmaForecaster(double alpha, int window)
+    : m_alpha(qBound(0.01, alpha, 1.0))
+    , m_window(qMax(1, window))
+{
+}
+
+QString EwmaForecaster::name() const
+{
+    return "Ewma";
+}
+
+int EwmaForecaster::minimumHistory() const
+{
+    return 2;
+}
+
+BalanceForecast EwmaForecaster::forecast(const BalanceHistory& history, int count, int daysAhead) const
+{
+    const QVector<double>& y = history.balances;
+    const int start = qMax(1, count - m_window);
+
+    double smoothed = y.at(start) - y.at(start - 1);
+    for (int i = start + 1; i < count; ++i) {
+        smoothed = m_alpha * (y.at(i) - y.at(i - 1)) + (1.0 - m_alpha) * smoothed;
+    }
+    return pointForecast(y.at(count - 1) + smoothed * daysAhead);
+}
+
+HoltWintersForecaster::HoltWintersForecaster(double alpha, double beta, double gamma)
+    : m_alpha(qBound(0.0, alpha, 1.0))
+    , m_beta(qBound(0.0, beta, 1.0))
+    , m_gamma(qBound(0.0, gamma, 1.0))
+{
+}
+
+QString HoltWintersForecaster::name() const
+{
+    return "HoltWinters";
+}
+
+int HoltWintersForecaster::minimumHistory() const
+{
+    return SEASON_LENGTH * 2;
+}
+
+BalanceForecast HoltWintersForecaster::forecast(const BalanceHistory& history, int count, int daysAhead) const
+{
+    const QVector<double>& y = history.balances;
+
+    // 用前两周初始化：水平为第一周均值，趋势为两周均值之差的日均值，季节项为第一周各天相对均值的偏差
+    double firstMean = 0.0;
+    double secondMean = 0.0;
+    for (int i = 0; i < SEASON_LENGTH; ++i) {
+        firstMean += y.at(i);
+        secondMean += y.at(SEASON_LENGTH + i);
+    }
+    firstMean /= SEASON_LENGTH;
+    secondMean /= SEASON_LENGTH;
+
+    std::array<double, SEASON_LENGTH> seasonal;
+    for (int i = 0; i < SEASON_LENGTH; ++i) {
+        seasonal[i] = y.at(i) - firstMean;
+    }
+    double level = firstMean;
+    double trend = (secondMean - firstMean) / SEASON_LENGTH;
+
+    // 季节项按距序列起点的天数取模，与星期几一一对应
+    for (int t = SEASON_LENGTH; t < count; ++t) {
+        double& season = seasonal[t % SEASON_LENGTH];
+        const double previousLevel = level;
+        level = m_alpha * (y.at(t) - season) + (1.0 - m_alpha) * (level + trend);
+        trend = m_beta * (level - previousLevel) + (1.0 - m_beta) * trend;
+        season = m_gamma * (y.at(t) - level) + (1.0 - m_gamma) * season;
+    }
+
+    const int target = count - 1 + daysAhead;
+    return pointForecast(level + trend * daysAhead + seasonal[target % SEASON_LENGTH]);
+}
+
+QuantileBandForecaster::QuantileBandForecaster(double lowerQuantile, double upperQuantile, int window)
+    : m_lowerQuantile(qBound(0.0, qMin(lowerQuantile, upperQuantile), 1.0))
+    , m_upperQuantile(qBound(0.0, qMax(lowerQuantile, upperQuantile), 1.0))
+    , m_window(qMax(2, window))
+{
+}
+
+QString QuantileBandForecaster::name() const
+{
+    return "QuantileBand";
+}
+
+int QuantileBandForecaster::minimumHistory() const
+{
+    return 2;
+}
+
+BalanceForecast QuantileBandForecaster::forecast(const BalanceHistory& history, int count, int daysAhead) const
+{
+    const QVector<double>& y = history.balances;
+    const int start = qMax(0, count - m_window);
+
+    // 窗口内所有跨度为 daysAhead 天的余额变化
+    QVector<double> changes;
+    for (int i = start; i + daysAhead < count; ++i) {
+        changes.append(y.at(i + daysAhead) - y.at(i));
+    }
+    // 历史比预测跨度还短：用每日变化按天数放大
+    if (changes.isEmpty()) {
+        for (int i = qMax(1, start); i < count; ++i) {
+            changes.append((y.at(i) - y.at(i - 1)) * daysAhead);
+        }
+    }
+    std::sort(changes.begin(), changes.end());
+
+    const double last = y.at(count - 1);
+    BalanceForecast result;
+    result.balance = qMax(0.0, last + quantileOf(changes, 0.5));
+    result.lower = qMax(0.0, last + quantileOf(changes, m_lowerQuantile));
+    result.upper = qMax(0.0, last + quantileOf(changes, m_upperQuantile));
+    return result;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file BalanceForecasters.h
+ * @brief 内置余额预测模型
+ *
+ * 定义了加权平均、线性回归、指数加权移动平均、Holt-Winters 和分位数区间五个内置预测模型。
+ */
+#pragma once
+
+#include "IBalanceForecaster.h"
+
+/**
+ * @brief 加权平均模型
+ *
+ * 对最近若干天的每日余额变化做加权平均（越近权重越高，权重为 1 / (1 + decay × 距今天数)），
+ * 作为未来每天的变化量。
+ */
+class WeightedAverageForecaster : public IBalanceForecaster {
+public:
+    /**
+     * @brief 构造函数
+     * @param window 参与平均的最近天数
+     * @param decay 权重衰减系数
+     */
+    WeightedAverageForecaster(int window, double decay);
+
+    QString name() const override;
+    int minimumHistory() const override;
+    BalanceForecast forecast(const BalanceHistory& history, int count, int daysAhead) const override;
+
+private:
+    int m_window;       //!< 参与平均的最近天数
+    double m_decay;     //!< 权重衰减系数
+};
+
+/**
+ * @brief 线性回归模型
+ *
+ * 对最近若干天的日终余额做最小二乘直线拟合，沿直线外推。
+ */
+class LinearRegressionForecaster : public IBalanceForecaster {
+public:
+    /**
+     * @brief 构造函数
+     * @param window 参与拟合的最近天数
+     */
+    explicit LinearRegressionForecaster(int window);
+
+    QString name() const override;
+    int minimumHistory() const override;
+    BalanceForecast forecast(const BalanceHistory& history, int count, int daysAhead) const override;
+
+private:
+    int m_window;       //!< 参与拟合的最近天数
+};
+
+/**
+ * @brief 指数加权移动平均（EWMA）模型
+ *
+ * 对每日余额变化做指数平滑，平滑后的变化量作为未来每天的变化量。
+ */
+class EwmaForecaster : public IBalanceForecaster {
+public:
+    /**
+     * @brief 构造函数
+     * @param alpha 平滑系数（0-1，越大越偏重近期）
+     * @param window 参与平滑的最近天数
+     */
+    EwmaForecaster(double alpha, int window);
+
+    QString name() const override;
+    int minimumHistory() const override;
+    BalanceForecast forecast(const BalanceHistory& history, int count, int daysAhead) const override;
+
+private:
+    double m_alpha;     //!< 平滑系数
+    int m_window;       //!< 参与平滑的最近天数
+};
+
+/**
+ * @brief Holt-Winters 加法模型（周季节性）
+ *
+ * 同时平滑水平、趋势和按星期几的季节项，适合工资日、周末消费等按周重复的收支。
+ * 用前两周初始化，至少需要两个完整周期。
+ */
+class HoltWintersForecaster : public IBalanceForecaster {
+public:
+    //!< 季节周期（天）
+    static const int SEASON_LENGTH = 7;
+
+    /**
+     * @brief 构造函数
+     * @param alpha 水平平滑系数
+     * @param beta 趋势平滑系数
+     * @param gamma 季节平滑系数
+     */
+    HoltWintersForecaster(double alpha, double beta, double gamma);
+
+    QString name() const override;
+    int minimumHistory() const override;
+    BalanceForecast forecast(const BalanceHistory& history, int count, int daysAhead) const override;
+
+private:
+    double m_alpha;     //!< 水平平滑系数
+    double m_beta;      //!< 趋势平滑系数
+    double m_gamma;     //!< 季节平滑系数
+};
+
+/**
+ * @brief 分位数区间模型
+ *
+ * 统计最近若干天内所有跨度为 daysAhead 天的历史余额变化，以中位数作为预测值，
+ * 以指定的上下分位数作为预测区间，不假设变化服从任何分布。
+ */
+class QuantileBandForecaster : public IBalanceForecaster {
+public:
+    /**
+     * @brief 构造函数
+     * @param lowerQuantile 下界分位数（如 0.1）
+     * @param upperQuantile 上界分位数（如 0.9）
+     * @param window 参与统计的最近天数
+     */
+    QuantileBandForecaster(double lowerQuantile, double upperQuantile, int window);
+
+    QString name() const override;
+    int minimumHistory() const override;
+    BalanceForecast forecast(const BalanceHistory& history, int count, int daysAhead) const override;
+
+private:
+    double m_lowerQuantile;     //!< 下界分位数
+    double m_upperQuantile;     //!< 上界分位数
+    int m_window;               //!< 参与统计的最近天数
+};
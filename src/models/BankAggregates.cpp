@@ -0,0 +1,209 @@
+/**
+ * @file BankAggregates.cpp
+ * @brief 全行汇总数据实现
+ *
+ * 实现了DailyActivityTotals和AccountAggregates的增量更新、全量计算和比较方法。
+ */
+#include "BankAggregates.h"
+#include <cmath>
+
+namespace {
+
+//!< 金额比较的容差（增量累加的浮点误差远小于一分钱）
+const double kAmountTolerance = 0.005;
+
+//!< 核对排行榜时比较的名次数
+const int kCheckedRanks = 100;
+
+/**
+ * @brief 比较计数，不一致时追加描述
+ */
+void compareCount(QStringList& out, const QString& field, qint64 actual, qint64 expected)
+{
+    if (actual != expected) {
+        out.append(QString("%1: 增量值 %2, 全量值 %3").arg(field).arg(actual).arg(expected));
+    }
+}
+
+/**
+ * @brief 比较金额，不一致时追加描述
+ */
+void compareAmount(QStringList& out, const QString& field, double actual, double expected)
+{
+    if (std::fabs(actual - expected) >= kAmountTolerance) {
+        out.append(QString("%1: 增量值 %2, 全量值 %3")
+                   .arg(field, QString::number(actual, 'f', 2), QString::number(expected, 'f', 2)));
+    }
+}
+
+/**
+ * @brief 获取账户的临时锁定到期时间
+ * @param account 账户
+ * @return 到期时间（UTC毫秒），未锁定时为0
+ */
+qint64 lockUntilMs(const Account& account)
+{
+    return account.temporaryLockTime.isValid() ? account.temporaryLockTime.toMSecsSinceEpoch() : 0;
+}
+
+/**
+ * @brief 比较两份排行榜
+ * @return 卡号顺序和值都相同时返回true
+ */
+bool sameRanking(const QVector<LeaderboardEntry>& actual, const QVector<LeaderboardEntry>& expected)
+{
+    if (actual.size() != expected.size()) {
+        return false;
+    }
+    for (int i = 0; i < actual.size(); ++i) {
+        if (actual.at(i).cardNumber != expected.at(i).cardNumber
+            || std::fabs(actual.at(i).value - expected.at(i).value) >= kAmountTolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void DailyActivityTotals::add(const Transaction& transaction)
+{
+    switch (transaction.type) {
+    case TransactionType::Deposit:
+        ++depositCount;
+        depositVolume += transaction.amount;
+        break;
+    case TransactionType::Withdrawal:
+        ++withdrawalCount;
+        withdrawalVolume += transaction.amount;
+        break;
+    case TransactionType::Transfer:
+        ++transferCount;
+        transferVolume += transaction.amount;
+        break;
+    default:
+        break;
+    }
+}
+
+DailyActivityTotals DailyActivityTotals::compute(const QVector<Transaction>& transactions, const QDate& date)
+{
+    DailyActivityTotals totals;
+    totals.date = date;
+    for (const Transaction& transaction : transactions) {
+        if (transaction.timestamp.toLocalTime().date() == date) {
+            totals.add(transaction);
+        }
+    }
+    return totals;
+}
+
+QStringList DailyActivityTotals::differences(const DailyActivityTotals& expected) const
+{
+    QStringList out;
+    if (date != expected.date) {
+        out.append(QString("统计日期: 增量值 %1, 全量值 %2")
+                   .arg(date.toString(Qt::ISODate), expected.date.toString(Qt::ISODate)));
+    }
+    compareCount(out, "今日存款笔数", depositCount, expected.depositCount);
+    compareAmount(out, "今日存款金额", depositVolume, expected.depositVolume);
+    compareCount(out, "今日取款笔数", withdrawalCount, expected.withdrawalCount);
+    compareAmount(out, "今日取款金额", withdrawalVolume, expected.withdrawalVolume);
+    compareCount(out, "今日转账笔数", transferCount, expected.transferCount);
+    compareAmount(out, "今日转账金额", transferVolume, expected.transferVolume);
+    return out;
+}
+
+void AccountAggregates::reset(const QVector<Account>& accounts, qint64 nowMs)
+{
+    *this = AccountAggregates();
+    for (const Account& account : accounts) {
+        accountAdded(account, nowMs);
+    }
+}
+
+void AccountAggregates::accountAdded(const Account& account, qint64 nowMs)
+{
+    ++m_accountCount;
+    m_totalBalance += account.balance;
+    if (account.isLocked) {
+        ++m_lockedCount;
+    }
+    if (account.isAdmin) {
+        ++m_adminCount;
+    }
+    m_balanceRanking.set(account.cardNumber, account.balance);
+    setTemporaryLock(account.cardNumber, lockUntilMs(account), nowMs);
+}
+
+void AccountAggregates::accountRemoved(const Account& account)
+{
+    --m_accountCount;
+    m_totalBalance -= account.balance;
+    if (account.isLocked) {
+        --m_lockedCount;
+    }
+    if (account.isAdmin) {
+        --m_adminCount;
+    }
+    m_balanceRanking.remove(account.cardNumber);
+    setTemporaryLock(account.cardNumber, 0, 0);
+}
+
+void AccountAggregates::accountUpdated(const Account& before, const Account& after)
+{
+    m_totalBalance += after.balance - before.balance;
+    m_lockedCount += int(after.isLocked) - int(before.isLocked);
+    m_adminCount += int(after.isAdmin) - int(before.isAdmin);
+    m_balanceRanking.set(after.cardNumber, after.balance);
+}
+
+void AccountAggregates::setTemporaryLock(const QString& cardNumber, qint64 lockUntilMs, qint64 nowMs)
+{
+    auto it = m_temporaryLocks.find(cardNumber);
+    if (it != m_temporaryLocks.end()) {
+        m_lockExpiries.remove(it.value(), cardNumber);
+        m_temporaryLocks.erase(it);
+    }
+    if (lockUntilMs > nowMs) {
+        m_temporaryLocks.insert(cardNumber, lockUntilMs);
+        m_lockExpiries.insert(lockUntilMs, cardNumber);
+    }
+}
+
+int AccountAggregates::temporarilyLockedCount(qint64 nowMs) const
+{
+    purgeExpiredLocks(nowMs);
+    return m_temporaryLocks.size();
+}
+
+AccountAggregates AccountAggregates::compute(const QVector<Account>& accounts, qint64 nowMs)
+{
+    AccountAggregates aggregates;
+    aggregates.reset(accounts, nowMs);
+    return aggregates;
+}
+
+QStringList AccountAggregates::differences(const AccountAggregates& expected, qint64 nowMs) const
+{
+    QStringList out;
+    compareCount(out, "账户数", m_accountCount, expected.m_accountCount);
+    compareAmount(out, "总余额", m_totalBalance, expected.m_totalBalance);
+    compareCount(out, "锁定账户数", m_lockedCount, expected.m_lockedCount);
+    compareCount(out, "管理员账户数", m_adminCount, expected.m_adminCount);
+    compareCount(out, "临时锁定账户数", temporarilyLockedCount(nowMs), expected.temporarilyLockedCount(nowMs));
+    compareCount(out, "余额排行榜账户数", m_balanceRanking.size(), expected.m_balanceRanking.size());
+    if (!sameRanking(m_balanceRanking.top(kCheckedRanks), expected.m_balanceRanking.top(kCheckedRanks))) {
+        out.append(QString("余额排行榜前 %1 名与全量排序不一致").arg(kCheckedRanks));
+    }
+    return out;
+}
+
+void AccountAggregates::purgeExpiredLocks(qint64 nowMs) const
+{
+    while (!m_lockExpiries.isEmpty() && m_lockExpiries.firstKey() <= nowMs) {
+        auto it = m_lockExpiries.begin();
+        m_temporaryLocks.remove(it.value());
+        m_lockExpiries.erase(it);
+    }
+}
@@ -0,0 +1,182 @@
+/**
+ * @file BankAggregates.h
+ * @brief 全行汇总数据
+ *
+ * 定义了账户汇总（总余额、锁定账户数等）和当日交易汇总，两者都在每次修改时增量更新，
+ * 读取时无需遍历全部账户或整个账本。
+ */
+#pragma once
+
+#include <QDate>
+#include <QHash>
+#include <QMultiMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "Account.h"
+#include "Transaction.h"
+#include "Leaderboards.h"
+
+/**
+ * @brief 某一天的交易汇总
+ *
+ * 只统计存款、取款和转账（转入是转账的另一侧，不重复计数），登录、查询等不计入。
+ */
+struct DailyActivityTotals {
+    QDate date;                     //!< 统计日期（本地时间）
+    int depositCount = 0;           //!< 存款笔数
+    double depositVolume = 0.0;     //!< 存款金额
+    int withdrawalCount = 0;        //!< 取款笔数
+    double withdrawalVolume = 0.0;  //!< 取款金额
+    int transferCount = 0;          //!< 转账笔数
+    double transferVolume = 0.0;    //!< 转账金额
+
+    /**
+     * @brief 累加一笔交易（不检查日期）
+     * @param transaction 交易记录
+     */
+    void add(const Transaction& transaction);
+
+    /**
+     * @brief 全量重新计算某一天的汇总
+     * @param transactions 全部交易记录
+     * @param date 统计日期（本地时间）
+     * @return 汇总
+     */
+    static DailyActivityTotals compute(const QVector<Transaction>& transactions, const QDate& date);
+
+    /**
+     * @brief 与全量计算的结果比较
+     * @param expected 全量计算的汇总
+     * @return 不一致的字段描述，一致时为空
+     */
+    QStringList differences(const DailyActivityTotals& expected) const;
+};
+
+/**
+ * @brief 全部账户的汇总
+ *
+ * 账户的增删改由服务层在保存成功后通知，每次通知只按新旧两份账户的差值调整计数，
+ * 与账户总数无关。临时锁定会随时间自动解除，因此按到期时间另行索引：
+ * 读取时先丢弃已到期的锁定，再返回剩余数量（均摊 O(log n)）。
+ * 同时维护余额排行榜，余额变化时以 O(log n) 调整名次。
+ */
+class AccountAggregates {
+public:
+    /**
+     * @brief 以全部账户重新初始化
+     * @param accounts 全部账户
+     * @param nowMs 当前时间（UTC毫秒）
+     */
+    void reset(const QVector<Account>& accounts, qint64 nowMs);
+
+    /**
+     * @brief 新增账户
+     * @param account 新账户
+     * @param nowMs 当前时间（UTC毫秒）
+     */
+    void accountAdded(const Account& account, qint64 nowMs);
+
+    /**
+     * @brief 删除账户
+     * @param account 被删除的账户
+     */
+    void accountRemoved(const Account& account);
+
+    /**
+     * @brief 账户更新（余额、锁定、管理员标记）
+     * @param before 更新前的账户
+     * @param after 更新后的账户
+     */
+    void accountUpdated(const Account& before, const Account& after);
+
+    /**
+     * @brief 设置卡号的临时锁定到期时间
+     * @param cardNumber 卡号
+     * @param lockUntilMs 到期时间（UTC毫秒），0 表示未锁定
+     * @param nowMs 当前时间（UTC毫秒）
+     */
+    void setTemporaryLock(const QString& cardNumber, qint64 lockUntilMs, qint64 nowMs);
+
+    /**
+     * @brief 获取账户总数
+     * @return 账户数
+     */
+    int accountCount() const { return m_accountCount; }
+
+    /**
+     * @brief 获取全部账户的余额之和
+     * @return 总余额
+     */
+    double totalBalance() const { return m_totalBalance; }
+
+    /**
+     * @brief 获取被管理员锁定的账户数
+     * @return 账户数
+     */
+    int lockedCount() const { return m_lockedCount; }
+
+    /**
+     * @brief 获取管理员账户数
+     * @return 账户数
+     */
+    int adminCount() const { return m_adminCount; }
+
+    /**
+     * @brief 获取处于临时锁定（连续登录失败）的账户数
+     * @param nowMs 当前时间（UTC毫秒）
+     * @return 账户数
+     */
+    int temporarilyLockedCount(qint64 nowMs) const;
+
+    /**
+     * @brief 获取余额最高的前 N 个账户
+     * @param n 数量
+     * @return 按余额降序排列的卡号和余额
+     */
+    QVector<LeaderboardEntry> topBalances(int n) const { return m_balanceRanking.top(n); }
+
+    /**
+     * @brief 全量计算汇总
+     * @param accounts 全部账户
+     * @param nowMs 当前时间（UTC毫秒）
+     * @return 汇总
+     */
+    static AccountAggregates compute(const QVector<Account>& accounts, qint64 nowMs);
+
+    /**
+     * @brief 与全量计算的结果比较
+     * @param expected 全量计算的汇总
+     * @param nowMs 当前时间（UTC毫秒）
+     * @return 不一致的字段描述，一致时为空
+     */
+    QStringList differences(const AccountAggregates& expected, qint64 nowMs) const;
+
+private:
+    /**
+     * @brief 丢弃已到期的临时锁定
+     * @param nowMs 当前时间（UTC毫秒）
+     */
+    void purgeExpiredLocks(qint64 nowMs) const;
+
+    //!< 账户总数
+    int m_accountCount = 0;
+
+    //!< 余额之和
+    double m_totalBalance = 0.0;
+
+    //!< 被管理员锁定的账户数
+    int m_lockedCount = 0;
+
+    //!< 管理员账户数
+    int m_adminCount = 0;
+
+    //!< 余额排行榜
+    BalanceLeaderboard m_balanceRanking;
+
+    //!< 临时锁定的卡号及到期时间（到期的项在读取时清除）
+    mutable QHash<QString, qint64> m_temporaryLocks;
+
+    //!< 按到期时间排序的临时锁定
+    mutable QMultiMap<qint64, QString> m_lockExpiries;
+};
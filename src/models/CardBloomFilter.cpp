@@ -0,0 +1,113 @@
+/**
+ * @file CardBloomFilter.cpp
+ * @brief 卡号布隆过滤器实现
+ *
+ * 使用双重哈希（h1 + i*h2）从一次64位哈希派生全部探测位置。
+ */
+#include "CardBloomFilter.h"
+#include <cmath>
+
+CardBloomFilter::CardBloomFilter(int expectedItems)
+    : m_bitCount(0)
+    , m_capacity(0)
+    , m_count(0)
+    , m_staleCount(0)
+{
+    reset(expectedItems);
+}
+
+void CardBloomFilter::reset(int expectedItems)
+{
+    m_capacity = qMax(expectedItems, MIN_BITS / BITS_PER_ITEM);
+    const qint64 bits = qint64(m_capacity) * BITS_PER_ITEM;
+    const qsizetype words = static_cast<qsizetype>((bits + 63) / 64);
+
+    m_words.fill(0, words);
+    m_bitCount = qint64(words) * 64;
+    m_count = 0;
+    m_staleCount = 0;
+}
+
+void CardBloomFilter::add(const QString& cardNumber)
+{
+    quint64 h1 = 0;
+    quint64 h2 = 0;
+    hashPair(cardNumber, h1, h2);
+
+    const quint64 bits = static_cast<quint64>(m_bitCount);
+    for (int i = 0; i < HASH_COUNT; ++i) {
+        const quint64 bit = (h1 + quint64(i) * h2) % bits;
+        m_words[static_cast<qsizetype>(bit >> 6)] |= quint64(1) << (bit & 63);
+    }
+    ++m_count;
+}
+
+void CardBloomFilter::markRemoved()
+{
+    ++m_staleCount;
+}
+
+bool CardBloomFilter::mightContain(const QString& cardNumber) const
+{
+    quint64 h1 = 0;
+    quint64 h2 = 0;
+    hashPair(cardNumber, h1, h2);
+
+    const quint64 bits = static_cast<quint64>(m_bitCount);
+    for (int i = 0; i < HASH_COUNT; ++i) {
+        const quint64 bit = (h1 + quint64(i) * h2) % bits;
+        if ((m_words.at(static_cast<qsizetype>(bit >> 6)) & (quint64(1) << (bit & 63))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CardBloomFilter::needsRebuild() const
+{
+    return m_count >= m_capacity
+        || qint64(m_staleCount) * 100 > qint64(m_count) * MAX_STALE_PERCENT;
+}
+
+int CardBloomFilter::count() const
+{
+    return m_count;
+}
+
+int CardBloomFilter::staleCount() const
+{
+    return m_staleCount;
+}
+
+qint64 CardBloomFilter::bitCount() const
+{
+    return m_bitCount;
+}
+
+double CardBloomFilter::estimatedFalsePositiveRate() const
+{
+    if (m_bitCount == 0) {
+        return 1.0;
+    }
+    // (1 - e^(-kn/m))^k
+    const double fill = 1.0 - std::exp(-double(HASH_COUNT) * m_count / double(m_bitCount));
+    return std::pow(fill, HASH_COUNT);
+}
+
+void CardBloomFilter::hashPair(const QString& cardNumber, quint64& h1, quint64& h2)
+{
+    // FNV-1a 64位哈希，再用 splitmix64 混合出第二个哈希
+    quint64 hash = 14695981039346656037ULL;
+    for (const QChar c : cardNumber) {
+        hash ^= c.unicode();
+        hash *= 1099511628211ULL;
+    }
+
+    quint64 mixed = hash + 0x9E3779B97F4A7C15ULL;
+    mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+    mixed ^= mixed >> 31;
+
+    h1 = hash;
+    h2 = mixed | 1;
+}
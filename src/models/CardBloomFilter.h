@@ -0,0 +1,123 @@
+/**
+ * @file CardBloomFilter.h
+ * @brief 卡号布隆过滤器
+ *
+ * 在存储库查找之前快速排除不存在的卡号。
+ */
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief 卡号布隆过滤器
+ *
+ * 只会误报（判断存在但实际不存在），不会漏报；因此 mightContain() 返回false
+ * 的卡号一定不存在，可以直接拒绝而不必访问存储。按目标误判率约1%配置位数和哈希函数个数。
+ * 布隆过滤器不支持删除：删除的卡号只计入过期数量，对应位保留，只会多出误报，
+ * 由调用方的精确查找拒绝。插入数量超过容量或过期卡号占比过高后需要重建。
+ */
+class CardBloomFilter {
+public:
+    /**
+     * @brief 构造函数
+     * @param expectedItems 预计的卡号数量
+     */
+    explicit CardBloomFilter(int expectedItems = 0);
+
+    /**
+     * @brief 清空并按新的容量重新分配
+     * @param expectedItems 预计的卡号数量
+     */
+    void reset(int expectedItems);
+
+    /**
+     * @brief 加入卡号
+     * @param cardNumber 卡号
+     */
+    void add(const QString& cardNumber);
+
+    /**
+     * @brief 记录一个卡号已被删除
+     *
+     * 不清除任何位，只累计过期数量，供 needsRebuild() 判断。
+     */
+    void markRemoved();
+
+    /**
+     * @brief 检查卡号是否可能存在
+     * @param cardNumber 卡号
+     * @return 返回false时卡号一定不存在
+     */
+    bool mightContain(const QString& cardNumber) const;
+
+    /**
+     * @brief 检查是否需要重建
+     *
+     * 插入数量超过容量后误判率会快速上升；过期卡号超过已加入数量的
+     * MAX_STALE_PERCENT% 后位数组明显大于实际需要。两种情况调用方都应按当前卡号重建。
+     *
+     * @return 如果需要重建返回true
+     */
+    bool needsRebuild() const;
+
+    /**
+     * @brief 获取已加入的卡号数量
+     * @return 卡号数量
+     */
+    int count() const;
+
+    /**
+     * @brief 获取已删除但仍留在位数组中的卡号数量
+     * @return 过期卡号数量
+     */
+    int staleCount() const;
+
+    /**
+     * @brief 获取位数组大小
+     * @return 位数
+     */
+    qint64 bitCount() const;
+
+    /**
+     * @brief 按当前装载量估算误判率
+     * @return 误判率（0~1）
+     */
+    double estimatedFalsePositiveRate() const;
+
+private:
+    /**
+     * @brief 计算卡号的两个基础哈希值
+     * @param cardNumber 卡号
+     * @param h1 输出参数，第一个哈希值
+     * @param h2 输出参数，第二个哈希值（奇数）
+     */
+    static void hashPair(const QString& cardNumber, quint64& h1, quint64& h2);
+
+    //!< 哈希函数个数（约1%误判率对应的最优值）
+    static const int HASH_COUNT = 7;
+
+    //!< 每个元素分配的位数（约1%误判率）
+    static const int BITS_PER_ITEM = 10;
+
+    //!< 最小位数
+    static const int MIN_BITS = 1024;
+
+    //!< 过期卡号占已加入数量的百分比上限，超过后需要重建
+    static const int MAX_STALE_PERCENT = 25;
+
+    //!< 位数组
+    QVector<quint64> m_words;
+
+    //!< 位数组大小
+    qint64 m_bitCount;
+
+    //!< 容量（超过后需要重建）
+    int m_capacity;
+
+    //!< 已加入的卡号数量（含已删除的）
+    int m_count;
+
+    //!< 已删除但仍留在位数组中的卡号数量
+    int m_staleCount;
+};
@@ -0,0 +1,80 @@
+/**
+ * @file CardNumber.cpp
+ * @brief 卡号解析与校验实现
+ *
+ * 以64位字为单位的SWAR（SIMD within a register）实现，每个字包含4个16位通道，
+ * 对应4个UTF-16字符。
+ */
+#include "CardNumber.h"
+#include <QtEndian>
+
+namespace {
+
+//!< 每个16位通道置1，乘以常量即可广播到全部通道
+constexpr quint64 kLanes = 0x0001000100010001ULL;
+
+//!< 通道高12位掩码，ASCII数字的高12位必须为 0x003
+constexpr quint64 kHighMask = 0xFFF0 * kLanes;
+
+//!< 字符 '0' 的广播值
+constexpr quint64 kZeros = 0x0030 * kLanes;
+
+//!< 偶数通道（0和2）掩码：16位卡号从左数偶数位需要在Luhn中加倍
+constexpr quint64 kEvenLanes = 0x0000FFFF0000FFFFULL;
+
+} // namespace
+
+CardNumber::Parsed CardNumber::parse(const QString& text)
+{
+    Parsed result;
+    if (text.size() != LENGTH) {
+        return result;
+    }
+
+    const QChar* chars = text.constData();
+    quint64 valid = 1;
+    quint64 packed = 0;
+    quint64 luhn = 0;
+
+    for (int i = 0; i < LENGTH; i += 4) {
+        const quint64 v = qFromLittleEndian<quint64>(chars + i);
+
+        // 每个通道必须落在 0x30~0x39：高12位为0x003，且加6后不进位到0x40
+        valid &= quint64((v & kHighMask) == kZeros)
+               & quint64(((v + 6 * kLanes) & kHighMask) == kZeros);
+
+        // 各通道减去 '0' 得到数字值，再两两合并为两位数、四位数
+        const quint64 d = v - kZeros;
+        const quint64 pairs = (d * 10 + (d >> 16)) & kEvenLanes;
+        const quint64 group = (pairs * 100 + (pairs >> 32)) & 0xFFFFFFFFULL;
+        packed = packed * 10000 + group;
+
+        // Luhn：加倍的数字若 >= 5 则减9（等价于把两位结果的各位相加）
+        const quint64 doubled = d & kEvenLanes;
+        const quint64 atLeastFive = ((doubled + 11 * kLanes) >> 4) & kLanes;
+        luhn += d + doubled - 9 * atLeastFive;
+    }
+
+    // 水平求和4个通道（每通道最大72，总和不会溢出16位）
+    const quint64 luhnSum = (luhn * kLanes) >> 48;
+
+    result.wellFormed = valid != 0;
+    result.packed = result.wellFormed ? packed : 0;
+    result.luhnValid = result.wellFormed && luhnSum % 10 == 0;
+    return result;
+}
+
+bool CardNumber::isWellFormed(const QString& text)
+{
+    return parse(text).wellFormed;
+}
+
+bool CardNumber::isValid(const QString& text)
+{
+    return parse(text).luhnValid;
+}
+
+QString CardNumber::format(quint64 packed)
+{
+    return QStringLiteral("%1").arg(packed, LENGTH, 10, QLatin1Char('0'));
+}
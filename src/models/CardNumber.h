@@ -0,0 +1,61 @@
+/**
+ * @file CardNumber.h
+ * @brief 卡号解析与校验
+ *
+ * 一次扫描完成16位ASCII数字的格式校验、Luhn校验位计算和整数打包。
+ */
+#pragma once
+
+#include <QString>
+
+/**
+ * @brief 卡号解析与校验
+ *
+ * 16位十进制卡号最大为 10^16-1，可以无损打包进一个 quint64。
+ * 解析时每次载入4个UTF-16字符，在64位字内按16位通道并行完成
+ * 数字范围检查、数值合并和Luhn加权求和，循环体内没有依赖数据的分支。
+ *
+ * 只接受ASCII数字 '0'~'9'，全角数字或其他Unicode数字一律视为无效。
+ */
+class CardNumber {
+public:
+    //!< 卡号位数
+    static const int LENGTH = 16;
+
+    /**
+     * @brief 解析结果
+     */
+    struct Parsed {
+        quint64 packed = 0;     //!< 卡号对应的整数值（仅在 wellFormed 时有效）
+        bool wellFormed = false; //!< 是否为16位ASCII数字
+        bool luhnValid = false;  //!< Luhn校验位是否正确（仅在 wellFormed 时有效）
+    };
+
+    /**
+     * @brief 解析卡号
+     * @param text 卡号字符串
+     * @return 解析结果
+     */
+    static Parsed parse(const QString& text);
+
+    /**
+     * @brief 检查卡号格式（16位ASCII数字），不检查校验位
+     * @param text 卡号字符串
+     * @return 如果格式有效返回true
+     */
+    static bool isWellFormed(const QString& text);
+
+    /**
+     * @brief 检查卡号格式和Luhn校验位
+     * @param text 卡号字符串
+     * @return 如果格式和校验位都有效返回true
+     */
+    static bool isValid(const QString& text);
+
+    /**
+     * @brief 将打包的整数还原为16位卡号字符串（保留前导零）
+     * @param packed 卡号整数值
+     * @return 卡号字符串
+     */
+    static QString format(quint64 packed);
+};
@@ -0,0 +1,195 @@
+/**
+ * @file ChangeFeed.cpp
+ * @brief 变更数据捕获（CDC）输出实现
+ *
+ * 实现了ChangeFeed类中定义的变更编码、批量写入、序号恢复和续读方法。
+ */
+#include "ChangeFeed.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonDocument>
+#include <QTimer>
+
+namespace {
+
+//!< 缓冲区超过该大小时立即写入文件
+const int kMaxBufferBytes = 256 * 1024;
+
+//!< 恢复序号时从文件末尾读取的字节数
+const qint64 kTailBytes = 64 * 1024;
+
+//!< 续读时每次读取的字节数
+const qint64 kReadChunkBytes = 256 * 1024;
+
+/**
+ * @brief 生成不含 PIN 哈希和盐值的账户内容
+ * @param account 账户
+ * @return JSON 对象，账户为空时为 null
+ */
+QJsonValue publicAccount(const std::optional<Account>& account)
+{
+    if (!account) {
+        return QJsonValue(QJsonValue::Null);
+    }
+    QJsonObject json = account->toJson();
+    json.remove("pinHash");
+    json.remove("salt");
+    return json;
+}
+
+} // namespace
+
+ChangeFeed::ChangeFeed(const QString& filePath, QObject* parent)
+    : QObject(parent)
+    , m_file(filePath)
+    , m_flushTimer(new QTimer(this))
+{
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        qWarning() << "无法打开变更文件:" << filePath << ", 错误:" << m_file.errorString();
+    } else {
+        recoverSequence();
+        m_file.seek(m_file.size());
+        qDebug() << "变更文件:" << filePath << "，最后序号" << m_sequence;
+    }
+
+    // 间隔为0：当前事件处理完、事件循环空闲时写出，同一轮产生的变更合并为一次写入
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(0);
+    connect(m_flushTimer, &QTimer::timeout, this, &ChangeFeed::flush);
+}
+
+ChangeFeed::~ChangeFeed()
+{
+    flush();
+}
+
+void ChangeFeed::accountChanged(const std::optional<Account>& before, const std::optional<Account>& after)
+{
+    const QString op = !before ? "insert" : !after ? "delete" : "update";
+    append(QJsonObject{
+        {"source", "account"},
+        {"op", op},
+        {"cardNumber", after ? after->cardNumber : before->cardNumber},
+        {"before", publicAccount(before)},
+        {"after", publicAccount(after)}
+    });
+}
+
+void ChangeFeed::transactionsAppended(const QVector<Transaction>& transactions, int begin, int end)
+{
+    for (int i = begin; i < end; ++i) {
+        append(QJsonObject{
+            {"source", "ledger"},
+            {"op", "append"},
+            {"record", transactions.at(i).toJson()}
+        });
+    }
+}
+
+void ChangeFeed::cardCleared(const QString& cardNumber)
+{
+    append(QJsonObject{
+        {"source", "ledger"},
+        {"op", "clear-card"},
+        {"cardNumber", cardNumber}
+    });
+}
+
+bool ChangeFeed::flush()
+{
+    m_flushTimer->stop();
+    if (m_buffer.isEmpty() || !m_file.isOpen()) {
+        return m_buffer.isEmpty();
+    }
+
+    if (m_file.write(m_buffer) != m_buffer.size() || !m_file.flush()) {
+        qWarning() << "写入变更文件失败:" << m_file.fileName() << ", 错误:" << m_file.errorString();
+        return false;
+    }
+    m_buffer.clear();
+    return true;
+}
+
+void ChangeFeed::append(QJsonObject event)
+{
+    // 与复制日志一致，64位整数以字符串保存，避免经 double 转换丢失精度
+    event["seq"] = QString::number(++m_sequence);
+    event["ms"] = QString::number(QDateTime::currentMSecsSinceEpoch());
+    m_buffer.append(QJsonDocument(event).toJson(QJsonDocument::Compact));
+    m_buffer.append('\n');
+
+    if (m_buffer.size() >= kMaxBufferBytes) {
+        flush();
+    } else if (!m_flushTimer->isActive()) {
+        m_flushTimer->start();
+    }
+}
+
+void ChangeFeed::recoverSequence()
+{
+    const qint64 size = m_file.size();
+    if (size == 0) {
+        return;
+    }
+
+    const qint64 tailStart = qMax<qint64>(0, size - kTailBytes);
+    m_file.seek(tailStart);
+    const QByteArray tail = m_file.read(size - tailStart);
+
+    // 不完整的最后一行是写入中途退出留下的，截掉后从上一行继续
+    const qsizetype lastNewline = tail.lastIndexOf('\n');
+    if (lastNewline != tail.size() - 1) {
+        const qint64 validSize = lastNewline < 0 ? tailStart : tailStart + lastNewline + 1;
+        qWarning() << "变更文件末尾有不完整的记录，截断到" << validSize << "字节";
+        m_file.resize(validSize);
+    }
+    if (lastNewline < 0) {
+        return;
+    }
+
+    // lastIndexOf 的起始位置为负数时从末尾倒数，第一行需要单独处理
+    const qsizetype lineStart = lastNewline > 0 ? tail.lastIndexOf('\n', lastNewline - 1) + 1 : 0;
+    const QJsonDocument last = QJsonDocument::fromJson(tail.mid(lineStart, lastNewline - lineStart));
+    m_sequence = last.object()["seq"].toString().toULongLong();
+}
+
+QVector<QJsonObject> ChangeFeed::readEvents(const QString& filePath, qint64 offset, int maxEvents,
+                                           qint64* nextOffset)
+{
+    QVector<QJsonObject> events;
+    if (nextOffset) {
+        *nextOffset = offset;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(offset)) {
+        return events;
+    }
+
+    qint64 position = offset;
+    QByteArray pending;
+    while (events.size() < maxEvents) {
+        const QByteArray chunk = file.read(kReadChunkBytes);
+        if (chunk.isEmpty()) {
+            break;
+        }
+        pending.append(chunk);
+
+        qsizetype lineStart = 0;
+        qsizetype newline;
+        while (events.size() < maxEvents && (newline = pending.indexOf('\n', lineStart)) >= 0) {
+            const QJsonDocument document = QJsonDocument::fromJson(pending.mid(lineStart, newline - lineStart));
+            if (document.isObject()) {
+                events.append(document.object());
+            }
+            lineStart = newline + 1;
+        }
+        position += lineStart;
+        pending.remove(0, lineStart);
+    }
+
+    if (nextOffset) {
+        *nextOffset = position;
+    }
+    return events;
+}
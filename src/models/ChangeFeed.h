@@ -0,0 +1,130 @@
+/**
+ * @file ChangeFeed.h
+ * @brief 变更数据捕获（CDC）输出
+ *
+ * 定义了把账户和账本的每次提交写成只追加 JSON Lines 文件的变更流，以及下游按偏移量续读的方法。
+ */
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <optional>
+#include "Account.h"
+#include "Transaction.h"
+
+class QTimer;
+
+/**
+ * @brief 变更数据捕获（CDC）输出
+ *
+ * ChangeFeedAccountRepository（包装任意账户存储库）和 TransactionModel 在每次成功提交后调用本类，
+ * 每个变更写成一行 JSON：
+ * - 账户：{"seq", "ms", "source": "account", "op": "insert" | "update" | "delete", "cardNumber", "before", "after"}
+ * - 账本：{"seq", "ms", "source": "ledger", "op": "append", "record"} 或 {"op": "clear-card", "cardNumber"}
+ *
+ * seq 从1开始连续递增，重启后从文件最后一行接着编号。账户的 before/after 不包含 PIN 哈希和盐值。
+ *
+ * 同一轮事件循环中产生的变更先放在缓冲区，事件循环空闲时（或缓冲区超过上限时）一次写入文件，
+ * 批处理作业产生的大量变更只写一次，单笔交易的变更在毫秒内可见。
+ * 文件只追加，每行的字节偏移量不变，下游保存读到的偏移量即可续读，无需重新解析整个数据文件。
+ */
+class ChangeFeed : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     *
+     * 打开（或创建）变更文件；上次异常退出留下的不完整的最后一行会被截掉。
+     *
+     * @param filePath 变更文件路径
+     * @param parent 父对象
+     */
+    explicit ChangeFeed(const QString& filePath, QObject* parent = nullptr);
+
+    /**
+     * @brief 析构函数，写出缓冲区中的变更
+     */
+    ~ChangeFeed() override;
+
+    /**
+     * @brief 变更文件是否可用
+     * @return 如果文件已打开返回true
+     */
+    bool isOpen() const { return m_file.isOpen(); }
+
+    /**
+     * @brief 获取最后分配的序号
+     * @return 序号，没有变更时为0
+     */
+    quint64 lastSequence() const { return m_sequence; }
+
+    /**
+     * @brief 记录账户变更
+     * @param before 变更前的账户，新建时为空
+     * @param after 变更后的账户，删除时为空
+     */
+    void accountChanged(const std::optional<Account>& before, const std::optional<Account>& after);
+
+    /**
+     * @brief 记录新增的账本记录
+     * @param transactions 账本
+     * @param begin 第一条新记录的下标
+     * @param end 最后一条新记录之后的下标
+     */
+    void transactionsAppended(const QVector<Transaction>& transactions, int begin, int end);
+
+    /**
+     * @brief 记录删除某卡的交易记录
+     * @param cardNumber 卡号
+     */
+    void cardCleared(const QString& cardNumber);
+
+    /**
+     * @brief 把缓冲区中的变更写入文件
+     * @return 如果成功写入返回true
+     */
+    bool flush();
+
+    /**
+     * @brief 从指定偏移量读取变更
+     *
+     * 只读取完整的行，末尾正在写入的半行留到下次读取。
+     *
+     * @param filePath 变更文件路径
+     * @param offset 起始字节偏移量（0 或上次返回的 nextOffset）
+     * @param maxEvents 最多读取的变更数
+     * @param nextOffset 输出参数，下次读取的起始偏移量
+     * @return 读到的变更
+     */
+    static QVector<QJsonObject> readEvents(const QString& filePath, qint64 offset, int maxEvents,
+                                           qint64* nextOffset);
+
+private:
+    /**
+     * @brief 分配序号并把一个变更追加到缓冲区
+     * @param event 变更内容（不含序号和时间）
+     */
+    void append(QJsonObject event);
+
+    /**
+     * @brief 从文件最后一行恢复序号，并截掉不完整的最后一行
+     */
+    void recoverSequence();
+
+    //!< 变更文件
+    QFile m_file;
+
+    //!< 待写入的变更
+    QByteArray m_buffer;
+
+    //!< 事件循环空闲时写出缓冲区的定时器
+    QTimer* m_flushTimer;
+
+    //!< 最后分配的序号
+    quint64 m_sequence = 0;
+};
@@ -0,0 +1,90 @@
+/**
+ * @file ChangeFeedAccountRepository.cpp
+ * @brief 变更数据捕获账户存储库装饰器实现
+ *
+ * 实现了ChangeFeedAccountRepository类中定义的转发和记录变更方法。
+ */
+#include "ChangeFeedAccountRepository.h"
+#include <QHash>
+
+ChangeFeedAccountRepository::ChangeFeedAccountRepository(std::unique_ptr<IAccountRepository> repository,
+                                                         ChangeFeed* changeFeed)
+    : m_repository(std::move(repository))
+    , m_changeFeed(changeFeed)
+{
+    Q_ASSERT(m_repository != nullptr);
+    Q_ASSERT(m_changeFeed != nullptr);
+}
+
+OperationResult ChangeFeedAccountRepository::saveAccount(const Account& account)
+{
+    const std::optional<Account> before = m_repository->findByCardNumber(account.cardNumber);
+    OperationResult result = m_repository->saveAccount(account);
+    if (result.success) {
+        m_changeFeed->accountChanged(before, account);
+    }
+    return result;
+}
+
+OperationResult ChangeFeedAccountRepository::saveAccountsBatch(const QVector<Account>& accounts)
+{
+    // 同一卡号在批内出现多次时，后一条的变更前账户是前一条写入后的状态
+    QVector<std::optional<Account>> before;
+    before.reserve(accounts.size());
+    QHash<QString, int> lastIndex;
+    for (int i = 0; i < accounts.size(); ++i) {
+        const QString& cardNumber = accounts.at(i).cardNumber;
+        auto it = lastIndex.constFind(cardNumber);
+        before.append(it != lastIndex.constEnd() ? std::optional<Account>(accounts.at(it.value()))
+                                                 : m_repository->findByCardNumber(cardNumber));
+        lastIndex.insert(cardNumber, i);
+    }
+
+    OperationResult result = m_repository->saveAccountsBatch(accounts);
+    if (result.success) {
+        for (int i = 0; i < accounts.size(); ++i) {
+            m_changeFeed->accountChanged(before.at(i), accounts.at(i));
+        }
+    }
+    return result;
+}
+
+OperationResult ChangeFeedAccountRepository::deleteAccount(const QString& cardNumber)
+{
+    const std::optional<Account> before = m_repository->findByCardNumber(cardNumber);
+    OperationResult result = m_repository->deleteAccount(cardNumber);
+    if (result.success && before) {
+        m_changeFeed->accountChanged(before, std::nullopt);
+    }
+    return result;
+}
+
+std::optional<Account> ChangeFeedAccountRepository::findByCardNumber(const QString& cardNumber) const
+{
+    return m_repository->findByCardNumber(cardNumber);
+}
+
+QVector<Account> ChangeFeedAccountRepository::getAllAccounts() const
+{
+    return m_repository->getAllAccounts();
+}
+
+bool ChangeFeedAccountRepository::saveAccounts()
+{
+    return m_repository->saveAccounts();
+}
+
+bool ChangeFeedAccountRepository::loadAccounts()
+{
+    return m_repository->loadAccounts();
+}
+
+bool ChangeFeedAccountRepository::accountExists(const QString& cardNumber) const
+{
+    return m_repository->accountExists(cardNumber);
+}
+
+const AccountTable* ChangeFeedAccountRepository::accountTable() const
+{
+    return m_repository->accountTable();
+}
@@ -0,0 +1,44 @@
+/**
+ * @file ChangeFeedAccountRepository.h
+ * @brief 变更数据捕获账户存储库装饰器
+ *
+ * 包装任意账户存储库，每次成功提交后把变更前后的账户写入变更流。
+ */
+#pragma once
+
+#include <memory>
+#include "IAccountRepository.h"
+#include "ChangeFeed.h"
+
+/**
+ * @brief 变更数据捕获账户存储库装饰器
+ *
+ * 所有操作转发给被包装的存储库（JSON 或 SQLite）；saveAccount()、saveAccountsBatch() 和 deleteAccount()
+ * 执行前先读出变更前的账户，成功后写入变更流，失败的操作不记录。加载和全量保存不改变账户内容，不记录。
+ */
+class ChangeFeedAccountRepository : public IAccountRepository {
+public:
+    /**
+     * @brief 构造函数
+     * @param repository 被包装的存储库（所有权转移）
+     * @param changeFeed 变更流
+     */
+    ChangeFeedAccountRepository(std::unique_ptr<IAccountRepository> repository, ChangeFeed* changeFeed);
+
+    OperationResult saveAccount(const Account& account) override;
+    OperationResult saveAccountsBatch(const QVector<Account>& accounts) override;
+    OperationResult deleteAccount(const QString& cardNumber) override;
+    std::optional<Account> findByCardNumber(const QString& cardNumber) const override;
+    QVector<Account> getAllAccounts() const override;
+    bool saveAccounts() override;
+    bool loadAccounts() override;
+    bool accountExists(const QString& cardNumber) const override;
+    const AccountTable* accountTable() const override;
+
+private:
+    //!< 被包装的存储库
+    std::unique_ptr<IAccountRepository> m_repository;
+
+    //!< 变更流
+    ChangeFeed* m_changeFeed;
+};
@@ -0,0 +1,86 @@
+/**
+ * @file Clock.cpp
+ * @brief 时钟抽象实现
+ *
+ * 实现了系统时钟和虚拟时钟。
+ */
+#include "Clock.h"
+
+QDateTime Clock::nowUtc() const
+{
+    return QDateTime::fromMSecsSinceEpoch(utcMs(), Qt::UTC);
+}
+
+QDate Clock::today() const
+{
+    return nowUtc().toLocalTime().date();
+}
+
+Clock* Clock::system()
+{
+    static SystemClock clock;
+    return &clock;
+}
+
+SystemClock::SystemClock()
+    : m_offsetMs(0)
+    , m_lastSyncMs(0)
+{
+    m_timer.start();
+    m_offsetMs.store(QDateTime::currentMSecsSinceEpoch() - m_timer.elapsed());
+}
+
+qint64 SystemClock::monotonicMs() const
+{
+    return m_timer.elapsed();
+}
+
+qint64 SystemClock::utcMs() const
+{
+    const qint64 monotonic = m_timer.elapsed();
+
+    // 定期与墙钟对齐；偏移只增不减，保证返回值单调
+    qint64 lastSync = m_lastSyncMs.load(std::memory_order_relaxed);
+    if (monotonic - lastSync >= RESYNC_INTERVAL_MS
+        && m_lastSyncMs.compare_exchange_strong(lastSync, monotonic, std::memory_order_relaxed)) {
+        const qint64 offset = QDateTime::currentMSecsSinceEpoch() - monotonic;
+        qint64 current = m_offsetMs.load(std::memory_order_relaxed);
+        while (offset > current
+               && !m_offsetMs.compare_exchange_weak(current, offset, std::memory_order_relaxed)) {
+        }
+    }
+
+    return m_offsetMs.load(std::memory_order_relaxed) + monotonic;
+}
+
+VirtualClock::VirtualClock(const QDateTime& start)
+    : m_monotonicMs(0)
+    , m_utcMs(start.isValid() ? start.toMSecsSinceEpoch() : QDateTime::currentMSecsSinceEpoch())
+{
+}
+
+qint64 VirtualClock::monotonicMs() const
+{
+    return m_monotonicMs;
+}
+
+qint64 VirtualClock::utcMs() const
+{
+    return m_utcMs;
+}
+
+void VirtualClock::advance(qint64 ms)
+{
+    if (ms <= 0) {
+        return;
+    }
+    m_monotonicMs += ms;
+    m_utcMs += ms;
+}
+
+void VirtualClock::setUtc(const QDateTime& utc)
+{
+    if (utc.isValid()) {
+        m_utcMs = utc.toMSecsSinceEpoch();
+    }
+}
@@ -0,0 +1,134 @@
+/**
+ * @file Clock.h
+ * @brief 时钟抽象
+ *
+ * 为模型层提供可注入的时间来源：单调时钟用于计算时间间隔，
+ * UTC时钟用于生成时间戳，虚拟时钟用于模拟和加速运行。
+ */
+#pragma once
+
+#include <QDate>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <atomic>
+
+/**
+ * @brief 时钟接口
+ *
+ * 模型层需要当前时间时都通过该接口获取，而不是直接调用
+ * QDateTime::currentDateTime()（每次调用都要做本地时区换算）。
+ * 时间戳统一使用UTC，只有显示和按自然日分组时才转换为本地时间。
+ */
+class Clock {
+public:
+    /**
+     * @brief 虚析构函数
+     */
+    virtual ~Clock() = default;
+
+    /**
+     * @brief 获取单调时钟读数
+     *
+     * 只保证单调递增，适合计算时间间隔，不对应任何日历时间。
+     *
+     * @return 毫秒数
+     */
+    virtual qint64 monotonicMs() const = 0;
+
+    /**
+     * @brief 获取当前UTC时间
+     * @return 自1970-01-01T00:00:00Z起的毫秒数
+     */
+    virtual qint64 utcMs() const = 0;
+
+    /**
+     * @brief 获取当前UTC时间
+     * @return UTC时区的 QDateTime
+     */
+    QDateTime nowUtc() const;
+
+    /**
+     * @brief 获取当前本地日期
+     *
+     * 涉及时区换算，只应在按自然日统计时每次调用一次，不应在逐条记录的循环中使用。
+     *
+     * @return 本地日期
+     */
+    QDate today() const;
+
+    /**
+     * @brief 获取系统时钟
+     * @return 进程内共享的系统时钟实例
+     */
+    static Clock* system();
+};
+
+/**
+ * @brief 系统时钟
+ *
+ * 单调读数来自 QElapsedTimer。UTC时间由启动时记录的墙钟偏移加上单调读数得到，
+ * 不需要每次读取墙钟，也不会因为系统时间被回拨而倒退；每隔一段时间与墙钟重新对齐一次。
+ */
+class SystemClock : public Clock {
+public:
+    /**
+     * @brief 构造函数
+     */
+    SystemClock();
+
+    qint64 monotonicMs() const override;
+    qint64 utcMs() const override;
+
+private:
+    //!< 与墙钟重新对齐的间隔（毫秒）
+    static const qint64 RESYNC_INTERVAL_MS = 60 * 1000;
+
+    //!< 单调计时器
+    QElapsedTimer m_timer;
+
+    //!< UTC毫秒与单调读数之间的偏移
+    mutable std::atomic<qint64> m_offsetMs;
+
+    //!< 上次对齐时的单调读数
+    mutable std::atomic<qint64> m_lastSyncMs;
+};
+
+/**
+ * @brief 虚拟时钟
+ *
+ * 时间只在调用 advance() 时前进，用于模拟多日流量或测试与时间相关的逻辑。
+ * 非线程安全，应在单个线程中驱动。
+ */
+class VirtualClock : public Clock {
+public:
+    /**
+     * @brief 构造函数
+     * @param start 起始UTC时间，无效时使用当前系统时间
+     */
+    explicit VirtualClock(const QDateTime& start = QDateTime());
+
+    qint64 monotonicMs() const override;
+    qint64 utcMs() const override;
+
+    /**
+     * @brief 推进虚拟时间
+     * @param ms 推进的毫秒数（负数会被忽略）
+     */
+    void advance(qint64 ms);
+
+    /**
+     * @brief 设置当前UTC时间
+     *
+     * 只影响UTC读数，单调读数保持不变。
+     *
+     * @param utc 新的当前时间
+     */
+    void setUtc(const QDateTime& utc);
+
+private:
+    //!< 单调读数（毫秒）
+    qint64 m_monotonicMs;
+
+    //!< UTC时间（毫秒）
+    qint64 m_utcMs;
+};
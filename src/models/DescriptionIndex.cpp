@@ -0,0 +1,206 @@
+/**
+ * @file DescriptionIndex.cpp
+ * @brief 交易描述全文索引实现
+ *
+ * 实现了DescriptionIndex类中定义的分词、索引和检索方法。
+ */
+#include "DescriptionIndex.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief 判断字符是否属于按二字词切分的中日韩文字
+ * @param ch 字符
+ * @return 是中日韩文字返回true
+ */
+bool isCjk(QChar ch)
+{
+    switch (ch.script()) {
+    case QChar::Script_Han:
+    case QChar::Script_Hiragana:
+    case QChar::Script_Katakana:
+    case QChar::Script_Hangul:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief 检索过程中的候选结果
+ */
+struct Candidate {
+    int row;        //!< 交易在账本中的下标
+    double score;   //!< 已累计的相关度
+};
+
+} // namespace
+
+QStringList DescriptionIndex::tokenize(const QString& text)
+{
+    QStringList tokens;
+    const QString folded = text.toCaseFolded();
+    const int length = folded.size();
+
+    int i = 0;
+    while (i < length) {
+        const QChar ch = folded.at(i);
+        if (isCjk(ch)) {
+            int end = i + 1;
+            while (end < length && isCjk(folded.at(end))) {
+                ++end;
+            }
+            if (end - i == 1) {
+                tokens.append(folded.mid(i, 1));
+            } else {
+                for (int k = i; k + 1 < end; ++k) {
+                    tokens.append(folded.mid(k, 2));
+                }
+            }
+            i = end;
+        } else if (ch.isLetterOrNumber()) {
+            int end = i + 1;
+            while (end < length && folded.at(end).isLetterOrNumber() && !isCjk(folded.at(end))) {
+                ++end;
+            }
+            tokens.append(folded.mid(i, end - i));
+            i = end;
+        } else {
+            ++i;
+        }
+    }
+    return tokens;
+}
+
+void DescriptionIndex::add(int row, const QString& description)
+{
+    const QStringList tokens = tokenize(description);
+
+    QHash<QString, int> frequencies;
+    for (const QString& token : tokens) {
+        ++frequencies[token];
+    }
+    for (auto it = frequencies.constBegin(); it != frequencies.constEnd(); ++it) {
+        m_postings[it.key()].append(Posting{row, it.value()});
+    }
+
+    if (row >= m_lengths.size()) {
+        m_lengths.resize(row + 1);
+    }
+    m_lengths[row] = tokens.size();
+    m_totalLength += tokens.size();
+    ++m_documentCount;
+}
+
+void DescriptionIndex::clear()
+{
+    m_postings.clear();
+    m_lengths.clear();
+    m_documentCount = 0;
+    m_totalLength = 0;
+}
+
+QVector<DescriptionIndex::Hit> DescriptionIndex::search(const QString& query, int limit,
+                                                        const QVector<int>* rows) const
+{
+    if (limit <= 0 || m_documentCount == 0) {
+        return {};
+    }
+
+    QStringList tokens = tokenize(query);
+    tokens.removeDuplicates();
+    if (tokens.isEmpty()) {
+        return {};
+    }
+
+    // 任一词不存在即无结果；其余按倒排表长度升序求交集，候选集尽早缩小
+    QVector<const QVector<Posting>*> lists;
+    for (const QString& token : tokens) {
+        auto found = m_postings.constFind(token);
+        if (found == m_postings.constEnd()) {
+            return {};
+        }
+        lists.append(&found.value());
+    }
+    std::sort(lists.begin(), lists.end(), [](const QVector<Posting>* a, const QVector<Posting>* b) {
+        return a->size() < b->size();
+    });
+
+    const double documents = m_documentCount;
+    const double averageLength = qMax(1.0, double(m_totalLength) / documents);
+    auto termScore = [&](const QVector<Posting>& list, const Posting& posting) {
+        const double df = list.size();
+        const double idf = std::log(1.0 + (documents - df + 0.5) / (df + 0.5));
+        const double tf = posting.frequency;
+        const double norm = 1.0 - BM25_B + BM25_B * m_lengths.at(posting.row) / averageLength;
+        return idf * tf * (BM25_K1 + 1.0) / (tf + BM25_K1 * norm);
+    };
+
+    // 候选集与一个倒排表求交集（两边都按下标递增，游标只前进）
+    auto intersect = [&](QVector<Candidate>& candidates, const QVector<Posting>& list) {
+        int kept = 0;
+        auto cursor = list.cbegin();
+        for (int i = 0; i < candidates.size(); ++i) {
+            const Candidate candidate = candidates.at(i);
+            cursor = std::lower_bound(cursor, list.cend(), candidate.row,
+                                      [](const Posting& posting, int row) { return posting.row < row; });
+            if (cursor == list.cend()) {
+                break;
+            }
+            if (cursor->row == candidate.row) {
+                candidates[kept++] = Candidate{candidate.row, candidate.score + termScore(list, *cursor)};
+            }
+        }
+        candidates.resize(kept);
+    };
+
+    QVector<Candidate> candidates;
+    int next = 0;
+    if (rows && rows->size() < lists.first()->size()) {
+        // 限定范围比最短的倒排表还小：从限定范围出发
+        candidates.reserve(rows->size());
+        for (int row : *rows) {
+            candidates.append(Candidate{row, 0.0});
+        }
+    } else {
+        const QVector<Posting>& first = *lists.first();
+        candidates.reserve(first.size());
+        auto rowCursor = rows ? rows->cbegin() : QVector<int>::const_iterator();
+        for (const Posting& posting : first) {
+            if (rows) {
+                rowCursor = std::lower_bound(rowCursor, rows->cend(), posting.row);
+                if (rowCursor == rows->cend()) {
+                    break;
+                }
+                if (*rowCursor != posting.row) {
+                    continue;
+                }
+            }
+            candidates.append(Candidate{posting.row, termScore(first, posting)});
+        }
+        next = 1;
+    }
+
+    for (int i = next; i < lists.size() && !candidates.isEmpty(); ++i) {
+        intersect(candidates, *lists.at(i));
+    }
+
+    // 只需要前 limit 条，部分排序即可
+    const int count = qMin(limit, int(candidates.size()));
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                      [](const Candidate& a, const Candidate& b) {
+                          if (a.score != b.score) {
+                              return a.score > b.score;
+                          }
+                          return a.row > b.row;
+                      });
+
+    QVector<Hit> hits;
+    hits.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        hits.append(Hit{candidates.at(i).row, candidates.at(i).score});
+    }
+    return hits;
+}
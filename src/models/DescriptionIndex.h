@@ -0,0 +1,102 @@
+/**
+ * @file DescriptionIndex.h
+ * @brief 交易描述全文索引
+ *
+ * 对交易描述建立倒排索引，支持按关键词检索并按相关度排序。
+ */
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief 交易描述全文索引
+ *
+ * 分词规则：
+ * - 连续的中日韩文字切成相邻二字词（"转账给" → "转账"、"账给"），单独一个字时保留单字
+ * - 连续的字母或数字作为一个词，统一转为小写
+ * - 其他字符（空格、标点等）作为分隔符
+ *
+ * 文档以交易在账本中的下标标识，倒排表按下标递增保存，追加新交易时只需在各词的
+ * 倒排表末尾追加。查询时所有词都必须出现（取倒排表交集，从最短的开始），
+ * 命中结果按 BM25 相关度排序，相关度相同时较新的交易在前。
+ */
+class DescriptionIndex {
+public:
+    /**
+     * @brief 一条命中结果
+     */
+    struct Hit {
+        int row;        //!< 交易在账本中的下标
+        double score;   //!< 相关度
+    };
+
+    /**
+     * @brief 把文本切分为索引词
+     * @param text 文本
+     * @return 索引词（按出现顺序，可能重复）
+     */
+    static QStringList tokenize(const QString& text);
+
+    /**
+     * @brief 索引一条交易描述
+     * @param row 交易在账本中的下标（必须大于已索引的下标）
+     * @param description 交易描述
+     */
+    void add(int row, const QString& description);
+
+    /**
+     * @brief 清空索引
+     */
+    void clear();
+
+    /**
+     * @brief 检索
+     * @param query 查询文本（按 tokenize() 分词，所有词都必须出现）
+     * @param limit 最多返回的结果数
+     * @param rows 只在这些下标中检索（按递增排序），为nullptr时检索全部
+     * @return 命中结果（按相关度降序）
+     */
+    QVector<Hit> search(const QString& query, int limit, const QVector<int>* rows = nullptr) const;
+
+    /**
+     * @brief 获取已索引的交易数
+     * @return 交易数
+     */
+    int documentCount() const { return m_documentCount; }
+
+    /**
+     * @brief 获取不同索引词的数量
+     * @return 索引词数
+     */
+    int termCount() const { return m_postings.size(); }
+
+private:
+    /**
+     * @brief 倒排表中的一项
+     */
+    struct Posting {
+        int row;            //!< 交易在账本中的下标
+        int frequency;      //!< 词在该描述中出现的次数
+    };
+
+    //!< BM25 词频饱和参数
+    static constexpr double BM25_K1 = 1.2;
+
+    //!< BM25 长度归一化参数
+    static constexpr double BM25_B = 0.75;
+
+    //!< 索引词到倒排表的映射
+    QHash<QString, QVector<Posting>> m_postings;
+
+    //!< 每条交易描述的词数（按下标）
+    QVector<int> m_lengths;
+
+    //!< 已索引的交易数
+    int m_documentCount = 0;
+
+    //!< 全部描述的词数之和
+    qint64 m_totalLength = 0;
+};
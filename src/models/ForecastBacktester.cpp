@@ -0,0 +1,208 @@
+/**
+ * @file ForecastBacktester.cpp
+ * @brief 余额预测模型回测实现
+ *
+ * 实现了ForecastBacktester类中定义的并行回测和报告方法。
+ */
+#include "ForecastBacktester.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+//!< 实际余额低于该值时不计算百分比误差，避免除以接近零的数
+const double kMinPercentBase = 1.0;
+
+//!< 每个线程分得的卡号块数，块数多于线程数以平衡各卡历史长度的差异
+const int kChunksPerThread = 4;
+
+/**
+ * @brief 一个分块的回测结果
+ */
+struct ChunkResult {
+    int cards = 0;                  //!< 参与回测的卡数
+    QVector<ForecastScore> scores;  //!< 各模型的误差
+};
+
+} // namespace
+
+double ForecastScore::meanAbsoluteError() const
+{
+    return samples > 0 ? absoluteErrorSum / samples : 0.0;
+}
+
+double ForecastScore::meanAbsolutePercentError() const
+{
+    return percentSamples > 0 ? percentErrorSum * 100.0 / percentSamples : 0.0;
+}
+
+double ForecastScore::bandCoverage() const
+{
+    return bandSamples > 0 ? double(bandHits) / bandSamples : 0.0;
+}
+
+void ForecastScore::merge(const ForecastScore& other)
+{
+    samples += other.samples;
+    absoluteErrorSum += other.absoluteErrorSum;
+    percentSamples += other.percentSamples;
+    percentErrorSum += other.percentErrorSum;
+    bandSamples += other.bandSamples;
+    bandHits += other.bandHits;
+}
+
+QString ForecastScore::toString() const
+{
+    QString text = QString("%1: MAE %2, MAPE %3%, %4 次预测")
+        .arg(model, QString::number(meanAbsoluteError(), 'f', 2),
+             QString::number(meanAbsolutePercentError(), 'f', 2))
+        .arg(samples);
+    if (bandSamples > 0) {
+        text += QString(", 区间覆盖率 %1%").arg(QString::number(bandCoverage() * 100.0, 'f', 1));
+    }
+    return text;
+}
+
+QString ForecastBacktestReport::bestModel() const
+{
+    const ForecastScore* best = nullptr;
+    for (const ForecastScore& score : scores) {
+        if (score.samples == 0) {
+            continue;
+        }
+        if (!best || score.meanAbsoluteError() < best->meanAbsoluteError()) {
+            best = &score;
+        }
+    }
+    return best ? best->model : QString();
+}
+
+double ForecastBacktestReport::cardsPerSecond() const
+{
+    if (elapsedMs <= 0) {
+        return 0.0;
+    }
+    return cardsTested * 1000.0 / elapsedMs;
+}
+
+QString ForecastBacktestReport::summary() const
+{
+    const QString best = bestModel();
+    return QString("预测模型回测: %1 张卡, 预测 %2 天, 最优模型 %3, %4 个线程, 耗时 %5 ms (%6 张卡/秒)")
+        .arg(cardsTested)
+        .arg(horizonDays)
+        .arg(best.isEmpty() ? QString("无") : best)
+        .arg(threads)
+        .arg(elapsedMs)
+        .arg(qRound64(cardsPerSecond()));
+}
+
+ForecastBacktester::ForecastBacktester(int horizonDays, int stride, int maxOriginsPerCard, int threads)
+    : m_horizonDays(qMax(1, horizonDays))
+    , m_stride(qMax(1, stride))
+    , m_maxOriginsPerCard(qMax(1, maxOriginsPerCard))
+    , m_threads(threads > 0 ? threads : qMax(1, QThread::idealThreadCount()))
+{
+}
+
+ForecastBacktestReport ForecastBacktester::run(const QVector<BalanceHistory>& histories,
+                                               const QVector<const IBalanceForecaster*>& forecasters) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    ForecastBacktestReport report;
+    report.horizonDays = m_horizonDays;
+    report.threads = m_threads;
+
+    // 所有模型共用起点，起点之前的历史要满足最挑剔的模型
+    int minimumHistory = 1;
+    QVector<ForecastScore> emptyScores;
+    for (const IBalanceForecaster* forecaster : forecasters) {
+        minimumHistory = qMax(minimumHistory, forecaster->minimumHistory());
+        ForecastScore score;
+        score.model = forecaster->name();
+        emptyScores.append(score);
+    }
+
+    const int chunkCount = qBound(1, int(histories.size()), m_threads * kChunksPerThread);
+    QVector<ChunkResult> results(chunkCount);
+    for (ChunkResult& result : results) {
+        result.scores = emptyScores;
+    }
+
+    auto backtestChunk = [&](int chunk) {
+        const int begin = int(qint64(histories.size()) * chunk / chunkCount);
+        const int end = int(qint64(histories.size()) * (chunk + 1) / chunkCount);
+        ChunkResult& result = results[chunk];
+
+        for (int card = begin; card < end; ++card) {
+            const BalanceHistory& history = histories.at(card);
+            bool tested = false;
+
+            // 起点 count 表示使用前 count 天，实际值为第 count - 1 + horizon 天
+            int origins = 0;
+            for (int count = history.balances.size() - m_horizonDays;
+                 count >= minimumHistory && origins < m_maxOriginsPerCard;
+                 count -= m_stride, ++origins) {
+                const double actual = history.balances.at(count - 1 + m_horizonDays);
+                for (int model = 0; model < forecasters.size(); ++model) {
+                    const BalanceForecast predicted = forecasters.at(model)->forecast(history, count, m_horizonDays);
+                    const double error = std::fabs(predicted.balance - actual);
+
+                    ForecastScore& score = result.scores[model];
+                    ++score.samples;
+                    score.absoluteErrorSum += error;
+                    if (std::fabs(actual) >= kMinPercentBase) {
+                        ++score.percentSamples;
+                        score.percentErrorSum += error / std::fabs(actual);
+                    }
+                    if (predicted.hasBand()) {
+                        ++score.bandSamples;
+                        if (actual >= predicted.lower && actual <= predicted.upper) {
+                            ++score.bandHits;
+                        }
+                    }
+                }
+                tested = true;
+            }
+
+            if (tested) {
+                ++result.cards;
+            }
+        }
+    };
+
+    if (chunkCount == 1 || m_threads == 1) {
+        for (int i = 0; i < chunkCount; ++i) {
+            backtestChunk(i);
+        }
+    } else {
+        QVector<int> indices(chunkCount);
+        std::iota(indices.begin(), indices.end(), 0);
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(m_threads);
+        QtConcurrent::blockingMap(&pool, indices, backtestChunk);
+    }
+
+    report.scores = emptyScores;
+    for (const ChunkResult& result : results) {
+        report.cardsTested += result.cards;
+        for (int model = 0; model < result.scores.size(); ++model) {
+            report.scores[model].merge(result.scores.at(model));
+        }
+    }
+    report.elapsedMs = timer.elapsed();
+
+    qDebug() << report.summary();
+    for (const ForecastScore& score : report.scores) {
+        qDebug() << "  " << score.toString();
+    }
+    return report;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file ForecastBacktester.h
+ * @brief 余额预测模型回测
+ *
+ * 在全部卡号的历史余额上重放预测，比较各预测模型的误差。
+ */
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include "IBalanceForecaster.h"
+
+/**
+ * @brief 一个预测模型的回测误差
+ */
+struct ForecastScore {
+    QString model;                  //!< 模型名称
+    qint64 samples = 0;             //!< 预测次数
+    double absoluteErrorSum = 0.0;  //!< 绝对误差之和
+    qint64 percentSamples = 0;      //!< 参与百分比误差的预测次数（实际余额不为零）
+    double percentErrorSum = 0.0;   //!< 绝对百分比误差之和
+    qint64 bandSamples = 0;         //!< 带预测区间的预测次数
+    qint64 bandHits = 0;            //!< 实际余额落在区间内的次数
+
+    /**
+     * @brief 平均绝对误差（MAE）
+     * @return 误差（元），没有样本时为0
+     */
+    double meanAbsoluteError() const;
+
+    /**
+     * @brief 平均绝对百分比误差（MAPE）
+     * @return 误差（百分比），没有样本时为0
+     */
+    double meanAbsolutePercentError() const;
+
+    /**
+     * @brief 预测区间覆盖率
+     * @return 落在区间内的比例（0-1），模型不提供区间时为0
+     */
+    double bandCoverage() const;
+
+    /**
+     * @brief 合并另一部分样本的误差
+     * @param other 同一模型的另一部分误差
+     */
+    void merge(const ForecastScore& other);
+
+    /**
+     * @brief 生成可读的描述
+     * @return 描述文本
+     */
+    QString toString() const;
+};
+
+/**
+ * @brief 回测报告
+ */
+struct ForecastBacktestReport {
+    int cardsTested = 0;            //!< 参与回测的卡数（历史足够长的卡）
+    int horizonDays = 0;            //!< 预测天数
+    int threads = 0;                //!< 使用的线程数
+    qint64 elapsedMs = 0;           //!< 耗时（毫秒）
+    QVector<ForecastScore> scores;  //!< 各模型的误差（与传入模型顺序相同）
+
+    /**
+     * @brief 获取平均绝对误差最小的模型
+     * @return 模型名称，没有任何样本时为空
+     */
+    QString bestModel() const;
+
+    /**
+     * @brief 回测吞吐量
+     * @return 每秒回测的卡数
+     */
+    double cardsPerSecond() const;
+
+    /**
+     * @brief 生成一行摘要
+     * @return 摘要文本
+     */
+    QString summary() const;
+};
+
+/**
+ * @brief 余额预测模型回测器
+ *
+ * 对每张卡的每日余额序列选取若干预测起点（最近的起点优先，间隔 stride 天）：
+ * 用起点之前的历史预测 horizonDays 天后的余额，与序列中的实际余额比较。
+ * 所有模型使用相同的起点，起点之前的历史不少于各模型所需天数的最大值。
+ *
+ * 卡号分块交给线程池，每块单独累计误差，最后按模型合并。
+ */
+class ForecastBacktester {
+public:
+    /**
+     * @brief 构造函数
+     * @param horizonDays 预测天数
+     * @param stride 相邻预测起点的间隔天数
+     * @param maxOriginsPerCard 每张卡最多的预测起点数
+     * @param threads 线程数，0 表示使用 QThread::idealThreadCount()
+     */
+    ForecastBacktester(int horizonDays, int stride, int maxOriginsPerCard, int threads = 0);
+
+    /**
+     * @brief 执行回测
+     * @param histories 各卡的每日余额序列
+     * @param forecasters 参与比较的模型
+     * @return 回测报告
+     */
+    ForecastBacktestReport run(const QVector<BalanceHistory>& histories,
+                               const QVector<const IBalanceForecaster*>& forecasters) const;
+
+private:
+    int m_horizonDays;          //!< 预测天数
+    int m_stride;               //!< 预测起点间隔
+    int m_maxOriginsPerCard;    //!< 每张卡最多的预测起点数
+    int m_threads;              //!< 线程数
+};
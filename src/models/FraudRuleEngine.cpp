@@ -0,0 +1,124 @@
+/**
+ * @file FraudRuleEngine.cpp
+ * @brief 风控规则引擎实现
+ *
+ * 实现了FraudRuleEngine类中定义的规则评估和状态维护方法。
+ */
+#include "FraudRuleEngine.h"
+#include "FraudRules.h"
+#include <QDebug>
+
+FraudRuleEngine::FraudRuleEngine(const Clock* clock)
+    : FraudRuleEngine(clock, Config())
+{
+}
+
+FraudRuleEngine::FraudRuleEngine(const Clock* clock, const Config& config)
+    : m_clock(clock ? clock : Clock::system())
+    , m_config(config)
+{
+    compileRules();
+}
+
+FraudRuleEngine::~FraudRuleEngine() = default;
+
+void FraudRuleEngine::setClock(const Clock* clock)
+{
+    m_clock = clock ? clock : Clock::system();
+}
+
+void FraudRuleEngine::addRule(std::unique_ptr<IFraudRule> rule)
+{
+    if (rule) {
+        m_rules.push_back(std::move(rule));
+    }
+}
+
+OperationResult FraudRuleEngine::evaluate(const QString& cardNumber, TransactionType type,
+                                          double amount, const QString& targetCard) const
+{
+    static const FraudCardState emptyState;
+
+    const FraudEvent event{cardNumber, type, amount, targetCard, m_clock->utcMs()};
+    auto found = m_states.constFind(cardNumber);
+    const FraudCardState& state = found != m_states.constEnd() ? found.value() : emptyState;
+
+    for (const auto& rule : m_rules) {
+        OperationResult result = rule->evaluate(event, state);
+        if (!result.success) {
+            qWarning() << "风控规则命中:" << rule->name() << "卡号:" << cardNumber << "金额:" << amount;
+            return result;
+        }
+    }
+    return OperationResult::Success();
+}
+
+void FraudRuleEngine::record(const QString& cardNumber, TransactionType type,
+                             double amount, const QString& targetCard)
+{
+    record(FraudEvent{cardNumber, type, amount, targetCard, m_clock->utcMs()});
+}
+
+void FraudRuleEngine::record(const FraudEvent& event)
+{
+    FraudCardState& state = m_states[event.cardNumber];
+    state.outflows.push(event.utcMs);
+
+    if (event.type == TransactionType::Transfer && !event.targetCard.isEmpty()) {
+        if (!state.isKnownTarget(event.targetCard)) {
+            state.newTargets.push(event.utcMs);
+
+            // 超出上限时淘汰最久未转账的卡号
+            if (state.knownTargets.size() >= FraudCardState::MAX_KNOWN_TARGETS) {
+                auto oldest = state.knownTargets.begin();
+                for (auto it = state.knownTargets.begin(); it != state.knownTargets.end(); ++it) {
+                    if (it.value() < oldest.value()) {
+                        oldest = it;
+                    }
+                }
+                state.knownTargets.erase(oldest);
+            }
+        }
+        state.knownTargets.insert(event.targetCard, event.utcMs);
+    }
+
+    // 样本较少时为算术平均，之后为指数加权平均，适应消费水平的缓慢变化
+    if (state.sampleCount < MEAN_HORIZON) {
+        ++state.sampleCount;
+    }
+    state.meanAmount += (event.amount - state.meanAmount) / state.sampleCount;
+}
+
+void FraudRuleEngine::rebuild(const QVector<Transaction>& transactions)
+{
+    m_states.clear();
+
+    int counted = 0;
+    for (const Transaction& transaction : transactions) {
+        if (transaction.type != TransactionType::Withdrawal && transaction.type != TransactionType::Transfer) {
+            continue;
+        }
+        if (!transaction.timestamp.isValid()) {
+            continue;
+        }
+        record(FraudEvent{transaction.cardNumber, transaction.type, transaction.amount,
+                          transaction.targetCardNumber, transaction.timestamp.toMSecsSinceEpoch()});
+        ++counted;
+    }
+
+    qDebug() << "风控状态已从账本重建:" << m_states.size() << "张卡," << counted << "笔交易";
+}
+
+void FraudRuleEngine::forget(const QString& cardNumber)
+{
+    m_states.remove(cardNumber);
+}
+
+void FraudRuleEngine::compileRules()
+{
+    m_rules.clear();
+    m_rules.push_back(std::make_unique<OutflowVelocityRule>(m_config.maxOutflows, m_config.outflowWindowMs));
+    m_rules.push_back(std::make_unique<NewTransferTargetRule>(m_config.maxNewTargets, m_config.newTargetWindowMs));
+    m_rules.push_back(std::make_unique<AmountSpikeRule>(m_config.spikeMultiple, m_config.spikeMinSamples,
+                                                        m_config.spikeMinAmount));
+}
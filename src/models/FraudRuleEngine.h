@@ -0,0 +1,144 @@
+/**
+ * @file FraudRuleEngine.h
+ * @brief 风控规则引擎
+ *
+ * 在取款和转账执行前按卡号的滑动窗口状态评估风控规则。
+ */
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <memory>
+#include <vector>
+#include "Clock.h"
+#include "IFraudRule.h"
+#include "OperationResult.h"
+#include "Transaction.h"
+
+/**
+ * @brief 风控规则引擎
+ *
+ * 规则对象在构造时按 Config 生成一次，之后每次评估只做一次哈希查找和
+ * 若干固定大小窗口的扫描，与账本规模无关。每卡状态在取款或转出成功后
+ * 通过 record() 增量更新，启动时通过 rebuild() 从账本重建。
+ *
+ * 评估不修改状态，因此可以放在校验器的const方法中调用。
+ */
+class FraudRuleEngine {
+public:
+    /**
+     * @brief 内置规则参数
+     */
+    struct Config {
+        int maxOutflows = 8;                            //!< 窗口内最多取款和转出次数
+        qint64 outflowWindowMs = 10 * 60 * 1000;        //!< 取款频率窗口（毫秒）
+        int maxNewTargets = 3;                          //!< 窗口内最多新收款卡号数
+        qint64 newTargetWindowMs = 60 * 60 * 1000;      //!< 新收款账户窗口（毫秒）
+        double spikeMultiple = 10.0;                    //!< 金额突增倍数
+        int spikeMinSamples = 5;                        //!< 金额突增规则所需的最少历史笔数
+        double spikeMinAmount = 1000.0;                 //!< 金额突增规则的最小金额
+    };
+
+    /**
+     * @brief 构造函数，使用默认参数生成内置规则
+     * @param clock 时间来源
+     */
+    explicit FraudRuleEngine(const Clock* clock = Clock::system());
+
+    /**
+     * @brief 构造函数
+     * @param clock 时间来源
+     * @param config 内置规则参数
+     */
+    FraudRuleEngine(const Clock* clock, const Config& config);
+
+    /**
+     * @brief 析构函数
+     */
+    ~FraudRuleEngine();
+
+    /**
+     * @brief 设置时间来源
+     * @param clock 时钟，为空时使用系统时钟
+     */
+    void setClock(const Clock* clock);
+
+    /**
+     * @brief 添加自定义规则
+     * @param rule 规则对象（所有权转移给引擎）
+     */
+    void addRule(std::unique_ptr<IFraudRule> rule);
+
+    /**
+     * @brief 获取规则数
+     * @return 规则数
+     */
+    int ruleCount() const { return static_cast<int>(m_rules.size()); }
+
+    /**
+     * @brief 评估一笔待执行的取款或转账
+     * @param cardNumber 卡号
+     * @param type 交易类型
+     * @param amount 金额
+     * @param targetCard 收款卡号（转账时有效）
+     * @return 全部规则通过返回成功，否则返回第一条命中规则的原因
+     */
+    OperationResult evaluate(const QString& cardNumber, TransactionType type,
+                             double amount, const QString& targetCard = QString()) const;
+
+    /**
+     * @brief 记录一笔成功的取款或转出（使用当前时间）
+     * @param cardNumber 卡号
+     * @param type 交易类型
+     * @param amount 金额
+     * @param targetCard 收款卡号（转账时有效）
+     */
+    void record(const QString& cardNumber, TransactionType type,
+                double amount, const QString& targetCard = QString());
+
+    /**
+     * @brief 记录一笔取款或转出
+     * @param event 事件
+     */
+    void record(const FraudEvent& event);
+
+    /**
+     * @brief 从账本重建全部卡的状态
+     * @param transactions 交易记录（按时间顺序，只使用取款和转出）
+     */
+    void rebuild(const QVector<Transaction>& transactions);
+
+    /**
+     * @brief 丢弃卡号的状态
+     * @param cardNumber 卡号
+     */
+    void forget(const QString& cardNumber);
+
+    /**
+     * @brief 获取有状态的卡数
+     * @return 卡数
+     */
+    int trackedCards() const { return m_states.size(); }
+
+private:
+    /**
+     * @brief 按参数生成内置规则
+     */
+    void compileRules();
+
+    //!< 滑动平均值的最大有效样本数，超过后按指数加权平均更新
+    static const int MEAN_HORIZON = 50;
+
+    //!< 时间来源
+    const Clock* m_clock;
+
+    //!< 内置规则参数
+    Config m_config;
+
+    //!< 规则列表（按评估顺序）
+    std::vector<std::unique_ptr<IFraudRule>> m_rules;
+
+    //!< 卡号到风控状态的映射
+    QHash<QString, FraudCardState> m_states;
+};
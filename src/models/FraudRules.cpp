@@ -0,0 +1,75 @@
+/**
+ * @file FraudRules.cpp
+ * @brief 内置风控规则实现
+ *
+ * 实现了FraudRules.h中定义的各条规则的评估方法。
+ */
+#include "FraudRules.h"
+
+OutflowVelocityRule::OutflowVelocityRule(int maxCount, qint64 windowMs)
+    : m_maxCount(qBound(1, maxCount, int(FraudEventWindow::CAPACITY)))
+    , m_windowMs(windowMs)
+{
+}
+
+QString OutflowVelocityRule::name() const
+{
+    return "OutflowVelocity";
+}
+
+OperationResult OutflowVelocityRule::evaluate(const FraudEvent& event, const FraudCardState& state) const
+{
+    if (state.outflows.countSince(event.utcMs - m_windowMs) >= m_maxCount) {
+        return OperationResult::Failure(QString("%1分钟内取款或转账次数过多，请稍后再试")
+                                        .arg(m_windowMs / 60000));
+    }
+    return OperationResult::Success();
+}
+
+NewTransferTargetRule::NewTransferTargetRule(int maxNewTargets, qint64 windowMs)
+    : m_maxNewTargets(qBound(1, maxNewTargets, int(FraudEventWindow::CAPACITY)))
+    , m_windowMs(windowMs)
+{
+}
+
+QString NewTransferTargetRule::name() const
+{
+    return "NewTransferTarget";
+}
+
+OperationResult NewTransferTargetRule::evaluate(const FraudEvent& event, const FraudCardState& state) const
+{
+    if (event.type != TransactionType::Transfer || event.targetCard.isEmpty()) {
+        return OperationResult::Success();
+    }
+    if (state.isKnownTarget(event.targetCard)) {
+        return OperationResult::Success();
+    }
+    if (state.newTargets.countSince(event.utcMs - m_windowMs) >= m_maxNewTargets) {
+        return OperationResult::Failure("短时间内向过多新账户转账，请稍后再试");
+    }
+    return OperationResult::Success();
+}
+
+AmountSpikeRule::AmountSpikeRule(double multiple, int minSamples, double minAmount)
+    : m_multiple(multiple)
+    , m_minSamples(minSamples)
+    , m_minAmount(minAmount)
+{
+}
+
+QString AmountSpikeRule::name() const
+{
+    return "AmountSpike";
+}
+
+OperationResult AmountSpikeRule::evaluate(const FraudEvent& event, const FraudCardState& state) const
+{
+    if (state.sampleCount < m_minSamples || event.amount < m_minAmount) {
+        return OperationResult::Success();
+    }
+    if (event.amount > state.meanAmount * m_multiple) {
+        return OperationResult::Failure("交易金额明显高于该卡的历史水平，请到柜台办理");
+    }
+    return OperationResult::Success();
+}
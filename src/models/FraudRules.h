@@ -0,0 +1,78 @@
+/**
+ * @file FraudRules.h
+ * @brief 内置风控规则
+ *
+ * 定义了取款频率、新收款账户和金额突增三条内置风控规则。
+ */
+#pragma once
+
+#include "IFraudRule.h"
+
+/**
+ * @brief 取款频率规则
+ *
+ * 时间窗口内取款和转出的次数达到上限时拒绝新的资金流出。
+ */
+class OutflowVelocityRule : public IFraudRule {
+public:
+    /**
+     * @brief 构造函数
+     * @param maxCount 窗口内允许的最多次数（不超过 FraudEventWindow::CAPACITY）
+     * @param windowMs 窗口长度（毫秒）
+     */
+    OutflowVelocityRule(int maxCount, qint64 windowMs);
+
+    QString name() const override;
+    OperationResult evaluate(const FraudEvent& event, const FraudCardState& state) const override;
+
+private:
+    int m_maxCount;         //!< 窗口内允许的最多次数
+    qint64 m_windowMs;      //!< 窗口长度（毫秒）
+};
+
+/**
+ * @brief 新收款账户规则
+ *
+ * 时间窗口内向从未转账过的卡号转账的次数达到上限时，拒绝再向新卡号转账；
+ * 向已转账过的卡号转账不受影响。
+ */
+class NewTransferTargetRule : public IFraudRule {
+public:
+    /**
+     * @brief 构造函数
+     * @param maxNewTargets 窗口内允许的新收款卡号数（不超过 FraudEventWindow::CAPACITY）
+     * @param windowMs 窗口长度（毫秒）
+     */
+    NewTransferTargetRule(int maxNewTargets, qint64 windowMs);
+
+    QString name() const override;
+    OperationResult evaluate(const FraudEvent& event, const FraudCardState& state) const override;
+
+private:
+    int m_maxNewTargets;    //!< 窗口内允许的新收款卡号数
+    qint64 m_windowMs;      //!< 窗口长度（毫秒）
+};
+
+/**
+ * @brief 金额突增规则
+ *
+ * 金额超过该卡滑动平均值的指定倍数时拒绝。样本不足或金额较小时不触发。
+ */
+class AmountSpikeRule : public IFraudRule {
+public:
+    /**
+     * @brief 构造函数
+     * @param multiple 相对平均值的倍数
+     * @param minSamples 触发所需的最少历史笔数
+     * @param minAmount 触发所需的最小金额
+     */
+    AmountSpikeRule(double multiple, int minSamples, double minAmount);
+
+    QString name() const override;
+    OperationResult evaluate(const FraudEvent& event, const FraudCardState& state) const override;
+
+private:
+    double m_multiple;      //!< 相对平均值的倍数
+    int m_minSamples;       //!< 最少历史笔数
+    double m_minAmount;     //!< 最小金额
+};
@@ -10,6 +10,7 @@
 #include <QVector>
 #include <optional>
 #include "Account.h"
+#include "AccountTable.h"
 #include "OperationResult.h"
 
 /**
@@ -31,6 +32,16 @@ public:
      */
     virtual OperationResult saveAccount(const Account& account) = 0;
     
+    /**
+     * @brief 批量保存多个账户
+     *
+     * 所有账户在同一次提交中写入存储，要么全部成功要么全部失败。
+     *
+     * @param accounts 要保存的账户列表
+     * @return 操作结果
+     */
+    virtual OperationResult saveAccountsBatch(const QVector<Account>& accounts) = 0;
+    
     /**
      * @brief 删除账户
      * @param cardNumber 要删除的账户卡号
@@ -69,4 +80,15 @@ public:
      * @return 如果账户存在返回true，否则返回false
      */
     virtual bool accountExists(const QString& cardNumber) const = 0;
+    
+    /**
+     * @brief 获取列式账户表
+     *
+     * 将全部账户以列式表形式保存在内存中的实现可返回该表，
+     * 供全表扫描直接遍历所需的列；其他实现返回nullptr，调用方应回退到 getAllAccounts()。
+     * 修改账户仍需通过存储库接口。
+     *
+     * @return 账户表，不支持时返回nullptr
+     */
+    virtual const AccountTable* accountTable() const { return nullptr; }
 }; 
\ No newline at end of file
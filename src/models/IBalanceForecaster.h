@@ -0,0 +1,74 @@
+/**
+ * @file IBalanceForecaster.h
+ * @brief 余额预测模型接口
+ *
+ * 定义了余额预测模型的抽象接口，以及预测使用的每日余额序列和预测结果。
+ */
+#pragma once
+
+#include <QDate>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief 一张卡的每日余额序列
+ *
+ * balances[i] 是 firstDate + i 天结束时的余额，日期连续，最后一项是当天的余额。
+ */
+struct BalanceHistory {
+    QString cardNumber;         //!< 卡号
+    QDate firstDate;            //!< 第一项对应的日期
+    QVector<double> balances;   //!< 每日日终余额
+};
+
+/**
+ * @brief 一次余额预测的结果
+ *
+ * 不提供区间的模型上下界都等于预测值。
+ */
+struct BalanceForecast {
+    double balance = 0.0;   //!< 预测余额
+    double lower = 0.0;     //!< 区间下界
+    double upper = 0.0;     //!< 区间上界
+
+    /**
+     * @brief 是否带有预测区间
+     * @return 上界大于下界时返回true
+     */
+    bool hasBand() const { return upper > lower; }
+};
+
+/**
+ * @brief 余额预测模型接口
+ *
+ * 模型只依赖每日余额序列，不访问账户或交易数据，可以在回测时对同一序列的
+ * 不同前缀反复调用，也可以在多个线程中同时调用（实现不得修改自身状态）。
+ */
+class IBalanceForecaster {
+public:
+    /**
+     * @brief 虚析构函数
+     */
+    virtual ~IBalanceForecaster() = default;
+
+    /**
+     * @brief 获取模型名称（用于选择模型和输出报告）
+     * @return 模型名称
+     */
+    virtual QString name() const = 0;
+
+    /**
+     * @brief 获取预测所需的最少天数
+     * @return 天数
+     */
+    virtual int minimumHistory() const = 0;
+
+    /**
+     * @brief 预测余额
+     * @param history 每日余额序列
+     * @param count 只使用序列的前 count 天（不小于 minimumHistory()，回测时截断历史无需复制）
+     * @param daysAhead 预测第 count 天之后多少天的余额
+     * @return 预测结果
+     */
+    virtual BalanceForecast forecast(const BalanceHistory& history, int count, int daysAhead) const = 0;
+};
@@ -0,0 +1,119 @@
+/**
+ * @file IFraudRule.h
+ * @brief 风控规则接口
+ *
+ * 定义了风控规则的抽象接口，以及规则评估时使用的交易事件和每卡滑动窗口状态。
+ */
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <array>
+#include "OperationResult.h"
+#include "Transaction.h"
+
+/**
+ * @brief 待评估或待记录的资金流出事件
+ */
+struct FraudEvent {
+    QString cardNumber;     //!< 卡号
+    TransactionType type;   //!< 交易类型（取款或转账）
+    double amount;          //!< 金额
+    QString targetCard;     //!< 收款卡号（转账时有效）
+    qint64 utcMs;           //!< 发生时间（UTC毫秒）
+};
+
+/**
+ * @brief 固定容量的事件时间窗口
+ *
+ * 环形保存最近 CAPACITY 个事件的时间，统计窗口内事件数的开销为常数。
+ * 规则的次数阈值不能超过该容量。
+ */
+struct FraudEventWindow {
+    static const int CAPACITY = 16;             //!< 最多保留的事件数
+
+    std::array<qint64, CAPACITY> times{};       //!< 事件时间（UTC毫秒）
+    int next = 0;                               //!< 下一个写入位置
+    int size = 0;                               //!< 已保存的事件数
+
+    /**
+     * @brief 记录一个事件
+     * @param utcMs 事件时间
+     */
+    void push(qint64 utcMs)
+    {
+        times[next] = utcMs;
+        next = (next + 1) % CAPACITY;
+        if (size < CAPACITY) {
+            ++size;
+        }
+    }
+
+    /**
+     * @brief 统计指定时间之后（含）的事件数
+     * @param sinceMs 起始时间
+     * @return 事件数
+     */
+    int countSince(qint64 sinceMs) const
+    {
+        int count = 0;
+        for (int i = 0; i < size; ++i) {
+            if (times[i] >= sinceMs) {
+                ++count;
+            }
+        }
+        return count;
+    }
+};
+
+/**
+ * @brief 单张卡的风控状态
+ *
+ * 由 FraudRuleEngine 在每笔成功的取款或转出后增量更新，规则只读取。
+ */
+struct FraudCardState {
+    static const int MAX_KNOWN_TARGETS = 32;    //!< 最多记住的收款卡号数
+
+    FraudEventWindow outflows;                  //!< 取款和转出的时间
+    FraudEventWindow newTargets;                //!< 向新收款卡号转账的时间
+    QHash<QString, qint64> knownTargets;        //!< 收款卡号到最近一次转账时间
+    qint64 sampleCount = 0;                     //!< 计入平均值的交易笔数
+    double meanAmount = 0.0;                    //!< 交易金额的滑动平均值
+
+    /**
+     * @brief 判断收款卡号是否曾经转账过
+     * @param targetCard 收款卡号
+     * @return 曾经转账过返回true
+     */
+    bool isKnownTarget(const QString& targetCard) const
+    {
+        return knownTargets.contains(targetCard);
+    }
+};
+
+/**
+ * @brief 风控规则接口
+ *
+ * 规则在构造时确定阈值，评估时只读取事件和该卡的窗口状态，不访问存储库或账本。
+ */
+class IFraudRule {
+public:
+    /**
+     * @brief 虚析构函数
+     */
+    virtual ~IFraudRule() = default;
+
+    /**
+     * @brief 获取规则名称（用于日志）
+     * @return 规则名称
+     */
+    virtual QString name() const = 0;
+
+    /**
+     * @brief 评估事件
+     * @param event 待执行的交易
+     * @param state 该卡的风控状态（此前没有记录的卡为空状态）
+     * @return 通过返回成功，命中规则返回失败及原因
+     */
+    virtual OperationResult evaluate(const FraudEvent& event, const FraudCardState& state) const = 0;
+};
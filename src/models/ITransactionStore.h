@@ -0,0 +1,63 @@
+/**
+ * @file ITransactionStore.h
+ * @brief 交易存储接口
+ *
+ * 定义了交易记录（账本）持久化的抽象接口，支持不同的后端存储实现。
+ */
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include "Transaction.h"
+
+/**
+ * @brief 交易存储接口
+ *
+ * TransactionModel 在内存中维护完整账本，通过该接口把变更写入具体后端
+ * （如JSON文件、SQLite数据库等）。整文件型后端可以忽略增量信息直接重写，
+ * 数据库型后端则只需写入新增或删除的行。
+ */
+class ITransactionStore {
+public:
+    /**
+     * @brief 虚析构函数
+     */
+    virtual ~ITransactionStore() = default;
+
+    /**
+     * @brief 加载全部交易记录
+     * @param transactions 输出参数，保存读取的交易记录
+     * @return 如果成功加载返回true；存储不存在或为空时返回false
+     */
+    virtual bool loadTransactions(QVector<Transaction>& transactions) = 0;
+
+    /**
+     * @brief 全量保存交易记录
+     * @param transactions 完整的交易记录列表
+     * @return 如果成功保存返回true，否则返回false
+     */
+    virtual bool saveTransactions(const QVector<Transaction>& transactions) = 0;
+
+    /**
+     * @brief 追加新交易记录
+     * @param transactions 完整的交易记录列表（已包含新记录）
+     * @param firstNewIndex 第一条新记录在列表中的下标，其后的记录均为新增
+     * @return 如果成功保存返回true，否则返回false
+     */
+    virtual bool appendTransactions(const QVector<Transaction>& transactions, int firstNewIndex) = 0;
+
+    /**
+     * @brief 删除指定卡号的交易记录
+     *
+     * 双边转账记录的一方被删除时记录不会被删除，而是改写为只属于另一方的记录，
+     * 这些记录的下标通过 rewritten 给出。
+     *
+     * @param cardNumber 卡号
+     * @param remaining 删除后剩余的完整交易记录列表
+     * @param rewritten remaining 中被改写的记录下标
+     * @return 如果成功保存返回true，否则返回false
+     */
+    virtual bool removeTransactionsForCard(const QString& cardNumber,
+                                           const QVector<Transaction>& remaining,
+                                           const QVector<int>& rewritten) = 0;
+};
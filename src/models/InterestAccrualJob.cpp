@@ -0,0 +1,213 @@
+/**
+ * @file InterestAccrualJob.cpp
+ * @brief 批量计息与收费作业实现
+ *
+ * 实现了InterestAccrualJob类中定义的并行计算和批量提交方法。
+ */
+#include "InterestAccrualJob.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+//!< 每个线程分得的行块数
+const int kChunksPerThread = 4;
+
+} // namespace
+
+double AccrualReport::accountsPerSecond() const
+{
+    if (elapsedMs <= 0) {
+        return 0.0;
+    }
+    return accountsScanned * 1000.0 / elapsedMs;
+}
+
+QString AccrualReport::summary() const
+{
+    return QString("批量计息: %1, 计息 %2 天, %3 个账户, 利息 %4 笔共 %5 元, 管理费 %6 笔共 %7 元, "
+                   "%8 个线程, 计算 %9 ms, 总耗时 %10 ms (%11 账户/秒)%12")
+        .arg(date.toString(Qt::ISODate))
+        .arg(accrualDays)
+        .arg(accountsScanned)
+        .arg(interestPostings)
+        .arg(QString::number(interestTotal, 'f', 2))
+        .arg(feePostings)
+        .arg(QString::number(feeTotal, 'f', 2))
+        .arg(threads)
+        .arg(computeMs)
+        .arg(elapsedMs)
+        .arg(qRound64(accountsPerSecond()))
+        .arg(committed ? QString() : QString(", 提交失败: %1").arg(error));
+}
+
+InterestAccrualJob::InterestAccrualJob(const AccrualPolicy& policy, int threads)
+    : m_policy(policy)
+    , m_threads(threads > 0 ? threads : qMax(1, QThread::idealThreadCount()))
+{
+}
+
+AccrualReport InterestAccrualJob::run(IAccountRepository& repository, TransactionModel& transactionModel,
+                                      AccountAggregates* aggregates, const QDate& date,
+                                      int accrualDays, bool chargeFees) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    AccrualReport report;
+    report.date = date;
+    report.accrualDays = qMax(0, accrualDays);
+    report.feesCharged = chargeFees;
+    report.threads = m_threads;
+
+    // 列式账户表直接使用其余额列和标志列，其他存储库先展开为列
+    const AccountTable* table = repository.accountTable();
+    QVector<Account> accounts;
+    QVector<double> balanceColumn;
+    QVector<quint8> flagColumn;
+    if (!table) {
+        accounts = repository.getAllAccounts();
+        balanceColumn.reserve(accounts.size());
+        flagColumn.reserve(accounts.size());
+        for (const Account& account : std::as_const(accounts)) {
+            balanceColumn.append(account.balance);
+            flagColumn.append(quint8((account.isLocked ? AccountTable::Locked : 0)
+                                     | (account.isAdmin ? AccountTable::Admin : 0)));
+        }
+    }
+    const double* balances = table ? table->balances().constData() : balanceColumn.constData();
+    const quint8* flags = table ? table->flags().constData() : flagColumn.constData();
+    const int count = table ? table->size() : int(accounts.size());
+    report.accountsScanned = count;
+
+    const double interestRate = m_policy.annualRate / m_policy.daysPerYear * report.accrualDays;
+    const double fee = chargeFees ? m_policy.monthlyFee : 0.0;
+
+    // 按行分块并行计算，各块只写自己的行
+    QVector<double> interest(count);
+    QVector<double> fees(count);
+    const int chunkCount = qBound(1, count, m_threads * kChunksPerThread);
+    auto accrueChunk = [&](int chunk) {
+        const int begin = int(qint64(count) * chunk / chunkCount);
+        const int end = int(qint64(count) * (chunk + 1) / chunkCount);
+        accrue(balances + begin, flags + begin, end - begin, interestRate, fee, m_policy.feeWaiverBalance,
+               interest.data() + begin, fees.data() + begin);
+    };
+
+    if (chunkCount == 1 || m_threads == 1) {
+        for (int i = 0; i < chunkCount; ++i) {
+            accrueChunk(i);
+        }
+    } else {
+        QVector<int> indices(chunkCount);
+        std::iota(indices.begin(), indices.end(), 0);
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(m_threads);
+        QtConcurrent::blockingMap(&pool, indices, accrueChunk);
+    }
+    report.computeMs = timer.elapsed();
+
+    // 收集有变化的账户和对应的账本记录
+    QVector<Account> before;
+    QVector<Account> updated;
+    QVector<Transaction> postings;
+    for (int row = 0; row < count; ++row) {
+        if (interest.at(row) <= 0.0 && fees.at(row) <= 0.0) {
+            continue;
+        }
+
+        Account account = table ? table->account(row) : accounts.at(row);
+        if (aggregates) {
+            before.append(account);
+        }
+        if (interest.at(row) > 0.0) {
+            account.balance += interest.at(row);
+            postings.append(transactionModel.createTransaction(
+                account.cardNumber, TransactionType::Interest, interest.at(row), account.balance,
+                QString("活期利息 (%1 天)").arg(report.accrualDays)));
+            ++report.interestPostings;
+            report.interestTotal += interest.at(row);
+        }
+        if (fees.at(row) > 0.0) {
+            account.balance -= fees.at(row);
+            postings.append(transactionModel.createTransaction(
+                account.cardNumber, TransactionType::Fee, fees.at(row), account.balance,
+                QString("账户管理费 (%1)").arg(date.toString("yyyy-MM"))));
+            ++report.feePostings;
+            report.feeTotal += fees.at(row);
+        }
+        updated.append(account);
+    }
+
+    // 先写账本再提交余额：上次计息和收费的日期取自账本中的利息和管理费记录，
+    // 账本先落盘时，即使提交余额前退出，重启后也不会重复计息或重复收费
+    if (!updated.isEmpty()) {
+        if (!transactionModel.addTransactions(postings)) {
+            report.error = "无法保存利息和管理费记录";
+            report.elapsedMs = timer.elapsed();
+            qWarning() << report.summary();
+            return report;
+        }
+
+        OperationResult saveResult = repository.saveAccountsBatch(updated);
+        if (!saveResult.success) {
+            // 撤销已写入的记录，下次运行重新计息；撤销也失败时宁可少计一次，不重复收费
+            QSet<quint64> postingIds;
+            postingIds.reserve(postings.size());
+            for (const Transaction& posting : std::as_const(postings)) {
+                postingIds.insert(posting.id);
+            }
+            report.error = saveResult.errorMessage;
+            if (!transactionModel.removeTransactions(postingIds)) {
+                report.error += "；撤销利息和管理费记录失败，请核对账本";
+            }
+            report.elapsedMs = timer.elapsed();
+            qWarning() << report.summary();
+            return report;
+        }
+        if (aggregates) {
+            for (int i = 0; i < updated.size(); ++i) {
+                aggregates->accountUpdated(before.at(i), updated.at(i));
+            }
+        }
+    }
+    report.committed = true;
+    report.elapsedMs = timer.elapsed();
+
+    qDebug() << report.summary();
+    return report;
+}
+
+void InterestAccrualJob::accrue(const double* balances, const quint8* flags, int count,
+                                double interestRate, double fee, double waiverBalance,
+                                double* interest, double* fees)
+{
+    // 循环体没有分支和跨行依赖，编译器可以直接向量化
+    for (int i = 0; i < count; ++i) {
+        const double balance = balances[i];
+        const double eligible = (flags[i] & AccountTable::Admin) ? 0.0 : 1.0;
+        const double accrued = balance > 0.0 ? std::floor(balance * interestRate * 100.0 + 0.5) / 100.0 : 0.0;
+        const double after = balance + accrued * eligible;
+        const double charged = (after > 0.0 && after < waiverBalance) ? std::min(fee, after) : 0.0;
+        interest[i] = accrued * eligible;
+        fees[i] = charged * eligible;
+    }
+}
+
+QDate InterestAccrualJob::lastPostingDate(const QVector<Transaction>& transactions, TransactionType type)
+{
+    for (auto it = transactions.crbegin(); it != transactions.crend(); ++it) {
+        if (it->type == type) {
+            return it->timestamp.toLocalTime().date();
+        }
+    }
+    return QDate();
+}
@@ -0,0 +1,121 @@
+/**
+ * @file InterestAccrualJob.h
+ * @brief 批量计息与收费作业
+ *
+ * 定义了对全部账户计提活期利息、扣收月度账户管理费的批处理作业，
+ * 在余额列上并行计算，账户余额和账本记录各一次性提交。
+ */
+#pragma once
+
+#include <QDate>
+#include <QString>
+#include <QVector>
+#include "IAccountRepository.h"
+#include "TransactionModel.h"
+#include "BankAggregates.h"
+
+/**
+ * @brief 计息与收费规则
+ */
+struct AccrualPolicy {
+    double annualRate = 0.0035;         //!< 活期年利率
+    int daysPerYear = 360;              //!< 计息年天数（日利率 = 年利率 / 该值）
+    double monthlyFee = 1.0;            //!< 月度账户管理费
+    double feeWaiverBalance = 300.0;    //!< 计息后余额不低于该值时免收管理费
+};
+
+/**
+ * @brief 一次计息作业的结果
+ */
+struct AccrualReport {
+    QDate date;                 //!< 计息日
+    int accrualDays = 0;        //!< 计息天数
+    bool feesCharged = false;   //!< 是否扣收了月度管理费
+    int accountsScanned = 0;    //!< 扫描的账户数
+    int interestPostings = 0;   //!< 利息入账笔数
+    double interestTotal = 0.0; //!< 利息合计
+    int feePostings = 0;        //!< 管理费扣收笔数
+    double feeTotal = 0.0;      //!< 管理费合计
+    int threads = 0;            //!< 使用的线程数
+    qint64 computeMs = 0;       //!< 计算耗时（毫秒）
+    qint64 elapsedMs = 0;       //!< 总耗时（毫秒，含提交）
+    bool committed = false;     //!< 是否已提交（没有需要入账的项时也为true）
+    QString error;              //!< 提交失败的原因
+
+    /**
+     * @brief 计算吞吐量
+     * @return 每秒处理的账户数
+     */
+    double accountsPerSecond() const;
+
+    /**
+     * @brief 生成一行摘要
+     * @return 摘要文本
+     */
+    QString summary() const;
+};
+
+/**
+ * @brief 批量计息与收费作业
+ *
+ * 计算阶段只读余额列和状态标志列（JSON 存储库直接使用列式账户表，其他存储库先展开为列），
+ * 按行分块交给线程池，每块在连续的数组上执行无分支的计算，结果写入各自的行。
+ * 提交阶段单线程收集有变化的账户，先通过一次 TransactionModel::addTransactions() 写入利息和管理费记录，
+ * 再通过一次 saveAccountsBatch() 保存余额；保存余额失败时撤销这些记录。
+ * 上次计息日取自账本，因此任何一步失败或中途退出都不会导致重复计息或重复收费。
+ *
+ * 利息按分四舍五入，不足一分不入账；管理费不会使余额变为负数；管理员账户不参与。
+ */
+class InterestAccrualJob {
+public:
+    /**
+     * @brief 构造函数
+     * @param policy 计息与收费规则
+     * @param threads 线程数，0 表示使用 QThread::idealThreadCount()
+     */
+    explicit InterestAccrualJob(const AccrualPolicy& policy = AccrualPolicy(), int threads = 0);
+
+    /**
+     * @brief 执行作业
+     * @param repository 账户存储库
+     * @param transactionModel 交易模型（写入利息和管理费记录）
+     * @param aggregates 全行账户汇总，为空时不更新
+     * @param date 计息日
+     * @param accrualDays 计息天数，0 表示不计息
+     * @param chargeFees 是否扣收月度管理费
+     * @return 作业结果
+     */
+    AccrualReport run(IAccountRepository& repository, TransactionModel& transactionModel,
+                      AccountAggregates* aggregates, const QDate& date,
+                      int accrualDays, bool chargeFees) const;
+
+    /**
+     * @brief 在连续的列上计算利息和管理费
+     * @param balances 余额列
+     * @param flags 状态标志列（AccountTable::Flag）
+     * @param count 行数
+     * @param interestRate 本次计息的利率（日利率 * 天数）
+     * @param fee 管理费，0 表示不收费
+     * @param waiverBalance 免收管理费的余额下限
+     * @param interest 输出参数，每行的利息
+     * @param fees 输出参数，每行的管理费
+     */
+    static void accrue(const double* balances, const quint8* flags, int count,
+                       double interestRate, double fee, double waiverBalance,
+                       double* interest, double* fees);
+
+    /**
+     * @brief 查找账本中最后一笔指定类型记录的日期
+     * @param transactions 全部交易记录（按账本顺序）
+     * @param type 交易类型
+     * @return 本地日期，没有该类型的记录时无效
+     */
+    static QDate lastPostingDate(const QVector<Transaction>& transactions, TransactionType type);
+
+private:
+    //!< 计息与收费规则
+    AccrualPolicy m_policy;
+
+    //!< 线程数
+    int m_threads;
+};
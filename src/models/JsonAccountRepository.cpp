@@ -82,8 +82,12 @@ OperationResult JsonAccountRepository::saveAccount(const Account& account)
         return OperationResult::Failure("账户数据无效");
     }
     
-    // 添加或更新账户到内存映射
-    m_accounts[account.cardNumber] = account;
+    // 添加或更新账户到内存表
+    const bool isNew = !m_table.contains(account.cardNumber);
+    m_table.upsert(account);
+    if (isNew) {
+        addToCardFilter(account.cardNumber);
+    }
     m_isDirty = true;
     
     // 保存所有账户数据到文件
@@ -94,6 +98,57 @@ OperationResult JsonAccountRepository::saveAccount(const Account& account)
     return OperationResult::Success();
 }
 
+/**
+ * @brief 批量保存多个账户
+ *
+ * 先校验全部账户，再一次性更新内存表并只写一次文件。
+ *
+ * @param accounts 要保存的账户列表
+ * @return 操作结果
+ */
+OperationResult JsonAccountRepository::saveAccountsBatch(const QVector<Account>& accounts)
+{
+    // 检查所有账户是否有效，任一无效则整批拒绝
+    for (const Account& account : accounts) {
+        if (!account.isValid()) {
+            return OperationResult::Failure("账户数据无效");
+        }
+    }
+    
+    // 备份被覆盖的账户，以便写文件失败时回滚内存状态
+    QMap<QString, Account> backup;
+    QVector<QString> inserted;
+    for (const Account& account : accounts) {
+        const int row = m_table.indexOf(account.cardNumber);
+        if (row >= 0) {
+            if (!backup.contains(account.cardNumber)) {
+                backup.insert(account.cardNumber, m_table.account(row));
+            }
+        } else {
+            inserted.append(account.cardNumber);
+        }
+        m_table.upsert(account);
+    }
+    for (const QString& cardNumber : inserted) {
+        addToCardFilter(cardNumber);
+    }
+    m_isDirty = true;
+    
+    // 整批只写一次文件
+    if (!saveAccounts()) {
+        for (auto it = backup.constBegin(); it != backup.constEnd(); ++it) {
+            m_table.upsert(it.value());
+        }
+        for (const QString& cardNumber : inserted) {
+            m_table.remove(cardNumber);
+            removeFromCardFilter();
+        }
+        return OperationResult::Failure("无法保存账户数据");
+    }
+    
+    return OperationResult::Success();
+}
+
 /**
  * @brief 删除账户
  * @param cardNumber 要删除的账户卡号
@@ -106,8 +161,9 @@ OperationResult JsonAccountRepository::deleteAccount(const QString& cardNumber)
         return OperationResult::Failure("账户不存在");
     }
     
-    // 从内存映射中移除账户
-    m_accounts.remove(cardNumber);
+    // 从内存表中移除账户；过滤器中的位保留，只会多出由内存表拒绝的误报
+    m_table.remove(cardNumber);
+    removeFromCardFilter();
     m_isDirty = true;
     
     // 保存所有账户数据到文件
@@ -125,9 +181,14 @@ OperationResult JsonAccountRepository::deleteAccount(const QString& cardNumber)
  */
 std::optional<Account> JsonAccountRepository::findByCardNumber(const QString& cardNumber) const
 {
-    auto it = m_accounts.find(cardNumber);
-    if (it != m_accounts.end()) {
-        return it.value();
+    // 布隆过滤器判定不存在的卡号直接返回，枚举攻击的探测大多止步于此
+    if (!m_cardFilter.mightContain(cardNumber)) {
+        return std::nullopt;
+    }
+    
+    const int row = m_table.indexOf(cardNumber);
+    if (row >= 0) {
+        return m_table.account(row);
     }
     return std::nullopt;
 }
@@ -138,11 +199,7 @@ std::optional<Account> JsonAccountRepository::findByCardNumber(const QString& ca
  */
 QVector<Account> JsonAccountRepository::getAllAccounts() const
 {
-    QVector<Account> accounts;
-    for (const auto& account : m_accounts) {
-        accounts.append(account);
-    }
-    return accounts;
+    return m_table.allAccounts();
 }
 
 /**
@@ -152,7 +209,16 @@ QVector<Account> JsonAccountRepository::getAllAccounts() const
  */
 bool JsonAccountRepository::accountExists(const QString& cardNumber) const
 {
-    return m_accounts.contains(cardNumber);
+    return m_cardFilter.mightContain(cardNumber) && m_table.contains(cardNumber);
+}
+
+/**
+ * @brief 获取列式账户表
+ * @return 账户表
+ */
+const AccountTable* JsonAccountRepository::accountTable() const
+{
+    return &m_table;
 }
 
 /**
@@ -161,18 +227,16 @@ bool JsonAccountRepository::accountExists(const QString& cardNumber) const
  */
 bool JsonAccountRepository::saveAccounts()
 {
-    QJsonArray accountsArray;
-
-    // 将所有账户转换为 JSON 数组
-    for (const auto &account : m_accounts) {
-        accountsArray.append(account.toJson());
-    }
-
-    // 使用持久化管理器保存数据
-    bool success = m_persistenceManager->saveToFile(m_filename, accountsArray);
+    // 使用持久化管理器流式写入，逐个账户直接编码到文件缓冲区
+    bool success = m_persistenceManager->saveRecords(m_filename, FORMAT_NAME, FORMAT_VERSION,
+        [this](JsonStreamWriter& writer) {
+            for (int row : m_table.rowsByCardNumber()) {
+                m_table.account(row).writeJson(writer);
+            }
+        });
     if (success) {
         m_isDirty = false;
-        qDebug() << "成功保存" << m_accounts.size() << "个账户";
+        qDebug() << "成功保存" << m_table.size() << "个账户";
     }
     
     return success;
@@ -184,24 +248,54 @@ bool JsonAccountRepository::saveAccounts()
  */
 bool JsonAccountRepository::loadAccounts()
 {
-    QJsonArray accountsArray;
+    QVector<QVector<Account>> chunks;
+    int fileVersion = 0;
+    Account (*decode)(JsonStreamReader&) = nullptr;
     
-    // 使用持久化管理器加载数据
-    if (!m_persistenceManager->loadFromFile(m_filename, accountsArray)) {
+    // 使用持久化管理器分块并行解析，每个分块写入各自的结果列表；
+    // 解码函数按文件版本选定一次，逐条解码时不再判断格式
+    bool success = m_persistenceManager->loadRecordChunks(m_filename, FORMAT_NAME,
+        [&](int version, int chunkCount) {
+            if (version == FORMAT_VERSION) {
+                decode = &Account::readJson;
+            } else if (version == JsonPersistenceManager::LEGACY_FORMAT_VERSION) {
+                decode = &Account::readJsonV1;
+            } else {
+                return false;
+            }
+            fileVersion = version;
+            chunks.resize(chunkCount);
+            return true;
+        },
+        [&chunks, &decode](int chunk, JsonStreamReader& reader) {
+            chunks[chunk].append(decode(reader));
+            return true;
+        });
+    if (!success) {
         return false;
     }
 
-    // 清空当前账户列表
-    m_accounts.clear();
-
-    // 从 JSON 数组加载账户数据
-    for (const QJsonValue &value : accountsArray) {
-        if (value.isObject()) {
-            Account account = Account::fromJson(value.toObject());
-            m_accounts[account.cardNumber] = account;
+    // 按分块顺序合并，重复卡号以文件中靠后的记录为准
+    QMap<QString, Account> accounts;
+    for (const auto &chunk : chunks) {
+        for (const auto &account : chunk) {
+            accounts.insert(account.cardNumber, account);
         }
     }
 
+    // 按卡号顺序重建内存表，逐行追加
+    m_table.clear();
+    m_table.reserve(accounts.size());
+    for (const auto &account : accounts) {
+        m_table.upsert(account);
+    }
+
+    // 旧格式文件只迁移一次：按当前格式写回后，后续启动直接走快速路径
+    if (fileVersion != FORMAT_VERSION) {
+        qDebug() << "账户数据文件从版本" << fileVersion << "迁移到版本" << FORMAT_VERSION;
+        m_isDirty = true;
+    }
+
     // 确保管理员账户加载正确或重新创建
     if (!accountExists("9999888877776666")) {
         qWarning() << "管理员账户未加载，创建新管理员账户";
@@ -214,21 +308,32 @@ bool JsonAccountRepository::loadAccounts()
         admin.isAdmin = true;
         // 设置PIN码（自动哈希）
         admin.setPin("8888");
-        m_accounts[admin.cardNumber] = admin;
+        m_table.upsert(admin);
         m_isDirty = true;
     }
 
-    qDebug() << "成功加载" << m_accounts.size() << "个账户";
+    rebuildCardFilter();
+
+    // 迁移或补建的数据立即持久化，避免下次启动重复处理（每次都会生成新的盐值）
+    if (m_isDirty) {
+        saveAccounts();
+    }
+
+    qDebug() << "成功加载" << m_table.size() << "个账户";
     return true;
 }
 
 /**
- * @brief 添加账户到内存映射
+ * @brief 添加账户到内存表
  * @param account 要添加的账户
  */
 void JsonAccountRepository::addAccount(const Account& account)
 {
-    m_accounts[account.cardNumber] = account;
+    const bool isNew = !m_table.contains(account.cardNumber);
+    m_table.upsert(account);
+    if (isNew) {
+        addToCardFilter(account.cardNumber);
+    }
     m_isDirty = true;
 }
 
@@ -253,5 +358,44 @@ void JsonAccountRepository::initializeTestAccounts()
     Account adminAccount("9999888877776666", "8888", "管理员", 500000.0, 100000.0, false, true);
     addAccount(adminAccount);
 
-    qDebug() << "测试账户初始化完成，共" << m_accounts.size() << "个账户";
-} 
\ No newline at end of file
+    qDebug() << "测试账户初始化完成，共" << m_table.size() << "个账户";
+} 
+
+/**
+ * @brief 按当前全部卡号重建布隆过滤器
+ */
+void JsonAccountRepository::rebuildCardFilter()
+{
+    // 预留一倍余量，避免新增少量账户就触发重建
+    m_cardFilter.reset(m_table.size() * 2);
+    for (const QString& cardNumber : m_table.cardNumbers()) {
+        m_cardFilter.add(cardNumber);
+    }
+    qDebug() << "卡号布隆过滤器已重建:" << m_cardFilter.count() << "个卡号,"
+             << m_cardFilter.bitCount() << "位, 估计误判率"
+             << m_cardFilter.estimatedFalsePositiveRate() * 100.0 << "%";
+}
+
+/**
+ * @brief 将新卡号加入布隆过滤器，超过容量时重建
+ * @param cardNumber 卡号（已加入内存表）
+ */
+void JsonAccountRepository::addToCardFilter(const QString& cardNumber)
+{
+    if (m_cardFilter.needsRebuild()) {
+        rebuildCardFilter();
+    } else {
+        m_cardFilter.add(cardNumber);
+    }
+}
+
+/**
+ * @brief 记录一个卡号已从内存表删除，过期卡号过多时重建布隆过滤器
+ */
+void JsonAccountRepository::removeFromCardFilter()
+{
+    m_cardFilter.markRemoved();
+    if (m_cardFilter.needsRebuild()) {
+        rebuildCardFilter();
+    }
+}
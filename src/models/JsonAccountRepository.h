@@ -13,6 +13,8 @@
 #include <optional>
 #include "IAccountRepository.h"
 #include "Account.h"
+#include "AccountTable.h"
+#include "CardBloomFilter.h"
 #include "JsonPersistenceManager.h"
 
 /**
@@ -22,6 +24,12 @@
  */
 class JsonAccountRepository : public IAccountRepository {
 public:
+    //!< 账户数据文件的格式名称
+    static constexpr const char* FORMAT_NAME = "atm-accounts";
+
+    //!< 当前账户数据文件格式版本（版本1为无文件头、可能含明文PIN的旧格式）
+    static const int FORMAT_VERSION = 2;
+
     /**
      * @brief 默认构造函数
      *
@@ -52,6 +60,13 @@ public:
      */
     OperationResult saveAccount(const Account& account) override;
     
+    /**
+     * @brief 批量保存多个账户
+     * @param accounts 要保存的账户列表
+     * @return 操作结果
+     */
+    OperationResult saveAccountsBatch(const QVector<Account>& accounts) override;
+    
     /**
      * @brief 删除账户
      * @param cardNumber 要删除的账户卡号
@@ -91,6 +106,12 @@ public:
      */
     bool accountExists(const QString& cardNumber) const override;
 
+    /**
+     * @brief 获取列式账户表
+     * @return 账户表
+     */
+    const AccountTable* accountTable() const override;
+
 private:
     /**
      * @brief 初始化测试账户数据
@@ -100,13 +121,32 @@ private:
     void initializeTestAccounts();
     
     /**
-     * @brief 添加账户到内存映射
+     * @brief 添加账户到内存表
      * @param account 要添加的账户
      */
     void addAccount(const Account& account);
     
-    //!< 账户内存存储（卡号->账户映射）
-    QMap<QString, Account> m_accounts;
+    /**
+     * @brief 按当前全部卡号重建布隆过滤器
+     */
+    void rebuildCardFilter();
+    
+    /**
+     * @brief 将新卡号加入布隆过滤器，超过容量时重建
+     * @param cardNumber 卡号（已加入内存表）
+     */
+    void addToCardFilter(const QString& cardNumber);
+    
+    /**
+     * @brief 记录一个卡号已从内存表删除，过期卡号过多时重建布隆过滤器
+     */
+    void removeFromCardFilter();
+    
+    //!< 账户内存存储（列式表，热字段与冷字段分开存放）
+    AccountTable m_table;
+    
+    //!< 现有卡号的布隆过滤器，查找前先排除不存在的卡号
+    CardBloomFilter m_cardFilter;
     
     //!< 账户数据文件名
     QString m_filename;
@@ -8,7 +8,206 @@
 #include <QDir>
 #include <QStandardPaths>
 #include <QFile>
+#include <QSaveFile>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <cstring>
+#include <numeric>
+
+std::atomic<int> JsonPersistenceManager::s_loadThreadCount{0};
+
+namespace {
+
+//!< 并行加载时每个分块的最小字节数，避免小文件被拆得过细
+constexpr qsizetype kMinChunkBytes = 64 * 1024;
+
+/**
+ * @brief 只读映射的输入文件
+ *
+ * 优先使用内存映射，映射失败（如空文件）时退回到一次性读取。
+ */
+class MappedInput {
+public:
+    ~MappedInput()
+    {
+        if (m_mapped) {
+            m_file.unmap(m_mapped);
+        }
+    }
+
+    bool open(const QString& filePath)
+    {
+        m_file.setFileName(filePath);
+        if (!m_file.exists()) {
+            qWarning() << "数据文件不存在:" << filePath;
+            return false;
+        }
+        if (!m_file.open(QIODevice::ReadOnly)) {
+            qWarning() << "无法打开文件加载数据:" << filePath << ", 错误:" << m_file.errorString();
+            return false;
+        }
+
+        m_mapped = m_file.size() > 0 ? m_file.map(0, m_file.size()) : nullptr;
+        if (m_mapped) {
+            m_begin = reinterpret_cast<const char*>(m_mapped);
+            m_end = m_begin + m_file.size();
+        } else {
+            m_fallback = m_file.readAll();
+            m_begin = m_fallback.constData();
+            m_end = m_begin + m_fallback.size();
+        }
+        return true;
+    }
+
+    const char* begin() const { return m_begin; }
+    const char* end() const { return m_end; }
+
+private:
+    QFile m_file;
+    uchar* m_mapped = nullptr;
+    QByteArray m_fallback;
+    const char* m_begin = nullptr;
+    const char* m_end = nullptr;
+};
+
+/**
+ * @brief 顶层数组中按记录边界切分出的一段输入
+ */
+struct RecordChunk {
+    const char* begin;  //!< 分块起始位置
+    const char* end;    //!< 分块结束位置（不含）
+};
+
+/**
+ * @brief 将顶层数组按记录边界切分为若干分块
+ *
+ * 只做结构扫描（括号深度和字符串边界），不解码任何值；
+ * 分块边界总是落在顶层的逗号上，因此每个分块都由完整记录组成。
+ *
+ * @param begin 输入起始位置
+ * @param end 输入结束位置
+ * @param chunkCount 期望的分块数量
+ * @param chunks 输出的分块列表
+ * @return 如果输入是完整的顶层数组返回true
+ */
+bool splitTopLevelArray(const char* begin, const char* end, int chunkCount,
+                        QVector<RecordChunk>& chunks)
+{
+    const char* p = begin;
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) {
+        ++p;
+    }
+    if (p >= end || *p != '[') {
+        return false;
+    }
+    ++p;
+
+    const char* base = p;
+    const qsizetype total = end - base;
+    const char* chunkStart = p;
+    int nextIndex = 1;
+    const char* nextTarget = chunkCount > 1 ? base + total / chunkCount : end;
+    int depth = 0;
+
+    while (p < end) {
+        const char c = *p;
+        if (c == '"') {
+            // 跳到未被转义的右引号
+            ++p;
+            for (;;) {
+                const char* quote = static_cast<const char*>(std::memchr(p, '"', end - p));
+                if (!quote) {
+                    return false;
+                }
+                const char* slash = quote;
+                while (slash > p && slash[-1] == '\\') {
+                    --slash;
+                }
+                p = quote + 1;
+                if (((quote - slash) & 1) == 0) {
+                    break;
+                }
+            }
+            continue;
+        }
+
+        if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}') {
+            --depth;
+        } else if (c == ']') {
+            if (depth == 0) {
+                chunks.append({chunkStart, p});
+                return true;
+            }
+            --depth;
+        } else if (c == ',' && depth == 0 && p >= nextTarget) {
+            chunks.append({chunkStart, p});
+            chunkStart = p + 1;
+            ++nextIndex;
+            nextTarget = nextIndex < chunkCount ? base + total * nextIndex / chunkCount : end;
+        }
+        ++p;
+    }
+    return false;
+}
+
+/**
+ * @brief 读取文件头并定位记录数组
+ *
+ * 顶层直接是数组的旧文件视为 LEGACY_FORMAT_VERSION；
+ * 否则文件头的 format 和 version 字段必须出现在 records 之前。
+ *
+ * @param begin 输入起始位置
+ * @param end 输入结束位置
+ * @param format 期望的格式名称
+ * @param version 输出的文件版本号
+ * @return 记录数组起始 '[' 的位置，文件头无效时返回nullptr
+ */
+const char* locateRecords(const char* begin, const char* end, const QString& format, int& version)
+{
+    const char* p = begin;
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) {
+        ++p;
+    }
+    if (p < end && *p == '[') {
+        version = JsonPersistenceManager::LEGACY_FORMAT_VERSION;
+        return p;
+    }
+
+    JsonStreamReader reader(p, end);
+    if (reader.readNext() != JsonStreamReader::StartObject) {
+        return nullptr;
+    }
+
+    QString fileFormat;
+    version = 0;
+    while (reader.readNext() == JsonStreamReader::Name) {
+        const QByteArrayView key = reader.name();
+        const JsonStreamReader::TokenType token = reader.readNext();
+        if (key == "records") {
+            if (token != JsonStreamReader::StartArray || fileFormat != format
+                || version <= JsonPersistenceManager::LEGACY_FORMAT_VERSION) {
+                return nullptr;
+            }
+            // offset() 位于 '[' 之后
+            return p + reader.offset() - 1;
+        }
+        if (key == "format") {
+            fileFormat = reader.stringValue();
+        } else if (key == "version") {
+            version = static_cast<int>(reader.integerValue());
+        } else {
+            reader.skipCurrentValue();
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
 
 JsonPersistenceManager::JsonPersistenceManager(QObject* parent, const QString& dataPath)
     : QObject(parent)
@@ -79,6 +278,142 @@ bool JsonPersistenceManager::loadFromFile(const QString& filename, QJsonArray& j
     return true;
 }
 
+bool JsonPersistenceManager::saveRecords(const QString& filename, const QString& format, int version,
+                                         const std::function<void(JsonStreamWriter&)>& writeRecords)
+{
+    QString filePath = m_dataPath + "/" + filename;
+    QSaveFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "无法打开文件保存数据:" << filePath << ", 错误:" << file.errorString();
+        return false;
+    }
+
+    {
+        JsonStreamWriter writer(&file);
+        writer.beginObject();
+        writer.writeString("format", format);
+        writer.writeInteger("version", version);
+        writer.beginArray("records");
+        writeRecords(writer);
+        writer.endArray();
+        writer.endObject();
+
+        if (!writer.flush()) {
+            qWarning() << "写入数据失败:" << filePath << ", 错误:" << file.errorString();
+            file.cancelWriting();
+            return false;
+        }
+    }
+
+    if (!file.commit()) {
+        qWarning() << "无法提交数据文件:" << filePath << ", 错误:" << file.errorString();
+        return false;
+    }
+
+    qDebug() << "成功保存数据到" << filePath;
+    return true;
+}
+
+bool JsonPersistenceManager::loadRecordChunks(const QString& filename, const QString& format,
+                                              const std::function<bool(int, int)>& prepare,
+                                              const std::function<bool(int, JsonStreamReader&)>& readRecord)
+{
+    QString filePath = m_dataPath + "/" + filename;
+    MappedInput input;
+    if (!input.open(filePath)) {
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    int version = 0;
+    const char* records = locateRecords(input.begin(), input.end(), format, version);
+    if (!records) {
+        qWarning() << "数据文件格式无效:" << filePath;
+        return false;
+    }
+
+    // 分块数量受线程数和最小分块大小共同限制，小文件直接单块解析
+    const qsizetype size = input.end() - records;
+    const int threads = loadThreadCount();
+    const int maxChunks = static_cast<int>(qBound<qsizetype>(1, size / kMinChunkBytes, threads));
+
+    QVector<RecordChunk> chunks;
+    if (!splitTopLevelArray(records, input.end(), maxChunks, chunks)) {
+        qWarning() << "数据文件格式无效:" << filePath;
+        return false;
+    }
+
+    if (!prepare(version, chunks.size())) {
+        qWarning() << "不支持的数据文件版本:" << filePath << ", 版本:" << version;
+        return false;
+    }
+
+    // 每个分块独立解析，结果与错误按分块下标存放，互不共享
+    QVector<QString> errors(chunks.size());
+    auto parseChunk = [&](int index) {
+        const RecordChunk& chunk = chunks.at(index);
+        JsonStreamReader reader(chunk.begin, chunk.end);
+        for (;;) {
+            JsonStreamReader::TokenType token = reader.readNext();
+            if (token == JsonStreamReader::EndDocument) {
+                break;
+            }
+            if (token == JsonStreamReader::StartObject) {
+                if (!readRecord(index, reader)) {
+                    errors[index] = QStringLiteral("记录解码失败");
+                    return;
+                }
+            } else if (token == JsonStreamReader::Invalid) {
+                errors[index] = reader.errorString();
+                return;
+            } else {
+                // 非对象元素直接跳过
+                reader.skipCurrentValue();
+            }
+        }
+        if (reader.hasError()) {
+            errors[index] = reader.errorString();
+        }
+    };
+
+    if (chunks.size() == 1) {
+        parseChunk(0);
+    } else {
+        QVector<int> indices(chunks.size());
+        std::iota(indices.begin(), indices.end(), 0);
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(threads);
+        QtConcurrent::blockingMap(&pool, indices, parseChunk);
+    }
+
+    for (int i = 0; i < errors.size(); ++i) {
+        if (!errors.at(i).isEmpty()) {
+            qWarning() << "数据文件格式无效:" << filePath << ", 分块" << i << ":" << errors.at(i);
+            return false;
+        }
+    }
+
+    qDebug() << "成功从" << filePath << "加载数据: 版本" << version << "," << size << "字节,"
+             << chunks.size() << "个分块," << threads << "个线程, 耗时"
+             << timer.elapsed() << "ms";
+    return true;
+}
+
+void JsonPersistenceManager::setLoadThreadCount(int threads)
+{
+    s_loadThreadCount.store(qMax(0, threads), std::memory_order_relaxed);
+}
+
+int JsonPersistenceManager::loadThreadCount()
+{
+    const int threads = s_loadThreadCount.load(std::memory_order_relaxed);
+    return threads > 0 ? threads : qMax(1, QThread::idealThreadCount());
+}
+
 QString JsonPersistenceManager::getDataPath() const
 {
     return m_dataPath;
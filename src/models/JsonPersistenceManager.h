@@ -12,6 +12,9 @@
 #include <QJsonDocument>
 #include <QObject>
 #include <functional>
+#include <atomic>
+#include "JsonStreamWriter.h"
+#include "JsonStreamReader.h"
 
 /**
  * @brief JSON持久化管理器
@@ -45,6 +48,60 @@ public:
      */
     bool loadFromFile(const QString& filename, QJsonArray& jsonArray);
 
+    //!< 无文件头的旧格式（顶层直接是记录数组）的版本号
+    static const int LEGACY_FORMAT_VERSION = 1;
+
+    /**
+     * @brief 以流式方式保存带版本文件头的记录数组
+     *
+     * 文件格式为 {"format": ..., "version": ..., "records": [...]}，文件头字段
+     * 总是写在记录数组之前，加载时无需先解析记录即可确定版本。
+     * 写入器直接输出到文件缓冲区，不构建中间的 QJsonArray 和 QByteArray；
+     * 通过 QSaveFile 写入临时文件后再原子替换原文件。
+     *
+     * @param filename 文件名
+     * @param format 格式名称
+     * @param version 格式版本号
+     * @param writeRecords 回调，负责依次写入数组中的每条记录
+     * @return 如果成功保存返回true，否则返回false
+     */
+    bool saveRecords(const QString& filename, const QString& format, int version,
+                     const std::function<void(JsonStreamWriter&)>& writeRecords);
+
+    /**
+     * @brief 并行分块加载记录数组
+     *
+     * 先读取文件头确定版本（顶层直接是数组的旧文件视为 LEGACY_FORMAT_VERSION），
+     * 再对记录数组做一次只看括号和引号的结构扫描，按顶层记录边界切分为若干分块，
+     * 然后在线程池中并发解析各分块。
+     *
+     * prepare 在解析开始前调用一次，调用方据此选定该版本的解码函数，
+     * 解析过程中不再逐条判断格式。readRecord 会被多个线程同时调用，
+     * 但同一分块内的记录总在同一线程上按文件顺序回调，调用方按分块下标
+     * 分别收集结果后顺序合并即可保持原有顺序。
+     *
+     * @param filename 文件名
+     * @param format 期望的格式名称
+     * @param prepare 回调，参数为文件版本和分块数量；返回false表示不支持该版本
+     * @param readRecord 回调，参数为分块下标和位于记录起始记号的读取器；返回false时加载失败
+     * @return 如果成功加载返回true，否则返回false
+     */
+    bool loadRecordChunks(const QString& filename, const QString& format,
+                          const std::function<bool(int, int)>& prepare,
+                          const std::function<bool(int, JsonStreamReader&)>& readRecord);
+
+    /**
+     * @brief 设置并行加载使用的线程数
+     * @param threads 线程数，0 表示使用 QThread::idealThreadCount()
+     */
+    static void setLoadThreadCount(int threads);
+
+    /**
+     * @brief 获取并行加载使用的线程数
+     * @return 线程数
+     */
+    static int loadThreadCount();
+
     /**
      * @brief 获取数据存储路径
      * @return 数据存储路径
@@ -54,4 +111,7 @@ public:
 private:
     //!< 数据存储路径
     QString m_dataPath;
+
+    //!< 并行加载线程数，0 表示自动
+    static std::atomic<int> s_loadThreadCount;
 }; 
\ No newline at end of file
@@ -0,0 +1,307 @@
+/**
+ * @file JsonStreamReader.cpp
+ * @brief 流式JSON读取器实现
+ *
+ * 实现了JsonStreamReader类中定义的记号扫描和值解码方法。
+ */
+#include "JsonStreamReader.h"
+#include <cstring>
+
+JsonStreamReader::JsonStreamReader(const char* begin, const char* end)
+    : m_begin(begin)
+    , m_pos(begin)
+    , m_end(end)
+    , m_token(Invalid)
+    , m_valueBegin(nullptr)
+    , m_valueLength(0)
+    , m_hasEscapes(false)
+    , m_boolValue(false)
+    , m_expectName(false)
+{
+}
+
+JsonStreamReader::JsonStreamReader(const QByteArray& data)
+    : JsonStreamReader(data.constData(), data.constData() + data.size())
+{
+}
+
+JsonStreamReader::TokenType JsonStreamReader::readNext()
+{
+    if (m_token == Invalid && !m_error.isEmpty()) {
+        return Invalid;
+    }
+
+    for (;;) {
+        skipWhitespace();
+        if (m_pos >= m_end) {
+            if (!m_stack.isEmpty()) {
+                return fail("JSON 数据意外结束");
+            }
+            return m_token = EndDocument;
+        }
+
+        const char c = *m_pos;
+        switch (c) {
+        case ',':
+            // 对象中逗号之后是下一个字段名
+            ++m_pos;
+            m_expectName = !m_stack.isEmpty() && m_stack.last();
+            continue;
+        case ':':
+            ++m_pos;
+            continue;
+        case '{':
+            ++m_pos;
+            m_stack.append(true);
+            m_expectName = true;
+            return m_token = StartObject;
+        case '[':
+            ++m_pos;
+            m_stack.append(false);
+            m_expectName = false;
+            return m_token = StartArray;
+        case '}':
+        case ']': {
+            const bool isObject = (c == '}');
+            if (m_stack.isEmpty() || m_stack.last() != isObject) {
+                return fail("JSON 括号不匹配");
+            }
+            ++m_pos;
+            m_stack.removeLast();
+            m_expectName = false;
+            return m_token = isObject ? EndObject : EndArray;
+        }
+        case '"':
+            if (!scanString()) {
+                return fail("JSON 字符串未结束");
+            }
+            if (m_expectName) {
+                m_expectName = false;
+                return m_token = Name;
+            }
+            return m_token = String;
+        case 't':
+            if (!scanLiteral("true")) {
+                return fail("无效的 JSON 字面量");
+            }
+            m_boolValue = true;
+            return m_token = Bool;
+        case 'f':
+            if (!scanLiteral("false")) {
+                return fail("无效的 JSON 字面量");
+            }
+            m_boolValue = false;
+            return m_token = Bool;
+        case 'n':
+            if (!scanLiteral("null")) {
+                return fail("无效的 JSON 字面量");
+            }
+            return m_token = Null;
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                if (!scanNumber()) {
+                    return fail("无效的 JSON 数值");
+                }
+                return m_token = Number;
+            }
+            return fail(QString("无效的 JSON 字符: %1").arg(QLatin1Char(c)));
+        }
+    }
+}
+
+JsonStreamReader::TokenType JsonStreamReader::tokenType() const
+{
+    return m_token;
+}
+
+QByteArrayView JsonStreamReader::name() const
+{
+    return QByteArrayView(m_valueBegin, m_valueLength);
+}
+
+QString JsonStreamReader::stringValue() const
+{
+    if (m_token != String && m_token != Name) {
+        return QString();
+    }
+
+    // 快速路径：没有转义序列时直接按 UTF-8 解码
+    if (!m_hasEscapes) {
+        return QString::fromUtf8(m_valueBegin, m_valueLength);
+    }
+
+    QString result;
+    result.reserve(m_valueLength);
+    const char* p = m_valueBegin;
+    const char* end = m_valueBegin + m_valueLength;
+    const char* runStart = p;
+
+    auto hexValue = [](const char* s) -> int {
+        int value = 0;
+        for (int i = 0; i < 4; ++i) {
+            const char h = s[i];
+            value <<= 4;
+            if (h >= '0' && h <= '9') value |= h - '0';
+            else if (h >= 'a' && h <= 'f') value |= h - 'a' + 10;
+            else if (h >= 'A' && h <= 'F') value |= h - 'A' + 10;
+            else return -1;
+        }
+        return value;
+    };
+
+    while (p < end) {
+        if (*p != '\\') {
+            ++p;
+            continue;
+        }
+        result += QString::fromUtf8(runStart, p - runStart);
+        ++p;
+        if (p >= end) {
+            break;
+        }
+        switch (*p) {
+        case '"': result += QLatin1Char('"'); break;
+        case '\\': result += QLatin1Char('\\'); break;
+        case '/': result += QLatin1Char('/'); break;
+        case 'b': result += QLatin1Char('\b'); break;
+        case 'f': result += QLatin1Char('\f'); break;
+        case 'n': result += QLatin1Char('\n'); break;
+        case 'r': result += QLatin1Char('\r'); break;
+        case 't': result += QLatin1Char('\t'); break;
+        case 'u':
+            if (end - p >= 5) {
+                const int code = hexValue(p + 1);
+                if (code >= 0) {
+                    result += QChar(static_cast<char16_t>(code));
+                }
+                p += 4;
+            }
+            break;
+        default:
+            break;
+        }
+        ++p;
+        runStart = p;
+    }
+    result += QString::fromUtf8(runStart, end - runStart);
+    return result;
+}
+
+double JsonStreamReader::numberValue() const
+{
+    if (m_token != Number) {
+        return 0.0;
+    }
+    // fromRawData 不复制数据；QByteArray::toDouble 与区域设置无关
+    return QByteArray::fromRawData(m_valueBegin, m_valueLength).toDouble();
+}
+
+qint64 JsonStreamReader::integerValue() const
+{
+    if (m_token != Number) {
+        return 0;
+    }
+    bool ok = false;
+    const QByteArray raw = QByteArray::fromRawData(m_valueBegin, m_valueLength);
+    const qint64 value = raw.toLongLong(&ok);
+    return ok ? value : static_cast<qint64>(raw.toDouble());
+}
+
+bool JsonStreamReader::boolValue() const
+{
+    return m_token == Bool && m_boolValue;
+}
+
+bool JsonStreamReader::skipCurrentValue()
+{
+    if (m_token != StartArray && m_token != StartObject) {
+        return m_token != Invalid;
+    }
+
+    const int depth = m_stack.size() - 1;
+    while (m_stack.size() > depth) {
+        if (readNext() == Invalid) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool JsonStreamReader::hasError() const
+{
+    return !m_error.isEmpty();
+}
+
+QString JsonStreamReader::errorString() const
+{
+    return m_error;
+}
+
+qsizetype JsonStreamReader::offset() const
+{
+    return m_pos - m_begin;
+}
+
+void JsonStreamReader::skipWhitespace()
+{
+    while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\n' || *m_pos == '\r' || *m_pos == '\t')) {
+        ++m_pos;
+    }
+}
+
+bool JsonStreamReader::scanString()
+{
+    // m_pos 指向起始引号
+    ++m_pos;
+    m_valueBegin = m_pos;
+    m_hasEscapes = false;
+
+    while (m_pos < m_end) {
+        // 批量查找下一个引号或反斜杠
+        const char* quote = static_cast<const char*>(std::memchr(m_pos, '"', m_end - m_pos));
+        if (!quote) {
+            return false;
+        }
+        const char* backslash = static_cast<const char*>(std::memchr(m_pos, '\\', quote - m_pos));
+        if (!backslash) {
+            m_valueLength = quote - m_valueBegin;
+            m_pos = quote + 1;
+            return true;
+        }
+        // 跳过转义字符后继续查找
+        m_hasEscapes = true;
+        m_pos = backslash + 2;
+    }
+    return false;
+}
+
+bool JsonStreamReader::scanNumber()
+{
+    m_valueBegin = m_pos;
+    while (m_pos < m_end) {
+        const char c = *m_pos;
+        if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+            ++m_pos;
+        } else {
+            break;
+        }
+    }
+    m_valueLength = m_pos - m_valueBegin;
+    return m_valueLength > 0;
+}
+
+bool JsonStreamReader::scanLiteral(const char* literal)
+{
+    const size_t length = std::strlen(literal);
+    if (static_cast<size_t>(m_end - m_pos) < length || std::memcmp(m_pos, literal, length) != 0) {
+        return false;
+    }
+    m_pos += length;
+    return true;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::fail(const QString& message)
+{
+    m_error = QString("%1 (偏移 %2)").arg(message).arg(m_pos - m_begin);
+    return m_token = Invalid;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file JsonStreamReader.h
+ * @brief 流式JSON读取器头文件
+ *
+ * 拉取式（pull）JSON解析器，逐个产出记号，不构建 QJsonDocument。
+ */
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief 流式JSON读取器
+ *
+ * 直接在输入字节（通常是内存映射的文件）上解析。字段名以原始字节视图返回，
+ * 不做解码和内存分配；字符串值只有在调用 stringValue() 时才解码。
+ */
+class JsonStreamReader {
+public:
+    /**
+     * @brief 记号类型
+     */
+    enum TokenType {
+        Invalid,        //!< 解析错误
+        StartArray,     //!< [
+        EndArray,       //!< ]
+        StartObject,    //!< {
+        EndObject,      //!< }
+        Name,           //!< 对象字段名
+        String,         //!< 字符串值
+        Number,         //!< 数值
+        Bool,           //!< true / false
+        Null,           //!< null
+        EndDocument     //!< 输入结束
+    };
+
+    /**
+     * @brief 构造函数
+     * @param begin 输入起始位置
+     * @param end 输入结束位置
+     */
+    JsonStreamReader(const char* begin, const char* end);
+
+    /**
+     * @brief 构造函数
+     * @param data 输入数据（调用方需保证其生命周期覆盖读取过程）
+     */
+    explicit JsonStreamReader(const QByteArray& data);
+
+    /**
+     * @brief 读取下一个记号
+     * @return 记号类型
+     */
+    TokenType readNext();
+
+    /**
+     * @brief 获取当前记号类型
+     * @return 记号类型
+     */
+    TokenType tokenType() const;
+
+    /**
+     * @brief 获取当前字段名的原始字节
+     * @return 字段名字节视图（不含引号）
+     */
+    QByteArrayView name() const;
+
+    /**
+     * @brief 获取当前字符串值（解码转义序列）
+     * @return 字符串值
+     */
+    QString stringValue() const;
+
+    /**
+     * @brief 获取当前数值
+     * @return 浮点数值
+     */
+    double numberValue() const;
+
+    /**
+     * @brief 获取当前数值的整数形式
+     * @return 整数值
+     */
+    qint64 integerValue() const;
+
+    /**
+     * @brief 获取当前布尔值
+     * @return 布尔值
+     */
+    bool boolValue() const;
+
+    /**
+     * @brief 跳过当前值
+     *
+     * 如果当前记号是数组或对象的开始，则一直读到与之匹配的结束记号。
+     *
+     * @return 如果成功跳过返回true，否则返回false
+     */
+    bool skipCurrentValue();
+
+    /**
+     * @brief 检查是否发生解析错误
+     * @return 如果出现错误返回true
+     */
+    bool hasError() const;
+
+    /**
+     * @brief 获取错误描述
+     * @return 错误描述
+     */
+    QString errorString() const;
+
+    /**
+     * @brief 获取当前解析位置相对输入起点的偏移
+     * @return 字节偏移
+     */
+    qsizetype offset() const;
+
+private:
+    /**
+     * @brief 跳过空白字符
+     */
+    void skipWhitespace();
+
+    /**
+     * @brief 解析字符串，记录其原始范围
+     * @return 如果成功解析返回true
+     */
+    bool scanString();
+
+    /**
+     * @brief 解析数值，记录其原始范围
+     * @return 如果成功解析返回true
+     */
+    bool scanNumber();
+
+    /**
+     * @brief 解析字面量（true/false/null）
+     * @param literal 期望的字面量
+     * @return 如果匹配返回true
+     */
+    bool scanLiteral(const char* literal);
+
+    /**
+     * @brief 记录错误并返回 Invalid
+     * @param message 错误描述
+     * @return Invalid
+     */
+    TokenType fail(const QString& message);
+
+    //!< 输入起始位置
+    const char* m_begin;
+
+    //!< 当前解析位置
+    const char* m_pos;
+
+    //!< 输入结束位置
+    const char* m_end;
+
+    //!< 当前记号类型
+    TokenType m_token;
+
+    //!< 当前记号原始内容起始位置
+    const char* m_valueBegin;
+
+    //!< 当前记号原始内容长度
+    qsizetype m_valueLength;
+
+    //!< 当前字符串是否包含转义序列
+    bool m_hasEscapes;
+
+    //!< 当前布尔值
+    bool m_boolValue;
+
+    //!< 容器栈：true 表示对象，false 表示数组
+    QVector<bool> m_stack;
+
+    //!< 下一个字符串是否应作为字段名
+    bool m_expectName;
+
+    //!< 错误描述
+    QString m_error;
+};
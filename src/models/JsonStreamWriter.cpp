@@ -0,0 +1,194 @@
+/**
+ * @file JsonStreamWriter.cpp
+ * @brief 流式JSON写入器实现
+ *
+ * 实现了JsonStreamWriter类中定义的编码和缓冲写入方法。
+ */
+#include "JsonStreamWriter.h"
+#include <QLocale>
+#include <cmath>
+
+JsonStreamWriter::JsonStreamWriter(QIODevice* device, int bufferSize)
+    : m_device(device)
+    , m_bufferSize(bufferSize)
+    , m_error(false)
+{
+    m_buffer.reserve(bufferSize + 4096);
+}
+
+JsonStreamWriter::~JsonStreamWriter()
+{
+    flush();
+}
+
+void JsonStreamWriter::beginArray()
+{
+    beginValue();
+    m_buffer += "[\n";
+    m_counts.append(0);
+}
+
+void JsonStreamWriter::beginArray(const char* key)
+{
+    writeKey(key);
+    m_buffer += "[\n";
+    m_counts.append(0);
+}
+
+void JsonStreamWriter::endArray()
+{
+    endContainer(']');
+}
+
+void JsonStreamWriter::beginObject()
+{
+    beginValue();
+    m_buffer += "{\n";
+    m_counts.append(0);
+}
+
+void JsonStreamWriter::endObject()
+{
+    endContainer('}');
+}
+
+void JsonStreamWriter::writeString(const char* key, const QString& value)
+{
+    writeKey(key);
+    m_buffer += '"';
+    appendEscaped(value);
+    m_buffer += '"';
+}
+
+void JsonStreamWriter::writeDouble(const char* key, double value)
+{
+    writeKey(key);
+    if (!std::isfinite(value)) {
+        // 与 Qt 一致：非有限数写为 null
+        m_buffer += "null";
+        return;
+    }
+    // 与 Qt 一致：整数值用 'f'，其余用 'g'，均取最短可往返表示
+    const double absValue = std::abs(value);
+    const bool integral = absValue < 18446744073709551616.0
+                          && absValue == static_cast<double>(static_cast<quint64>(absValue));
+    m_buffer += QByteArray::number(value, integral ? 'f' : 'g', QLocale::FloatingPointShortest);
+}
+
+void JsonStreamWriter::writeInteger(const char* key, qint64 value)
+{
+    writeKey(key);
+    m_buffer += QByteArray::number(value);
+}
+
+void JsonStreamWriter::writeBool(const char* key, bool value)
+{
+    writeKey(key);
+    m_buffer += value ? "true" : "false";
+}
+
+bool JsonStreamWriter::flush()
+{
+    if (m_buffer.isEmpty() || m_error) {
+        return !m_error;
+    }
+    if (m_device->write(m_buffer) != m_buffer.size()) {
+        m_error = true;
+    }
+    m_buffer.clear();
+    return !m_error;
+}
+
+bool JsonStreamWriter::hasError() const
+{
+    return m_error;
+}
+
+void JsonStreamWriter::beginValue()
+{
+    if (m_counts.isEmpty()) {
+        return; // 顶层值
+    }
+    if (m_counts.last()++ > 0) {
+        m_buffer += ",\n";
+    }
+    appendIndent(m_counts.size());
+}
+
+void JsonStreamWriter::writeKey(const char* key)
+{
+    beginValue();
+    m_buffer += '"';
+    m_buffer += key;
+    m_buffer += "\": ";
+}
+
+void JsonStreamWriter::appendEscaped(const QString& value)
+{
+    const QChar* it = value.constData();
+    const QChar* end = it + value.size();
+    const QChar* runStart = it;
+
+    // 需要转义的字符之间的连续片段整体转换为 UTF-8
+    auto flushRun = [&](const QChar* runEnd) {
+        if (runEnd > runStart) {
+            m_buffer += QStringView(runStart, runEnd - runStart).toUtf8();
+        }
+    };
+
+    for (; it != end; ++it) {
+        const char16_t u = it->unicode();
+        if (u >= 0x20 && u != 0x22 && u != 0x5c) {
+            continue;
+        }
+        flushRun(it);
+        runStart = it + 1;
+        m_buffer += '\\';
+        switch (u) {
+        case 0x22: m_buffer += '"'; break;
+        case 0x5c: m_buffer += '\\'; break;
+        case 0x08: m_buffer += 'b'; break;
+        case 0x0c: m_buffer += 'f'; break;
+        case 0x0a: m_buffer += 'n'; break;
+        case 0x0d: m_buffer += 'r'; break;
+        case 0x09: m_buffer += 't'; break;
+        default: {
+            static const char hex[] = "0123456789abcdef";
+            m_buffer += "u00";
+            m_buffer += hex[(u >> 4) & 0xf];
+            m_buffer += hex[u & 0xf];
+            break;
+        }
+        }
+    }
+    flushRun(end);
+}
+
+void JsonStreamWriter::appendIndent(int depth)
+{
+    m_buffer.append(4 * depth, ' ');
+}
+
+void JsonStreamWriter::endContainer(char closing)
+{
+    if (m_counts.isEmpty()) {
+        return;
+    }
+    const bool hasElements = m_counts.takeLast() > 0;
+    if (hasElements) {
+        m_buffer += '\n';
+    }
+    appendIndent(m_counts.size());
+    m_buffer += closing;
+    if (m_counts.isEmpty()) {
+        m_buffer += '\n'; // 顶层值以换行结束
+    }
+    maybeFlush();
+}
+
+void JsonStreamWriter::maybeFlush()
+{
+    if (m_buffer.size() >= m_bufferSize) {
+        flush();
+    }
+}
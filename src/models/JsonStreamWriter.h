@@ -0,0 +1,150 @@
+/**
+ * @file JsonStreamWriter.h
+ * @brief 流式JSON写入器头文件
+ *
+ * 不构建 QJsonDocument，直接把记录编码到输出缓冲区并分块写入设备。
+ */
+#pragma once
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief 流式JSON写入器
+ *
+ * 输出格式与 QJsonDocument::toJson(QJsonDocument::Indented) 逐字节一致：
+ * 四空格缩进、"key": value 形式、顶层结尾换行。调用方需要按键名排序
+ * 依次写入对象字段（QJsonObject 总是按键名排序输出）。
+ */
+class JsonStreamWriter {
+public:
+    /**
+     * @brief 构造函数
+     * @param device 输出设备（需已打开）
+     * @param bufferSize 缓冲区大小，缓冲满后写入设备
+     */
+    explicit JsonStreamWriter(QIODevice* device, int bufferSize = 64 * 1024);
+
+    /**
+     * @brief 析构函数，写出剩余缓冲
+     */
+    ~JsonStreamWriter();
+
+    /**
+     * @brief 开始一个数组（作为数组元素或顶层值）
+     */
+    void beginArray();
+
+    /**
+     * @brief 结束当前数组
+     */
+    void endArray();
+
+    /**
+     * @brief 开始一个对象（作为数组元素或顶层值）
+     */
+    void beginObject();
+
+    /**
+     * @brief 开始一个对象字段值为数组
+     * @param key 字段名
+     */
+    void beginArray(const char* key);
+
+    /**
+     * @brief 结束当前对象
+     */
+    void endObject();
+
+    /**
+     * @brief 写入字符串字段
+     * @param key 字段名（ASCII，无需转义）
+     * @param value 字段值
+     */
+    void writeString(const char* key, const QString& value);
+
+    /**
+     * @brief 写入浮点数字段
+     * @param key 字段名
+     * @param value 字段值
+     */
+    void writeDouble(const char* key, double value);
+
+    /**
+     * @brief 写入整数字段
+     * @param key 字段名
+     * @param value 字段值
+     */
+    void writeInteger(const char* key, qint64 value);
+
+    /**
+     * @brief 写入布尔字段
+     * @param key 字段名
+     * @param value 字段值
+     */
+    void writeBool(const char* key, bool value);
+
+    /**
+     * @brief 将缓冲区内容写入设备
+     * @return 如果写入成功返回true，否则返回false
+     */
+    bool flush();
+
+    /**
+     * @brief 检查是否发生过写入错误
+     * @return 如果出现错误返回true
+     */
+    bool hasError() const;
+
+private:
+    /**
+     * @brief 在写入一个新值之前输出分隔符和缩进
+     */
+    void beginValue();
+
+    /**
+     * @brief 输出字段名
+     * @param key 字段名
+     */
+    void writeKey(const char* key);
+
+    /**
+     * @brief 按 Qt JSON 规则转义并追加字符串
+     * @param value 字符串
+     */
+    void appendEscaped(const QString& value);
+
+    /**
+     * @brief 追加当前层级的缩进
+     * @param depth 层级
+     */
+    void appendIndent(int depth);
+
+    /**
+     * @brief 结束一个容器
+     * @param closing 结束符
+     */
+    void endContainer(char closing);
+
+    /**
+     * @brief 缓冲区超过阈值时写入设备
+     */
+    void maybeFlush();
+
+    //!< 输出设备
+    QIODevice* m_device;
+
+    //!< 输出缓冲区
+    QByteArray m_buffer;
+
+    //!< 缓冲区阈值
+    int m_bufferSize;
+
+    //!< 每一层容器中已写入的元素数量
+    QVector<int> m_counts;
+
+    //!< 是否发生过写入错误
+    bool m_error;
+};
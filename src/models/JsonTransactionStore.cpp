@@ -0,0 +1,119 @@
+/**
+ * @file JsonTransactionStore.cpp
+ * @brief JSON交易存储类实现
+ *
+ * 实现了JsonTransactionStore类中定义的文件读写方法。
+ */
+#include "JsonTransactionStore.h"
+#include "TransactionIdGenerator.h"
+#include <QDebug>
+
+/**
+ * @brief 构造函数
+ * @param persistenceManager JSON持久化管理器
+ * @param filename 交易数据文件名
+ */
+JsonTransactionStore::JsonTransactionStore(JsonPersistenceManager* persistenceManager,
+                                           const QString& filename)
+    : m_persistenceManager(persistenceManager)
+    , m_filename(filename)
+{
+}
+
+/**
+ * @brief 从JSON文件加载全部交易记录
+ * @param transactions 输出参数，保存读取的交易记录
+ * @return 如果成功加载返回true，否则返回false
+ */
+bool JsonTransactionStore::loadTransactions(QVector<Transaction>& transactions)
+{
+    QVector<QVector<Transaction>> chunks;
+    int fileVersion = 0;
+
+    // 使用持久化管理器分块并行解析，每个分块写入各自的结果列表；
+    // 各版本的记录使用同一个解码函数，旧版本缺少的交易编号在合并后补分配
+    bool success = m_persistenceManager->loadRecordChunks(m_filename, FORMAT_NAME,
+        [&](int version, int chunkCount) {
+            if (version < JsonPersistenceManager::LEGACY_FORMAT_VERSION || version > FORMAT_VERSION) {
+                return false;
+            }
+            fileVersion = version;
+            chunks.resize(chunkCount);
+            return true;
+        },
+        [&chunks](int chunk, JsonStreamReader& reader) {
+            chunks[chunk].append(Transaction::readJson(reader));
+            return true;
+        });
+    if (!success) {
+        return false;
+    }
+
+    // 按分块顺序合并，保持文件中的记录顺序
+    qsizetype total = 0;
+    for (const auto &chunk : chunks) {
+        total += chunk.size();
+    }
+    QVector<Transaction> loaded;
+    loaded.reserve(total);
+    for (auto &chunk : chunks) {
+        loaded.append(std::move(chunk));
+    }
+
+    transactions = std::move(loaded);
+
+    // 旧格式文件只迁移一次：补分配交易编号后按当前格式写回
+    const int assigned = TransactionIdGenerator::assignMissingIds(transactions);
+    if (fileVersion != FORMAT_VERSION || assigned > 0) {
+        qDebug() << "交易数据文件从版本" << fileVersion << "迁移到版本" << FORMAT_VERSION;
+        saveTransactions(transactions);
+    }
+    return true;
+}
+
+/**
+ * @brief 将全部交易记录保存到JSON文件
+ * @param transactions 完整的交易记录列表
+ * @return 如果成功保存返回true，否则返回false
+ */
+bool JsonTransactionStore::saveTransactions(const QVector<Transaction>& transactions)
+{
+    // 使用持久化管理器流式写入，逐条直接编码到文件缓冲区
+    return m_persistenceManager->saveRecords(m_filename, FORMAT_NAME, FORMAT_VERSION,
+        [&transactions](JsonStreamWriter& writer) {
+            for (const auto &transaction : transactions) {
+                transaction.writeJson(writer);
+            }
+        });
+}
+
+/**
+ * @brief 追加新交易记录
+ *
+ * JSON文件无法原地追加，直接重写完整账本。
+ *
+ * @param transactions 完整的交易记录列表
+ * @param firstNewIndex 第一条新记录的下标（未使用）
+ * @return 如果成功保存返回true，否则返回false
+ */
+bool JsonTransactionStore::appendTransactions(const QVector<Transaction>& transactions, int firstNewIndex)
+{
+    Q_UNUSED(firstNewIndex);
+    return saveTransactions(transactions);
+}
+
+/**
+ * @brief 删除指定卡号的交易记录
+ * @param cardNumber 卡号（未使用）
+ * @param remaining 删除后剩余的完整交易记录列表
+ * @param rewritten 被改写的记录下标（未使用）
+ * @return 如果成功保存返回true，否则返回false
+ */
+bool JsonTransactionStore::removeTransactionsForCard(const QString& cardNumber,
+                                                     const QVector<Transaction>& remaining,
+                                                     const QVector<int>& rewritten)
+{
+    Q_UNUSED(cardNumber);
+    Q_UNUSED(rewritten);
+    return saveTransactions(remaining);
+}
@@ -0,0 +1,74 @@
+/**
+ * @file JsonTransactionStore.h
+ * @brief JSON交易存储类
+ *
+ * 使用JSON文件作为后端存储实现ITransactionStore接口。
+ */
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include "ITransactionStore.h"
+#include "JsonPersistenceManager.h"
+
+/**
+ * @brief JSON交易存储类
+ *
+ * 每次变更都将完整账本重写到JSON文件。
+ */
+class JsonTransactionStore : public ITransactionStore {
+public:
+    //!< 交易数据文件的格式名称
+    static constexpr const char* FORMAT_NAME = "atm-transactions";
+
+    //!< 当前交易数据文件格式版本（版本1为无文件头的旧格式，版本2的记录没有交易编号，
+    //!< 版本3没有双边转账记录）
+    static const int FORMAT_VERSION = 4;
+
+    /**
+     * @brief 构造函数
+     * @param persistenceManager JSON持久化管理器
+     * @param filename 交易数据文件名
+     */
+    JsonTransactionStore(JsonPersistenceManager* persistenceManager, const QString& filename);
+
+    /**
+     * @brief 加载全部交易记录
+     * @param transactions 输出参数，保存读取的交易记录
+     * @return 如果成功加载返回true，否则返回false
+     */
+    bool loadTransactions(QVector<Transaction>& transactions) override;
+
+    /**
+     * @brief 全量保存交易记录
+     * @param transactions 完整的交易记录列表
+     * @return 如果成功保存返回true，否则返回false
+     */
+    bool saveTransactions(const QVector<Transaction>& transactions) override;
+
+    /**
+     * @brief 追加新交易记录（重写完整文件）
+     * @param transactions 完整的交易记录列表
+     * @param firstNewIndex 第一条新记录的下标
+     * @return 如果成功保存返回true，否则返回false
+     */
+    bool appendTransactions(const QVector<Transaction>& transactions, int firstNewIndex) override;
+
+    /**
+     * @brief 删除指定卡号的交易记录（重写完整文件）
+     * @param cardNumber 卡号
+     * @param remaining 删除后剩余的完整交易记录列表
+     * @param rewritten 被改写的记录下标（整文件重写，未使用）
+     * @return 如果成功保存返回true，否则返回false
+     */
+    bool removeTransactionsForCard(const QString& cardNumber,
+                                   const QVector<Transaction>& remaining,
+                                   const QVector<int>& rewritten) override;
+
+private:
+    //!< JSON持久化管理器
+    JsonPersistenceManager* m_persistenceManager;
+
+    //!< 交易数据文件名
+    QString m_filename;
+};
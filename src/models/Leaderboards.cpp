@@ -0,0 +1,119 @@
+/**
+ * @file Leaderboards.cpp
+ * @brief 增量维护的排行榜实现
+ *
+ * 实现了BalanceLeaderboard和ActivityLeaderboard的更新和查询方法。
+ */
+#include "Leaderboards.h"
+
+void BalanceLeaderboard::clear()
+{
+    m_order.clear();
+    m_balances.clear();
+}
+
+void BalanceLeaderboard::set(const QString& cardNumber, double balance)
+{
+    auto it = m_balances.find(cardNumber);
+    if (it != m_balances.end()) {
+        if (it.value() == balance) {
+            return;
+        }
+        m_order.erase(Key{it.value(), cardNumber});
+        it.value() = balance;
+    } else {
+        m_balances.insert(cardNumber, balance);
+    }
+    m_order.insert(Key{balance, cardNumber});
+}
+
+void BalanceLeaderboard::remove(const QString& cardNumber)
+{
+    auto it = m_balances.find(cardNumber);
+    if (it == m_balances.end()) {
+        return;
+    }
+    m_order.erase(Key{it.value(), cardNumber});
+    m_balances.erase(it);
+}
+
+QVector<LeaderboardEntry> BalanceLeaderboard::top(int n) const
+{
+    QVector<LeaderboardEntry> result;
+    result.reserve(qBound(0, n, int(m_order.size())));
+    for (auto it = m_order.begin(); it != m_order.end() && result.size() < n; ++it) {
+        result.append(LeaderboardEntry{it->cardNumber, it->balance});
+    }
+    return result;
+}
+
+ActivityLeaderboard::ActivityLeaderboard(qint64 windowMs)
+    : m_windowMs(windowMs)
+{
+}
+
+void ActivityLeaderboard::clear()
+{
+    m_events.clear();
+    m_counts.clear();
+    m_order.clear();
+}
+
+void ActivityLeaderboard::record(const QString& cardNumber, qint64 atMs, qint64 nowMs)
+{
+    if (atMs <= nowMs - m_windowMs) {
+        return;
+    }
+    m_events.insert(atMs, cardNumber);
+    adjust(cardNumber, 1);
+    expire(nowMs);
+}
+
+QVector<LeaderboardEntry> ActivityLeaderboard::top(int n, qint64 nowMs) const
+{
+    expire(nowMs);
+
+    QVector<LeaderboardEntry> result;
+    result.reserve(qBound(0, n, int(m_order.size())));
+    for (auto it = m_order.begin(); it != m_order.end() && result.size() < n; ++it) {
+        result.append(LeaderboardEntry{it->cardNumber, double(it->count)});
+    }
+    return result;
+}
+
+int ActivityLeaderboard::eventCount(qint64 nowMs) const
+{
+    expire(nowMs);
+    return m_events.size();
+}
+
+void ActivityLeaderboard::expire(qint64 nowMs) const
+{
+    const qint64 cutoff = nowMs - m_windowMs;
+    while (!m_events.isEmpty() && m_events.firstKey() <= cutoff) {
+        auto it = m_events.begin();
+        adjust(it.value(), -1);
+        m_events.erase(it);
+    }
+}
+
+void ActivityLeaderboard::adjust(const QString& cardNumber, int delta) const
+{
+    auto it = m_counts.find(cardNumber);
+    const int before = it != m_counts.end() ? it.value() : 0;
+    const int after = before + delta;
+
+    if (before > 0) {
+        m_order.erase(Key{before, cardNumber});
+    }
+    if (after > 0) {
+        m_order.insert(Key{after, cardNumber});
+        if (it != m_counts.end()) {
+            it.value() = after;
+        } else {
+            m_counts.insert(cardNumber, after);
+        }
+    } else if (it != m_counts.end()) {
+        m_counts.erase(it);
+    }
+}
@@ -0,0 +1,171 @@
+/**
+ * @file Leaderboards.h
+ * @brief 增量维护的排行榜
+ *
+ * 定义了按余额排序的账户排行榜和按最近交易次数排序的活跃卡号排行榜，
+ * 两者都在每次变化时以 O(log n) 更新，取前 N 名只需 O(N)。
+ */
+#pragma once
+
+#include <QHash>
+#include <QMultiMap>
+#include <QString>
+#include <QVector>
+#include <set>
+
+/**
+ * @brief 排行榜中的一项
+ */
+struct LeaderboardEntry {
+    QString cardNumber;     //!< 卡号
+    double value;           //!< 排序值（余额或交易次数）
+};
+
+/**
+ * @brief 余额排行榜
+ *
+ * 有序集合按（余额降序，卡号升序）保存每张卡，另用哈希表记录每张卡当前的余额，
+ * 更新时先按旧余额删除再按新余额插入。
+ */
+class BalanceLeaderboard {
+public:
+    /**
+     * @brief 清空排行榜
+     */
+    void clear();
+
+    /**
+     * @brief 设置卡号的余额（不存在时插入）
+     * @param cardNumber 卡号
+     * @param balance 余额
+     */
+    void set(const QString& cardNumber, double balance);
+
+    /**
+     * @brief 移除卡号
+     * @param cardNumber 卡号
+     */
+    void remove(const QString& cardNumber);
+
+    /**
+     * @brief 获取余额最高的前 N 张卡
+     * @param n 数量
+     * @return 按余额降序排列的卡号和余额
+     */
+    QVector<LeaderboardEntry> top(int n) const;
+
+    /**
+     * @brief 获取排行榜中的卡数
+     * @return 卡数
+     */
+    int size() const { return m_balances.size(); }
+
+private:
+    /**
+     * @brief 有序集合的键
+     */
+    struct Key {
+        double balance;         //!< 余额
+        QString cardNumber;     //!< 卡号
+
+        bool operator<(const Key& other) const
+        {
+            if (balance != other.balance) {
+                return balance > other.balance;
+            }
+            return cardNumber < other.cardNumber;
+        }
+    };
+
+    //!< 按余额降序排列的卡号
+    std::set<Key> m_order;
+
+    //!< 卡号到当前余额
+    QHash<QString, double> m_balances;
+};
+
+/**
+ * @brief 活跃卡号排行榜
+ *
+ * 统计每张卡在滑动时间窗口内的交易次数。事件按时间保存在有序表中，窗口移动时
+ * 从最早的事件开始过期并扣减对应卡号的次数；次数的有序集合与余额排行榜相同。
+ * 事件可以乱序登记（例如加载账本时），早于窗口的事件直接忽略。
+ */
+class ActivityLeaderboard {
+public:
+    /**
+     * @brief 构造函数
+     * @param windowMs 窗口长度（毫秒）
+     */
+    explicit ActivityLeaderboard(qint64 windowMs = 24LL * 60 * 60 * 1000);
+
+    /**
+     * @brief 清空排行榜
+     */
+    void clear();
+
+    /**
+     * @brief 登记一次交易
+     * @param cardNumber 卡号
+     * @param atMs 交易时间（UTC毫秒）
+     * @param nowMs 当前时间（UTC毫秒）
+     */
+    void record(const QString& cardNumber, qint64 atMs, qint64 nowMs);
+
+    /**
+     * @brief 获取窗口内交易次数最多的前 N 张卡
+     * @param n 数量
+     * @param nowMs 当前时间（UTC毫秒）
+     * @return 按次数降序排列的卡号和次数
+     */
+    QVector<LeaderboardEntry> top(int n, qint64 nowMs) const;
+
+    /**
+     * @brief 获取窗口内的事件数
+     * @param nowMs 当前时间（UTC毫秒）
+     * @return 事件数
+     */
+    int eventCount(qint64 nowMs) const;
+
+private:
+    /**
+     * @brief 有序集合的键
+     */
+    struct Key {
+        int count;              //!< 窗口内交易次数
+        QString cardNumber;     //!< 卡号
+
+        bool operator<(const Key& other) const
+        {
+            if (count != other.count) {
+                return count > other.count;
+            }
+            return cardNumber < other.cardNumber;
+        }
+    };
+
+    /**
+     * @brief 过期窗口之外的事件
+     * @param nowMs 当前时间（UTC毫秒）
+     */
+    void expire(qint64 nowMs) const;
+
+    /**
+     * @brief 调整卡号的次数并维护有序集合
+     * @param cardNumber 卡号
+     * @param delta 变化量
+     */
+    void adjust(const QString& cardNumber, int delta) const;
+
+    //!< 窗口长度（毫秒）
+    qint64 m_windowMs;
+
+    //!< 窗口内的事件（时间 → 卡号，读取时过期）
+    mutable QMultiMap<qint64, QString> m_events;
+
+    //!< 卡号到窗口内交易次数
+    mutable QHash<QString, int> m_counts;
+
+    //!< 按次数降序排列的卡号
+    mutable std::set<Key> m_order;
+};
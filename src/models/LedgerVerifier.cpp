@@ -0,0 +1,243 @@
+/**
+ * @file LedgerVerifier.cpp
+ * @brief 账本一致性校验实现
+ *
+ * 实现了LedgerVerifier类中定义的分组、并行重放和报告方法。
+ */
+#include "LedgerVerifier.h"
+#include "TransactionIdGenerator.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+//!< 金额比较的容差（不到一分钱视为相等）
+const double kBalanceTolerance = 0.005;
+
+//!< 每个线程分得的卡号块数，块数多于线程数以平衡各卡交易数的差异
+const int kChunksPerThread = 4;
+
+bool sameBalance(double a, double b)
+{
+    return std::fabs(a - b) < kBalanceTolerance;
+}
+
+/**
+ * @brief 一个卡号分块
+ */
+struct CardChunk {
+    int begin;      //!< 起始卡号下标
+    int end;        //!< 结束卡号下标（不含）
+};
+
+} // namespace
+
+QString LedgerDiscrepancy::toString() const
+{
+    const QString id = TransactionIdGenerator::toString(transactionId);
+    switch (kind) {
+    case Kind::ChainBreak:
+        return QString("卡号 %1 交易 %2: 余额链断裂，应为 %3，记录为 %4")
+            .arg(cardNumber, id, QString::number(expected, 'f', 2), QString::number(actual, 'f', 2));
+    case Kind::BalanceMismatch:
+        return QString("卡号 %1: 账户余额 %2 与最后一笔交易 %3 的余额 %4 不符")
+            .arg(cardNumber, QString::number(actual, 'f', 2), id, QString::number(expected, 'f', 2));
+    case Kind::OrphanLedger:
+        return QString("卡号 %1: 存在交易记录但账户不存在").arg(cardNumber);
+    }
+    return QString();
+}
+
+double LedgerReport::transactionsPerSecond() const
+{
+    if (elapsedMs <= 0) {
+        return 0.0;
+    }
+    return transactionsReplayed * 1000.0 / elapsedMs;
+}
+
+QString LedgerReport::summary() const
+{
+    return QString("账本校验%1: %2 张卡, %3 笔交易, %4 处不一致, %5 个线程, 耗时 %6 ms (%7 笔/秒)")
+        .arg(isConsistent() ? "通过" : "未通过")
+        .arg(cardsChecked)
+        .arg(transactionsReplayed)
+        .arg(discrepancies.size())
+        .arg(threads)
+        .arg(elapsedMs)
+        .arg(qRound64(transactionsPerSecond()));
+}
+
+LedgerVerifier::LedgerVerifier(int threads)
+    : m_threads(threads > 0 ? threads : qMax(1, QThread::idealThreadCount()))
+{
+}
+
+LedgerReport LedgerVerifier::verify(const QVector<Transaction>& transactions,
+                                    const QVector<Account>& accounts) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // 按卡号分组（单线程，只记录下标）；双边转账记录同时归入收款方
+    QHash<QString, int> cardIndex;
+    QVector<QString> cards;
+    QVector<QVector<int>> perCard;
+    auto addToCard = [&](const QString& cardNumber, int index) {
+        auto found = cardIndex.constFind(cardNumber);
+        int slot;
+        if (found == cardIndex.constEnd()) {
+            slot = cards.size();
+            cardIndex.insert(cardNumber, slot);
+            cards.append(cardNumber);
+            perCard.append(QVector<int>());
+        } else {
+            slot = found.value();
+        }
+        perCard[slot].append(index);
+    };
+    for (int i = 0; i < transactions.size(); ++i) {
+        const Transaction& transaction = transactions.at(i);
+        addToCard(transaction.cardNumber, i);
+        if (transaction.hasTargetLeg && transaction.targetCardNumber != transaction.cardNumber) {
+            addToCard(transaction.targetCardNumber, i);
+        }
+    }
+
+    QVector<const Account*> cardAccounts(cards.size(), nullptr);
+    for (const Account& account : accounts) {
+        auto found = cardIndex.constFind(account.cardNumber);
+        if (found != cardIndex.constEnd()) {
+            cardAccounts[found.value()] = &account;
+        }
+    }
+
+    // 卡号分块，每块的结果单独存放，互不共享
+    const int chunkCount = qBound(1, cards.size(), m_threads * kChunksPerThread);
+    QVector<CardChunk> chunks;
+    chunks.reserve(chunkCount);
+    for (int i = 0; i < chunkCount; ++i) {
+        chunks.append(CardChunk{int(qint64(cards.size()) * i / chunkCount),
+                                int(qint64(cards.size()) * (i + 1) / chunkCount)});
+    }
+    QVector<QVector<LedgerDiscrepancy>> results(chunks.size());
+
+    auto replayChunk = [&](int index) {
+        const CardChunk& chunk = chunks.at(index);
+        for (int card = chunk.begin; card < chunk.end; ++card) {
+            replayCard(transactions, cards.at(card), perCard[card], cardAccounts.at(card), results[index]);
+        }
+    };
+
+    if (chunks.size() == 1 || m_threads == 1) {
+        for (int i = 0; i < chunks.size(); ++i) {
+            replayChunk(i);
+        }
+    } else {
+        QVector<int> indices(chunks.size());
+        std::iota(indices.begin(), indices.end(), 0);
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(m_threads);
+        QtConcurrent::blockingMap(&pool, indices, replayChunk);
+    }
+
+    LedgerReport report;
+    report.cardsChecked = cards.size();
+    report.transactionsReplayed = transactions.size();
+    report.threads = m_threads;
+    for (const auto& chunkResult : results) {
+        report.discrepancies += chunkResult;
+    }
+    std::stable_sort(report.discrepancies.begin(), report.discrepancies.end(),
+                     [](const LedgerDiscrepancy& a, const LedgerDiscrepancy& b) {
+                         return a.cardNumber < b.cardNumber;
+                     });
+    report.elapsedMs = timer.elapsed();
+
+    if (report.isConsistent()) {
+        qDebug() << report.summary();
+    } else {
+        qWarning() << report.summary();
+    }
+    return report;
+}
+
+void LedgerVerifier::replayCard(const QVector<Transaction>& transactions, const QString& cardNumber,
+                                QVector<int>& indices,
+                                const Account* account, QVector<LedgerDiscrepancy>& discrepancies)
+{
+    if (indices.isEmpty()) {
+        return;
+    }
+
+    if (!account) {
+        discrepancies.append(LedgerDiscrepancy{LedgerDiscrepancy::Kind::OrphanLedger, cardNumber});
+        return;
+    }
+
+    std::sort(indices.begin(), indices.end(), [&transactions](int a, int b) {
+        const Transaction& left = transactions.at(a);
+        const Transaction& right = transactions.at(b);
+        if (left.timestamp != right.timestamp) {
+            return left.timestamp < right.timestamp;
+        }
+        if (left.id != right.id) {
+            return left.id < right.id;
+        }
+        return a < b;
+    });
+
+    bool hasBalance = false;
+    double balance = 0.0;
+    for (int index : indices) {
+        const Transaction& transaction = transactions.at(index);
+
+        // 收款方一侧：按转入处理，核对收款方余额
+        const bool incoming = transaction.cardNumber != cardNumber;
+        const TransactionType type = incoming ? TransactionType::TransferIn : transaction.type;
+        const double recorded = incoming ? transaction.targetBalanceAfter : transaction.balanceAfter;
+
+        double expected = balance;
+        bool checked = hasBalance;
+        switch (type) {
+        case TransactionType::Deposit:
+        case TransactionType::TransferIn:
+        case TransactionType::Interest:
+            expected = balance + transaction.amount;
+            break;
+        case TransactionType::Withdrawal:
+        case TransactionType::Transfer:
+        case TransactionType::Fee:
+            expected = balance - transaction.amount;
+            break;
+        case TransactionType::BalanceInquiry:
+            break;
+        case TransactionType::Other:
+            checked = false;
+            break;
+        }
+
+        if (checked && !sameBalance(expected, recorded)) {
+            discrepancies.append(LedgerDiscrepancy{LedgerDiscrepancy::Kind::ChainBreak, cardNumber,
+                                                   transaction.id, expected, recorded});
+        }
+
+        // 以记录的余额继续，单处错误不会让后续交易全部报错
+        balance = recorded;
+        hasBalance = true;
+    }
+
+    if (!sameBalance(balance, account->balance)) {
+        const Transaction& last = transactions.at(indices.last());
+        discrepancies.append(LedgerDiscrepancy{LedgerDiscrepancy::Kind::BalanceMismatch, cardNumber,
+                                               last.id, balance, account->balance});
+    }
+}
@@ -0,0 +1,115 @@
+/**
+ * @file LedgerVerifier.h
+ * @brief 账本一致性校验
+ *
+ * 按卡号重放交易记录的 balanceAfter 链，检查其与交易金额及账户当前余额是否一致。
+ */
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include "Account.h"
+#include "Transaction.h"
+
+/**
+ * @brief 一处账本不一致
+ */
+struct LedgerDiscrepancy {
+    /**
+     * @brief 不一致的类型
+     */
+    enum class Kind {
+        ChainBreak,         //!< balanceAfter 与上一笔余额和本笔金额推算的结果不符
+        BalanceMismatch,    //!< 账户当前余额与最后一笔交易的 balanceAfter 不符
+        OrphanLedger        //!< 交易记录所属的账户不存在
+    };
+
+    Kind kind;                  //!< 不一致的类型
+    QString cardNumber;         //!< 卡号
+    quint64 transactionId = 0;  //!< 相关交易编号（BalanceMismatch 时为最后一笔交易）
+    double expected = 0.0;      //!< 推算的余额
+    double actual = 0.0;        //!< 记录的余额
+
+    /**
+     * @brief 生成可读的描述
+     * @return 描述文本
+     */
+    QString toString() const;
+};
+
+/**
+ * @brief 校验报告
+ */
+struct LedgerReport {
+    int cardsChecked = 0;                       //!< 重放了账本的卡数
+    qint64 transactionsReplayed = 0;            //!< 重放的交易数
+    int threads = 0;                            //!< 使用的线程数
+    qint64 elapsedMs = 0;                       //!< 耗时（毫秒）
+    QVector<LedgerDiscrepancy> discrepancies;   //!< 发现的不一致（按卡号排序）
+
+    /**
+     * @brief 账本是否一致
+     * @return 没有发现不一致时返回true
+     */
+    bool isConsistent() const { return discrepancies.isEmpty(); }
+
+    /**
+     * @brief 重放吞吐量
+     * @return 每秒重放的交易数
+     */
+    double transactionsPerSecond() const;
+
+    /**
+     * @brief 生成一行摘要
+     * @return 摘要文本
+     */
+    QString summary() const;
+};
+
+/**
+ * @brief 账本一致性校验器
+ *
+ * 先按卡号对交易分组，再把卡号分块交给线程池；每张卡的交易按时间戳
+ * （相同时按交易编号）排序后依次重放：
+ * - 存款、转入：上一笔余额 + 金额
+ * - 取款、转出：上一笔余额 - 金额
+ * - 余额查询：余额不变
+ * - 其他（登录、管理员操作等）：只作为余额快照，用于重新同步，不做校验
+ *
+ * 每张卡的第一笔交易没有前序余额，只用来确定起点。最后一笔交易的余额再与
+ * 账户当前余额比较。双边转账记录同时归入付款方和收款方，收款方一侧按转入处理，
+ * 核对 targetBalanceAfter。各卡之间没有共享状态，分块结果最后合并。
+ */
+class LedgerVerifier {
+public:
+    /**
+     * @brief 构造函数
+     * @param threads 线程数，0 表示使用 QThread::idealThreadCount()
+     */
+    explicit LedgerVerifier(int threads = 0);
+
+    /**
+     * @brief 校验账本
+     * @param transactions 全部交易记录（任意顺序）
+     * @param accounts 全部账户
+     * @return 校验报告
+     */
+    LedgerReport verify(const QVector<Transaction>& transactions,
+                        const QVector<Account>& accounts) const;
+
+private:
+    /**
+     * @brief 重放一张卡的交易
+     * @param transactions 全部交易记录
+     * @param cardNumber 卡号
+     * @param indices 该卡交易在 transactions 中的下标（会被排序）
+     * @param account 该卡的账户，不存在时为nullptr
+     * @param discrepancies 输出参数，追加发现的不一致
+     */
+    static void replayCard(const QVector<Transaction>& transactions, const QString& cardNumber,
+                           QVector<int>& indices,
+                           const Account* account, QVector<LedgerDiscrepancy>& discrepancies);
+
+    //!< 线程数
+    int m_threads;
+};
@@ -0,0 +1,205 @@
+/**
+ * @file LoginThrottle.cpp
+ * @brief 登录限流表实现
+ *
+ * 实现了LoginThrottle类中定义的限流判断和延迟写回方法。
+ */
+#include "LoginThrottle.h"
+#include "IAccountRepository.h"
+#include <QDebug>
+#include <QVector>
+
+namespace {
+
+//!< 终端令牌桶数量超过该值时清理闲置的桶
+constexpr int kTerminalPruneThreshold = 1024;
+
+} // namespace
+
+LoginThrottle::LoginThrottle(const Clock* clock)
+    : LoginThrottle(clock, Config())
+{
+}
+
+LoginThrottle::LoginThrottle(const Clock* clock, const Config& config)
+    : m_clock(clock ? clock : Clock::system())
+    , m_config(config)
+    , m_urgent(false)
+{
+}
+
+void LoginThrottle::setClock(const Clock* clock)
+{
+    m_clock = clock ? clock : Clock::system();
+}
+
+bool LoginThrottle::isCardLocked(const Account& account)
+{
+    const CardState& state = cardState(account);
+    return state.lockUntilMs != 0 && m_clock->utcMs() < state.lockUntilMs;
+}
+
+qint64 LoginThrottle::lockedUntilMs(const Account& account)
+{
+    return cardState(account).lockUntilMs;
+}
+
+bool LoginThrottle::allowTerminal(const QString& terminalId)
+{
+    return terminalBucket(terminalId).tokens >= 1.0;
+}
+
+LoginThrottle::FailureOutcome LoginThrottle::recordFailure(const Account& account, const QString& terminalId)
+{
+    recordTerminalFailure(terminalId);
+
+    CardState& state = cardState(account);
+    const qint64 now = m_clock->utcMs();
+    state.failedAttempts++;
+    state.lastFailedMs = now;
+    m_dirtyCards.insert(account.cardNumber);
+
+    FailureOutcome outcome{state.failedAttempts, false};
+    if (state.failedAttempts >= m_config.maxFailedAttempts) {
+        state.lockUntilMs = now + m_config.lockDurationMs;
+        outcome.lockedNow = true;
+        // 锁定必须尽快持久化，否则重启即可绕过
+        m_urgent = true;
+        qDebug() << "账户" << account.cardNumber << "因连续登录失败被临时锁定，锁定至"
+                 << QDateTime::fromMSecsSinceEpoch(state.lockUntilMs).toString();
+    }
+
+    return outcome;
+}
+
+void LoginThrottle::recordTerminalFailure(const QString& terminalId)
+{
+    TerminalBucket& bucket = terminalBucket(terminalId);
+    bucket.tokens = qMax(0.0, bucket.tokens - 1.0);
+
+    if (m_terminals.size() > kTerminalPruneThreshold) {
+        pruneTerminals();
+    }
+}
+
+void LoginThrottle::recordSuccess(const Account& account)
+{
+    CardState& state = cardState(account);
+    if (state.failedAttempts == 0 && state.lockUntilMs == 0) {
+        return;
+    }
+
+    state = CardState();
+    m_dirtyCards.insert(account.cardNumber);
+    m_urgent = true;
+}
+
+void LoginThrottle::forget(const QString& cardNumber)
+{
+    m_cards.remove(cardNumber);
+    m_dirtyCards.remove(cardNumber);
+}
+
+bool LoginThrottle::hasUrgentChanges() const
+{
+    return m_urgent && !m_dirtyCards.isEmpty();
+}
+
+bool LoginThrottle::hasPendingChanges() const
+{
+    return !m_dirtyCards.isEmpty();
+}
+
+OperationResult LoginThrottle::flush(IAccountRepository* repository)
+{
+    if (m_dirtyCards.isEmpty()) {
+        m_urgent = false;
+        return OperationResult::Success();
+    }
+
+    // 以存储库中的最新数据为基础，只覆盖登录失败相关字段
+    QVector<Account> accounts;
+    accounts.reserve(m_dirtyCards.size());
+    for (const QString& cardNumber : std::as_const(m_dirtyCards)) {
+        std::optional<Account> accountOpt = repository->findByCardNumber(cardNumber);
+        if (!accountOpt) {
+            m_cards.remove(cardNumber);
+            continue;
+        }
+
+        const CardState& state = m_cards.value(cardNumber);
+        Account account = accountOpt.value();
+        account.failedLoginAttempts = state.failedAttempts;
+        account.lastFailedLogin = state.lastFailedMs != 0
+            ? QDateTime::fromMSecsSinceEpoch(state.lastFailedMs, Qt::UTC) : QDateTime();
+        account.temporaryLockTime = state.lockUntilMs != 0
+            ? QDateTime::fromMSecsSinceEpoch(state.lockUntilMs, Qt::UTC) : QDateTime();
+        accounts.append(account);
+    }
+
+    OperationResult result = repository->saveAccountsBatch(accounts);
+    if (!result.success) {
+        qWarning() << "登录失败状态写回失败:" << result.errorMessage;
+        return result;
+    }
+
+    // 已写回且没有失败记录的卡号不再需要留在内存中
+    for (const QString& cardNumber : std::as_const(m_dirtyCards)) {
+        auto it = m_cards.find(cardNumber);
+        if (it != m_cards.end() && it->failedAttempts == 0 && it->lockUntilMs == 0) {
+            m_cards.erase(it);
+        }
+    }
+    m_dirtyCards.clear();
+    m_urgent = false;
+    return OperationResult::Success();
+}
+
+LoginThrottle::CardState& LoginThrottle::cardState(const Account& account)
+{
+    auto it = m_cards.find(account.cardNumber);
+    if (it == m_cards.end()) {
+        CardState state;
+        state.failedAttempts = account.failedLoginAttempts;
+        state.lastFailedMs = account.lastFailedLogin.isValid() ? account.lastFailedLogin.toMSecsSinceEpoch() : 0;
+        state.lockUntilMs = account.temporaryLockTime.isValid() ? account.temporaryLockTime.toMSecsSinceEpoch() : 0;
+        it = m_cards.insert(account.cardNumber, state);
+    }
+    return it.value();
+}
+
+LoginThrottle::TerminalBucket& LoginThrottle::terminalBucket(const QString& terminalId)
+{
+    const qint64 now = m_clock->monotonicMs();
+
+    auto it = m_terminals.find(terminalId);
+    if (it == m_terminals.end()) {
+        TerminalBucket bucket;
+        bucket.tokens = m_config.terminalBurst;
+        bucket.refilledAtMs = now;
+        return m_terminals.insert(terminalId, bucket).value();
+    }
+
+    TerminalBucket& bucket = it.value();
+    if (now > bucket.refilledAtMs && m_config.terminalRefillMs > 0) {
+        const double refill = double(now - bucket.refilledAtMs) / m_config.terminalRefillMs;
+        bucket.tokens = qMin<double>(m_config.terminalBurst, bucket.tokens + refill);
+        bucket.refilledAtMs = now;
+    }
+    return bucket;
+}
+
+void LoginThrottle::pruneTerminals()
+{
+    const qint64 now = m_clock->monotonicMs();
+    const qint64 fullAfterMs = qint64(m_config.terminalBurst) * m_config.terminalRefillMs;
+
+    for (auto it = m_terminals.begin(); it != m_terminals.end();) {
+        // 闲置到足以补满的桶与新建的桶等价，可以直接丢弃
+        if (now - it->refilledAtMs >= fullAfterMs) {
+            it = m_terminals.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,194 @@
+/**
+ * @file LoginThrottle.h
+ * @brief 登录限流表
+ *
+ * 在内存中跟踪按卡号的登录失败次数和临时锁定，以及按终端的令牌桶，
+ * 使密码错误不再每次都重写账户文件。
+ */
+#pragma once
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include "Account.h"
+#include "Clock.h"
+#include "OperationResult.h"
+
+class IAccountRepository;
+
+/**
+ * @brief 登录限流表
+ *
+ * 卡号维度：失败次数达到上限后临时锁定，状态首次访问时从账户数据初始化，
+ * 之后以内存为准，仅在 flush() 时批量写回存储库。
+ *
+ * 终端维度：令牌桶，每次PIN错误消耗一个令牌，令牌按固定间隔恢复；
+ * 令牌耗尽的终端在恢复前不再进行PIN校验，防止同一终端轮换卡号暴力尝试。
+ * 令牌桶只使用单调时钟，不涉及日历时间，也不持久化。
+ */
+class LoginThrottle {
+public:
+    /**
+     * @brief 限流参数
+     */
+    struct Config {
+        int maxFailedAttempts = Account::MAX_FAILED_ATTEMPTS;                   //!< 卡号连续失败上限
+        qint64 lockDurationMs = qint64(Account::TEMP_LOCK_DURATION) * 60 * 1000; //!< 临时锁定时长（毫秒）
+        int terminalBurst = 10;                                                 //!< 终端令牌桶容量
+        qint64 terminalRefillMs = 30 * 1000;                                    //!< 终端恢复一个令牌的间隔（毫秒）
+    };
+
+    /**
+     * @brief 一次失败登录的处理结果
+     */
+    struct FailureOutcome {
+        int failedAttempts;     //!< 当前连续失败次数
+        bool lockedNow;         //!< 本次失败是否触发了临时锁定
+    };
+
+    /**
+     * @brief 构造函数，使用默认限流参数
+     * @param clock 时间来源
+     */
+    explicit LoginThrottle(const Clock* clock = Clock::system());
+
+    /**
+     * @brief 构造函数
+     * @param clock 时间来源
+     * @param config 限流参数
+     */
+    LoginThrottle(const Clock* clock, const Config& config);
+
+    /**
+     * @brief 设置时间来源
+     * @param clock 时钟，为空时使用系统时钟
+     */
+    void setClock(const Clock* clock);
+
+    /**
+     * @brief 检查卡号是否处于临时锁定
+     * @param account 账户（首次访问时用于初始化内存状态）
+     * @return 如果临时锁定返回true
+     */
+    bool isCardLocked(const Account& account);
+
+    /**
+     * @brief 获取卡号的临时锁定到期时间
+     * @param account 账户（首次访问时用于初始化内存状态）
+     * @return 到期时间（UTC毫秒），从未锁定时为0（已到期的锁定仍返回原到期时间）
+     */
+    qint64 lockedUntilMs(const Account& account);
+
+    /**
+     * @brief 检查终端是否还有尝试额度
+     * @param terminalId 终端标识
+     * @return 如果允许尝试返回true
+     */
+    bool allowTerminal(const QString& terminalId);
+
+    /**
+     * @brief 记录一次PIN错误
+     * @param account 账户
+     * @param terminalId 终端标识
+     * @return 失败次数及是否触发临时锁定
+     */
+    FailureOutcome recordFailure(const Account& account, const QString& terminalId);
+
+    /**
+     * @brief 记录一次只涉及终端的失败（如卡号不存在）
+     * @param terminalId 终端标识
+     */
+    void recordTerminalFailure(const QString& terminalId);
+
+    /**
+     * @brief 记录一次登录成功，清除卡号的失败计数和临时锁定
+     * @param account 账户
+     */
+    void recordSuccess(const Account& account);
+
+    /**
+     * @brief 丢弃卡号的内存状态
+     *
+     * 管理员解锁、重置PIN或删除账户后调用，下次访问时重新从账户数据初始化。
+     *
+     * @param cardNumber 卡号
+     */
+    void forget(const QString& cardNumber);
+
+    /**
+     * @brief 检查是否有需要尽快写回的状态（新触发的锁定或清除的计数）
+     * @return 如果需要立即写回返回true
+     */
+    bool hasUrgentChanges() const;
+
+    /**
+     * @brief 检查是否有尚未写回的状态
+     * @return 如果存在未写回的卡号状态返回true
+     */
+    bool hasPendingChanges() const;
+
+    /**
+     * @brief 将未写回的卡号状态批量写入存储库
+     *
+     * 只覆盖账户的失败次数、最后失败时间和临时锁定时间，其余字段以存储库中的最新数据为准。
+     *
+     * @param repository 账户存储库
+     * @return 操作结果
+     */
+    OperationResult flush(IAccountRepository* repository);
+
+private:
+    /**
+     * @brief 卡号维度的状态
+     */
+    struct CardState {
+        int failedAttempts = 0;     //!< 连续失败次数
+        qint64 lastFailedMs = 0;    //!< 最后一次失败时间（UTC毫秒，0表示无）
+        qint64 lockUntilMs = 0;     //!< 临时锁定到期时间（UTC毫秒，0表示未锁定）
+    };
+
+    /**
+     * @brief 终端维度的令牌桶
+     */
+    struct TerminalBucket {
+        double tokens = 0.0;        //!< 当前令牌数
+        qint64 refilledAtMs = 0;    //!< 上次补充令牌时的单调读数
+    };
+
+    /**
+     * @brief 获取卡号状态，首次访问时从账户数据初始化
+     * @param account 账户
+     * @return 卡号状态
+     */
+    CardState& cardState(const Account& account);
+
+    /**
+     * @brief 获取终端令牌桶并按经过时间补充令牌
+     * @param terminalId 终端标识
+     * @return 令牌桶
+     */
+    TerminalBucket& terminalBucket(const QString& terminalId);
+
+    /**
+     * @brief 清理已满且长时间未使用的终端令牌桶
+     */
+    void pruneTerminals();
+
+    //!< 时间来源
+    const Clock* m_clock;
+
+    //!< 限流参数
+    Config m_config;
+
+    //!< 卡号状态表
+    QHash<QString, CardState> m_cards;
+
+    //!< 终端令牌桶表
+    QHash<QString, TerminalBucket> m_terminals;
+
+    //!< 尚未写回存储库的卡号
+    QSet<QString> m_dirtyCards;
+
+    //!< 是否存在需要立即写回的变更
+    bool m_urgent;
+};
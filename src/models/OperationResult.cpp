@@ -12,6 +12,7 @@
 OperationResult::OperationResult()
     : success(true)
     , errorMessage(QString())
+    , transactionId(0)
 {
 }
 
@@ -23,6 +24,7 @@ OperationResult::OperationResult()
 OperationResult::OperationResult(bool success, const QString& errorMessage)
     : success(success)
     , errorMessage(errorMessage)
+    , transactionId(0)
 {
 }
 
@@ -35,6 +37,18 @@ OperationResult OperationResult::Success()
     return OperationResult(true, QString());
 }
 
+/**
+ * @brief 创建一个记录了交易的成功 OperationResult
+ * @param transactionId 账本中的交易编号
+ * @return 成功的 OperationResult
+ */
+OperationResult OperationResult::Success(quint64 transactionId)
+{
+    OperationResult result(true, QString());
+    result.transactionId = transactionId;
+    return result;
+}
+
 /**
  * @brief 创建一个失败的 OperationResult
  * @param error 错误信息
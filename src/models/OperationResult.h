@@ -37,11 +37,23 @@ public:
      */
     QString errorMessage;
 
+    /**
+     * @brief 操作在账本中记录的交易编号，未记录交易时为0
+     */
+    quint64 transactionId;
+
     /**
      * @brief 创建一个成功的 OperationResult
      * @return 成功的 OperationResult
      */
     static OperationResult Success();
+
+    /**
+     * @brief 创建一个记录了交易的成功 OperationResult
+     * @param transactionId 账本中的交易编号
+     * @return 成功的 OperationResult
+     */
+    static OperationResult Success(quint64 transactionId);
     
     /**
      * @brief 创建一个失败的 OperationResult
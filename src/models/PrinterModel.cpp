@@ -9,7 +9,6 @@
 #include "PrinterModel.h"
 #include <QDebug>
 #include <QGuiApplication>
-#include <QUuid>
 #include <QFileDialog>
 #include <QPdfWriter> // 用于直接生成 PDF
 #include <QPainter> // 用于 QPdfWriter
@@ -197,11 +196,6 @@ QString PrinterModel::generateReceiptHtml(
     const QDateTime &transactionDate,
     const QString &transactionId)
 {
-    // 生成唯一交易 ID，如果未提供则生成新的 UUID
-    QString uuid = transactionId.isEmpty() ?
-                  QUuid::createUuid().toString(QUuid::WithoutBraces).mid(0, 10).toUpper() :
-                  transactionId;
-
     // 构建改进的HTML结构，确保所有信息清晰可见并设置明确的黑色文本颜色
     QString html = 
         // 头部 - 减小高度，保持样式
@@ -227,7 +221,7 @@ QString PrinterModel::generateReceiptHtml(
         }
     }
 
-    html += "<tr><th style='padding: 12px; color: #000000; background-color: #f0f0f0;'>交易编号:</th><td style='padding: 12px; color: #000000;'>" + uuid + "</td></tr>"
+    html += "<tr><th style='padding: 12px; color: #000000; background-color: #f0f0f0;'>交易编号:</th><td style='padding: 12px; color: #000000;'>" + transactionId + "</td></tr>"
             "</table>"
             
             // 分隔线
@@ -61,7 +61,7 @@ public:
      * @param targetCardNumber 目标卡号（转账时使用，默认为空）
      * @param targetCardHolder 目标持卡人姓名（转账时使用，默认为空）
      * @param transactionDate 交易日期时间（默认为当前时间）
-     * @param transactionId 交易编号（默认为空，将自动生成）
+     * @param transactionId 账本中的交易编号（由调用方提供，不会自动生成）
      * @return 生成的 HTML 内容字符串
      */
     QString generateReceiptHtml(
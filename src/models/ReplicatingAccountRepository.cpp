@@ -0,0 +1,73 @@
+/**
+ * @file ReplicatingAccountRepository.cpp
+ * @brief 复制账户存储库装饰器实现
+ *
+ * 实现了ReplicatingAccountRepository类中定义的转发和记录变更方法。
+ */
+#include "ReplicatingAccountRepository.h"
+
+ReplicatingAccountRepository::ReplicatingAccountRepository(std::unique_ptr<IAccountRepository> repository,
+                                                           ReplicationLog* log)
+    : m_repository(std::move(repository))
+    , m_log(log)
+{
+    Q_ASSERT(m_repository != nullptr);
+    Q_ASSERT(m_log != nullptr);
+}
+
+OperationResult ReplicatingAccountRepository::saveAccount(const Account& account)
+{
+    OperationResult result = m_repository->saveAccount(account);
+    if (result.success) {
+        m_log->appendAccounts(QVector<Account>{account});
+    }
+    return result;
+}
+
+OperationResult ReplicatingAccountRepository::saveAccountsBatch(const QVector<Account>& accounts)
+{
+    OperationResult result = m_repository->saveAccountsBatch(accounts);
+    if (result.success && !accounts.isEmpty()) {
+        m_log->appendAccounts(accounts);
+    }
+    return result;
+}
+
+OperationResult ReplicatingAccountRepository::deleteAccount(const QString& cardNumber)
+{
+    OperationResult result = m_repository->deleteAccount(cardNumber);
+    if (result.success) {
+        m_log->appendAccountDeleted(cardNumber);
+    }
+    return result;
+}
+
+std::optional<Account> ReplicatingAccountRepository::findByCardNumber(const QString& cardNumber) const
+{
+    return m_repository->findByCardNumber(cardNumber);
+}
+
+QVector<Account> ReplicatingAccountRepository::getAllAccounts() const
+{
+    return m_repository->getAllAccounts();
+}
+
+bool ReplicatingAccountRepository::saveAccounts()
+{
+    return m_repository->saveAccounts();
+}
+
+bool ReplicatingAccountRepository::loadAccounts()
+{
+    return m_repository->loadAccounts();
+}
+
+bool ReplicatingAccountRepository::accountExists(const QString& cardNumber) const
+{
+    return m_repository->accountExists(cardNumber);
+}
+
+const AccountTable* ReplicatingAccountRepository::accountTable() const
+{
+    return m_repository->accountTable();
+}
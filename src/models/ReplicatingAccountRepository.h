@@ -0,0 +1,44 @@
+/**
+ * @file ReplicatingAccountRepository.h
+ * @brief 复制账户存储库装饰器
+ *
+ * 包装任意账户存储库，每次成功提交后把变更追加到主备复制日志。
+ */
+#pragma once
+
+#include <memory>
+#include "IAccountRepository.h"
+#include "ReplicationLog.h"
+
+/**
+ * @brief 复制账户存储库装饰器
+ *
+ * 所有操作转发给被包装的存储库；saveAccount()、saveAccountsBatch() 和 deleteAccount()
+ * 成功后记录一条变更，失败的操作不记录。加载和全量保存不改变账户内容，不记录。
+ */
+class ReplicatingAccountRepository : public IAccountRepository {
+public:
+    /**
+     * @brief 构造函数
+     * @param repository 被包装的存储库（所有权转移）
+     * @param log 复制日志
+     */
+    ReplicatingAccountRepository(std::unique_ptr<IAccountRepository> repository, ReplicationLog* log);
+
+    OperationResult saveAccount(const Account& account) override;
+    OperationResult saveAccountsBatch(const QVector<Account>& accounts) override;
+    OperationResult deleteAccount(const QString& cardNumber) override;
+    std::optional<Account> findByCardNumber(const QString& cardNumber) const override;
+    QVector<Account> getAllAccounts() const override;
+    bool saveAccounts() override;
+    bool loadAccounts() override;
+    bool accountExists(const QString& cardNumber) const override;
+    const AccountTable* accountTable() const override;
+
+private:
+    //!< 被包装的存储库
+    std::unique_ptr<IAccountRepository> m_repository;
+
+    //!< 复制日志
+    ReplicationLog* m_log;
+};
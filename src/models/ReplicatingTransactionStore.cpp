@@ -0,0 +1,52 @@
+/**
+ * @file ReplicatingTransactionStore.cpp
+ * @brief 复制交易存储装饰器实现
+ *
+ * 实现了ReplicatingTransactionStore类中定义的转发和记录变更方法。
+ */
+#include "ReplicatingTransactionStore.h"
+
+ReplicatingTransactionStore::ReplicatingTransactionStore(std::unique_ptr<ITransactionStore> store,
+                                                         ReplicationLog* log)
+    : m_store(std::move(store))
+    , m_log(log)
+{
+    Q_ASSERT(m_store != nullptr);
+    Q_ASSERT(m_log != nullptr);
+}
+
+bool ReplicatingTransactionStore::loadTransactions(QVector<Transaction>& transactions)
+{
+    return m_store->loadTransactions(transactions);
+}
+
+bool ReplicatingTransactionStore::saveTransactions(const QVector<Transaction>& transactions)
+{
+    if (!m_store->saveTransactions(transactions)) {
+        return false;
+    }
+    m_log->appendLedgerReset();
+    return true;
+}
+
+bool ReplicatingTransactionStore::appendTransactions(const QVector<Transaction>& transactions, int firstNewIndex)
+{
+    if (!m_store->appendTransactions(transactions, firstNewIndex)) {
+        return false;
+    }
+    if (firstNewIndex < transactions.size()) {
+        m_log->appendTransactions(transactions.mid(firstNewIndex));
+    }
+    return true;
+}
+
+bool ReplicatingTransactionStore::removeTransactionsForCard(const QString& cardNumber,
+                                                            const QVector<Transaction>& remaining,
+                                                            const QVector<int>& rewritten)
+{
+    if (!m_store->removeTransactionsForCard(cardNumber, remaining, rewritten)) {
+        return false;
+    }
+    m_log->appendCardCleared(cardNumber);
+    return true;
+}
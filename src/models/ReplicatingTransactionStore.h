@@ -0,0 +1,42 @@
+/**
+ * @file ReplicatingTransactionStore.h
+ * @brief 复制交易存储装饰器
+ *
+ * 包装任意交易存储后端，每次成功写入后把账本变更追加到主备复制日志。
+ */
+#pragma once
+
+#include <memory>
+#include "ITransactionStore.h"
+#include "ReplicationLog.h"
+
+/**
+ * @brief 复制交易存储装饰器
+ *
+ * 追加记录只复制新增的部分；删除某卡的记录只复制卡号，备用节点按
+ * TransactionModel::withoutCard() 的同一规则重放。全量保存无法表示为增量，
+ * 记录为账本重写，使备用节点重新获取快照。
+ */
+class ReplicatingTransactionStore : public ITransactionStore {
+public:
+    /**
+     * @brief 构造函数
+     * @param store 被包装的交易存储（所有权转移）
+     * @param log 复制日志
+     */
+    ReplicatingTransactionStore(std::unique_ptr<ITransactionStore> store, ReplicationLog* log);
+
+    bool loadTransactions(QVector<Transaction>& transactions) override;
+    bool saveTransactions(const QVector<Transaction>& transactions) override;
+    bool appendTransactions(const QVector<Transaction>& transactions, int firstNewIndex) override;
+    bool removeTransactionsForCard(const QString& cardNumber,
+                                   const QVector<Transaction>& remaining,
+                                   const QVector<int>& rewritten) override;
+
+private:
+    //!< 被包装的交易存储
+    std::unique_ptr<ITransactionStore> m_store;
+
+    //!< 复制日志
+    ReplicationLog* m_log;
+};
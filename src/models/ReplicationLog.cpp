@@ -0,0 +1,139 @@
+/**
+ * @file ReplicationLog.cpp
+ * @brief 主备复制变更日志实现
+ *
+ * 实现了ReplicationLog类中定义的变更追加、淘汰和帧编解码方法。
+ */
+#include "ReplicationLog.h"
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QtEndian>
+
+namespace {
+
+//!< 帧长度前缀的字节数
+const int kFrameHeaderSize = 4;
+
+//!< 单帧的最大长度，超过时视为数据损坏
+const quint32 kMaxFrameSize = 64 * 1024 * 1024;
+
+QString kindName(ChangeKind kind)
+{
+    switch (kind) {
+    case ChangeKind::AccountsSaved:
+        return "accounts";
+    case ChangeKind::AccountDeleted:
+        return "account-deleted";
+    case ChangeKind::TransactionsAppended:
+        return "transactions";
+    case ChangeKind::CardCleared:
+        return "card-cleared";
+    case ChangeKind::LedgerReset:
+        return "ledger-reset";
+    }
+    return QString();
+}
+
+} // namespace
+
+ReplicationLog::ReplicationLog(qint64 maxBytes, QObject* parent)
+    : QObject(parent)
+    , m_epoch(QRandomGenerator::global()->generate64())
+    , m_maxBytes(maxBytes)
+{
+}
+
+void ReplicationLog::appendAccounts(const QVector<Account>& accounts)
+{
+    QJsonArray records;
+    for (const Account& account : accounts) {
+        records.append(account.toJson());
+    }
+    append(ChangeKind::AccountsSaved, QJsonObject{{"records", records}});
+}
+
+void ReplicationLog::appendAccountDeleted(const QString& cardNumber)
+{
+    append(ChangeKind::AccountDeleted, QJsonObject{{"cardNumber", cardNumber}});
+}
+
+void ReplicationLog::appendTransactions(const QVector<Transaction>& transactions)
+{
+    QJsonArray records;
+    for (const Transaction& transaction : transactions) {
+        records.append(transaction.toJson());
+    }
+    append(ChangeKind::TransactionsAppended, QJsonObject{{"records", records}});
+}
+
+void ReplicationLog::appendCardCleared(const QString& cardNumber)
+{
+    append(ChangeKind::CardCleared, QJsonObject{{"cardNumber", cardNumber}});
+}
+
+void ReplicationLog::appendLedgerReset()
+{
+    append(ChangeKind::LedgerReset, QJsonObject());
+}
+
+void ReplicationLog::append(ChangeKind kind, QJsonObject message)
+{
+    // 变更时间用于测量复制延迟，主备在同一台机器上比较，使用真实时间
+    ChangeEntry entry;
+    entry.lsn = lastLsn() + 1;
+    entry.utcMs = QDateTime::currentMSecsSinceEpoch();
+    entry.kind = kind;
+
+    // 64位整数超出 double 的精确范围，以字符串保存
+    message["type"] = "change";
+    message["kind"] = kindName(kind);
+    message["lsn"] = QString::number(entry.lsn);
+    message["ms"] = QString::number(entry.utcMs);
+    entry.frame = encodeFrame(message);
+
+    m_bytes += entry.frame.size();
+    m_entries.append(std::move(entry));
+    while (m_bytes > m_maxBytes && m_entries.size() > 1) {
+        m_bytes -= m_entries.first().frame.size();
+        m_entries.removeFirst();
+        ++m_firstLsn;
+    }
+
+    emit appended(lastLsn());
+}
+
+QByteArray ReplicationLog::encodeFrame(const QJsonObject& message)
+{
+    const QByteArray payload = QJsonDocument(message).toJson(QJsonDocument::Compact);
+    QByteArray frame(kFrameHeaderSize, Qt::Uninitialized);
+    qToBigEndian(quint32(payload.size()), frame.data());
+    frame.append(payload);
+    return frame;
+}
+
+bool ReplicationLog::takeFrames(QByteArray& buffer, QVector<QJsonObject>& messages)
+{
+    qsizetype offset = 0;
+    while (buffer.size() - offset >= kFrameHeaderSize) {
+        const quint32 length = qFromBigEndian<quint32>(buffer.constData() + offset);
+        if (length > kMaxFrameSize) {
+            return false;
+        }
+        if (buffer.size() - offset - kFrameHeaderSize < qsizetype(length)) {
+            break;
+        }
+
+        QJsonParseError error;
+        const QJsonDocument document = QJsonDocument::fromJson(
+            buffer.mid(offset + kFrameHeaderSize, length), &error);
+        if (error.error != QJsonParseError::NoError || !document.isObject()) {
+            return false;
+        }
+        messages.append(document.object());
+        offset += kFrameHeaderSize + length;
+    }
+    buffer.remove(0, offset);
+    return true;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file ReplicationLog.h
+ * @brief 主备复制变更日志
+ *
+ * 定义了主节点记录账户和账本变更的有界内存日志，以及主备之间传输使用的帧格式。
+ */
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include "Account.h"
+#include "Transaction.h"
+
+/**
+ * @brief 变更类型
+ */
+enum class ChangeKind {
+    AccountsSaved,      //!< 账户新建或修改（携带完整账户）
+    AccountDeleted,     //!< 账户删除
+    TransactionsAppended, //!< 账本追加
+    CardCleared,        //!< 删除某卡的交易记录（备用节点按同一规则改写）
+    LedgerReset         //!< 账本被整体重写，备用节点需要重新获取快照
+};
+
+/**
+ * @brief 一条变更日志
+ */
+struct ChangeEntry {
+    quint64 lsn = 0;        //!< 日志序号（从1开始连续递增）
+    qint64 utcMs = 0;       //!< 写入日志的时间（UTC毫秒）
+    ChangeKind kind = ChangeKind::AccountsSaved; //!< 变更类型
+    QByteArray frame;       //!< 已编码的传输帧
+};
+
+/**
+ * @brief 主备复制变更日志
+ *
+ * 存储库和交易存储的复制装饰器在每次成功提交后追加一条变更，日志把变更编码为传输帧后保存在内存中，
+ * 发送时不再重复编码。日志只保留最近的变更，总字节数超过上限时从最早的一条开始淘汰；
+ * 落后于日志起点的备用节点改为从快照追赶，因此主节点的内存占用与备用节点落后多少无关。
+ *
+ * 日志序号只在本进程内有效，每个日志实例有一个随机的纪元编号，备用节点据此判断能否续传。
+ *
+ * 传输帧为 4 字节大端长度加紧凑格式的 JSON 对象，type 字段区分帧类型。
+ */
+class ReplicationLog : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param maxBytes 保留的变更帧总字节数上限
+     * @param parent 父对象
+     */
+    explicit ReplicationLog(qint64 maxBytes = 8 * 1024 * 1024, QObject* parent = nullptr);
+
+    /**
+     * @brief 追加账户新建或修改
+     * @param accounts 已提交的账户
+     */
+    void appendAccounts(const QVector<Account>& accounts);
+
+    /**
+     * @brief 追加账户删除
+     * @param cardNumber 卡号
+     */
+    void appendAccountDeleted(const QString& cardNumber);
+
+    /**
+     * @brief 追加账本记录
+     * @param transactions 新增的交易记录
+     */
+    void appendTransactions(const QVector<Transaction>& transactions);
+
+    /**
+     * @brief 追加删除某卡交易记录
+     * @param cardNumber 卡号
+     */
+    void appendCardCleared(const QString& cardNumber);
+
+    /**
+     * @brief 追加账本整体重写
+     */
+    void appendLedgerReset();
+
+    /**
+     * @brief 获取纪元编号
+     * @return 纪元编号
+     */
+    quint64 epoch() const { return m_epoch; }
+
+    /**
+     * @brief 获取保留的第一条变更的序号
+     * @return 序号，日志为空时为 lastLsn() + 1
+     */
+    quint64 firstLsn() const { return m_firstLsn; }
+
+    /**
+     * @brief 获取最后一条变更的序号
+     * @return 序号，从未追加时为0
+     */
+    quint64 lastLsn() const { return m_firstLsn + quint64(m_entries.size()) - 1; }
+
+    /**
+     * @brief 获取保留的变更
+     * @param lsn 序号（firstLsn() 到 lastLsn() 之间）
+     * @return 变更
+     */
+    const ChangeEntry& entry(quint64 lsn) const { return m_entries.at(int(lsn - m_firstLsn)); }
+
+    /**
+     * @brief 获取保留的变更数
+     * @return 变更数
+     */
+    int size() const { return m_entries.size(); }
+
+    /**
+     * @brief 获取保留的变更帧总字节数
+     * @return 字节数
+     */
+    qint64 bytes() const { return m_bytes; }
+
+    /**
+     * @brief 编码传输帧
+     * @param message 消息
+     * @return 长度前缀加 JSON 的帧
+     */
+    static QByteArray encodeFrame(const QJsonObject& message);
+
+    /**
+     * @brief 从接收缓冲区取出完整的帧
+     * @param buffer 接收缓冲区，已取出的字节会被移除
+     * @param messages 输出参数，追加解码的消息
+     * @return 如果缓冲区中的帧格式有效返回true
+     */
+    static bool takeFrames(QByteArray& buffer, QVector<QJsonObject>& messages);
+
+signals:
+    /**
+     * @brief 追加变更后发出的信号
+     * @param lsn 新变更的序号
+     */
+    void appended(quint64 lsn);
+
+private:
+    /**
+     * @brief 分配序号、编码并保存一条变更，超出上限时淘汰最早的变更
+     * @param kind 变更类型
+     * @param message 变更内容（不含序号和时间）
+     */
+    void append(ChangeKind kind, QJsonObject message);
+
+    //!< 纪元编号
+    quint64 m_epoch;
+
+    //!< 保留的变更帧总字节数上限
+    qint64 m_maxBytes;
+
+    //!< 保留的变更（按序号连续）
+    QVector<ChangeEntry> m_entries;
+
+    //!< m_entries 中第一条变更的序号
+    quint64 m_firstLsn = 1;
+
+    //!< 保留的变更帧总字节数
+    qint64 m_bytes = 0;
+};
@@ -0,0 +1,261 @@
+/**
+ * @file ReplicationPrimary.cpp
+ * @brief 主备复制的主节点实现
+ *
+ * 实现了ReplicationPrimary类中定义的连接管理、快照发送、日志续传和延迟统计方法。
+ */
+#include "ReplicationPrimary.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonArray>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QTimer>
+
+namespace {
+
+//!< 套接字待发送数据的上限（字节），超过时暂停发送
+const qint64 kMaxPendingBytes = 1024 * 1024;
+
+//!< 每个快照块的记录数
+const int kSnapshotChunkRecords = 1000;
+
+//!< 心跳间隔（毫秒）
+const int kHeartbeatIntervalMs = 1000;
+
+} // namespace
+
+QString ReplicationStatus::summary() const
+{
+    return QString("主备复制: %1 个备用节点, 最新序号 %2, 已确认 %3, 延迟 %4 条 / %5 ms, "
+                   "日志 %6 条 %7 字节, 已发送快照 %8 次")
+        .arg(standbys)
+        .arg(lastLsn)
+        .arg(ackedLsn)
+        .arg(lagRecords)
+        .arg(lagMs)
+        .arg(logRecords)
+        .arg(logBytes)
+        .arg(snapshotsSent);
+}
+
+ReplicationPrimary::ReplicationPrimary(ReplicationLog* log, IAccountRepository* repository,
+                                       TransactionModel* transactionModel, QObject* parent)
+    : QObject(parent)
+    , m_log(log)
+    , m_repository(repository)
+    , m_transactionModel(transactionModel)
+    , m_server(new QLocalServer(this))
+    , m_heartbeatTimer(new QTimer(this))
+{
+    Q_ASSERT(log != nullptr);
+    Q_ASSERT(repository != nullptr);
+    Q_ASSERT(transactionModel != nullptr);
+
+    connect(m_server, &QLocalServer::newConnection, this, &ReplicationPrimary::acceptConnections);
+    connect(m_log, &ReplicationLog::appended, this, [this]() {
+        const QList<QLocalSocket*> sockets = m_sessions.keys();
+        for (QLocalSocket* socket : sockets) {
+            pump(socket);
+        }
+    });
+
+    m_heartbeatTimer->setInterval(kHeartbeatIntervalMs);
+    connect(m_heartbeatTimer, &QTimer::timeout, this, &ReplicationPrimary::sendHeartbeats);
+}
+
+ReplicationPrimary::~ReplicationPrimary()
+{
+    // 断开时不再回调本对象
+    for (auto it = m_sessions.begin(); it != m_sessions.end(); ++it) {
+        it.key()->disconnect(this);
+        it.key()->abort();
+    }
+}
+
+bool ReplicationPrimary::listen(const QString& serverName)
+{
+    // 上次异常退出可能留下同名套接字文件
+    QLocalServer::removeServer(serverName);
+    if (!m_server->listen(serverName)) {
+        qWarning() << "复制服务无法监听" << serverName << ":" << m_server->errorString();
+        return false;
+    }
+    m_heartbeatTimer->start();
+    qDebug() << "复制服务已启动:" << m_server->fullServerName();
+    return true;
+}
+
+ReplicationStatus ReplicationPrimary::status() const
+{
+    ReplicationStatus status;
+    status.lastLsn = m_log->lastLsn();
+    status.ackedLsn = status.lastLsn;
+    status.logRecords = m_log->size();
+    status.logBytes = m_log->bytes();
+    status.snapshotsSent = m_snapshotsSent;
+    for (const Session& session : m_sessions) {
+        if (session.ready) {
+            ++status.standbys;
+            status.ackedLsn = qMin(status.ackedLsn, session.ackedLsn);
+        }
+    }
+    status.lagRecords = status.lastLsn - status.ackedLsn;
+
+    // 最早一条未确认变更已被淘汰时，从日志起点估计延迟（偏小）
+    if (status.lagRecords > 0 && m_log->size() > 0) {
+        const quint64 oldest = qMax(status.ackedLsn + 1, m_log->firstLsn());
+        status.lagMs = QDateTime::currentMSecsSinceEpoch() - m_log->entry(oldest).utcMs;
+    }
+    return status;
+}
+
+void ReplicationPrimary::acceptConnections()
+{
+    while (QLocalSocket* socket = m_server->nextPendingConnection()) {
+        m_sessions.insert(socket, Session());
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { readMessages(socket); });
+        connect(socket, &QLocalSocket::bytesWritten, this, [this, socket]() { pump(socket); });
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+            qDebug() << "备用节点已断开，已确认序号" << m_sessions.value(socket).ackedLsn;
+            m_sessions.remove(socket);
+            socket->deleteLater();
+        });
+        qDebug() << "备用节点已连接";
+    }
+}
+
+void ReplicationPrimary::readMessages(QLocalSocket* socket)
+{
+    auto it = m_sessions.find(socket);
+    if (it == m_sessions.end()) {
+        return;
+    }
+    Session& session = it.value();
+    session.readBuffer.append(socket->readAll());
+
+    QVector<QJsonObject> messages;
+    if (!ReplicationLog::takeFrames(session.readBuffer, messages)) {
+        qWarning() << "备用节点发来的数据无效，断开连接";
+        socket->abort();
+        return;
+    }
+
+    for (const QJsonObject& message : std::as_const(messages)) {
+        const QString type = message["type"].toString();
+        if (type == "hello") {
+            const quint64 epoch = message["epoch"].toString().toULongLong();
+            const quint64 lsn = message["lsn"].toString().toULongLong();
+            session.ready = true;
+            session.ackedLsn = 0;
+            if (epoch == m_log->epoch() && lsn + 1 >= m_log->firstLsn() && lsn <= m_log->lastLsn()) {
+                session.ackedLsn = lsn;
+                session.nextLsn = lsn + 1;
+                qDebug() << "备用节点从序号" << session.nextLsn << "续传";
+            } else {
+                beginSnapshot(socket, session);
+            }
+        } else if (type == "ack") {
+            session.ackedLsn = qMax(session.ackedLsn, quint64(message["lsn"].toString().toULongLong()));
+        }
+    }
+    pump(socket);
+}
+
+void ReplicationPrimary::pump(QLocalSocket* socket)
+{
+    auto it = m_sessions.find(socket);
+    if (it == m_sessions.end() || !it->ready) {
+        return;
+    }
+    Session& session = it.value();
+
+    while (socket->bytesToWrite() < kMaxPendingBytes) {
+        if (session.snapshotting) {
+            sendSnapshotChunk(socket, session);
+            continue;
+        }
+        if (session.nextLsn > m_log->lastLsn()) {
+            break;
+        }
+        if (session.nextLsn < m_log->firstLsn()) {
+            qDebug() << "备用节点需要的序号" << session.nextLsn << "已淘汰，改为发送快照";
+            beginSnapshot(socket, session);
+            continue;
+        }
+
+        const ChangeEntry& entry = m_log->entry(session.nextLsn);
+        if (entry.kind == ChangeKind::LedgerReset) {
+            beginSnapshot(socket, session);
+            continue;
+        }
+        socket->write(entry.frame);
+        ++session.nextLsn;
+    }
+}
+
+void ReplicationPrimary::beginSnapshot(QLocalSocket* socket, Session& session)
+{
+    session.snapshotting = true;
+    session.snapshotLsn = m_log->lastLsn();
+    session.snapshotAccounts = m_repository->getAllAccounts();
+    session.snapshotTransactions = m_transactionModel->getAllTransactions();
+    session.accountCursor = 0;
+    session.transactionCursor = 0;
+
+    socket->write(ReplicationLog::encodeFrame(QJsonObject{
+        {"type", "snapshot-begin"},
+        {"epoch", QString::number(m_log->epoch())},
+        {"lsn", QString::number(session.snapshotLsn)},
+        {"accounts", session.snapshotAccounts.size()},
+        {"transactions", session.snapshotTransactions.size()}
+    }));
+    qDebug() << "开始向备用节点发送快照，序号" << session.snapshotLsn << ":"
+             << session.snapshotAccounts.size() << "个账户," << session.snapshotTransactions.size() << "条交易";
+}
+
+void ReplicationPrimary::sendSnapshotChunk(QLocalSocket* socket, Session& session)
+{
+    QJsonArray records;
+    if (session.accountCursor < session.snapshotAccounts.size()) {
+        const int end = qMin(int(session.snapshotAccounts.size()), session.accountCursor + kSnapshotChunkRecords);
+        for (; session.accountCursor < end; ++session.accountCursor) {
+            records.append(session.snapshotAccounts.at(session.accountCursor).toJson());
+        }
+        socket->write(ReplicationLog::encodeFrame(QJsonObject{{"type", "snapshot-accounts"}, {"records", records}}));
+        return;
+    }
+    if (session.transactionCursor < session.snapshotTransactions.size()) {
+        const int end = qMin(int(session.snapshotTransactions.size()),
+                             session.transactionCursor + kSnapshotChunkRecords);
+        for (; session.transactionCursor < end; ++session.transactionCursor) {
+            records.append(session.snapshotTransactions.at(session.transactionCursor).toJson());
+        }
+        socket->write(ReplicationLog::encodeFrame(QJsonObject{{"type", "snapshot-transactions"}, {"records", records}}));
+        return;
+    }
+
+    socket->write(ReplicationLog::encodeFrame(QJsonObject{
+        {"type", "snapshot-end"},
+        {"lsn", QString::number(session.snapshotLsn)}
+    }));
+    session.snapshotting = false;
+    session.nextLsn = session.snapshotLsn + 1;
+    session.snapshotAccounts.clear();
+    session.snapshotTransactions.clear();
+    ++m_snapshotsSent;
+}
+
+void ReplicationPrimary::sendHeartbeats()
+{
+    const QByteArray frame = ReplicationLog::encodeFrame(QJsonObject{
+        {"type", "heartbeat"},
+        {"lsn", QString::number(m_log->lastLsn())},
+        {"ms", QString::number(QDateTime::currentMSecsSinceEpoch())}
+    });
+    for (auto it = m_sessions.cbegin(); it != m_sessions.cend(); ++it) {
+        if (it->ready && !it->snapshotting && it.key()->bytesToWrite() < kMaxPendingBytes) {
+            it.key()->write(frame);
+        }
+    }
+}
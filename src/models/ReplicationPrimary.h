@@ -0,0 +1,157 @@
+/**
+ * @file ReplicationPrimary.h
+ * @brief 主备复制的主节点
+ *
+ * 在本地套接字上接受备用节点连接，按备用节点的进度发送快照和变更日志，并统计复制延迟。
+ */
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include "ReplicationLog.h"
+#include "IAccountRepository.h"
+#include "TransactionModel.h"
+
+class QLocalServer;
+class QLocalSocket;
+class QTimer;
+
+/**
+ * @brief 主节点的复制状态
+ */
+struct ReplicationStatus {
+    int standbys = 0;           //!< 已连接的备用节点数
+    quint64 lastLsn = 0;        //!< 最后一条变更的序号
+    quint64 ackedLsn = 0;       //!< 所有备用节点都已确认的序号
+    quint64 lagRecords = 0;     //!< 尚未确认的变更数
+    qint64 lagMs = 0;           //!< 最早一条未确认变更的等待时间（毫秒）
+    int logRecords = 0;         //!< 日志保留的变更数
+    qint64 logBytes = 0;        //!< 日志保留的字节数
+    int snapshotsSent = 0;      //!< 已发送的快照数
+
+    /**
+     * @brief 生成一行摘要
+     * @return 摘要文本
+     */
+    QString summary() const;
+};
+
+/**
+ * @brief 主备复制的主节点
+ *
+ * 备用节点连接后先发送 hello（纪元编号和已应用的序号）。纪元相同且序号仍在日志中时从下一条续传，
+ * 否则先发送快照：当时的全部账户和账本（账本为隐式共享的副本）按块发送，
+ * 结束后从快照对应的序号继续发送日志。日志中的账本重写也会触发重新发送快照。
+ *
+ * 发送受背压控制：套接字待发送的数据超过上限时暂停，写出后再继续，
+ * 因此追赶期间主节点的内存只多出快照副本和一个发送窗口。
+ * 备用节点每应用一批变更回复 ack，主节点据此计算复制延迟。
+ */
+class ReplicationPrimary : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param log 复制日志
+     * @param repository 账户存储库（用于快照）
+     * @param transactionModel 交易模型（用于快照）
+     * @param parent 父对象
+     */
+    ReplicationPrimary(ReplicationLog* log, IAccountRepository* repository,
+                       TransactionModel* transactionModel, QObject* parent = nullptr);
+
+    /**
+     * @brief 析构函数，断开全部备用节点
+     */
+    ~ReplicationPrimary() override;
+
+    /**
+     * @brief 在本地套接字上开始监听
+     * @param serverName 套接字名称
+     * @return 如果成功监听返回true
+     */
+    bool listen(const QString& serverName);
+
+    /**
+     * @brief 获取复制状态
+     * @return 复制状态
+     */
+    ReplicationStatus status() const;
+
+private:
+    /**
+     * @brief 一个备用节点的连接状态
+     */
+    struct Session {
+        QByteArray readBuffer;          //!< 接收缓冲区
+        bool ready = false;             //!< 是否已收到 hello
+        quint64 nextLsn = 0;            //!< 下一条要发送的变更
+        quint64 ackedLsn = 0;           //!< 已确认的序号
+        bool snapshotting = false;      //!< 是否正在发送快照
+        quint64 snapshotLsn = 0;        //!< 快照对应的序号
+        QVector<Account> snapshotAccounts;          //!< 快照中的账户
+        QVector<Transaction> snapshotTransactions;  //!< 快照中的账本
+        int accountCursor = 0;          //!< 下一个要发送的账户
+        int transactionCursor = 0;      //!< 下一条要发送的交易
+    };
+
+    /**
+     * @brief 接受新连接
+     */
+    void acceptConnections();
+
+    /**
+     * @brief 处理备用节点发来的消息
+     * @param socket 连接
+     */
+    void readMessages(QLocalSocket* socket);
+
+    /**
+     * @brief 在发送窗口允许的范围内发送快照或变更
+     * @param socket 连接
+     */
+    void pump(QLocalSocket* socket);
+
+    /**
+     * @brief 开始向备用节点发送快照
+     * @param socket 连接
+     * @param session 连接状态
+     */
+    void beginSnapshot(QLocalSocket* socket, Session& session);
+
+    /**
+     * @brief 发送下一块快照，全部发完时发送快照结束
+     * @param socket 连接
+     * @param session 连接状态
+     */
+    void sendSnapshotChunk(QLocalSocket* socket, Session& session);
+
+    /**
+     * @brief 向已追上的备用节点发送心跳（携带最新序号）
+     */
+    void sendHeartbeats();
+
+    //!< 复制日志
+    ReplicationLog* m_log;
+
+    //!< 账户存储库
+    IAccountRepository* m_repository;
+
+    //!< 交易模型
+    TransactionModel* m_transactionModel;
+
+    //!< 本地套接字服务器
+    QLocalServer* m_server;
+
+    //!< 心跳定时器
+    QTimer* m_heartbeatTimer;
+
+    //!< 各备用节点的连接状态
+    QHash<QLocalSocket*, Session> m_sessions;
+
+    //!< 已发送的快照数
+    int m_snapshotsSent = 0;
+};
@@ -0,0 +1,350 @@
+/**
+ * @file ReplicationStandby.cpp
+ * @brief 主备复制的备用节点实现
+ *
+ * 实现了ReplicationStandby类中定义的连接、快照替换、变更应用、组提交和提升方法。
+ */
+#include "ReplicationStandby.h"
+#include "ReplicationLog.h"
+#include "TransactionModel.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonArray>
+#include <QLocalSocket>
+#include <QTimer>
+
+namespace {
+
+//!< 重连间隔（毫秒）
+const int kReconnectIntervalMs = 1000;
+
+//!< 复制进度文件名
+const char* const kStateFilename = "replication_state.json";
+
+} // namespace
+
+QString StandbyStatus::summary() const
+{
+    return QString("备用节点%1: 已应用序号 %2, 主节点序号 %3, 延迟 %4 条 / %5 ms (最大 %6 ms), "
+                   "已应用 %7 条变更和 %8 次快照, %9 个账户, %10 条交易")
+        .arg(promoted ? "(已提升)" : connected ? "(已连接)" : "(未连接)")
+        .arg(appliedLsn)
+        .arg(primaryLsn)
+        .arg(lagRecords)
+        .arg(lagMs)
+        .arg(maxLagMs)
+        .arg(changesApplied)
+        .arg(snapshotsApplied)
+        .arg(accounts)
+        .arg(transactions);
+}
+
+ReplicationStandby::ReplicationStandby(JsonPersistenceManager* persistenceManager, const QString& serverName,
+                                       int promoteAfterMs, QObject* parent)
+    : QObject(parent)
+    , m_persistenceManager(persistenceManager)
+    , m_serverName(serverName)
+    , m_promoteAfterMs(promoteAfterMs)
+    , m_accounts(std::make_unique<JsonAccountRepository>(persistenceManager, "accounts.json"))
+    , m_transactionStore(persistenceManager, "transactions.json")
+    , m_socket(new QLocalSocket(this))
+    , m_reconnectTimer(new QTimer(this))
+{
+    Q_ASSERT(persistenceManager != nullptr);
+
+    m_transactionStore.loadTransactions(m_transactions);
+    rebuildTransactionIds();
+    loadState();
+
+    connect(m_socket, &QLocalSocket::connected, this, [this]() {
+        m_disconnectedSinceMs = 0;
+        m_readBuffer.clear();
+        m_receivingSnapshot = false;
+        m_socket->write(ReplicationLog::encodeFrame(QJsonObject{
+            {"type", "hello"},
+            {"epoch", QString::number(m_epoch)},
+            {"lsn", QString::number(m_appliedLsn)}
+        }));
+        qDebug() << "已连接主节点" << m_serverName << "，请求从序号" << m_appliedLsn + 1 << "开始复制";
+    });
+    connect(m_socket, &QLocalSocket::readyRead, this, &ReplicationStandby::readMessages);
+    connect(m_socket, &QLocalSocket::disconnected, this, [this]() {
+        qWarning() << "与主节点的连接已断开";
+        if (m_disconnectedSinceMs == 0) {
+            m_disconnectedSinceMs = QDateTime::currentMSecsSinceEpoch();
+        }
+    });
+    connect(m_socket, &QLocalSocket::errorOccurred, this, [this]() {
+        if (m_disconnectedSinceMs == 0) {
+            m_disconnectedSinceMs = QDateTime::currentMSecsSinceEpoch();
+        }
+    });
+
+    m_reconnectTimer->setInterval(kReconnectIntervalMs);
+    connect(m_reconnectTimer, &QTimer::timeout, this, &ReplicationStandby::connectToPrimary);
+}
+
+ReplicationStandby::~ReplicationStandby()
+{
+    m_socket->disconnect(this);
+    m_socket->abort();
+}
+
+void ReplicationStandby::start()
+{
+    m_disconnectedSinceMs = QDateTime::currentMSecsSinceEpoch();
+    m_reconnectTimer->start();
+    connectToPrimary();
+}
+
+void ReplicationStandby::promote()
+{
+    if (m_promoted) {
+        return;
+    }
+    m_reconnectTimer->stop();
+    m_socket->disconnect(this);
+    m_socket->abort();
+    flush();
+    m_promoted = true;
+
+    qDebug() << "备用节点已提升为主节点，已应用序号" << m_appliedLsn << "，"
+             << m_accounts->accountTable()->size() << "个账户，" << m_transactions.size() << "条交易";
+    emit promoted();
+}
+
+StandbyStatus ReplicationStandby::status() const
+{
+    StandbyStatus status;
+    status.connected = m_socket->state() == QLocalSocket::ConnectedState;
+    status.promoted = m_promoted;
+    status.appliedLsn = m_appliedLsn;
+    status.primaryLsn = qMax(m_primaryLsn, m_appliedLsn);
+    status.lagRecords = status.primaryLsn - m_appliedLsn;
+    status.lagMs = m_lagMs;
+    status.maxLagMs = m_maxLagMs;
+    status.changesApplied = m_changesApplied;
+    status.snapshotsApplied = m_snapshotsApplied;
+    status.accounts = m_accounts->accountTable()->size();
+    status.transactions = m_transactions.size();
+    return status;
+}
+
+void ReplicationStandby::connectToPrimary()
+{
+    if (m_socket->state() != QLocalSocket::UnconnectedState) {
+        return;
+    }
+    if (m_promoteAfterMs > 0 && m_disconnectedSinceMs > 0
+        && QDateTime::currentMSecsSinceEpoch() - m_disconnectedSinceMs >= m_promoteAfterMs) {
+        qWarning() << "主节点已" << m_promoteAfterMs << "ms 不可用，自动提升";
+        promote();
+        return;
+    }
+    m_socket->connectToServer(m_serverName);
+}
+
+void ReplicationStandby::readMessages()
+{
+    m_readBuffer.append(m_socket->readAll());
+
+    QVector<QJsonObject> messages;
+    if (!ReplicationLog::takeFrames(m_readBuffer, messages)) {
+        qWarning() << "主节点发来的数据无效，断开后重新连接";
+        m_socket->abort();
+        return;
+    }
+
+    for (const QJsonObject& message : std::as_const(messages)) {
+        const QString type = message["type"].toString();
+        if (type == "change") {
+            applyChange(message);
+        } else if (type == "heartbeat") {
+            m_primaryLsn = qMax(m_primaryLsn, quint64(message["lsn"].toString().toULongLong()));
+        } else if (type == "snapshot-begin") {
+            m_receivingSnapshot = true;
+            m_snapshotEpoch = message["epoch"].toString().toULongLong();
+            m_snapshotAccounts.clear();
+            m_snapshotTransactions.clear();
+            m_snapshotAccounts.reserve(message["accounts"].toInt());
+            m_snapshotTransactions.reserve(message["transactions"].toInt());
+        } else if (type == "snapshot-accounts" && m_receivingSnapshot) {
+            for (const QJsonValue& record : message["records"].toArray()) {
+                m_snapshotAccounts.append(Account::fromJson(record.toObject()));
+            }
+        } else if (type == "snapshot-transactions" && m_receivingSnapshot) {
+            for (const QJsonValue& record : message["records"].toArray()) {
+                m_snapshotTransactions.append(Transaction::fromJson(record.toObject()));
+            }
+        } else if (type == "snapshot-end" && m_receivingSnapshot) {
+            applySnapshot(message["lsn"].toString().toULongLong());
+        }
+    }
+
+    flush();
+}
+
+void ReplicationStandby::applyChange(const QJsonObject& message)
+{
+    const quint64 lsn = message["lsn"].toString().toULongLong();
+    if (m_receivingSnapshot || lsn <= m_appliedLsn) {
+        return;
+    }
+
+    const QString kind = message["kind"].toString();
+    if (kind == "accounts") {
+        for (const QJsonValue& record : message["records"].toArray()) {
+            const Account account = Account::fromJson(record.toObject());
+            m_pendingAccounts.insert(account.cardNumber, account);
+        }
+    } else if (kind == "account-deleted") {
+        // 删除不常见，直接写入；同一卡号之前待保存的修改一并丢弃
+        const QString cardNumber = message["cardNumber"].toString();
+        m_pendingAccounts.remove(cardNumber);
+        if (m_accounts->accountExists(cardNumber)) {
+            m_accounts->deleteAccount(cardNumber);
+        }
+    } else if (kind == "transactions") {
+        for (const QJsonValue& record : message["records"].toArray()) {
+            const Transaction transaction = Transaction::fromJson(record.toObject());
+            if (m_transactionIds.contains(transaction.id)) {
+                continue;
+            }
+            if (m_firstNewTransaction < 0) {
+                m_firstNewTransaction = m_transactions.size();
+            }
+            m_transactionIds.insert(transaction.id);
+            m_transactions.append(transaction);
+        }
+    } else if (kind == "card-cleared") {
+        m_transactions = TransactionModel::withoutCard(m_transactions, message["cardNumber"].toString());
+        rebuildTransactionIds();
+        m_ledgerRewritten = true;
+    }
+
+    m_appliedLsn = lsn;
+    m_primaryLsn = qMax(m_primaryLsn, lsn);
+    m_lastChangeMs = message["ms"].toString().toLongLong();
+    m_progressPending = true;
+    ++m_changesApplied;
+}
+
+void ReplicationStandby::applySnapshot(quint64 lsn)
+{
+    m_receivingSnapshot = false;
+
+    // 先删除快照中没有的账户，再整体写入快照中的账户
+    QSet<QString> snapshotCards;
+    for (const Account& account : std::as_const(m_snapshotAccounts)) {
+        snapshotCards.insert(account.cardNumber);
+    }
+    for (const Account& account : m_accounts->getAllAccounts()) {
+        if (!snapshotCards.contains(account.cardNumber)) {
+            m_accounts->deleteAccount(account.cardNumber);
+        }
+    }
+    m_pendingAccounts.clear();
+    if (!m_snapshotAccounts.isEmpty()) {
+        m_accounts->saveAccountsBatch(m_snapshotAccounts);
+    }
+
+    m_transactions = std::move(m_snapshotTransactions);
+    m_transactionStore.saveTransactions(m_transactions);
+    rebuildTransactionIds();
+    m_firstNewTransaction = -1;
+    m_ledgerRewritten = false;
+
+    m_epoch = m_snapshotEpoch;
+    m_appliedLsn = lsn;
+    m_primaryLsn = qMax(m_primaryLsn, lsn);
+    m_lastChangeMs = 0;
+    m_progressPending = true;
+    ++m_snapshotsApplied;
+    qDebug() << "已应用快照，序号" << lsn << ":" << m_snapshotAccounts.size() << "个账户,"
+             << m_transactions.size() << "条交易";
+    m_snapshotAccounts.clear();
+    m_snapshotTransactions = QVector<Transaction>();
+}
+
+void ReplicationStandby::flush()
+{
+    if (!m_pendingAccounts.isEmpty()) {
+        OperationResult result = m_accounts->saveAccountsBatch(m_pendingAccounts.values());
+        if (!result.success) {
+            qWarning() << "备用节点保存账户失败:" << result.errorMessage;
+        }
+        m_pendingAccounts.clear();
+    }
+    if (m_ledgerRewritten) {
+        m_transactionStore.saveTransactions(m_transactions);
+    } else if (m_firstNewTransaction >= 0) {
+        m_transactionStore.appendTransactions(m_transactions, m_firstNewTransaction);
+    }
+    m_ledgerRewritten = false;
+    m_firstNewTransaction = -1;
+
+    if (!m_progressPending) {
+        return;
+    }
+    m_progressPending = false;
+
+    // 数据写入后再保存进度：中途退出时进度只会落后，重放时按序号和交易编号去重
+    saveState();
+    if (m_lastChangeMs > 0) {
+        m_lagMs = QDateTime::currentMSecsSinceEpoch() - m_lastChangeMs;
+        m_maxLagMs = qMax(m_maxLagMs, m_lagMs);
+    }
+    if (m_socket->state() == QLocalSocket::ConnectedState) {
+        m_socket->write(ReplicationLog::encodeFrame(QJsonObject{
+            {"type", "ack"},
+            {"lsn", QString::number(m_appliedLsn)}
+        }));
+    }
+}
+
+void ReplicationStandby::loadState()
+{
+    m_persistenceManager->loadRecordChunks(kStateFilename, FORMAT_NAME,
+        [](int version, int chunkCount) {
+            Q_UNUSED(chunkCount);
+            return version == FORMAT_VERSION;
+        },
+        [this](int chunk, JsonStreamReader& reader) {
+            Q_UNUSED(chunk);
+            while (reader.readNext() == JsonStreamReader::Name) {
+                const QByteArrayView key = reader.name();
+                if (reader.readNext() == JsonStreamReader::Invalid) {
+                    break;
+                }
+                if (key == "epoch") {
+                    m_epoch = reader.stringValue().toULongLong();
+                } else if (key == "lsn") {
+                    m_appliedLsn = reader.stringValue().toULongLong();
+                } else {
+                    reader.skipCurrentValue();
+                }
+            }
+            return true;
+        });
+    m_primaryLsn = m_appliedLsn;
+}
+
+bool ReplicationStandby::saveState()
+{
+    return m_persistenceManager->saveRecords(kStateFilename, FORMAT_NAME, FORMAT_VERSION,
+        [this](JsonStreamWriter& writer) {
+            writer.beginObject();
+            writer.writeString("epoch", QString::number(m_epoch));
+            writer.writeString("lsn", QString::number(m_appliedLsn));
+            writer.endObject();
+        });
+}
+
+void ReplicationStandby::rebuildTransactionIds()
+{
+    m_transactionIds.clear();
+    m_transactionIds.reserve(m_transactions.size());
+    for (const Transaction& transaction : std::as_const(m_transactions)) {
+        m_transactionIds.insert(transaction.id);
+    }
+}
@@ -0,0 +1,235 @@
+/**
+ * @file ReplicationStandby.h
+ * @brief 主备复制的备用节点
+ *
+ * 连接主节点的本地套接字，持续应用快照和变更日志到本节点的数据目录，并可以提升为主节点。
+ */
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include <memory>
+#include "JsonAccountRepository.h"
+#include "JsonTransactionStore.h"
+#include "JsonPersistenceManager.h"
+
+class QLocalSocket;
+class QTimer;
+
+/**
+ * @brief 备用节点的复制状态
+ */
+struct StandbyStatus {
+    bool connected = false;     //!< 是否已连接主节点
+    bool promoted = false;      //!< 是否已提升为主节点
+    quint64 appliedLsn = 0;     //!< 已应用的序号
+    quint64 primaryLsn = 0;     //!< 已知的主节点最新序号
+    quint64 lagRecords = 0;     //!< 落后的变更数
+    qint64 lagMs = 0;           //!< 最近一批变更从主节点写入日志到本节点应用完成的时间（毫秒）
+    qint64 maxLagMs = 0;        //!< 启动以来的最大延迟（毫秒）
+    qint64 changesApplied = 0;  //!< 启动以来应用的变更数
+    int snapshotsApplied = 0;   //!< 启动以来应用的快照数
+    int accounts = 0;           //!< 本节点的账户数
+    int transactions = 0;       //!< 本节点的交易数
+
+    /**
+     * @brief 生成一行摘要
+     * @return 摘要文本
+     */
+    QString summary() const;
+};
+
+/**
+ * @brief 主备复制的备用节点
+ *
+ * 账户和账本保存在本节点数据目录的 accounts.json 和 transactions.json 中，格式与主节点相同，
+ * 提升后直接以该目录启动即可接管。已应用的纪元编号和序号保存在 replication_state.json 中，
+ * 重启后据此向主节点请求续传。
+ *
+ * 每次读到一批帧时逐条应用到内存，然后一次写入账户和账本、保存进度并回复 ack（组提交）；
+ * 重复收到的变更按序号跳过，追加的交易按交易编号去重，因此进度落后于数据时重放也是安全的。
+ * 快照先在内存中收齐，结束时整体替换，中途断开不会留下半个快照。
+ */
+class ReplicationStandby : public QObject {
+    Q_OBJECT
+
+public:
+    //!< 复制进度文件的格式名称
+    static constexpr const char* FORMAT_NAME = "atm-replication-state";
+
+    //!< 当前复制进度文件格式版本
+    static const int FORMAT_VERSION = 1;
+
+    /**
+     * @brief 构造函数
+     *
+     * 构造时加载本节点已有的数据和复制进度。
+     *
+     * @param persistenceManager 本节点数据目录的持久化管理器
+     * @param serverName 主节点的套接字名称
+     * @param promoteAfterMs 与主节点断开超过该时间后自动提升，0 表示不自动提升
+     * @param parent 父对象
+     */
+    ReplicationStandby(JsonPersistenceManager* persistenceManager, const QString& serverName,
+                       int promoteAfterMs = 0, QObject* parent = nullptr);
+
+    /**
+     * @brief 析构函数
+     */
+    ~ReplicationStandby() override;
+
+    /**
+     * @brief 开始连接主节点，断开后自动重连
+     */
+    void start();
+
+    /**
+     * @brief 提升为主节点
+     *
+     * 停止复制并断开连接，已应用的数据都已写入数据目录。完成后发出 promoted()。
+     */
+    void promote();
+
+    /**
+     * @brief 获取复制状态
+     * @return 复制状态
+     */
+    StandbyStatus status() const;
+
+signals:
+    /**
+     * @brief 提升为主节点后发出的信号
+     */
+    void promoted();
+
+private:
+    /**
+     * @brief 连接主节点并发送 hello
+     */
+    void connectToPrimary();
+
+    /**
+     * @brief 读取并应用主节点发来的帧，然后组提交
+     */
+    void readMessages();
+
+    /**
+     * @brief 应用一条变更
+     * @param message 变更帧
+     */
+    void applyChange(const QJsonObject& message);
+
+    /**
+     * @brief 用收齐的快照替换本节点的数据
+     * @param lsn 快照对应的序号
+     */
+    void applySnapshot(quint64 lsn);
+
+    /**
+     * @brief 写入待保存的账户和账本，保存进度并回复 ack
+     */
+    void flush();
+
+    /**
+     * @brief 加载复制进度
+     */
+    void loadState();
+
+    /**
+     * @brief 保存复制进度
+     * @return 如果成功保存返回true
+     */
+    bool saveState();
+
+    /**
+     * @brief 按当前账本重建交易编号集合
+     */
+    void rebuildTransactionIds();
+
+    //!< 本节点数据目录的持久化管理器
+    JsonPersistenceManager* m_persistenceManager;
+
+    //!< 主节点的套接字名称
+    QString m_serverName;
+
+    //!< 断开超过该时间后自动提升（毫秒），0 表示不自动提升
+    int m_promoteAfterMs;
+
+    //!< 本节点的账户存储库
+    std::unique_ptr<JsonAccountRepository> m_accounts;
+
+    //!< 本节点的交易存储
+    JsonTransactionStore m_transactionStore;
+
+    //!< 本节点的账本
+    QVector<Transaction> m_transactions;
+
+    //!< 账本中的交易编号（追加时去重）
+    QSet<quint64> m_transactionIds;
+
+    //!< 与主节点的连接
+    QLocalSocket* m_socket;
+
+    //!< 重连定时器
+    QTimer* m_reconnectTimer;
+
+    //!< 接收缓冲区
+    QByteArray m_readBuffer;
+
+    //!< 已应用的纪元编号
+    quint64 m_epoch = 0;
+
+    //!< 已应用的序号
+    quint64 m_appliedLsn = 0;
+
+    //!< 已知的主节点最新序号
+    quint64 m_primaryLsn = 0;
+
+    //!< 待保存的账户（组提交）
+    QHash<QString, Account> m_pendingAccounts;
+
+    //!< 本批第一条新增交易的下标，-1 表示没有
+    int m_firstNewTransaction = -1;
+
+    //!< 本批是否改写了账本（需要全量保存）
+    bool m_ledgerRewritten = false;
+
+    //!< 本批是否有需要确认的进度
+    bool m_progressPending = false;
+
+    //!< 是否正在接收快照
+    bool m_receivingSnapshot = false;
+
+    //!< 快照的纪元编号
+    quint64 m_snapshotEpoch = 0;
+
+    //!< 正在接收的快照中的账户
+    QVector<Account> m_snapshotAccounts;
+
+    //!< 正在接收的快照中的账本
+    QVector<Transaction> m_snapshotTransactions;
+
+    //!< 本批最后一条变更写入主节点日志的时间（UTC毫秒）
+    qint64 m_lastChangeMs = 0;
+
+    //!< 与主节点断开的时间（UTC毫秒），0 表示已连接
+    qint64 m_disconnectedSinceMs = 0;
+
+    //!< 最近一批的延迟（毫秒）
+    qint64 m_lagMs = 0;
+
+    //!< 最大延迟（毫秒）
+    qint64 m_maxLagMs = 0;
+
+    //!< 应用的变更数
+    qint64 m_changesApplied = 0;
+
+    //!< 应用的快照数
+    int m_snapshotsApplied = 0;
+
+    //!< 是否已提升为主节点
+    bool m_promoted = false;
+};
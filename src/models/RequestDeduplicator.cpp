@@ -0,0 +1,121 @@
+/**
+ * @file RequestDeduplicator.cpp
+ * @brief 请求去重表实现
+ *
+ * 实现了RequestDeduplicator类中定义的占位、结果记录和淘汰方法。
+ */
+#include "RequestDeduplicator.h"
+#include <QMutexLocker>
+#include <QDebug>
+
+RequestDeduplicator::RequestDeduplicator(const Clock* clock)
+    : RequestDeduplicator(clock, Config())
+{
+}
+
+RequestDeduplicator::RequestDeduplicator(const Clock* clock, const Config& config)
+    : m_clock(clock ? clock : Clock::system())
+    , m_config(config)
+{
+    m_config.shardCount = qMax(1, m_config.shardCount);
+    m_shardCapacity = qMax(1, m_config.capacity / m_config.shardCount);
+    m_shards = std::make_unique<Shard[]>(m_config.shardCount);
+}
+
+RequestDeduplicator::~RequestDeduplicator() = default;
+
+void RequestDeduplicator::setClock(const Clock* clock)
+{
+    m_clock = clock ? clock : Clock::system();
+}
+
+RequestDeduplicator::Claim RequestDeduplicator::claim(const QString& key, const QString& fingerprint)
+{
+    Shard& shard = shardFor(key);
+    const qint64 now = m_clock->monotonicMs();
+    QMutexLocker locker(&shard.mutex);
+
+    auto found = shard.index.find(key);
+    if (found != shard.index.end()) {
+        auto node = found.value();
+        if (node->expiresAtMs > now) {
+            // 命中：移到表头
+            shard.lru.splice(shard.lru.begin(), shard.lru, node);
+
+            if (node->fingerprint != fingerprint) {
+                return Claim{Status::Conflict, OperationResult::Failure("请求编号已被其他操作使用")};
+            }
+            if (!node->completed) {
+                return Claim{Status::InProgress, OperationResult::Failure("相同的请求正在处理中")};
+            }
+            qDebug() << "重复请求，返回首次执行结果:" << key;
+            return Claim{Status::Replayed, node->result};
+        }
+
+        // 已过期，按新请求处理
+        shard.lru.erase(node);
+        shard.index.erase(found);
+    }
+
+    Entry entry;
+    entry.key = key;
+    entry.fingerprint = fingerprint;
+    entry.expiresAtMs = now + m_config.ttlMs;
+    shard.lru.push_front(std::move(entry));
+    shard.index.insert(key, shard.lru.begin());
+
+    evict(shard, now);
+    return Claim{Status::Started, OperationResult::Success()};
+}
+
+void RequestDeduplicator::complete(const QString& key, const OperationResult& result)
+{
+    Shard& shard = shardFor(key);
+    const qint64 now = m_clock->monotonicMs();
+    QMutexLocker locker(&shard.mutex);
+
+    auto found = shard.index.find(key);
+    if (found == shard.index.end()) {
+        return;
+    }
+
+    auto node = found.value();
+    if (!result.success) {
+        // 失败的操作没有副作用，释放占位以便重试
+        shard.lru.erase(node);
+        shard.index.erase(found);
+        return;
+    }
+
+    node->result = result;
+    node->completed = true;
+    node->expiresAtMs = now + m_config.ttlMs;
+}
+
+int RequestDeduplicator::size() const
+{
+    int total = 0;
+    for (int i = 0; i < m_config.shardCount; ++i) {
+        QMutexLocker locker(&m_shards[i].mutex);
+        total += m_shards[i].index.size();
+    }
+    return total;
+}
+
+RequestDeduplicator::Shard& RequestDeduplicator::shardFor(const QString& key) const
+{
+    return m_shards[qHash(key) % uint(m_config.shardCount)];
+}
+
+void RequestDeduplicator::evict(Shard& shard, qint64 now) const
+{
+    while (!shard.lru.empty()) {
+        const Entry& oldest = shard.lru.back();
+        const bool overCapacity = shard.index.size() > m_shardCapacity;
+        if (!overCapacity && oldest.expiresAtMs > now) {
+            break;
+        }
+        shard.index.remove(oldest.key);
+        shard.lru.pop_back();
+    }
+}
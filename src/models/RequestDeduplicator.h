@@ -0,0 +1,151 @@
+/**
+ * @file RequestDeduplicator.h
+ * @brief 请求去重表
+ *
+ * 按客户端提供的请求编号记录已完成操作的结果，使超时重试的请求不会被重复执行。
+ */
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <list>
+#include <memory>
+#include "Clock.h"
+#include "OperationResult.h"
+
+/**
+ * @brief 请求去重表
+ *
+ * 有界、带过期时间的分片LRU表：键按哈希分配到固定数量的分片，每个分片
+ * 有自己的互斥锁、LRU链表和哈希索引，不同分片上的请求互不阻塞。
+ * 超过容量时淘汰最久未使用的条目；条目超过存活时间后视为不存在。
+ *
+ * 使用方式：执行操作前调用 claim()，返回 Started 时执行操作并调用 complete()；
+ * 返回 Replayed 时直接使用保存的结果。只保存成功的结果：失败的操作不产生副作用，
+ * complete() 会释放占位，允许客户端用同一请求编号重试。
+ */
+class RequestDeduplicator {
+public:
+    /**
+     * @brief 去重表参数
+     */
+    struct Config {
+        int capacity = 4096;                //!< 最多保留的请求数（所有分片合计）
+        qint64 ttlMs = 10 * 60 * 1000;      //!< 条目存活时间（毫秒）
+        int shardCount = 16;                //!< 分片数
+    };
+
+    /**
+     * @brief 占位结果
+     */
+    enum class Status {
+        Started,        //!< 新请求，调用方应执行操作并调用 complete()
+        Replayed,       //!< 重复请求，result 为首次执行的结果
+        InProgress,     //!< 同一请求正在执行
+        Conflict        //!< 请求编号已被参数不同的操作使用
+    };
+
+    /**
+     * @brief claim() 的返回值
+     */
+    struct Claim {
+        Status status;              //!< 占位结果
+        OperationResult result;     //!< 仅在 Replayed 时有效
+    };
+
+    /**
+     * @brief 构造函数，使用默认参数
+     * @param clock 时间来源（使用单调读数计算过期）
+     */
+    explicit RequestDeduplicator(const Clock* clock = Clock::system());
+
+    /**
+     * @brief 构造函数
+     * @param clock 时间来源
+     * @param config 去重表参数
+     */
+    RequestDeduplicator(const Clock* clock, const Config& config);
+
+    /**
+     * @brief 析构函数
+     */
+    ~RequestDeduplicator();
+
+    /**
+     * @brief 设置时间来源
+     * @param clock 时钟，为空时使用系统时钟
+     */
+    void setClock(const Clock* clock);
+
+    /**
+     * @brief 为请求占位或取回已保存的结果
+     * @param key 请求键（调用方应包含卡号等作用域信息）
+     * @param fingerprint 操作参数摘要，用于识别请求编号被误用于不同操作
+     * @return 占位结果
+     */
+    Claim claim(const QString& key, const QString& fingerprint);
+
+    /**
+     * @brief 记录请求的执行结果
+     *
+     * 成功结果保存至过期；失败结果不保存，并释放占位。
+     *
+     * @param key 请求键
+     * @param result 执行结果
+     */
+    void complete(const QString& key, const OperationResult& result);
+
+    /**
+     * @brief 获取当前保存的条目数（包括尚未清理的过期条目）
+     * @return 条目数
+     */
+    int size() const;
+
+private:
+    /**
+     * @brief 表中的一个条目
+     */
+    struct Entry {
+        QString key;                //!< 请求键
+        QString fingerprint;        //!< 操作参数摘要
+        OperationResult result;     //!< 执行结果（仅在 completed 时有效）
+        bool completed = false;     //!< 是否已执行完成
+        qint64 expiresAtMs = 0;     //!< 过期时间（单调毫秒）
+    };
+
+    /**
+     * @brief 一个分片
+     */
+    struct Shard {
+        QMutex mutex;                                           //!< 分片锁
+        std::list<Entry> lru;                                   //!< LRU链表，表头为最近使用
+        QHash<QString, std::list<Entry>::iterator> index;       //!< 请求键到链表节点的索引
+    };
+
+    /**
+     * @brief 获取请求键所在的分片
+     * @param key 请求键
+     * @return 分片
+     */
+    Shard& shardFor(const QString& key) const;
+
+    /**
+     * @brief 从分片尾部清理过期条目并淘汰超出容量的条目
+     * @param shard 分片（调用方已加锁）
+     * @param now 当前单调毫秒
+     */
+    void evict(Shard& shard, qint64 now) const;
+
+    //!< 时间来源
+    const Clock* m_clock;
+
+    //!< 去重表参数
+    Config m_config;
+
+    //!< 每个分片的容量
+    int m_shardCapacity;
+
+    //!< 分片数组
+    std::unique_ptr<Shard[]> m_shards;
+};
@@ -0,0 +1,402 @@
+/**
+ * @file SettlementBatch.cpp
+ * @brief 日终清算批处理实现
+ *
+ * 实现了SettlementBatch类中定义的分区、并行归约和CSV输出方法。
+ */
+#include "SettlementBatch.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QPair>
+#include <QSaveFile>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+//!< 每个线程分得的行块数和分区数的默认值
+// 行块越多负载越均衡，但分区桶数为 行块数 × 分区数，按线程数的平方增长（见 settlement 基准）
+const int kChunksPerThread = 4;
+
+//!< 输出缓冲区大小，缓冲满后写入文件
+const int kWriteBufferSize = 64 * 1024;
+
+/**
+ * @brief 分录类型
+ */
+enum class LegKind : quint8 {
+    Debit,      //!< 借记交易卡号
+    Credit,     //!< 贷记交易卡号
+    CreditTarget, //!< 贷记双边转账的收款方
+    Transfer    //!< 转账往来（按卡号对轧差）
+};
+
+/**
+ * @brief 一条分录
+ */
+struct Leg {
+    int index;      //!< 交易在快照中的下标
+    LegKind kind;   //!< 分录类型
+};
+
+/**
+ * @brief 一个行分块
+ */
+struct RowChunk {
+    int begin;      //!< 起始行
+    int end;        //!< 结束行（不含）
+};
+
+/**
+ * @brief 一个分区的归约结果
+ */
+struct PartitionResult {
+    QVector<CardPosition> positions;            //!< 各卡借贷汇总
+    QVector<NetTransferPosition> netTransfers;  //!< 卡号对轧差结果
+};
+
+int partitionOf(const QString& cardNumber, int partitionCount)
+{
+    return int(qHash(cardNumber) % uint(partitionCount));
+}
+
+/**
+ * @brief 取转账的付款方和收款方
+ * @param transaction 转账或单独存储的转入记录
+ * @return 付款方卡号和收款方卡号
+ */
+QPair<QString, QString> transferParties(const Transaction& transaction)
+{
+    if (transaction.type == TransactionType::TransferIn) {
+        return qMakePair(transaction.targetCardNumber, transaction.cardNumber);
+    }
+    return qMakePair(transaction.cardNumber, transaction.targetCardNumber);
+}
+
+void appendCsvRow(QByteArray& buffer, const char* record, const QString& cardNumber,
+                  const QString& counterparty, int debitCount, double debitAmount,
+                  int creditCount, double creditAmount, double net)
+{
+    // 卡号只含数字，无需转义
+    buffer.append(record);
+    buffer.append(',');
+    buffer.append(cardNumber.toLatin1());
+    buffer.append(',');
+    buffer.append(counterparty.toLatin1());
+    buffer.append(',');
+    buffer.append(QByteArray::number(debitCount));
+    buffer.append(',');
+    buffer.append(QByteArray::number(debitAmount, 'f', 2));
+    buffer.append(',');
+    buffer.append(QByteArray::number(creditCount));
+    buffer.append(',');
+    buffer.append(QByteArray::number(creditAmount, 'f', 2));
+    buffer.append(',');
+    buffer.append(QByteArray::number(net, 'f', 2));
+    buffer.append('\n');
+}
+
+} // namespace
+
+double SettlementReport::transactionsPerSecond() const
+{
+    if (elapsedMs <= 0) {
+        return 0.0;
+    }
+    return transactionsScanned * 1000.0 / elapsedMs;
+}
+
+QString SettlementReport::summary() const
+{
+    return QString("日终清算%1: %2, %3 笔交易中 %4 笔纳入清算, %5 张卡, %6 对转账往来, "
+                   "借记 %7 元, 贷记 %8 元, %9 个线程, 汇总 %10 ms, 写文件 %11 ms (%12 字节), "
+                   "总耗时 %13 ms (%14 笔/秒)%15")
+        .arg(success ? "完成" : "失败")
+        .arg(date.toString(Qt::ISODate))
+        .arg(transactionsScanned)
+        .arg(transactionsSettled)
+        .arg(cards)
+        .arg(transferPairs)
+        .arg(QString::number(totalDebits, 'f', 2))
+        .arg(QString::number(totalCredits, 'f', 2))
+        .arg(threads)
+        .arg(computeMs)
+        .arg(writeMs)
+        .arg(bytesWritten)
+        .arg(elapsedMs)
+        .arg(qRound64(transactionsPerSecond()))
+        .arg(success ? QString() : QString(": %1").arg(error));
+}
+
+SettlementBatch::SettlementBatch(int threads, int chunksPerThread)
+    : m_threads(threads > 0 ? threads : qMax(1, QThread::idealThreadCount()))
+    , m_chunksPerThread(chunksPerThread > 0 ? chunksPerThread : kChunksPerThread)
+{
+}
+
+SettlementReport SettlementBatch::run(QVector<Transaction> transactions, const QDate& date,
+                                      const QString& filePath) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    SettlementReport report;
+    report.date = date;
+    report.filePath = filePath;
+    report.threads = m_threads;
+    report.transactionsScanned = transactions.size();
+
+    const qint64 dayStartMs = QDateTime(date, QTime(0, 0)).toMSecsSinceEpoch();
+    const qint64 dayEndMs = QDateTime(date.addDays(1), QTime(0, 0)).toMSecsSinceEpoch();
+    const int partitionCount = m_threads * m_chunksPerThread;
+    const int chunkCount = qBound(1, int(transactions.size()), m_threads * m_chunksPerThread);
+
+    QVector<RowChunk> chunks;
+    chunks.reserve(chunkCount);
+    for (int i = 0; i < chunkCount; ++i) {
+        chunks.append(RowChunk{int(qint64(transactions.size()) * i / chunkCount),
+                               int(qint64(transactions.size()) * (i + 1) / chunkCount)});
+    }
+
+    auto forEachIndex = [this](int count, const std::function<void(int)>& work) {
+        if (count == 1 || m_threads == 1) {
+            for (int i = 0; i < count; ++i) {
+                work(i);
+            }
+            return;
+        }
+        QVector<int> indices(count);
+        std::iota(indices.begin(), indices.end(), 0);
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(m_threads);
+        QtConcurrent::blockingMap(&pool, indices, work);
+    };
+
+    // 分区：每个行块把分录放入自己的一组分区桶，行块之间不共享
+    QVector<QVector<QVector<Leg>>> buckets(chunks.size());
+    QVector<qint64> settledPerChunk(chunks.size(), 0);
+    forEachIndex(chunks.size(), [&](int chunkIndex) {
+        const RowChunk& chunk = chunks.at(chunkIndex);
+        QVector<QVector<Leg>>& chunkBuckets = buckets[chunkIndex];
+        chunkBuckets.resize(partitionCount);
+        qint64 settled = 0;
+        for (int i = chunk.begin; i < chunk.end; ++i) {
+            const Transaction& transaction = transactions.at(i);
+            const qint64 timestampMs = transaction.timestamp.toMSecsSinceEpoch();
+            if (timestampMs < dayStartMs || timestampMs >= dayEndMs) {
+                continue;
+            }
+
+            switch (transaction.type) {
+            case TransactionType::Deposit:
+            case TransactionType::Interest:
+                chunkBuckets[partitionOf(transaction.cardNumber, partitionCount)].append(Leg{i, LegKind::Credit});
+                break;
+            case TransactionType::Withdrawal:
+            case TransactionType::Fee:
+                chunkBuckets[partitionOf(transaction.cardNumber, partitionCount)].append(Leg{i, LegKind::Debit});
+                break;
+            case TransactionType::Transfer:
+                chunkBuckets[partitionOf(transaction.cardNumber, partitionCount)].append(Leg{i, LegKind::Debit});
+                // 旧格式中收款方单独保存了存款记录，贷记由那条记录计入
+                if (transaction.hasTargetLeg) {
+                    chunkBuckets[partitionOf(transaction.targetCardNumber, partitionCount)]
+                        .append(Leg{i, LegKind::CreditTarget});
+                }
+                break;
+            case TransactionType::TransferIn:
+                chunkBuckets[partitionOf(transaction.cardNumber, partitionCount)].append(Leg{i, LegKind::Credit});
+                break;
+            case TransactionType::BalanceInquiry:
+            case TransactionType::Other:
+                continue;
+            }
+
+            if ((transaction.type == TransactionType::Transfer || transaction.type == TransactionType::TransferIn)
+                && !transaction.targetCardNumber.isEmpty()
+                && transaction.targetCardNumber != transaction.cardNumber) {
+                const QString& lower = qMin(transaction.cardNumber, transaction.targetCardNumber);
+                chunkBuckets[partitionOf(lower, partitionCount)].append(Leg{i, LegKind::Transfer});
+            }
+            ++settled;
+        }
+        settledPerChunk[chunkIndex] = settled;
+    });
+
+    // 归约：每个分区汇总所有行块放入该分区的分录，分区之间卡号不重叠
+    QVector<PartitionResult> partitions(partitionCount);
+    forEachIndex(partitionCount, [&](int partition) {
+        QHash<QString, CardPosition> positions;
+        QHash<QPair<QString, QString>, NetTransferPosition> pairs;
+
+        for (int chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex) {
+            for (const Leg& leg : buckets.at(chunkIndex).at(partition)) {
+                const Transaction& transaction = transactions.at(leg.index);
+                if (leg.kind == LegKind::Transfer) {
+                    const QPair<QString, QString> parties = transferParties(transaction);
+                    const bool lowerPays = parties.first < parties.second;
+                    const QPair<QString, QString> key = lowerPays ? parties : qMakePair(parties.second, parties.first);
+                    NetTransferPosition& pair = pairs[key];
+                    if (pair.payerCard.isEmpty()) {
+                        pair.payerCard = key.first;
+                        pair.payeeCard = key.second;
+                    }
+                    if (lowerPays) {
+                        ++pair.paidCount;
+                        pair.paidAmount += transaction.amount;
+                    } else {
+                        ++pair.receivedCount;
+                        pair.receivedAmount += transaction.amount;
+                    }
+                    continue;
+                }
+
+                const QString& cardNumber = leg.kind == LegKind::CreditTarget
+                    ? transaction.targetCardNumber : transaction.cardNumber;
+                CardPosition& position = positions[cardNumber];
+                if (position.cardNumber.isEmpty()) {
+                    position.cardNumber = cardNumber;
+                }
+                if (leg.kind == LegKind::Debit) {
+                    ++position.debitCount;
+                    position.debitAmount += transaction.amount;
+                } else {
+                    ++position.creditCount;
+                    position.creditAmount += transaction.amount;
+                }
+            }
+        }
+
+        PartitionResult& result = partitions[partition];
+        result.positions.reserve(positions.size());
+        for (auto it = positions.cbegin(); it != positions.cend(); ++it) {
+            result.positions.append(it.value());
+        }
+        result.netTransfers.reserve(pairs.size());
+        for (auto it = pairs.cbegin(); it != pairs.cend(); ++it) {
+            NetTransferPosition pair = it.value();
+            if (pair.receivedAmount > pair.paidAmount) {
+                std::swap(pair.payerCard, pair.payeeCard);
+                std::swap(pair.paidCount, pair.receivedCount);
+                std::swap(pair.paidAmount, pair.receivedAmount);
+            }
+            result.netTransfers.append(pair);
+        }
+    });
+
+    // 合并：分区结果直接拼接，再按卡号排序以便对账
+    for (int i = 0; i < chunks.size(); ++i) {
+        report.transactionsSettled += settledPerChunk.at(i);
+    }
+    for (const PartitionResult& result : std::as_const(partitions)) {
+        report.positions += result.positions;
+        report.netTransfers += result.netTransfers;
+    }
+    std::sort(report.positions.begin(), report.positions.end(),
+              [](const CardPosition& a, const CardPosition& b) {
+                  return a.cardNumber < b.cardNumber;
+              });
+    std::sort(report.netTransfers.begin(), report.netTransfers.end(),
+              [](const NetTransferPosition& a, const NetTransferPosition& b) {
+                  if (a.payerCard != b.payerCard) {
+                      return a.payerCard < b.payerCard;
+                  }
+                  return a.payeeCard < b.payeeCard;
+              });
+    for (const CardPosition& position : std::as_const(report.positions)) {
+        report.totalDebits += position.debitAmount;
+        report.totalCredits += position.creditAmount;
+    }
+    report.cards = report.positions.size();
+    report.transferPairs = report.netTransfers.size();
+    report.computeMs = timer.elapsed();
+
+    if (filePath.isEmpty()) {
+        report.success = true;
+    } else {
+        QElapsedTimer writeTimer;
+        writeTimer.start();
+        report.success = writeCsv(report, filePath, report.bytesWritten, report.error);
+        report.writeMs = writeTimer.elapsed();
+    }
+    report.elapsedMs = timer.elapsed();
+
+    if (report.success) {
+        qDebug() << report.summary();
+    } else {
+        qWarning() << report.summary();
+    }
+    return report;
+}
+
+bool SettlementBatch::writeCsv(const SettlementReport& report, const QString& filePath,
+                               qint64& bytesWritten, QString& error)
+{
+    bytesWritten = 0;
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        error = QString("无法打开清算文件 %1: %2").arg(filePath, file.errorString());
+        return false;
+    }
+
+    QByteArray buffer;
+    buffer.reserve(kWriteBufferSize + 256);
+    auto flush = [&]() {
+        if (file.write(buffer) != buffer.size()) {
+            return false;
+        }
+        bytesWritten += buffer.size();
+        buffer.clear();
+        return true;
+    };
+    auto flushIfFull = [&]() {
+        return buffer.size() < kWriteBufferSize || flush();
+    };
+
+    buffer.append("record,card_number,counterparty,debit_count,debit_amount,credit_count,credit_amount,net_amount\n");
+
+    bool ok = true;
+    int debitCount = 0;
+    int creditCount = 0;
+    for (const CardPosition& position : report.positions) {
+        appendCsvRow(buffer, "position", position.cardNumber, QString(),
+                     position.debitCount, position.debitAmount,
+                     position.creditCount, position.creditAmount, position.net());
+        debitCount += position.debitCount;
+        creditCount += position.creditCount;
+        if (!(ok = flushIfFull())) {
+            break;
+        }
+    }
+    for (int i = 0; ok && i < report.netTransfers.size(); ++i) {
+        const NetTransferPosition& pair = report.netTransfers.at(i);
+        appendCsvRow(buffer, "net", pair.payerCard, pair.payeeCard,
+                     pair.paidCount, pair.paidAmount,
+                     pair.receivedCount, pair.receivedAmount, pair.net());
+        ok = flushIfFull();
+    }
+    if (ok) {
+        appendCsvRow(buffer, "total", QString(), QString(), debitCount, report.totalDebits,
+                     creditCount, report.totalCredits, report.totalCredits - report.totalDebits);
+        ok = flush();
+    }
+
+    if (!ok) {
+        error = QString("写入清算文件 %1 失败: %2").arg(filePath, file.errorString());
+        file.cancelWriting();
+        return false;
+    }
+    if (!file.commit()) {
+        error = QString("无法提交清算文件 %1: %2").arg(filePath, file.errorString());
+        return false;
+    }
+    return true;
+}
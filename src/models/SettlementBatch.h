@@ -0,0 +1,141 @@
+/**
+ * @file SettlementBatch.h
+ * @brief 日终清算批处理
+ *
+ * 定义了对一天的交易按卡号并行汇总借贷、按卡号对轧差转账，并把头寸流式写入 CSV 文件的批处理作业。
+ */
+#pragma once
+
+#include <QDate>
+#include <QString>
+#include <QVector>
+#include "Transaction.h"
+
+/**
+ * @brief 一张卡当天的借贷汇总
+ */
+struct CardPosition {
+    QString cardNumber;         //!< 卡号
+    int debitCount = 0;         //!< 借记笔数（取款、转出、管理费）
+    double debitAmount = 0.0;   //!< 借记金额
+    int creditCount = 0;        //!< 贷记笔数（存款、转入、利息）
+    double creditAmount = 0.0;  //!< 贷记金额
+
+    /**
+     * @brief 净头寸
+     * @return 贷记金额 - 借记金额
+     */
+    double net() const { return creditAmount - debitAmount; }
+};
+
+/**
+ * @brief 两张卡之间当天转账的轧差结果
+ *
+ * payerCard 为轧差后的净付款方，双方往来相等时取卡号较小的一方。
+ */
+struct NetTransferPosition {
+    QString payerCard;          //!< 净付款方卡号
+    QString payeeCard;          //!< 净收款方卡号
+    int paidCount = 0;          //!< 付款方转给收款方的笔数
+    double paidAmount = 0.0;    //!< 付款方转给收款方的金额
+    int receivedCount = 0;      //!< 收款方转给付款方的笔数
+    double receivedAmount = 0.0; //!< 收款方转给付款方的金额
+
+    /**
+     * @brief 轧差后的净额
+     * @return 付款方应付收款方的金额（不小于0）
+     */
+    double net() const { return paidAmount - receivedAmount; }
+};
+
+/**
+ * @brief 一次清算的结果
+ */
+struct SettlementReport {
+    QDate date;                         //!< 清算日
+    qint64 transactionsScanned = 0;     //!< 扫描的交易数（快照中的全部交易）
+    qint64 transactionsSettled = 0;     //!< 纳入清算的交易数（清算日的资金类交易）
+    int cards = 0;                      //!< 有资金变动的卡数
+    int transferPairs = 0;              //!< 有转账往来的卡号对数
+    double totalDebits = 0.0;           //!< 借记合计
+    double totalCredits = 0.0;          //!< 贷记合计
+    int threads = 0;                    //!< 使用的线程数
+    qint64 computeMs = 0;               //!< 汇总耗时（毫秒）
+    qint64 writeMs = 0;                 //!< 写文件耗时（毫秒）
+    qint64 elapsedMs = 0;               //!< 总耗时（毫秒）
+    qint64 bytesWritten = 0;            //!< 写入的字节数
+    QString filePath;                   //!< 清算文件路径
+    bool success = false;               //!< 是否成功写出清算文件
+    QString error;                      //!< 失败的原因
+    QVector<CardPosition> positions;    //!< 各卡借贷汇总（按卡号排序）
+    QVector<NetTransferPosition> netTransfers; //!< 卡号对轧差结果（按付款方、收款方卡号排序）
+
+    /**
+     * @brief 计算吞吐量
+     * @return 每秒扫描的交易数
+     */
+    double transactionsPerSecond() const;
+
+    /**
+     * @brief 生成一行摘要
+     * @return 摘要文本
+     */
+    QString summary() const;
+};
+
+/**
+ * @brief 日终清算批处理
+ *
+ * 输入为交易记录的快照：调用方在主线程复制 TransactionModel::getAllTransactions()，
+ * QVector 的隐式共享使复制只增加引用计数，之后主线程继续登记的交易会让账本另行分配，
+ * 快照保持不变，因此清算可以在后台线程与在线交易同时进行。
+ *
+ * 处理分三步：
+ * - 分区：账本按行分块并行扫描，把清算日的每条资金类交易拆成借记、贷记和转账往来三类分录，
+ *   按卡号的散列放入各自的分区（转账往来按卡号对中较小的卡号分区）；
+ * - 归约：各分区并行汇总，分区之间卡号不重叠，无需加锁或合并同一卡号；
+ * - 输出：合并各分区的结果并排序，以缓冲方式流式写入 CSV，通过 QSaveFile 原子替换。
+ *
+ * 借贷规则与账本校验一致：存款、转入、利息为贷记，取款、转出、管理费为借记，
+ * 余额查询和其他操作不参与清算。
+ */
+class SettlementBatch {
+public:
+    /**
+     * @brief 构造函数
+     * @param threads 线程数，0 表示使用 QThread::idealThreadCount()
+     * @param chunksPerThread 每个线程分得的行块数和分区数，0 表示使用默认值 4
+     */
+    explicit SettlementBatch(int threads = 0, int chunksPerThread = 0);
+
+    /**
+     * @brief 执行清算
+     * @param transactions 交易记录快照（任意顺序）
+     * @param date 清算日（本地日期）
+     * @param filePath 清算文件路径，为空时只汇总不写文件
+     * @return 清算结果
+     */
+    SettlementReport run(QVector<Transaction> transactions, const QDate& date,
+                         const QString& filePath) const;
+
+    /**
+     * @brief 把清算结果写成 CSV
+     *
+     * 第一列为记录类型：position 行为单张卡的借贷汇总，net 行为卡号对的轧差结果
+     * （card_number 为净付款方，debit 列为其付出的金额，credit 列为其收到的金额）。
+     *
+     * @param report 清算结果
+     * @param filePath 文件路径
+     * @param bytesWritten 输出参数，写入的字节数
+     * @param error 输出参数，失败的原因
+     * @return 如果成功写出返回true，否则返回false
+     */
+    static bool writeCsv(const SettlementReport& report, const QString& filePath,
+                         qint64& bytesWritten, QString& error);
+
+private:
+    //!< 线程数
+    int m_threads;
+    //!< 每个线程分得的行块数和分区数
+    int m_chunksPerThread;
+};
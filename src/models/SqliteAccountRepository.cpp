@@ -0,0 +1,455 @@
+/**
+ * @file SqliteAccountRepository.cpp
+ * @brief SQLite账户存储库类实现
+ *
+ * 实现了SqliteAccountRepository类中定义的数据库读写和账户管理方法。
+ */
+#include "SqliteAccountRepository.h"
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+
+/**
+ * @brief 构造函数
+ * @param persistenceManager SQLite持久化管理器
+ */
+SqliteAccountRepository::SqliteAccountRepository(SqlitePersistenceManager* persistenceManager)
+    : m_persistenceManager(persistenceManager)
+{
+    Q_ASSERT(persistenceManager != nullptr);
+    
+    // 尝试从数据库加载账户数据
+    // 如果数据库中没有账户，则初始化测试账户
+    if (!loadAccounts()) {
+        qDebug() << "数据库中没有账户数据，初始化测试账户";
+        initializeTestAccounts();
+    }
+}
+
+/**
+ * @brief 保存单个账户
+ * @param account 要保存的账户
+ * @return 操作结果
+ */
+OperationResult SqliteAccountRepository::saveAccount(const Account& account)
+{
+    // 检查账户是否有效
+    if (!account.isValid()) {
+        return OperationResult::Failure("账户数据无效");
+    }
+    
+    // 单条语句在自动提交模式下即为一个事务
+    if (!upsertAccount(account)) {
+        return OperationResult::Failure("无法保存账户数据");
+    }
+    addToCardFilter(account.cardNumber);
+    
+    return OperationResult::Success();
+}
+
+/**
+ * @brief 批量保存多个账户
+ *
+ * 所有写入包裹在同一个事务中，只产生一次提交。
+ *
+ * @param accounts 要保存的账户列表
+ * @return 操作结果
+ */
+OperationResult SqliteAccountRepository::saveAccountsBatch(const QVector<Account>& accounts)
+{
+    // 检查所有账户是否有效，任一无效则整批拒绝
+    for (const Account& account : accounts) {
+        if (!account.isValid()) {
+            return OperationResult::Failure("账户数据无效");
+        }
+    }
+    
+    if (!m_persistenceManager->beginBatch()) {
+        return OperationResult::Failure("无法保存账户数据");
+    }
+    
+    for (const Account& account : accounts) {
+        if (!upsertAccount(account)) {
+            m_persistenceManager->rollbackBatch();
+            return OperationResult::Failure("无法保存账户数据");
+        }
+    }
+    
+    if (!m_persistenceManager->commitBatch()) {
+        return OperationResult::Failure("无法保存账户数据");
+    }
+    
+    // 事务提交后才加入过滤器，回滚的卡号不会留下痕迹
+    for (const Account& account : accounts) {
+        addToCardFilter(account.cardNumber);
+    }
+    
+    return OperationResult::Success();
+}
+
+/**
+ * @brief 删除账户
+ * @param cardNumber 要删除的账户卡号
+ * @return 操作结果
+ */
+OperationResult SqliteAccountRepository::deleteAccount(const QString& cardNumber)
+{
+    // 检查账户是否存在
+    if (!accountExists(cardNumber)) {
+        return OperationResult::Failure("账户不存在");
+    }
+    
+    m_deleteQuery.bindValue(":cardNumber", cardNumber);
+    bool success = m_deleteQuery.exec();
+    m_deleteQuery.finish();
+    
+    if (!success) {
+        qWarning() << "删除账户失败:" << m_deleteQuery.lastError().text();
+        return OperationResult::Failure("无法保存账户数据");
+    }
+    
+    // 过滤器中的位保留，只会多出由数据库查询拒绝的误报
+    removeFromCardFilter();
+    
+    return OperationResult::Success();
+}
+
+/**
+ * @brief 根据卡号查找账户
+ * @param cardNumber 卡号
+ * @return 包含账户的optional对象，如果未找到则为empty
+ */
+std::optional<Account> SqliteAccountRepository::findByCardNumber(const QString& cardNumber) const
+{
+    // 布隆过滤器判定不存在的卡号不访问数据库
+    if (!m_cardFilter.mightContain(cardNumber)) {
+        return std::nullopt;
+    }
+    
+    m_selectQuery.bindValue(":cardNumber", cardNumber);
+    if (!m_selectQuery.exec()) {
+        qWarning() << "查询账户失败:" << m_selectQuery.lastError().text();
+        return std::nullopt;
+    }
+    
+    std::optional<Account> result;
+    if (m_selectQuery.next()) {
+        result = accountFromQuery(m_selectQuery);
+    }
+    m_selectQuery.finish();
+    
+    return result;
+}
+
+/**
+ * @brief 获取所有账户
+ * @return 所有账户的列表（按卡号排序）
+ */
+QVector<Account> SqliteAccountRepository::getAllAccounts() const
+{
+    QVector<Account> accounts;
+    
+    QSqlQuery query(m_persistenceManager->database());
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT card_number, pin_hash, salt, holder_name, balance, withdraw_limit, "
+                    "is_locked, is_admin, failed_login_attempts, last_failed_login, temporary_lock_time "
+                    "FROM accounts ORDER BY card_number")) {
+        qWarning() << "查询账户列表失败:" << query.lastError().text();
+        return accounts;
+    }
+    
+    while (query.next()) {
+        accounts.append(accountFromQuery(query));
+    }
+    
+    return accounts;
+}
+
+/**
+ * @brief 检查账户是否存在
+ * @param cardNumber 卡号
+ * @return 如果账户存在返回true，否则返回false
+ */
+bool SqliteAccountRepository::accountExists(const QString& cardNumber) const
+{
+    if (!m_cardFilter.mightContain(cardNumber)) {
+        return false;
+    }
+    
+    m_existsQuery.bindValue(":cardNumber", cardNumber);
+    if (!m_existsQuery.exec()) {
+        return false;
+    }
+    
+    bool exists = m_existsQuery.next();
+    m_existsQuery.finish();
+    return exists;
+}
+
+/**
+ * @brief 保存所有账户数据
+ * @return 数据库可用时返回true
+ */
+bool SqliteAccountRepository::saveAccounts()
+{
+    // 每次写操作都已提交，这里无需额外工作
+    return m_persistenceManager->isOpen();
+}
+
+/**
+ * @brief 加载账户数据
+ *
+ * SQLite 后端按需查询，不把整表读入内存；这里只负责建表和预编译语句。
+ *
+ * @return 如果数据库中已有账户返回true，否则返回false
+ */
+bool SqliteAccountRepository::loadAccounts()
+{
+    if (!m_persistenceManager->isOpen()) {
+        return false;
+    }
+    
+    if (!createSchema() || !prepareStatements()) {
+        return false;
+    }
+    
+    QSqlQuery countQuery(m_persistenceManager->database());
+    if (!countQuery.exec("SELECT COUNT(*) FROM accounts") || !countQuery.next()) {
+        return false;
+    }
+    
+    int count = countQuery.value(0).toInt();
+    if (count == 0) {
+        return false;
+    }
+    
+    // 后续的存在性检查依赖过滤器，必须先建好
+    if (!rebuildCardFilter()) {
+        return false;
+    }
+    
+    // 确保管理员账户存在
+    if (!accountExists("9999888877776666")) {
+        qWarning() << "管理员账户未加载，创建新管理员账户";
+        Account admin;
+        admin.cardNumber = "9999888877776666";
+        admin.holderName = "管理员";
+        admin.balance = 50000.0;
+        admin.withdrawLimit = 10000.0;
+        admin.isLocked = false;
+        admin.isAdmin = true;
+        admin.failedLoginAttempts = 0;
+        // 设置PIN码（自动哈希）
+        admin.setPin("8888");
+        if (upsertAccount(admin)) {
+            addToCardFilter(admin.cardNumber);
+        }
+    }
+    
+    qDebug() << "SQLite数据库中共有" << count << "个账户";
+    return true;
+}
+
+/**
+ * @brief 创建账户表
+ * @return 如果成功创建返回true，否则返回false
+ */
+bool SqliteAccountRepository::createSchema()
+{
+    // 卡号为主键，WITHOUT ROWID 使按卡号查找直接命中聚簇索引
+    return m_persistenceManager->execute(
+        "CREATE TABLE IF NOT EXISTS accounts ("
+        "card_number TEXT PRIMARY KEY NOT NULL, "
+        "pin_hash TEXT NOT NULL, "
+        "salt TEXT NOT NULL, "
+        "holder_name TEXT NOT NULL, "
+        "balance REAL NOT NULL, "
+        "withdraw_limit REAL NOT NULL, "
+        "is_locked INTEGER NOT NULL DEFAULT 0, "
+        "is_admin INTEGER NOT NULL DEFAULT 0, "
+        "failed_login_attempts INTEGER NOT NULL DEFAULT 0, "
+        "last_failed_login TEXT, "
+        "temporary_lock_time TEXT"
+        ") WITHOUT ROWID");
+}
+
+/**
+ * @brief 预编译常用语句
+ * @return 如果全部成功返回true，否则返回false
+ */
+bool SqliteAccountRepository::prepareStatements()
+{
+    QSqlDatabase db = m_persistenceManager->database();
+    
+    m_upsertQuery = QSqlQuery(db);
+    m_selectQuery = QSqlQuery(db);
+    m_existsQuery = QSqlQuery(db);
+    m_deleteQuery = QSqlQuery(db);
+    
+    m_selectQuery.setForwardOnly(true);
+    m_existsQuery.setForwardOnly(true);
+    
+    bool ok = m_upsertQuery.prepare(
+                  "INSERT OR REPLACE INTO accounts (card_number, pin_hash, salt, holder_name, balance, "
+                  "withdraw_limit, is_locked, is_admin, failed_login_attempts, last_failed_login, "
+                  "temporary_lock_time) VALUES (:cardNumber, :pinHash, :salt, :holderName, :balance, "
+                  ":withdrawLimit, :isLocked, :isAdmin, :failedLoginAttempts, :lastFailedLogin, "
+                  ":temporaryLockTime)")
+              && m_selectQuery.prepare(
+                  "SELECT card_number, pin_hash, salt, holder_name, balance, withdraw_limit, "
+                  "is_locked, is_admin, failed_login_attempts, last_failed_login, temporary_lock_time "
+                  "FROM accounts WHERE card_number = :cardNumber")
+              && m_existsQuery.prepare("SELECT 1 FROM accounts WHERE card_number = :cardNumber")
+              && m_deleteQuery.prepare("DELETE FROM accounts WHERE card_number = :cardNumber");
+    
+    if (!ok) {
+        qWarning() << "预编译账户语句失败:" << db.lastError().text();
+    }
+    return ok;
+}
+
+/**
+ * @brief 执行一次账户写入（不开启事务）
+ * @param account 要写入的账户
+ * @return 如果成功写入返回true，否则返回false
+ */
+bool SqliteAccountRepository::upsertAccount(const Account& account)
+{
+    m_upsertQuery.bindValue(":cardNumber", account.cardNumber);
+    m_upsertQuery.bindValue(":pinHash", account.pinHash);
+    m_upsertQuery.bindValue(":salt", account.salt);
+    m_upsertQuery.bindValue(":holderName", account.holderName);
+    m_upsertQuery.bindValue(":balance", account.balance);
+    m_upsertQuery.bindValue(":withdrawLimit", account.withdrawLimit);
+    m_upsertQuery.bindValue(":isLocked", account.isLocked ? 1 : 0);
+    m_upsertQuery.bindValue(":isAdmin", account.isAdmin ? 1 : 0);
+    m_upsertQuery.bindValue(":failedLoginAttempts", account.failedLoginAttempts);
+    m_upsertQuery.bindValue(":lastFailedLogin", account.lastFailedLogin.isValid()
+                            ? QVariant(account.lastFailedLogin.toString(Qt::ISODate)) : QVariant());
+    m_upsertQuery.bindValue(":temporaryLockTime", account.temporaryLockTime.isValid()
+                            ? QVariant(account.temporaryLockTime.toString(Qt::ISODate)) : QVariant());
+    
+    bool success = m_upsertQuery.exec();
+    if (!success) {
+        qWarning() << "写入账户失败:" << account.cardNumber << m_upsertQuery.lastError().text();
+    }
+    m_upsertQuery.finish();
+    return success;
+}
+
+/**
+ * @brief 从查询结果的当前行构造账户
+ *
+ * 列顺序必须与 SELECT 语句一致。
+ *
+ * @param query 已定位到某一行的查询
+ * @return 账户对象
+ */
+Account SqliteAccountRepository::accountFromQuery(const QSqlQuery& query)
+{
+    Account account;
+    account.cardNumber = query.value(0).toString();
+    account.pinHash = query.value(1).toString();
+    account.salt = query.value(2).toString();
+    account.holderName = query.value(3).toString();
+    account.balance = query.value(4).toDouble();
+    account.withdrawLimit = query.value(5).toDouble();
+    account.isLocked = query.value(6).toInt() != 0;
+    account.isAdmin = query.value(7).toInt() != 0;
+    account.failedLoginAttempts = query.value(8).toInt();
+    
+    if (!query.value(9).isNull()) {
+        account.lastFailedLogin = QDateTime::fromString(query.value(9).toString(), Qt::ISODate);
+    }
+    
+    if (!query.value(10).isNull()) {
+        account.temporaryLockTime = QDateTime::fromString(query.value(10).toString(), Qt::ISODate);
+    }
+    
+    return account;
+}
+
+/**
+ * @brief 初始化测试账户数据
+ *
+ * 与 JsonAccountRepository 使用相同的预设测试账户，并在一个事务中写入。
+ */
+void SqliteAccountRepository::initializeTestAccounts()
+{
+    if (!m_persistenceManager->isOpen()) {
+        return;
+    }
+    
+    QVector<Account> accounts;
+    accounts.append(Account("1234567890123456", "1234", "张三", 50000.0, 20000.0, false, false));
+    accounts.append(Account("2345678901234567", "2345", "李四", 100000.0, 30000.0, false, false));
+    accounts.append(Account("3456789012345678", "3456", "王五", 75000.0, 25000.0, true, false));
+    accounts.append(Account("9999888877776666", "8888", "管理员", 500000.0, 100000.0, false, true));
+    
+    saveAccountsBatch(accounts);
+    
+    qDebug() << "测试账户初始化完成，共" << accounts.size() << "个账户";
+}
+
+/**
+ * @brief 从数据库读取全部卡号重建布隆过滤器
+ * @return 如果成功读取返回true，否则返回false
+ */
+bool SqliteAccountRepository::rebuildCardFilter()
+{
+    QSqlQuery countQuery(m_persistenceManager->database());
+    if (!countQuery.exec("SELECT COUNT(*) FROM accounts") || !countQuery.next()) {
+        qWarning() << "统计账户数量失败:" << countQuery.lastError().text();
+        return false;
+    }
+    
+    // 预留一倍余量，避免新增少量账户就触发重建
+    m_cardFilter.reset(countQuery.value(0).toInt() * 2);
+    
+    QSqlQuery query(m_persistenceManager->database());
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT card_number FROM accounts")) {
+        qWarning() << "读取卡号失败:" << query.lastError().text();
+        return false;
+    }
+    while (query.next()) {
+        m_cardFilter.add(query.value(0).toString());
+    }
+    
+    qDebug() << "卡号布隆过滤器已重建:" << m_cardFilter.count() << "个卡号,"
+             << m_cardFilter.bitCount() << "位, 估计误判率"
+             << m_cardFilter.estimatedFalsePositiveRate() * 100.0 << "%";
+    return true;
+}
+
+/**
+ * @brief 将已写入数据库的卡号加入布隆过滤器，超过容量时重建
+ *
+ * 过滤器判定可能存在的卡号对应位已全部置位，无需重复加入，
+ * 因此更新已有账户不会消耗容量。
+ *
+ * @param cardNumber 卡号
+ */
+void SqliteAccountRepository::addToCardFilter(const QString& cardNumber)
+{
+    if (m_cardFilter.mightContain(cardNumber)) {
+        return;
+    }
+    
+    if (m_cardFilter.needsRebuild()) {
+        rebuildCardFilter();
+    } else {
+        m_cardFilter.add(cardNumber);
+    }
+}
+
+/**
+ * @brief 记录一个卡号已从数据库删除，过期卡号过多时重建布隆过滤器
+ */
+void SqliteAccountRepository::removeFromCardFilter()
+{
+    m_cardFilter.markRemoved();
+    if (m_cardFilter.needsRebuild()) {
+        rebuildCardFilter();
+    }
+}
@@ -0,0 +1,160 @@
+/**
+ * @file SqliteAccountRepository.h
+ * @brief SQLite账户存储库类
+ *
+ * 使用嵌入式SQLite数据库作为后端存储实现IAccountRepository接口。
+ */
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QSqlQuery>
+#include <optional>
+#include "IAccountRepository.h"
+#include "Account.h"
+#include "SqlitePersistenceManager.h"
+#include "CardBloomFilter.h"
+
+/**
+ * @brief SQLite账户存储库类
+ *
+ * 账户数据直接保存在 accounts 表中（以卡号为主键），不在内存中缓存整表。
+ * 单个账户的读写使用预编译语句，批量写入包裹在一个事务中提交。
+ * 内存中只保留全部卡号的布隆过滤器，不存在的卡号在查询数据库之前即被排除。
+ */
+class SqliteAccountRepository : public IAccountRepository {
+public:
+    /**
+     * @brief 构造函数
+     * @param persistenceManager SQLite持久化管理器
+     */
+    explicit SqliteAccountRepository(SqlitePersistenceManager* persistenceManager);
+    
+    /**
+     * @brief 保存单个账户
+     * @param account 要保存的账户
+     * @return 操作结果
+     */
+    OperationResult saveAccount(const Account& account) override;
+    
+    /**
+     * @brief 批量保存多个账户
+     * @param accounts 要保存的账户列表
+     * @return 操作结果
+     */
+    OperationResult saveAccountsBatch(const QVector<Account>& accounts) override;
+    
+    /**
+     * @brief 删除账户
+     * @param cardNumber 要删除的账户卡号
+     * @return 操作结果
+     */
+    OperationResult deleteAccount(const QString& cardNumber) override;
+    
+    /**
+     * @brief 根据卡号查找账户
+     * @param cardNumber 卡号
+     * @return 包含账户的optional对象，如果未找到则为empty
+     */
+    std::optional<Account> findByCardNumber(const QString& cardNumber) const override;
+    
+    /**
+     * @brief 获取所有账户
+     * @return 所有账户的列表
+     */
+    QVector<Account> getAllAccounts() const override;
+    
+    /**
+     * @brief 保存所有账户数据
+     *
+     * 每次写操作都已提交到数据库，此方法无需额外工作。
+     *
+     * @return 数据库可用时返回true
+     */
+    bool saveAccounts() override;
+    
+    /**
+     * @brief 加载所有账户数据
+     *
+     * 创建表结构并预编译语句。
+     *
+     * @return 如果数据库中已有账户返回true，否则返回false
+     */
+    bool loadAccounts() override;
+    
+    /**
+     * @brief 检查账户是否存在
+     * @param cardNumber 卡号
+     * @return 如果账户存在返回true，否则返回false
+     */
+    bool accountExists(const QString& cardNumber) const override;
+
+private:
+    /**
+     * @brief 创建账户表
+     * @return 如果成功创建返回true，否则返回false
+     */
+    bool createSchema();
+    
+    /**
+     * @brief 预编译常用语句
+     * @return 如果全部成功返回true，否则返回false
+     */
+    bool prepareStatements();
+    
+    /**
+     * @brief 执行一次账户写入（不开启事务）
+     * @param account 要写入的账户
+     * @return 如果成功写入返回true，否则返回false
+     */
+    bool upsertAccount(const Account& account);
+    
+    /**
+     * @brief 从查询结果的当前行构造账户
+     * @param query 已定位到某一行的查询
+     * @return 账户对象
+     */
+    static Account accountFromQuery(const QSqlQuery& query);
+    
+    /**
+     * @brief 初始化测试账户数据
+     *
+     * 如果数据库中没有账户，则创建一些预设的测试账户。
+     */
+    void initializeTestAccounts();
+    
+    /**
+     * @brief 从数据库读取全部卡号重建布隆过滤器
+     * @return 如果成功读取返回true，否则返回false
+     */
+    bool rebuildCardFilter();
+    
+    /**
+     * @brief 将已写入数据库的卡号加入布隆过滤器，超过容量时重建
+     * @param cardNumber 卡号
+     */
+    void addToCardFilter(const QString& cardNumber);
+    
+    /**
+     * @brief 记录一个卡号已从数据库删除，过期卡号过多时重建布隆过滤器
+     */
+    void removeFromCardFilter();
+    
+    //!< SQLite持久化管理器
+    SqlitePersistenceManager* m_persistenceManager;
+    
+    //!< 预编译语句：插入或更新账户
+    QSqlQuery m_upsertQuery;
+    
+    //!< 预编译语句：按卡号查询账户
+    mutable QSqlQuery m_selectQuery;
+    
+    //!< 预编译语句：检查卡号是否存在
+    mutable QSqlQuery m_existsQuery;
+    
+    //!< 预编译语句：删除账户
+    QSqlQuery m_deleteQuery;
+    
+    //!< 现有卡号的布隆过滤器，查询数据库前先排除不存在的卡号
+    CardBloomFilter m_cardFilter;
+};
@@ -0,0 +1,109 @@
+/**
+ * @file SqlitePersistenceManager.cpp
+ * @brief SQLite持久化管理器实现文件
+ *
+ * 实现了SqlitePersistenceManager类中定义的数据库连接和事务管理方法。
+ */
+#include "SqlitePersistenceManager.h"
+#include <QDir>
+#include <QStandardPaths>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QUuid>
+#include <QDebug>
+
+SqlitePersistenceManager::SqlitePersistenceManager(QObject* parent,
+                                                   const QString& dataPath,
+                                                   const QString& databaseName)
+    : QObject(parent)
+    , m_connectionName(QString("atm_sqlite_%1").arg(QUuid::createUuid().toString(QUuid::Id128)))
+{
+    // 如果未提供数据路径，则使用应用程序的本地数据目录
+    if (dataPath.isEmpty()) {
+        m_dataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    } else {
+        m_dataPath = dataPath;
+    }
+
+    QDir dir(m_dataPath);
+    // 如果目录不存在，则创建它
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+
+    QString filePath = m_dataPath + "/" + databaseName;
+    m_database = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+    m_database.setDatabaseName(filePath);
+
+    if (!m_database.open()) {
+        qWarning() << "无法打开SQLite数据库:" << filePath << ", 错误:" << m_database.lastError().text();
+        return;
+    }
+
+    // WAL 模式下读写互不阻塞，且每次提交只追加日志，无需重写整个文件；
+    // 配合 synchronous=NORMAL，仅在检查点时执行 fsync
+    execute("PRAGMA journal_mode=WAL");
+    execute("PRAGMA synchronous=NORMAL");
+    execute("PRAGMA temp_store=MEMORY");
+
+    qDebug() << "SQLite数据库路径:" << filePath;
+}
+
+SqlitePersistenceManager::~SqlitePersistenceManager()
+{
+    if (m_database.isOpen()) {
+        m_database.close();
+    }
+    // 必须先释放所有 QSqlDatabase 副本，才能移除连接
+    m_database = QSqlDatabase();
+    QSqlDatabase::removeDatabase(m_connectionName);
+}
+
+bool SqlitePersistenceManager::isOpen() const
+{
+    return m_database.isOpen();
+}
+
+QSqlDatabase SqlitePersistenceManager::database() const
+{
+    return m_database;
+}
+
+bool SqlitePersistenceManager::beginBatch()
+{
+    if (!m_database.transaction()) {
+        qWarning() << "无法开始SQLite事务:" << m_database.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool SqlitePersistenceManager::commitBatch()
+{
+    if (!m_database.commit()) {
+        qWarning() << "无法提交SQLite事务:" << m_database.lastError().text();
+        m_database.rollback();
+        return false;
+    }
+    return true;
+}
+
+void SqlitePersistenceManager::rollbackBatch()
+{
+    m_database.rollback();
+}
+
+bool SqlitePersistenceManager::execute(const QString& sql)
+{
+    QSqlQuery query(m_database);
+    if (!query.exec(sql)) {
+        qWarning() << "SQL执行失败:" << sql << ", 错误:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+QString SqlitePersistenceManager::getDataPath() const
+{
+    return m_dataPath;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file SqlitePersistenceManager.h
+ * @brief SQLite持久化管理器头文件
+ *
+ * 负责打开和配置嵌入式SQLite数据库，供SQLite账户存储库和交易存储共用。
+ */
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QSqlDatabase>
+
+/**
+ * @brief SQLite持久化管理器
+ *
+ * 通过 Qt SQL 的 QSQLITE 驱动打开数据库连接，启用 WAL 日志模式，
+ * 并提供批量事务的开始/提交/回滚接口。
+ */
+class SqlitePersistenceManager : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父对象
+     * @param dataPath 数据存储路径，默认使用应用程序的本地数据目录
+     * @param databaseName 数据库文件名，默认为"atm.db"
+     */
+    explicit SqlitePersistenceManager(QObject* parent = nullptr,
+                                      const QString& dataPath = QString(),
+                                      const QString& databaseName = "atm.db");
+
+    /**
+     * @brief 析构函数
+     *
+     * 关闭数据库连接并从连接池中移除。
+     */
+    ~SqlitePersistenceManager() override;
+
+    /**
+     * @brief 检查数据库是否已打开
+     * @return 如果数据库连接可用返回true，否则返回false
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief 获取数据库连接
+     * @return 数据库连接对象
+     */
+    QSqlDatabase database() const;
+
+    /**
+     * @brief 开始批量事务
+     * @return 如果成功开始返回true，否则返回false
+     */
+    bool beginBatch();
+
+    /**
+     * @brief 提交批量事务
+     * @return 如果成功提交返回true，否则返回false
+     */
+    bool commitBatch();
+
+    /**
+     * @brief 回滚批量事务
+     */
+    void rollbackBatch();
+
+    /**
+     * @brief 执行一条不带参数的SQL语句
+     * @param sql SQL语句
+     * @return 如果执行成功返回true，否则返回false
+     */
+    bool execute(const QString& sql);
+
+    /**
+     * @brief 获取数据存储路径
+     * @return 数据存储路径
+     */
+    QString getDataPath() const;
+
+private:
+    //!< 数据存储路径
+    QString m_dataPath;
+
+    //!< 数据库连接名（每个管理器实例独立）
+    QString m_connectionName;
+
+    //!< 数据库连接
+    QSqlDatabase m_database;
+};
@@ -0,0 +1,369 @@
+/**
+ * @file SqliteTransactionStore.cpp
+ * @brief SQLite交易存储类实现
+ *
+ * 实现了SqliteTransactionStore类中定义的数据库读写方法。
+ */
+#include "SqliteTransactionStore.h"
+#include "TransactionIdGenerator.h"
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+
+/**
+ * @brief 构造函数
+ * @param persistenceManager SQLite持久化管理器
+ */
+SqliteTransactionStore::SqliteTransactionStore(SqlitePersistenceManager* persistenceManager)
+    : m_persistenceManager(persistenceManager)
+{
+    Q_ASSERT(persistenceManager != nullptr);
+
+    if (!m_persistenceManager->isOpen() || !createSchema()) {
+        qWarning() << "SQLite交易存储初始化失败";
+        return;
+    }
+
+    QSqlDatabase db = m_persistenceManager->database();
+    m_insertQuery = QSqlQuery(db);
+    m_deleteForCardQuery = QSqlQuery(db);
+    m_updateQuery = QSqlQuery(db);
+
+    bool ok = m_insertQuery.prepare(
+                  "INSERT INTO transactions (id, card_number, timestamp_ms, type, amount, balance_after, "
+                  "description, target_card_number, target_balance_after) VALUES (:id, :cardNumber, "
+                  ":timestampMs, :type, :amount, :balanceAfter, :description, :targetCardNumber, "
+                  ":targetBalanceAfter)")
+              && m_deleteForCardQuery.prepare("DELETE FROM transactions WHERE card_number = :cardNumber")
+              && m_updateQuery.prepare(
+                  "UPDATE transactions SET card_number = :cardNumber, timestamp_ms = :timestampMs, type = :type, "
+                  "amount = :amount, balance_after = :balanceAfter, description = :description, "
+                  "target_card_number = :targetCardNumber, target_balance_after = :targetBalanceAfter "
+                  "WHERE id = :id");
+
+    if (!ok) {
+        qWarning() << "预编译交易语句失败:" << db.lastError().text();
+    }
+}
+
+/**
+ * @brief 加载全部交易记录
+ * @param transactions 输出参数，保存读取的交易记录
+ * @return 如果表中已有记录返回true，否则返回false
+ */
+bool SqliteTransactionStore::loadTransactions(QVector<Transaction>& transactions)
+{
+    if (!m_persistenceManager->isOpen()) {
+        return false;
+    }
+
+    QSqlQuery query(m_persistenceManager->database());
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT card_number, timestamp_ms, type, amount, balance_after, description, "
+                    "target_card_number, id, rowid, target_balance_after FROM transactions ORDER BY rowid")) {
+        qWarning() << "查询交易记录失败:" << query.lastError().text();
+        return false;
+    }
+
+    transactions.clear();
+    QVector<qint64> rowIds;
+    QVector<int> missing;
+    while (query.next()) {
+        Transaction transaction;
+        transaction.cardNumber = query.value(0).toString();
+        transaction.timestamp = QDateTime::fromMSecsSinceEpoch(query.value(1).toLongLong(), Qt::UTC);
+        transaction.type = static_cast<TransactionType>(query.value(2).toInt());
+        transaction.amount = query.value(3).toDouble();
+        transaction.balanceAfter = query.value(4).toDouble();
+        transaction.description = query.value(5).toString();
+        transaction.targetCardNumber = query.value(6).toString();
+        transaction.id = query.value(7).toULongLong();
+        if (transaction.id == 0) {
+            missing.append(transactions.size());
+        }
+        rowIds.append(query.value(8).toLongLong());
+        if (!query.isNull(9)) {
+            transaction.hasTargetLeg = true;
+            transaction.targetBalanceAfter = query.value(9).toDouble();
+        }
+        transactions.append(transaction);
+    }
+
+    // 旧版本表中的记录没有交易编号：补分配并写回
+    if (!missing.isEmpty()) {
+        TransactionIdGenerator::assignMissingIds(transactions);
+        writeAssignedIds(transactions, rowIds, missing);
+    }
+
+    // 空表视为尚未初始化，交由 TransactionModel 生成测试数据
+    return !transactions.isEmpty();
+}
+
+/**
+ * @brief 全量保存交易记录
+ * @param transactions 完整的交易记录列表
+ * @return 如果成功保存返回true，否则返回false
+ */
+bool SqliteTransactionStore::saveTransactions(const QVector<Transaction>& transactions)
+{
+    if (!m_persistenceManager->beginBatch()) {
+        return false;
+    }
+
+    QSqlQuery clearQuery(m_persistenceManager->database());
+    if (!clearQuery.exec("DELETE FROM transactions")) {
+        qWarning() << "清空交易表失败:" << clearQuery.lastError().text();
+        m_persistenceManager->rollbackBatch();
+        return false;
+    }
+
+    for (const Transaction& transaction : transactions) {
+        if (!insertTransaction(transaction)) {
+            m_persistenceManager->rollbackBatch();
+            return false;
+        }
+    }
+
+    return m_persistenceManager->commitBatch();
+}
+
+/**
+ * @brief 追加新交易记录
+ * @param transactions 完整的交易记录列表
+ * @param firstNewIndex 第一条新记录的下标
+ * @return 如果成功保存返回true，否则返回false
+ */
+bool SqliteTransactionStore::appendTransactions(const QVector<Transaction>& transactions, int firstNewIndex)
+{
+    if (firstNewIndex < 0 || firstNewIndex >= transactions.size()) {
+        return true;
+    }
+
+    // 单条记录直接在自动提交模式下插入，多条记录合并为一个事务
+    if (firstNewIndex == transactions.size() - 1) {
+        return insertTransaction(transactions.last());
+    }
+
+    return insertRange(transactions, firstNewIndex);
+}
+
+/**
+ * @brief 删除指定卡号的交易记录
+ * @param cardNumber 卡号
+ * @param remaining 删除后剩余的完整交易记录列表（只读取被改写的记录）
+ * @param rewritten 被改写的记录下标
+ * @return 如果成功删除返回true，否则返回false
+ */
+bool SqliteTransactionStore::removeTransactionsForCard(const QString& cardNumber,
+                                                       const QVector<Transaction>& remaining,
+                                                       const QVector<int>& rewritten)
+{
+    // 没有被改写的记录时直接在自动提交模式下删除
+    if (rewritten.isEmpty()) {
+        return deleteForCard(cardNumber);
+    }
+
+    // 被改写的双边转账记录按编号原地改写，保留 rowid，重新加载时仍在原来的位置（加载按 rowid 排序）；
+    // 改写后的记录不再属于被删除的卡号，必须先改写再按卡号删除，两步放在同一个事务中
+    if (!m_persistenceManager->beginBatch()) {
+        return false;
+    }
+
+    for (int index : rewritten) {
+        if (!updateTransaction(remaining.at(index))) {
+            m_persistenceManager->rollbackBatch();
+            return false;
+        }
+    }
+
+    if (!deleteForCard(cardNumber)) {
+        m_persistenceManager->rollbackBatch();
+        return false;
+    }
+
+    return m_persistenceManager->commitBatch();
+}
+
+/**
+ * @brief 按卡号删除交易记录（不开启事务）
+ * @param cardNumber 卡号
+ * @return 如果成功删除返回true，否则返回false
+ */
+bool SqliteTransactionStore::deleteForCard(const QString& cardNumber)
+{
+    // 按卡号删除命中 (card_number, timestamp_ms) 索引
+    m_deleteForCardQuery.bindValue(":cardNumber", cardNumber);
+    bool success = m_deleteForCardQuery.exec();
+    if (!success) {
+        qWarning() << "删除交易记录失败:" << m_deleteForCardQuery.lastError().text();
+    }
+    m_deleteForCardQuery.finish();
+    return success;
+}
+
+/**
+ * @brief 创建交易表及索引
+ * @return 如果成功创建返回true，否则返回false
+ */
+bool SqliteTransactionStore::createSchema()
+{
+    // 时间戳以 UTC 毫秒整数存储，便于范围查询走索引
+    return m_persistenceManager->execute(
+               "CREATE TABLE IF NOT EXISTS transactions ("
+               "card_number TEXT NOT NULL, "
+               "timestamp_ms INTEGER NOT NULL, "
+               "type INTEGER NOT NULL, "
+               "amount REAL NOT NULL, "
+               "balance_after REAL NOT NULL, "
+               "description TEXT, "
+               "target_card_number TEXT, "
+               "id INTEGER, "
+               "target_balance_after REAL)")
+           && ensureColumn("id", "INTEGER")
+           && ensureColumn("target_balance_after", "REAL")
+           && m_persistenceManager->execute(
+               "CREATE UNIQUE INDEX IF NOT EXISTS idx_transactions_id "
+               "ON transactions (id)")
+           && m_persistenceManager->execute(
+               "CREATE INDEX IF NOT EXISTS idx_transactions_card_time "
+               "ON transactions (card_number, timestamp_ms)")
+           && m_persistenceManager->execute(
+               "CREATE INDEX IF NOT EXISTS idx_transactions_time "
+               "ON transactions (timestamp_ms)");
+}
+
+/**
+ * @brief 插入一条交易记录（不开启事务）
+ * @param transaction 要插入的交易
+ * @return 如果成功插入返回true，否则返回false
+ */
+bool SqliteTransactionStore::insertTransaction(const Transaction& transaction)
+{
+    m_insertQuery.bindValue(":id", transaction.id != 0 ? QVariant(transaction.id) : QVariant());
+    m_insertQuery.bindValue(":cardNumber", transaction.cardNumber);
+    m_insertQuery.bindValue(":timestampMs", transaction.timestamp.toMSecsSinceEpoch());
+    m_insertQuery.bindValue(":type", static_cast<int>(transaction.type));
+    m_insertQuery.bindValue(":amount", transaction.amount);
+    m_insertQuery.bindValue(":balanceAfter", transaction.balanceAfter);
+    m_insertQuery.bindValue(":description", transaction.description);
+    m_insertQuery.bindValue(":targetCardNumber", transaction.targetCardNumber);
+    // 只有双边转账记录有收款方余额，其余记录为 NULL
+    m_insertQuery.bindValue(":targetBalanceAfter",
+                            transaction.hasTargetLeg ? QVariant(transaction.targetBalanceAfter) : QVariant());
+
+    bool success = m_insertQuery.exec();
+    if (!success) {
+        qWarning() << "插入交易记录失败:" << m_insertQuery.lastError().text();
+    }
+    m_insertQuery.finish();
+    return success;
+}
+
+/**
+ * @brief 按交易编号原地改写一条交易记录（不开启事务）
+ * @param transaction 改写后的交易
+ * @return 如果成功改写返回true，否则返回false
+ */
+bool SqliteTransactionStore::updateTransaction(const Transaction& transaction)
+{
+    m_updateQuery.bindValue(":id", transaction.id);
+    m_updateQuery.bindValue(":cardNumber", transaction.cardNumber);
+    m_updateQuery.bindValue(":timestampMs", transaction.timestamp.toMSecsSinceEpoch());
+    m_updateQuery.bindValue(":type", static_cast<int>(transaction.type));
+    m_updateQuery.bindValue(":amount", transaction.amount);
+    m_updateQuery.bindValue(":balanceAfter", transaction.balanceAfter);
+    m_updateQuery.bindValue(":description", transaction.description);
+    m_updateQuery.bindValue(":targetCardNumber", transaction.targetCardNumber);
+    m_updateQuery.bindValue(":targetBalanceAfter",
+                            transaction.hasTargetLeg ? QVariant(transaction.targetBalanceAfter) : QVariant());
+
+    bool success = m_updateQuery.exec();
+    if (!success) {
+        qWarning() << "改写交易记录失败:" << m_updateQuery.lastError().text();
+    } else if (m_updateQuery.numRowsAffected() != 1) {
+        qWarning() << "改写交易记录失败: 找不到交易编号" << transaction.id;
+        success = false;
+    }
+    m_updateQuery.finish();
+    return success;
+}
+
+/**
+ * @brief 在一个事务中插入一段交易记录
+ * @param transactions 交易记录列表
+ * @param from 起始下标
+ * @return 如果全部成功返回true，否则回滚并返回false
+ */
+bool SqliteTransactionStore::insertRange(const QVector<Transaction>& transactions, int from)
+{
+    if (!m_persistenceManager->beginBatch()) {
+        return false;
+    }
+
+    for (int i = from; i < transactions.size(); ++i) {
+        if (!insertTransaction(transactions[i])) {
+            m_persistenceManager->rollbackBatch();
+            return false;
+        }
+    }
+
+    return m_persistenceManager->commitBatch();
+}
+
+/**
+ * @brief 为旧版本创建的交易表补充缺少的列
+ * @param name 列名
+ * @param definition 列定义（类型等）
+ * @return 如果列已存在或成功添加返回true，否则返回false
+ */
+bool SqliteTransactionStore::ensureColumn(const QString& name, const QString& definition)
+{
+    QSqlQuery query(m_persistenceManager->database());
+    if (!query.exec("PRAGMA table_info(transactions)")) {
+        qWarning() << "读取交易表结构失败:" << query.lastError().text();
+        return false;
+    }
+
+    while (query.next()) {
+        if (query.value(1).toString() == name) {
+            return true;
+        }
+    }
+
+    qDebug() << "交易表缺少列" << name << "，正在添加";
+    return m_persistenceManager->execute(QString("ALTER TABLE transactions ADD COLUMN %1 %2").arg(name, definition));
+}
+
+/**
+ * @brief 将补分配的交易编号写回对应的行
+ * @param transactions 已补分配编号的交易记录列表
+ * @param rowIds 每条记录对应的 rowid
+ * @param missing 需要写回的记录下标
+ * @return 如果全部成功返回true，否则回滚并返回false
+ */
+bool SqliteTransactionStore::writeAssignedIds(const QVector<Transaction>& transactions,
+                                              const QVector<qint64>& rowIds, const QVector<int>& missing)
+{
+    if (!m_persistenceManager->beginBatch()) {
+        return false;
+    }
+
+    QSqlQuery update(m_persistenceManager->database());
+    if (!update.prepare("UPDATE transactions SET id = :id WHERE rowid = :rowid")) {
+        qWarning() << "预编译交易编号更新语句失败:" << update.lastError().text();
+        m_persistenceManager->rollbackBatch();
+        return false;
+    }
+
+    for (int index : missing) {
+        update.bindValue(":id", transactions[index].id);
+        update.bindValue(":rowid", rowIds[index]);
+        if (!update.exec()) {
+            qWarning() << "写回交易编号失败:" << update.lastError().text();
+            m_persistenceManager->rollbackBatch();
+            return false;
+        }
+    }
+
+    return m_persistenceManager->commitBatch();
+}
@@ -0,0 +1,127 @@
+/**
+ * @file SqliteTransactionStore.h
+ * @brief SQLite交易存储类
+ *
+ * 使用嵌入式SQLite数据库作为后端存储实现ITransactionStore接口。
+ */
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QSqlQuery>
+#include "ITransactionStore.h"
+#include "SqlitePersistenceManager.h"
+
+/**
+ * @brief SQLite交易存储类
+ *
+ * 交易记录保存在 transactions 表中，并按卡号+时间、时间分别建立索引。
+ * 新增记录只插入新行，多条记录在同一事务中批量提交。
+ */
+class SqliteTransactionStore : public ITransactionStore {
+public:
+    /**
+     * @brief 构造函数
+     * @param persistenceManager SQLite持久化管理器
+     */
+    explicit SqliteTransactionStore(SqlitePersistenceManager* persistenceManager);
+
+    /**
+     * @brief 加载全部交易记录
+     * @param transactions 输出参数，保存读取的交易记录（按写入顺序）
+     * @return 如果表中已有记录返回true，否则返回false
+     */
+    bool loadTransactions(QVector<Transaction>& transactions) override;
+
+    /**
+     * @brief 全量保存交易记录（清空后在一个事务中重新写入）
+     * @param transactions 完整的交易记录列表
+     * @return 如果成功保存返回true，否则返回false
+     */
+    bool saveTransactions(const QVector<Transaction>& transactions) override;
+
+    /**
+     * @brief 追加新交易记录（只插入新行）
+     * @param transactions 完整的交易记录列表
+     * @param firstNewIndex 第一条新记录的下标
+     * @return 如果成功保存返回true，否则返回false
+     */
+    bool appendTransactions(const QVector<Transaction>& transactions, int firstNewIndex) override;
+
+    /**
+     * @brief 删除指定卡号的交易记录
+     * @param cardNumber 卡号
+     * @param remaining 删除后剩余的完整交易记录列表（只读取被改写的记录）
+     * @param rewritten 被改写的记录下标
+     * @return 如果成功删除返回true，否则返回false
+     */
+    bool removeTransactionsForCard(const QString& cardNumber,
+                                   const QVector<Transaction>& remaining,
+                                   const QVector<int>& rewritten) override;
+
+private:
+    /**
+     * @brief 创建交易表及索引
+     * @return 如果成功创建返回true，否则返回false
+     */
+    bool createSchema();
+
+    /**
+     * @brief 为旧版本创建的交易表补充缺少的列
+     * @param name 列名
+     * @param definition 列定义（类型等）
+     * @return 如果列已存在或成功添加返回true，否则返回false
+     */
+    bool ensureColumn(const QString& name, const QString& definition);
+
+    /**
+     * @brief 将补分配的交易编号写回对应的行
+     * @param transactions 已补分配编号的交易记录列表
+     * @param rowIds 每条记录对应的 rowid
+     * @param missing 需要写回的记录下标
+     * @return 如果全部成功返回true，否则回滚并返回false
+     */
+    bool writeAssignedIds(const QVector<Transaction>& transactions,
+                          const QVector<qint64>& rowIds, const QVector<int>& missing);
+
+    /**
+     * @brief 按卡号删除交易记录（不开启事务）
+     * @param cardNumber 卡号
+     * @return 如果成功删除返回true，否则返回false
+     */
+    bool deleteForCard(const QString& cardNumber);
+
+    /**
+     * @brief 插入一条交易记录（不开启事务）
+     * @param transaction 要插入的交易
+     * @return 如果成功插入返回true，否则返回false
+     */
+    bool insertTransaction(const Transaction& transaction);
+
+    /**
+     * @brief 按交易编号原地改写一条交易记录（不开启事务），保留其 rowid 和账本中的位置
+     * @param transaction 改写后的交易
+     * @return 如果成功改写返回true，否则返回false
+     */
+    bool updateTransaction(const Transaction& transaction);
+
+    /**
+     * @brief 在一个事务中插入一段交易记录
+     * @param transactions 交易记录列表
+     * @param from 起始下标
+     * @return 如果全部成功返回true，否则回滚并返回false
+     */
+    bool insertRange(const QVector<Transaction>& transactions, int from);
+
+    //!< SQLite持久化管理器
+    SqlitePersistenceManager* m_persistenceManager;
+
+    //!< 预编译语句：插入交易
+    QSqlQuery m_insertQuery;
+
+    //!< 预编译语句：按卡号删除交易
+    QSqlQuery m_deleteForCardQuery;
+
+    //!< 预编译语句：按交易编号原地改写交易
+    QSqlQuery m_updateQuery;
+};
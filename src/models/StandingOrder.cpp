@@ -0,0 +1,131 @@
+/**
+ * @file StandingOrder.cpp
+ * @brief 定期转账指令实现
+ *
+ * 实现了StandingOrder的执行日计算和JSON编解码方法。
+ */
+#include "StandingOrder.h"
+
+/**
+ * @brief 计算晚于指定日期的下一次执行日
+ * @param date 日期
+ * @return 下一次执行日
+ */
+QDate StandingOrder::nextOccurrenceAfter(const QDate& date) const
+{
+    QDate next = nextRunDate;
+    switch (frequency) {
+    case StandingOrderFrequency::Daily:
+        if (next <= date) {
+            next = date.addDays(1);
+        }
+        break;
+    case StandingOrderFrequency::Weekly:
+        if (next <= date) {
+            next = next.addDays((next.daysTo(date) / 7 + 1) * 7);
+        }
+        break;
+    case StandingOrderFrequency::Monthly:
+        while (next <= date) {
+            const QDate following = QDate(next.year(), next.month(), 1).addMonths(1);
+            next = monthlyDate(following.year(), following.month(), dayOfMonth);
+        }
+        break;
+    }
+    return next;
+}
+
+/**
+ * @brief 计算某月的执行日
+ * @param year 年
+ * @param month 月
+ * @param dayOfMonth 每月执行日
+ * @return 该月的执行日（超出月末时取月末）
+ */
+QDate StandingOrder::monthlyDate(int year, int month, int dayOfMonth)
+{
+    const QDate first(year, month, 1);
+    return QDate(year, month, qBound(1, dayOfMonth, first.daysInMonth()));
+}
+
+/**
+ * @brief 获取周期名称
+ * @param frequency 周期
+ * @return 周期名称
+ */
+QString StandingOrder::frequencyName(StandingOrderFrequency frequency)
+{
+    switch (frequency) {
+    case StandingOrderFrequency::Daily:
+        return "每天";
+    case StandingOrderFrequency::Weekly:
+        return "每周";
+    case StandingOrderFrequency::Monthly:
+        return "每月";
+    }
+    return "未知";
+}
+
+/**
+ * @brief 以流式JSON写入器编码指令
+ * @param writer 写入器
+ */
+void StandingOrder::writeJson(JsonStreamWriter& writer) const
+{
+    // 字段顺序与 QJsonObject 的键名排序一致
+    writer.beginObject();
+    writer.writeDouble("amount", amount);
+    writer.writeInteger("dayOfMonth", dayOfMonth);
+    writer.writeString("description", description);
+    writer.writeInteger("frequency", static_cast<int>(frequency));
+    writer.writeString("fromCardNumber", fromCardNumber);
+    writer.writeString("id", QString::number(id));
+    writer.writeString("lastError", lastError);
+    writer.writeString("lastRunDate", lastRunDate.toString(Qt::ISODate));
+    writer.writeString("nextRunDate", nextRunDate.toString(Qt::ISODate));
+    writer.writeString("toCardNumber", toCardNumber);
+    writer.endObject();
+}
+
+/**
+ * @brief 从流式JSON读取器读取一条指令
+ * @param reader 位于对象起始记号（StartObject）的读取器
+ * @return 读取的指令
+ */
+StandingOrder StandingOrder::readJson(JsonStreamReader& reader)
+{
+    StandingOrder order;
+
+    while (reader.readNext() == JsonStreamReader::Name) {
+        const QByteArrayView key = reader.name();
+        if (reader.readNext() == JsonStreamReader::Invalid) {
+            break;
+        }
+
+        if (key == "id") {
+            order.id = reader.stringValue().toULongLong();
+        } else if (key == "fromCardNumber") {
+            order.fromCardNumber = reader.stringValue();
+        } else if (key == "toCardNumber") {
+            order.toCardNumber = reader.stringValue();
+        } else if (key == "amount") {
+            order.amount = reader.numberValue();
+        } else if (key == "frequency") {
+            order.frequency = static_cast<StandingOrderFrequency>(reader.integerValue());
+        } else if (key == "dayOfMonth") {
+            order.dayOfMonth = int(reader.integerValue());
+        } else if (key == "nextRunDate") {
+            order.nextRunDate = QDate::fromString(reader.stringValue(), Qt::ISODate);
+        } else if (key == "lastRunDate") {
+            order.lastRunDate = QDate::fromString(reader.stringValue(), Qt::ISODate);
+        } else if (key == "lastError") {
+            order.lastError = reader.stringValue();
+        } else if (key == "description") {
+            order.description = reader.stringValue();
+        } else {
+            reader.skipCurrentValue();
+        }
+    }
+
+    return order;
+}
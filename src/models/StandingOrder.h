@@ -0,0 +1,79 @@
+/**
+ * @file StandingOrder.h
+ * @brief 定期转账指令
+ *
+ * 定义了定期转账指令（如房租、工资分配）的数据结构及其执行日期的计算方法。
+ */
+#pragma once
+
+#include <QDate>
+#include <QString>
+#include "JsonStreamWriter.h"
+#include "JsonStreamReader.h"
+
+/**
+ * @brief 定期转账的周期
+ */
+enum class StandingOrderFrequency {
+    Daily = 0,      //!< 每天
+    Weekly = 1,     //!< 每周（与首次执行日同一星期几）
+    Monthly = 2     //!< 每月（dayOfMonth 日，该月没有这一天时在月末执行）
+};
+
+/**
+ * @brief 定期转账指令
+ *
+ * 在 nextRunDate 当天（本地时间零点之后）从 fromCardNumber 向 toCardNumber 转账 amount，
+ * 执行后按周期计算下一次执行日。
+ */
+struct StandingOrder {
+    quint64 id = 0;                     //!< 指令编号
+    QString fromCardNumber;             //!< 付款卡号
+    QString toCardNumber;               //!< 收款卡号
+    double amount = 0.0;                //!< 每次转账金额
+    StandingOrderFrequency frequency = StandingOrderFrequency::Monthly; //!< 周期
+    int dayOfMonth = 1;                 //!< 每月执行日（1-31，仅每月周期使用）
+    QDate nextRunDate;                  //!< 下一次执行日
+    QDate lastRunDate;                  //!< 上一次执行日，未执行过时无效
+    QString lastError;                  //!< 上一次执行失败的原因，成功时为空
+    QString description;                //!< 付款方一侧的交易描述，为空时使用默认描述
+
+    /**
+     * @brief 计算晚于指定日期的下一次执行日
+     *
+     * 从 nextRunDate 起按周期递推，跳过不晚于 date 的日期。
+     *
+     * @param date 日期
+     * @return 下一次执行日
+     */
+    QDate nextOccurrenceAfter(const QDate& date) const;
+
+    /**
+     * @brief 计算某月的执行日
+     * @param year 年
+     * @param month 月
+     * @param dayOfMonth 每月执行日
+     * @return 该月的执行日（超出月末时取月末）
+     */
+    static QDate monthlyDate(int year, int month, int dayOfMonth);
+
+    /**
+     * @brief 获取周期名称
+     * @param frequency 周期
+     * @return 周期名称
+     */
+    static QString frequencyName(StandingOrderFrequency frequency);
+
+    /**
+     * @brief 以流式JSON写入器编码指令
+     * @param writer 写入器
+     */
+    void writeJson(JsonStreamWriter& writer) const;
+
+    /**
+     * @brief 从流式JSON读取器读取一条指令
+     * @param reader 位于对象起始记号（StartObject）的读取器
+     * @return 读取的指令
+     */
+    static StandingOrder readJson(JsonStreamReader& reader);
+};
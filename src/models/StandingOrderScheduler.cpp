@@ -0,0 +1,424 @@
+/**
+ * @file StandingOrderScheduler.cpp
+ * @brief 定期转账调度器实现
+ *
+ * 实现了StandingOrderScheduler类中定义的指令管理、到期执行和持久化方法。
+ */
+#include "StandingOrderScheduler.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <algorithm>
+
+namespace {
+
+//!< 时间轮一个刻度的长度（毫秒）
+const qint64 kTickMs = 60 * 1000;
+
+//!< 默认每批执行的指令数
+const int kDefaultBatchSize = 500;
+
+} // namespace
+
+QString StandingOrderRunReport::summary() const
+{
+    return QString("定期转账: 到期 %1 条, 成功 %2 条, 失败 %3 条, 共 %4 批, 耗时 %5 ms")
+        .arg(dueOrders)
+        .arg(executed)
+        .arg(failed)
+        .arg(batches)
+        .arg(elapsedMs);
+}
+
+/**
+ * @brief 构造函数
+ * @param accountService 账户服务
+ * @param persistenceManager JSON持久化管理器，为空时自行创建
+ * @param filename 指令数据文件名
+ */
+StandingOrderScheduler::StandingOrderScheduler(AccountService* accountService,
+                                               JsonPersistenceManager* persistenceManager,
+                                               const QString& filename)
+    : m_accountService(accountService)
+    , m_persistenceManager(persistenceManager)
+    , m_filename(filename)
+    , m_clock(Clock::system())
+{
+    Q_ASSERT(accountService != nullptr);
+
+    if (!m_persistenceManager) {
+        m_ownedPersistenceManager = std::make_unique<JsonPersistenceManager>();
+        m_persistenceManager = m_ownedPersistenceManager.get();
+    }
+
+    if (!loadOrders()) {
+        rebuildSchedule();
+    }
+}
+
+/**
+ * @brief 析构函数
+ *
+ * 每次修改都已立即保存，这里无需再写文件。
+ */
+StandingOrderScheduler::~StandingOrderScheduler() = default;
+
+/**
+ * @brief 设置时间来源，并按新的当前时间重建时间轮
+ * @param clock 时钟，为空时使用系统时钟
+ */
+void StandingOrderScheduler::setClock(const Clock* clock)
+{
+    m_clock = clock ? clock : Clock::system();
+    rebuildSchedule();
+}
+
+/**
+ * @brief 添加指令
+ * @param order 指令
+ * @return 操作结果
+ */
+OperationResult StandingOrderScheduler::addOrder(StandingOrder& order)
+{
+    if (order.fromCardNumber.isEmpty()) {
+        return OperationResult::Failure("请先登录");
+    }
+    if (order.amount <= 0) {
+        return OperationResult::Failure("转账金额必须为正数");
+    }
+    if (order.fromCardNumber == order.toCardNumber) {
+        return OperationResult::Failure("源卡号和目标卡号不能相同");
+    }
+    if (order.frequency == StandingOrderFrequency::Monthly && (order.dayOfMonth < 1 || order.dayOfMonth > 31)) {
+        return OperationResult::Failure("每月执行日必须在 1 到 31 之间");
+    }
+    OperationResult targetResult = m_accountService->validateTargetAccount(order.toCardNumber);
+    if (!targetResult.success) {
+        return targetResult;
+    }
+
+    // 未指定首次执行日时从今天起取第一个符合周期的日期
+    const QDate today = m_clock->today();
+    if (!order.nextRunDate.isValid()) {
+        order.nextRunDate = today;
+        if (order.frequency == StandingOrderFrequency::Monthly) {
+            order.nextRunDate = StandingOrder::monthlyDate(today.year(), today.month(), order.dayOfMonth);
+            if (order.nextRunDate < today) {
+                order.nextRunDate = order.nextOccurrenceAfter(today);
+            }
+        }
+    } else if (order.nextRunDate < today) {
+        return OperationResult::Failure("首次执行日不能早于今天");
+    }
+
+    order.id = m_nextId++;
+    order.lastRunDate = QDate();
+    order.lastError.clear();
+    m_orders.insert(order.id, order);
+    m_cardOrders[order.fromCardNumber].append(order.id);
+
+    if (!saveOrders()) {
+        m_orders.remove(order.id);
+        m_cardOrders[order.fromCardNumber].removeOne(order.id);
+        return OperationResult::Failure("保存定期转账指令失败");
+    }
+    m_wheel.schedule(order.id, dueTick(order.nextRunDate));
+
+    qDebug() << "定期转账指令已添加:" << order.id << order.fromCardNumber << "->" << order.toCardNumber
+             << StandingOrder::frequencyName(order.frequency) << "金额:" << order.amount
+             << "首次执行:" << order.nextRunDate;
+    return OperationResult::Success();
+}
+
+/**
+ * @brief 取消指令
+ * @param id 指令编号
+ * @param cardNumber 操作者卡号，非空时只能取消该卡付款的指令
+ * @return 操作结果
+ */
+OperationResult StandingOrderScheduler::cancelOrder(quint64 id, const QString& cardNumber)
+{
+    auto it = m_orders.find(id);
+    if (it == m_orders.end()) {
+        return OperationResult::Failure("定期转账指令不存在");
+    }
+    if (!cardNumber.isEmpty() && it->fromCardNumber != cardNumber) {
+        return OperationResult::Failure("无权取消该定期转账指令");
+    }
+
+    const StandingOrder order = it.value();
+    m_orders.erase(it);
+    m_cardOrders[order.fromCardNumber].removeOne(id);
+    if (m_cardOrders[order.fromCardNumber].isEmpty()) {
+        m_cardOrders.remove(order.fromCardNumber);
+    }
+
+    if (!saveOrders()) {
+        m_orders.insert(id, order);
+        m_cardOrders[order.fromCardNumber].append(id);
+        return OperationResult::Failure("保存定期转账指令失败");
+    }
+    m_wheel.cancel(id);
+
+    qDebug() << "定期转账指令已取消:" << id;
+    return OperationResult::Success();
+}
+
+/**
+ * @brief 取消付款或收款涉及某卡的全部指令
+ * @param cardNumber 卡号
+ * @return 取消的指令数
+ */
+int StandingOrderScheduler::cancelOrdersForCard(const QString& cardNumber)
+{
+    // 收款卡号没有索引；删除账户很少发生，直接扫描全部指令
+    QVector<quint64> ids = m_cardOrders.value(cardNumber);
+    for (auto it = m_orders.constBegin(); it != m_orders.constEnd(); ++it) {
+        if (it->toCardNumber == cardNumber) {
+            ids.append(it.key());
+        }
+    }
+    if (ids.isEmpty()) {
+        return 0;
+    }
+
+    for (quint64 id : std::as_const(ids)) {
+        removeOrder(id);
+    }
+    // 账户已经删除，保存失败时仍以内存为准，下次保存时一并写入
+    if (!saveOrders()) {
+        qWarning() << "保存定期转账指令失败，已取消的指令将在下次保存时写入";
+    }
+
+    qDebug() << "账户" << cardNumber << "已删除，取消定期转账指令" << ids.size() << "条";
+    return ids.size();
+}
+
+/**
+ * @brief 查找指令
+ * @param id 指令编号
+ * @return 指令，不存在时为空
+ */
+std::optional<StandingOrder> StandingOrderScheduler::findOrder(quint64 id) const
+{
+    auto it = m_orders.constFind(id);
+    if (it == m_orders.constEnd()) {
+        return std::nullopt;
+    }
+    return it.value();
+}
+
+/**
+ * @brief 获取某卡付款的全部指令
+ * @param cardNumber 付款卡号
+ * @return 指令列表（按编号排列）
+ */
+QVector<StandingOrder> StandingOrderScheduler::ordersForCard(const QString& cardNumber) const
+{
+    QVector<quint64> ids = m_cardOrders.value(cardNumber);
+    std::sort(ids.begin(), ids.end());
+
+    QVector<StandingOrder> orders;
+    orders.reserve(ids.size());
+    for (quint64 id : std::as_const(ids)) {
+        orders.append(m_orders.value(id));
+    }
+    return orders;
+}
+
+/**
+ * @brief 执行全部到期的指令
+ * @param batchSize 每批的指令数，不大于0时使用默认值
+ * @return 执行结果
+ */
+StandingOrderRunReport StandingOrderScheduler::runDueOrders(int batchSize)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    StandingOrderRunReport report;
+    const QVector<quint64> due = m_wheel.advance(m_clock->utcMs() / kTickMs);
+    report.dueOrders = due.size();
+    if (due.isEmpty()) {
+        return report;
+    }
+
+    const QDate today = m_clock->today();
+    const int size = batchSize > 0 ? batchSize : kDefaultBatchSize;
+    for (int begin = 0; begin < due.size(); begin += size) {
+        const int end = qMin(int(due.size()), begin + size);
+
+        QVector<quint64> ids;
+        QVector<StandingOrder> before;
+        QVector<TransferRequest> requests;
+        for (int i = begin; i < end; ++i) {
+            auto it = m_orders.find(due.at(i));
+            if (it == m_orders.end()) {
+                continue;
+            }
+            StandingOrder& order = it.value();
+            if (order.nextRunDate < today) {
+                qWarning() << "定期转账指令" << order.id << "错过了" << order.nextRunDate << "的执行，今天补执行一次";
+            }
+
+            ids.append(order.id);
+            before.append(order);
+            requests.append(TransferRequest{
+                order.fromCardNumber,
+                order.toCardNumber,
+                order.amount,
+                order.description.isEmpty() ? QString("定期转账 #%1").arg(order.id) : order.description
+            });
+            order.lastRunDate = today;
+            order.nextRunDate = order.nextOccurrenceAfter(today);
+        }
+        if (ids.isEmpty()) {
+            continue;
+        }
+
+        // 先保存下一次执行日再转账：保存失败时放弃本批，下次运行重试
+        if (!saveOrders()) {
+            qWarning() << "保存定期转账指令失败，本批" << ids.size() << "条指令推迟执行";
+            for (int k = 0; k < ids.size(); ++k) {
+                m_orders[ids.at(k)] = before.at(k);
+                m_wheel.schedule(ids.at(k), dueTick(before.at(k).nextRunDate));
+            }
+            for (int i = end; i < due.size(); ++i) {
+                if (m_orders.contains(due.at(i))) {
+                    m_wheel.schedule(due.at(i), dueTick(m_orders.value(due.at(i)).nextRunDate));
+                }
+            }
+            break;
+        }
+
+        const QVector<OperationResult> results = m_accountService->transferBatch(requests);
+        ++report.batches;
+
+        for (int k = 0; k < ids.size(); ++k) {
+            StandingOrder& order = m_orders[ids.at(k)];
+            if (results.at(k).success) {
+                ++report.executed;
+                order.lastError.clear();
+            } else if (!m_accountService->accountExists(order.fromCardNumber)
+                       || !m_accountService->accountExists(order.toCardNumber)) {
+                // 账户已删除的指令永远不会成功，直接移除，不再每期重试
+                ++report.failed;
+                qWarning() << "定期转账指令" << order.id << "的账户已不存在，移除该指令";
+                removeOrder(ids.at(k));
+                continue;
+            } else {
+                ++report.failed;
+                order.lastError = results.at(k).errorMessage;
+                qWarning() << "定期转账指令" << order.id << "执行失败:" << order.lastError;
+            }
+            m_wheel.schedule(order.id, dueTick(order.nextRunDate));
+        }
+    }
+
+    // 记录本次执行的失败原因
+    if (report.batches > 0) {
+        saveOrders();
+    }
+
+    report.elapsedMs = timer.elapsed();
+    qDebug() << report.summary();
+    return report;
+}
+
+/**
+ * @brief 从文件加载指令并重建时间轮
+ * @return 如果成功加载返回true；文件不存在时返回false
+ */
+bool StandingOrderScheduler::loadOrders()
+{
+    QVector<QVector<StandingOrder>> chunks;
+
+    bool success = m_persistenceManager->loadRecordChunks(m_filename, FORMAT_NAME,
+        [&chunks](int version, int chunkCount) {
+            if (version != FORMAT_VERSION) {
+                return false;
+            }
+            chunks.resize(chunkCount);
+            return true;
+        },
+        [&chunks](int chunk, JsonStreamReader& reader) {
+            chunks[chunk].append(StandingOrder::readJson(reader));
+            return true;
+        });
+    if (!success) {
+        return false;
+    }
+
+    m_orders.clear();
+    m_cardOrders.clear();
+    m_nextId = 1;
+    for (const auto& chunk : std::as_const(chunks)) {
+        for (const StandingOrder& order : chunk) {
+            m_orders.insert(order.id, order);
+            m_cardOrders[order.fromCardNumber].append(order.id);
+            m_nextId = qMax(m_nextId, order.id + 1);
+        }
+    }
+
+    rebuildSchedule();
+    qDebug() << "已加载定期转账指令:" << m_orders.size() << "条";
+    return true;
+}
+
+/**
+ * @brief 把全部指令保存到文件
+ * @return 如果成功保存返回true，否则返回false
+ */
+bool StandingOrderScheduler::saveOrders()
+{
+    return m_persistenceManager->saveRecords(m_filename, FORMAT_NAME, FORMAT_VERSION,
+        [this](JsonStreamWriter& writer) {
+            for (const StandingOrder& order : std::as_const(m_orders)) {
+                order.writeJson(writer);
+            }
+        });
+}
+
+/**
+ * @brief 计算执行日对应的时间轮刻度
+ * @param date 执行日
+ * @return 刻度（本地零点的UTC分钟数）
+ */
+qint64 StandingOrderScheduler::dueTick(const QDate& date)
+{
+    return QDateTime(date, QTime(0, 0)).toMSecsSinceEpoch() / kTickMs;
+}
+
+/**
+ * @brief 按当前时间重建时间轮
+ */
+void StandingOrderScheduler::rebuildSchedule()
+{
+    m_wheel.reset(m_clock->utcMs() / kTickMs);
+    for (auto it = m_orders.constBegin(); it != m_orders.constEnd(); ++it) {
+        m_wheel.schedule(it.key(), dueTick(it->nextRunDate));
+    }
+}
+
+/**
+ * @brief 从内存和时间轮中移除指令（不保存文件）
+ * @param id 指令编号
+ */
+void StandingOrderScheduler::removeOrder(quint64 id)
+{
+    auto it = m_orders.find(id);
+    if (it == m_orders.end()) {
+        return;
+    }
+    const QString fromCardNumber = it->fromCardNumber;
+    m_orders.erase(it);
+    m_wheel.cancel(id);
+
+    auto cardIt = m_cardOrders.find(fromCardNumber);
+    if (cardIt != m_cardOrders.end()) {
+        cardIt->removeOne(id);
+        if (cardIt->isEmpty()) {
+            m_cardOrders.erase(cardIt);
+        }
+    }
+}
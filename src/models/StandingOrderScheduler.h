@@ -0,0 +1,195 @@
+/**
+ * @file StandingOrderScheduler.h
+ * @brief 定期转账调度器
+ *
+ * 保存定期转账指令，用分层时间轮按执行时间排队，并通过账户服务分批执行到期的转账。
+ */
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <memory>
+#include <optional>
+#include "StandingOrder.h"
+#include "TimerWheel.h"
+#include "AccountService.h"
+#include "JsonPersistenceManager.h"
+#include "Clock.h"
+#include "OperationResult.h"
+
+/**
+ * @brief 一次执行到期指令的结果
+ */
+struct StandingOrderRunReport {
+    int dueOrders = 0;      //!< 到期的指令数
+    int executed = 0;       //!< 转账成功的指令数
+    int failed = 0;         //!< 转账失败的指令数
+    int batches = 0;        //!< 提交的批次数
+    qint64 elapsedMs = 0;   //!< 耗时（毫秒）
+
+    /**
+     * @brief 生成一行摘要
+     * @return 摘要文本
+     */
+    QString summary() const;
+};
+
+/**
+ * @brief 定期转账调度器
+ *
+ * 每条指令以下一次执行日的本地零点（按分钟取整）作为到期刻度放入时间轮，
+ * 添加和取消都是 O(1)；runDueOrders() 只取出已到期的指令，与指令总数无关。
+ * 到期的指令按批交给 AccountService::transferBatch()，每批的账户余额和交易记录各提交一次。
+ *
+ * 每批执行前先把这些指令的下一次执行日写入存储，即使执行中途退出，
+ * 同一次执行也不会在重启后重复转账（宁可漏付，不重复付款）。
+ * 停机期间错过多次执行时只补执行一次。付款或收款账户已删除的指令在删除账户时一并取消，
+ * 遗留的此类指令在下次到期失败时移除。
+ */
+class StandingOrderScheduler {
+public:
+    //!< 文件头中的格式名称
+    static constexpr const char* FORMAT_NAME = "atm-standing-orders";
+
+    //!< 当前文件格式版本
+    static const int FORMAT_VERSION = 1;
+
+    /**
+     * @brief 构造函数
+     *
+     * 构造时从文件加载已有的指令。
+     *
+     * @param accountService 账户服务
+     * @param persistenceManager JSON持久化管理器，为空时自行创建（使用默认数据目录，
+     *                           仅供未指定数据目录的场合；应用启动时应传入数据目录的管理器）
+     * @param filename 指令数据文件名
+     */
+    explicit StandingOrderScheduler(AccountService* accountService,
+                                    JsonPersistenceManager* persistenceManager = nullptr,
+                                    const QString& filename = "standing_orders.json");
+
+    /**
+     * @brief 析构函数
+     */
+    ~StandingOrderScheduler();
+
+    /**
+     * @brief 设置时间来源，并按新的当前时间重建时间轮
+     * @param clock 时钟，为空时使用系统时钟
+     */
+    void setClock(const Clock* clock);
+
+    /**
+     * @brief 添加指令
+     *
+     * 成功时为 order 分配指令编号；未指定首次执行日时取下一个符合周期的日期。
+     *
+     * @param order 指令
+     * @return 操作结果
+     */
+    OperationResult addOrder(StandingOrder& order);
+
+    /**
+     * @brief 取消指令
+     * @param id 指令编号
+     * @param cardNumber 操作者卡号，非空时只能取消该卡付款的指令
+     * @return 操作结果
+     */
+    OperationResult cancelOrder(quint64 id, const QString& cardNumber = QString());
+
+    /**
+     * @brief 取消付款或收款涉及某卡的全部指令
+     *
+     * 删除账户后调用，否则这些指令以后每次到期都会失败。
+     *
+     * @param cardNumber 卡号
+     * @return 取消的指令数
+     */
+    int cancelOrdersForCard(const QString& cardNumber);
+
+    /**
+     * @brief 查找指令
+     * @param id 指令编号
+     * @return 指令，不存在时为空
+     */
+    std::optional<StandingOrder> findOrder(quint64 id) const;
+
+    /**
+     * @brief 获取某卡付款的全部指令
+     * @param cardNumber 付款卡号
+     * @return 指令列表（按编号排列）
+     */
+    QVector<StandingOrder> ordersForCard(const QString& cardNumber) const;
+
+    /**
+     * @brief 获取指令总数
+     * @return 指令数
+     */
+    int orderCount() const { return m_orders.size(); }
+
+    /**
+     * @brief 执行全部到期的指令
+     * @param batchSize 每批的指令数，不大于0时使用默认值
+     * @return 执行结果
+     */
+    StandingOrderRunReport runDueOrders(int batchSize = 0);
+
+    /**
+     * @brief 从文件加载指令并重建时间轮
+     * @return 如果成功加载返回true；文件不存在时返回false
+     */
+    bool loadOrders();
+
+    /**
+     * @brief 把全部指令保存到文件
+     * @return 如果成功保存返回true，否则返回false
+     */
+    bool saveOrders();
+
+private:
+    /**
+     * @brief 计算执行日对应的时间轮刻度
+     * @param date 执行日
+     * @return 刻度（本地零点的UTC分钟数）
+     */
+    static qint64 dueTick(const QDate& date);
+
+    /**
+     * @brief 按当前时间重建时间轮
+     */
+    void rebuildSchedule();
+
+    /**
+     * @brief 从内存和时间轮中移除指令（不保存文件）
+     * @param id 指令编号
+     */
+    void removeOrder(quint64 id);
+
+    //!< 账户服务
+    AccountService* m_accountService;
+
+    //!< JSON持久化管理器
+    JsonPersistenceManager* m_persistenceManager;
+
+    //!< 自行创建的持久化管理器（未注入时）
+    std::unique_ptr<JsonPersistenceManager> m_ownedPersistenceManager;
+
+    //!< 指令数据文件名
+    QString m_filename;
+
+    //!< 时间来源
+    const Clock* m_clock;
+
+    //!< 指令编号到指令
+    QHash<quint64, StandingOrder> m_orders;
+
+    //!< 付款卡号到指令编号
+    QHash<QString, QVector<quint64>> m_cardOrders;
+
+    //!< 按执行时间排队的指令编号
+    TimerWheel m_wheel;
+
+    //!< 下一个指令编号
+    quint64 m_nextId = 1;
+};
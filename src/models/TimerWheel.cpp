@@ -0,0 +1,160 @@
+/**
+ * @file TimerWheel.cpp
+ * @brief 分层时间轮实现
+ *
+ * 实现了TimerWheel类中定义的放置、下放和推进方法。
+ */
+#include "TimerWheel.h"
+#include <QtAlgorithms>
+#include <algorithm>
+
+/**
+ * @brief 构造函数
+ * @param currentTick 当前刻度
+ */
+TimerWheel::TimerWheel(qint64 currentTick)
+{
+    reset(currentTick);
+}
+
+/**
+ * @brief 清空全部定时器并设置当前刻度
+ * @param currentTick 当前刻度
+ */
+void TimerWheel::reset(qint64 currentTick)
+{
+    m_currentTick = currentTick;
+    m_slots = QVector<QVector<Timer>>(LEVELS * SLOTS);
+    m_overflow.clear();
+    m_ready.clear();
+    m_dueTicks.clear();
+}
+
+/**
+ * @brief 添加定时器（已存在时改期）
+ * @param id 定时器编号
+ * @param dueTick 到期刻度
+ */
+void TimerWheel::schedule(quint64 id, qint64 dueTick)
+{
+    // 旧的槽位项留在原处，推进到时发现到期刻度不符即丢弃
+    m_dueTicks.insert(id, dueTick);
+    place(Timer{id, dueTick});
+}
+
+/**
+ * @brief 取消定时器
+ * @param id 定时器编号
+ * @return 定时器存在时返回true
+ */
+bool TimerWheel::cancel(quint64 id)
+{
+    return m_dueTicks.remove(id) > 0;
+}
+
+/**
+ * @brief 推进到指定刻度并取出到期的定时器
+ * @param toTick 目标刻度
+ * @return 到期的定时器编号（按到期刻度排列）
+ */
+QVector<quint64> TimerWheel::advance(qint64 toTick)
+{
+    QVector<quint64> fired;
+
+    // 已到期的定时器按添加顺序排列，先按到期刻度排序
+    std::stable_sort(m_ready.begin(), m_ready.end(), [](const Timer& a, const Timer& b) {
+        return a.dueTick < b.dueTick;
+    });
+    fire(m_ready, fired);
+
+    const qint64 overflowSpan = qint64(1) << (SLOT_BITS * LEVELS);
+    while (m_currentTick < toTick) {
+        // 没有定时器时直接跳到目标刻度，槽位中只剩已取消的旧项
+        if (m_dueTicks.isEmpty()) {
+            reset(toTick);
+            break;
+        }
+
+        ++m_currentTick;
+
+        // 从高层到低层依次下放：高层下放的定时器可能落入本刻度同时回绕的低层槽位
+        if ((m_currentTick & (overflowSpan - 1)) == 0) {
+            cascade(m_overflow);
+        }
+        for (int level = LEVELS - 1; level >= 1; --level) {
+            const qint64 levelSpan = qint64(1) << (SLOT_BITS * level);
+            if ((m_currentTick & (levelSpan - 1)) == 0) {
+                cascade(slot(level, m_currentTick));
+            }
+        }
+
+        fire(m_ready, fired);
+        fire(slot(0, m_currentTick), fired);
+    }
+    return fired;
+}
+
+/**
+ * @brief 按到期刻度放入对应的层和槽位
+ * @param timer 定时器
+ */
+void TimerWheel::place(const Timer& timer)
+{
+    if (timer.dueTick <= m_currentTick) {
+        m_ready.append(timer);
+        return;
+    }
+
+    // 与当前刻度最高的不同位决定层：更高的位相同，说明在该层当前这一圈之内
+    const quint64 diff = quint64(timer.dueTick) ^ quint64(m_currentTick);
+    const int level = (63 - qCountLeadingZeroBits(diff)) / SLOT_BITS;
+    if (level >= LEVELS) {
+        m_overflow.append(timer);
+    } else {
+        slot(level, timer.dueTick).append(timer);
+    }
+}
+
+/**
+ * @brief 把槽位中的有效定时器重新放置到更低的层
+ * @param timers 槽位（处理后清空）
+ */
+void TimerWheel::cascade(QVector<Timer>& timers)
+{
+    QVector<Timer> pending;
+    pending.swap(timers);
+    for (const Timer& timer : std::as_const(pending)) {
+        auto it = m_dueTicks.constFind(timer.id);
+        if (it != m_dueTicks.constEnd() && it.value() == timer.dueTick) {
+            place(timer);
+        }
+    }
+}
+
+/**
+ * @brief 取出槽位中仍然有效的定时器
+ * @param timers 槽位（处理后清空）
+ * @param fired 输出参数，追加到期的定时器编号
+ */
+void TimerWheel::fire(QVector<Timer>& timers, QVector<quint64>& fired)
+{
+    for (const Timer& timer : std::as_const(timers)) {
+        auto it = m_dueTicks.find(timer.id);
+        if (it != m_dueTicks.end() && it.value() == timer.dueTick) {
+            fired.append(timer.id);
+            m_dueTicks.erase(it);
+        }
+    }
+    timers.clear();
+}
+
+/**
+ * @brief 获取槽位
+ * @param level 层
+ * @param tick 刻度
+ * @return 刻度在该层对应的槽位
+ */
+QVector<TimerWheel::Timer>& TimerWheel::slot(int level, qint64 tick)
+{
+    return m_slots[level * SLOTS + int((tick >> (SLOT_BITS * level)) & (SLOTS - 1))];
+}
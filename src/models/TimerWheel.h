@@ -0,0 +1,139 @@
+/**
+ * @file TimerWheel.h
+ * @brief 分层时间轮
+ *
+ * 定义了按到期刻度触发定时器的分层时间轮，添加、取消定时器都是 O(1)，
+ * 推进时只处理到期的槽位，与定时器总数无关。
+ */
+#pragma once
+
+#include <QHash>
+#include <QVector>
+
+/**
+ * @brief 分层时间轮
+ *
+ * 共 LEVELS 层，每层 SLOTS 个槽位。第 k 层的一个槽位覆盖 SLOTS^k 个刻度：
+ * 定时器按到期刻度与当前刻度最高的不同位所在的层放入对应槽位，当前刻度走到
+ * 该槽位覆盖的范围起点时再下放到更低的层，最终在第 0 层到期。
+ * 超出最高层范围的定时器先放在溢出列表中，最高层回绕时重新放置。
+ *
+ * 取消或改期时只更新到期表，槽位中的旧项在推进到时按到期表核对后丢弃。
+ */
+class TimerWheel {
+public:
+    //!< 层数
+    static const int LEVELS = 4;
+
+    //!< 每层槽位数的位数
+    static const int SLOT_BITS = 6;
+
+    //!< 每层槽位数
+    static const int SLOTS = 1 << SLOT_BITS;
+
+    /**
+     * @brief 构造函数
+     * @param currentTick 当前刻度
+     */
+    explicit TimerWheel(qint64 currentTick = 0);
+
+    /**
+     * @brief 清空全部定时器并设置当前刻度
+     * @param currentTick 当前刻度
+     */
+    void reset(qint64 currentTick);
+
+    /**
+     * @brief 添加定时器（已存在时改期）
+     *
+     * 到期刻度不晚于当前刻度的定时器在下一次 advance() 时立即触发。
+     *
+     * @param id 定时器编号
+     * @param dueTick 到期刻度
+     */
+    void schedule(quint64 id, qint64 dueTick);
+
+    /**
+     * @brief 取消定时器
+     * @param id 定时器编号
+     * @return 定时器存在时返回true
+     */
+    bool cancel(quint64 id);
+
+    /**
+     * @brief 检查定时器是否存在
+     * @param id 定时器编号
+     * @return 存在时返回true
+     */
+    bool contains(quint64 id) const { return m_dueTicks.contains(id); }
+
+    /**
+     * @brief 获取未触发的定时器数
+     * @return 定时器数
+     */
+    int size() const { return m_dueTicks.size(); }
+
+    /**
+     * @brief 获取当前刻度
+     * @return 当前刻度
+     */
+    qint64 currentTick() const { return m_currentTick; }
+
+    /**
+     * @brief 推进到指定刻度并取出到期的定时器
+     * @param toTick 目标刻度，早于当前刻度时只取出已到期的定时器
+     * @return 到期的定时器编号（按到期刻度排列）
+     */
+    QVector<quint64> advance(qint64 toTick);
+
+private:
+    /**
+     * @brief 槽位中的一项
+     */
+    struct Timer {
+        quint64 id;         //!< 定时器编号
+        qint64 dueTick;     //!< 放入时的到期刻度
+    };
+
+    /**
+     * @brief 按到期刻度放入对应的层和槽位
+     * @param timer 定时器
+     */
+    void place(const Timer& timer);
+
+    /**
+     * @brief 把槽位中的有效定时器重新放置到更低的层
+     * @param timers 槽位（处理后清空）
+     */
+    void cascade(QVector<Timer>& timers);
+
+    /**
+     * @brief 取出槽位中仍然有效的定时器
+     * @param timers 槽位（处理后清空）
+     * @param fired 输出参数，追加到期的定时器编号
+     */
+    void fire(QVector<Timer>& timers, QVector<quint64>& fired);
+
+    /**
+     * @brief 获取槽位
+     * @param level 层
+     * @param tick 刻度
+     * @return 刻度在该层对应的槽位
+     */
+    QVector<Timer>& slot(int level, qint64 tick);
+
+    //!< 当前刻度
+    qint64 m_currentTick;
+
+    //!< 各层槽位（LEVELS * SLOTS 个）
+    QVector<QVector<Timer>> m_slots;
+
+    //!< 超出最高层范围的定时器
+    QVector<Timer> m_overflow;
+
+    //!< 已到期但尚未取出的定时器
+    QVector<Timer> m_ready;
+
+    //!< 有效定时器的到期刻度
+    QHash<quint64, qint64> m_dueTicks;
+};
@@ -0,0 +1,93 @@
+/**
+ * @file Transaction.cpp
+ * @brief 交易数据实体实现
+ *
+ * 实现了Transaction结构体的流式JSON读写方法。
+ */
+#include "Transaction.h"
+#include "JsonStreamWriter.h"
+#include "JsonStreamReader.h"
+
+/**
+ * @brief 生成双边转账记录在收款方一侧的视图
+ * @return 收款方一侧的交易
+ */
+Transaction Transaction::incomingLeg() const
+{
+    Transaction leg = *this;
+    leg.cardNumber = targetCardNumber;
+    leg.type = TransactionType::TransferIn;
+    leg.balanceAfter = targetBalanceAfter;
+    leg.description = QString("来自尾号 %1 的转账").arg(cardNumber.right(4));
+    leg.targetCardNumber = cardNumber;
+    leg.hasTargetLeg = false;
+    leg.targetBalanceAfter = 0.0;
+    return leg;
+}
+
+/**
+ * @brief 将交易直接写入流式JSON写入器
+ * @param writer 流式JSON写入器
+ */
+void Transaction::writeJson(JsonStreamWriter &writer) const
+{
+    // 字段顺序必须与 QJsonObject 的键名排序一致
+    writer.beginObject();
+    writer.writeDouble("amount", amount);
+    writer.writeDouble("balanceAfter", balanceAfter);
+    writer.writeString("cardNumber", cardNumber);
+    writer.writeString("description", description);
+    writer.writeString("id", QString::number(id));
+    if (hasTargetLeg) {
+        writer.writeDouble("targetBalanceAfter", targetBalanceAfter);
+    }
+    writer.writeString("targetCardNumber", targetCardNumber);
+    writer.writeString("timestamp", timestamp.toString(Qt::ISODate));
+    writer.writeInteger("type", static_cast<int>(type));
+    writer.endObject();
+}
+
+/**
+ * @brief 从流式JSON读取器读取一条交易
+ * @param reader 位于对象起始记号（StartObject）的读取器
+ * @return 创建的 Transaction 对象
+ */
+Transaction Transaction::readJson(JsonStreamReader &reader)
+{
+    Transaction transaction;
+    transaction.type = TransactionType::Other;
+    transaction.amount = 0.0;
+    transaction.balanceAfter = 0.0;
+
+    while (reader.readNext() == JsonStreamReader::Name) {
+        const QByteArrayView key = reader.name();
+        if (reader.readNext() == JsonStreamReader::Invalid) {
+            break;
+        }
+
+        if (key == "id") {
+            transaction.id = reader.stringValue().toULongLong();
+        } else if (key == "cardNumber") {
+            transaction.cardNumber = reader.stringValue();
+        } else if (key == "timestamp") {
+            transaction.timestamp = QDateTime::fromString(reader.stringValue(), Qt::ISODate);
+        } else if (key == "type") {
+            transaction.type = static_cast<TransactionType>(reader.integerValue());
+        } else if (key == "amount") {
+            transaction.amount = reader.numberValue();
+        } else if (key == "balanceAfter") {
+            transaction.balanceAfter = reader.numberValue();
+        } else if (key == "description") {
+            transaction.description = reader.stringValue();
+        } else if (key == "targetBalanceAfter") {
+            transaction.hasTargetLeg = true;
+            transaction.targetBalanceAfter = reader.numberValue();
+        } else if (key == "targetCardNumber") {
+            transaction.targetCardNumber = reader.stringValue();
+        } else {
+            reader.skipCurrentValue();
+        }
+    }
+
+    return transaction;
+}
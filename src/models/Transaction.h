@@ -0,0 +1,113 @@
+/**
+ * @file Transaction.h
+ * @brief 交易数据实体
+ *
+ * 定义了交易类型枚举和交易结构体，供交易模型及各存储后端共用。
+ */
+#pragma once
+
+#include <QString>
+#include <QDateTime>
+#include <QJsonObject>
+
+class JsonStreamWriter;
+class JsonStreamReader;
+
+/**
+ * @brief 交易类型枚举
+ */
+enum class TransactionType {
+    Deposit,        //!< 存款
+    Withdrawal,     //!< 取款
+    BalanceInquiry, //!< 余额查询
+    Transfer,       //!< 转账
+    Other,          //!< 其他类型交易 (例如：登录、登出、PIN 码修改)
+    TransferIn,     //!< 转入：双边转账记录在收款方一侧的视图（付款方账本被删除后才单独存储）
+    Interest,       //!< 利息入账（批量计息）
+    Fee             //!< 账户管理费扣收（批量收费）
+};
+
+/**
+ * @brief 交易数据结构体
+ *
+ * 存储单条交易的详细信息。
+ */
+struct Transaction {
+    quint64 id = 0;         //!< 交易编号（按时间有序，0表示尚未分配，见 TransactionIdGenerator）
+    QString cardNumber;     //!< 交易涉及的卡号
+    QDateTime timestamp;    //!< 交易发生的时间戳
+    TransactionType type;   //!< 交易类型
+    double amount;          //!< 交易金额
+    double balanceAfter;    //!< 交易后的账户余额
+    QString description;    //!< 交易描述
+    QString targetCardNumber; //!< 目标卡号 (转账时记录对方卡号)
+    bool hasTargetLeg = false;      //!< 是否为双边转账记录（同一条记录同时表示收款方一侧）
+    double targetBalanceAfter = 0.0; //!< 收款方交易后余额（仅双边转账记录有效）
+
+    /**
+     * @brief 生成双边转账记录在收款方一侧的视图
+     *
+     * 视图与原记录共用交易编号，卡号和余额取收款方，类型为 TransferIn。
+     *
+     * @return 收款方一侧的交易
+     */
+    Transaction incomingLeg() const;
+
+    /**
+     * @brief 将 Transaction 对象转换为 QJsonObject
+     * @return 包含交易数据的 QJsonObject
+     */
+    QJsonObject toJson() const {
+        QJsonObject json;
+        json["id"] = QString::number(id); // 64位编号超出 double 的精确范围，以字符串保存
+        json["cardNumber"] = cardNumber;
+        json["timestamp"] = timestamp.toString(Qt::ISODate); // 使用 ISO 格式以便可靠解析
+        json["type"] = static_cast<int>(type);
+        json["amount"] = amount;
+        json["balanceAfter"] = balanceAfter;
+        json["description"] = description;
+        json["targetCardNumber"] = targetCardNumber;
+        if (hasTargetLeg) {
+            json["targetBalanceAfter"] = targetBalanceAfter;
+        }
+        return json;
+    }
+
+    /**
+     * @brief 从 QJsonObject 创建 Transaction 对象
+     * @param json 包含交易数据的 QJsonObject
+     * @return 创建的 Transaction 对象
+     */
+    static Transaction fromJson(const QJsonObject &json) {
+        Transaction transaction;
+        transaction.id = json["id"].toString().toULongLong();
+        transaction.cardNumber = json["cardNumber"].toString();
+        transaction.timestamp = QDateTime::fromString(json["timestamp"].toString(), Qt::ISODate);
+        transaction.type = static_cast<TransactionType>(json["type"].toInt());
+        transaction.amount = json["amount"].toDouble();
+        transaction.balanceAfter = json["balanceAfter"].toDouble();
+        transaction.description = json["description"].toString();
+        transaction.targetCardNumber = json["targetCardNumber"].toString();
+        if (json.contains("targetBalanceAfter")) {
+            transaction.hasTargetLeg = true;
+            transaction.targetBalanceAfter = json["targetBalanceAfter"].toDouble();
+        }
+        return transaction;
+    }
+
+    /**
+     * @brief 将交易直接写入流式JSON写入器
+     *
+     * 输出与 toJson() 经 QJsonDocument 序列化后的结果一致（字段按键名排序）。
+     *
+     * @param writer 流式JSON写入器
+     */
+    void writeJson(JsonStreamWriter &writer) const;
+
+    /**
+     * @brief 从流式JSON读取器读取一条交易
+     * @param reader 位于对象起始记号（StartObject）的读取器
+     * @return 创建的 Transaction 对象
+     */
+    static Transaction readJson(JsonStreamReader &reader);
+};
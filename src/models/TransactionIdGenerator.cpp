@@ -0,0 +1,166 @@
+/**
+ * @file TransactionIdGenerator.cpp
+ * @brief 交易编号生成器实现
+ *
+ * 实现了TransactionIdGenerator类中定义的编号生成、补分配和格式化方法。
+ */
+#include "TransactionIdGenerator.h"
+#include <QHash>
+#include <QSet>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+
+//!< 序列号最大值
+constexpr int kMaxSequence = (1 << TransactionIdGenerator::SEQUENCE_BITS) - 1;
+
+//!< 时间戳部分的最大值（41位）
+constexpr qint64 kMaxTimestamp = (qint64(1) << 41) - 1;
+
+//!< 时间戳在编号中的位移
+constexpr int kTimestampShift = TransactionIdGenerator::TERMINAL_BITS + TransactionIdGenerator::SEQUENCE_BITS;
+
+} // namespace
+
+std::atomic<int> TransactionIdGenerator::s_defaultTerminalId{0};
+
+TransactionIdGenerator::TransactionIdGenerator(const Clock* clock, int terminalId)
+    : m_clock(clock ? clock : Clock::system())
+    , m_terminalId(qBound(0, terminalId, MAX_TERMINALS - 1))
+    , m_lastMs(-1)
+    , m_sequence(0)
+{
+}
+
+void TransactionIdGenerator::setClock(const Clock* clock)
+{
+    m_clock = clock ? clock : Clock::system();
+}
+
+quint64 TransactionIdGenerator::next()
+{
+    const qint64 now = qBound<qint64>(0, m_clock->utcMs() - EPOCH_MS, kMaxTimestamp);
+
+    if (now > m_lastMs) {
+        m_lastMs = now;
+        m_sequence = 0;
+    } else if (++m_sequence > kMaxSequence) {
+        // 时钟未前进（或回拨）且本毫秒序列号用尽：借用下一毫秒
+        ++m_lastMs;
+        m_sequence = 0;
+    }
+
+    return compose(m_lastMs, m_terminalId, m_sequence);
+}
+
+void TransactionIdGenerator::observe(quint64 issuedId)
+{
+    const qint64 ms = qint64(issuedId >> kTimestampShift);
+    if (ms < m_lastMs) {
+        return;
+    }
+
+    if (terminalIdOf(issuedId) == m_terminalId) {
+        // 本终端的编号：从其序列号之后继续
+        const int sequence = int(issuedId & kMaxSequence);
+        if (ms > m_lastMs || sequence > m_sequence) {
+            m_lastMs = ms;
+            m_sequence = sequence;
+        }
+    } else {
+        // 其他终端的编号：直接用尽该毫秒，下一个编号从下一毫秒开始
+        m_lastMs = ms;
+        m_sequence = kMaxSequence;
+    }
+}
+
+int TransactionIdGenerator::assignMissingIds(QVector<Transaction>& transactions)
+{
+    // 常见情况下所有记录都已有编号，不必建立编号集合
+    const bool anyMissing = std::any_of(transactions.cbegin(), transactions.cend(),
+                                        [](const Transaction& t) { return t.id == 0; });
+    if (!anyMissing) {
+        return 0;
+    }
+
+    QSet<quint64> existing;
+    for (const Transaction& transaction : transactions) {
+        if (transaction.id != 0) {
+            existing.insert(transaction.id);
+        }
+    }
+
+    QHash<qint64, int> nextSequence;
+    int assigned = 0;
+    for (Transaction& transaction : transactions) {
+        if (transaction.id != 0) {
+            continue;
+        }
+
+        qint64 ms = transaction.timestamp.isValid()
+            ? qBound<qint64>(0, transaction.timestamp.toMSecsSinceEpoch() - EPOCH_MS, kMaxTimestamp)
+            : 0;
+
+        quint64 id = 0;
+        do {
+            int& sequence = nextSequence[ms];
+            if (sequence > kMaxSequence) {
+                ++ms;
+                continue;
+            }
+            id = compose(ms, 0, sequence++);
+        } while (id == 0 || existing.contains(id));
+
+        transaction.id = id;
+        existing.insert(id);
+        ++assigned;
+    }
+
+    if (assigned > 0) {
+        qDebug() << "为" << assigned << "条旧交易记录补分配了交易编号";
+    }
+    return assigned;
+}
+
+qint64 TransactionIdGenerator::timestampMs(quint64 id)
+{
+    return qint64(id >> kTimestampShift) + EPOCH_MS;
+}
+
+int TransactionIdGenerator::terminalIdOf(quint64 id)
+{
+    return int((id >> SEQUENCE_BITS) & (MAX_TERMINALS - 1));
+}
+
+QString TransactionIdGenerator::toString(quint64 id)
+{
+    if (id == 0) {
+        return QString();
+    }
+    return QStringLiteral("%1").arg(id, 16, 16, QLatin1Char('0')).toUpper();
+}
+
+quint64 TransactionIdGenerator::fromString(const QString& text)
+{
+    bool ok = false;
+    const quint64 id = text.toULongLong(&ok, 16);
+    return ok ? id : 0;
+}
+
+void TransactionIdGenerator::setDefaultTerminalId(int terminalId)
+{
+    s_defaultTerminalId.store(qBound(0, terminalId, MAX_TERMINALS - 1));
+}
+
+int TransactionIdGenerator::defaultTerminalId()
+{
+    return s_defaultTerminalId.load();
+}
+
+quint64 TransactionIdGenerator::compose(qint64 timestampMs, int terminalId, int sequence)
+{
+    return (quint64(timestampMs) << kTimestampShift)
+         | (quint64(terminalId) << SEQUENCE_BITS)
+         | quint64(sequence);
+}
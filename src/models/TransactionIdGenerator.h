@@ -0,0 +1,155 @@
+/**
+ * @file TransactionIdGenerator.h
+ * @brief 交易编号生成器
+ *
+ * 生成64位、按时间有序的交易编号：时间戳 + 终端编号 + 序列号。
+ */
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include "Clock.h"
+#include "Transaction.h"
+
+/**
+ * @brief 交易编号生成器
+ *
+ * 编号布局（从高位到低位）：
+ * - 1位保留（恒为0，保证编号为正数，可直接存入 SQLite INTEGER）
+ * - 41位自 EPOCH_MS 起的毫秒数（约69年）
+ * - 10位终端编号（0~1023）
+ * - 12位同一毫秒内的序列号（0~4095）
+ *
+ * 同一生成器产生的编号严格递增：时钟回拨时沿用上次的时间戳，
+ * 同一毫秒序列号用尽时借用下一毫秒，而不是等待时钟前进。
+ * 不同终端的编号因终端编号不同而不会冲突。
+ */
+class TransactionIdGenerator {
+public:
+    //!< 编号时间戳的起点（2024-01-01T00:00:00Z，UTC毫秒）
+    static const qint64 EPOCH_MS = 1704067200000LL;
+
+    //!< 终端编号位数
+    static const int TERMINAL_BITS = 10;
+
+    //!< 序列号位数
+    static const int SEQUENCE_BITS = 12;
+
+    //!< 终端编号上限（不含）
+    static const int MAX_TERMINALS = 1 << TERMINAL_BITS;
+
+    /**
+     * @brief 构造函数
+     * @param clock 时间来源
+     * @param terminalId 终端编号（0~1023）
+     */
+    explicit TransactionIdGenerator(const Clock* clock = Clock::system(),
+                                    int terminalId = defaultTerminalId());
+
+    /**
+     * @brief 设置时间来源
+     * @param clock 时钟，为空时使用系统时钟
+     */
+    void setClock(const Clock* clock);
+
+    /**
+     * @brief 获取终端编号
+     * @return 终端编号
+     */
+    int terminalId() const { return m_terminalId; }
+
+    /**
+     * @brief 生成下一个编号
+     * @return 交易编号
+     */
+    quint64 next();
+
+    /**
+     * @brief 保证之后生成的编号都大于给定编号
+     *
+     * 加载已有账本后调用，防止时钟回拨跨越重启导致编号倒退或重复。
+     *
+     * @param issuedId 已分配的编号
+     */
+    void observe(quint64 issuedId);
+
+    /**
+     * @brief 为没有编号的旧交易补分配编号
+     *
+     * 编号按交易自身的时间戳生成，终端编号固定为0；同一毫秒的多条交易依次递增序列号。
+     * 补分配的编号在所有已有编号中保持唯一。
+     *
+     * @param transactions 交易记录列表
+     * @return 补分配编号的记录数
+     */
+    static int assignMissingIds(QVector<Transaction>& transactions);
+
+    /**
+     * @brief 从编号中取出时间戳
+     * @param id 交易编号
+     * @return UTC毫秒
+     */
+    static qint64 timestampMs(quint64 id);
+
+    /**
+     * @brief 从编号中取出终端编号
+     * @param id 交易编号
+     * @return 终端编号
+     */
+    static int terminalIdOf(quint64 id);
+
+    /**
+     * @brief 将编号格式化为回单上显示的16位十六进制字符串
+     * @param id 交易编号
+     * @return 编号字符串，编号为0时返回空字符串
+     */
+    static QString toString(quint64 id);
+
+    /**
+     * @brief 解析 toString() 生成的编号字符串
+     * @param text 编号字符串
+     * @return 交易编号，无效时返回0
+     */
+    static quint64 fromString(const QString& text);
+
+    /**
+     * @brief 设置新建生成器默认使用的终端编号
+     *
+     * 必须在创建交易模型之前调用（通常由命令行参数决定）。
+     *
+     * @param terminalId 终端编号（0~1023）
+     */
+    static void setDefaultTerminalId(int terminalId);
+
+    /**
+     * @brief 获取新建生成器默认使用的终端编号
+     * @return 终端编号
+     */
+    static int defaultTerminalId();
+
+private:
+    /**
+     * @brief 组装编号
+     * @param timestampMs UTC毫秒
+     * @param terminalId 终端编号
+     * @param sequence 序列号
+     * @return 交易编号
+     */
+    static quint64 compose(qint64 timestampMs, int terminalId, int sequence);
+
+    //!< 时间来源
+    const Clock* m_clock;
+
+    //!< 终端编号
+    int m_terminalId;
+
+    //!< 上次分配编号使用的时间戳（相对 EPOCH_MS 的毫秒数）
+    qint64 m_lastMs;
+
+    //!< 上次分配编号的序列号
+    int m_sequence;
+
+    //!< 默认终端编号
+    static std::atomic<int> s_defaultTerminalId;
+};
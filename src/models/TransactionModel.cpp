@@ -4,9 +4,11 @@
  * @brief 交易数据模型实现文件
  *
  * 实现了 TransactionModel 类中定义的交易数据管理和格式化方法。
- * 负责与持久化存储交互（模拟 JSON 文件存储）并处理交易记录。
+ * 通过 ITransactionStore 与持久化存储交互（JSON 文件或 SQLite）并处理交易记录。
  */
 #include "TransactionModel.h"
+#include "JsonTransactionStore.h"
+#include "ChangeFeed.h"
 #include <algorithm> // 用于 std::sort 和 std::remove_if
 #include <QDebug>
 
@@ -20,15 +22,59 @@ TransactionModel::TransactionModel(JsonPersistenceManager* persistenceManager,
                                  const QString& filename,
                                  QObject *parent)
     : QObject(parent)
-    , m_persistenceManager(persistenceManager)
-    , m_filename(filename)
+    , m_clock(Clock::system())
+    , m_idGenerator(m_clock)
+    , m_store(std::make_unique<JsonTransactionStore>(persistenceManager, filename))
     , m_isDirty(false)
 {
-    // 尝试从文件加载交易记录
-    // 如果加载失败，则初始化测试交易并保存到文件
+    initialize();
+}
+
+/**
+ * @brief 构造函数
+ * @param store 交易存储后端（所有权转移给 TransactionModel）
+ * @param parent 父对象
+ */
+TransactionModel::TransactionModel(std::unique_ptr<ITransactionStore> store,
+                                 QObject *parent)
+    : QObject(parent)
+    , m_clock(Clock::system())
+    , m_idGenerator(m_clock)
+    , m_store(std::move(store))
+    , m_isDirty(false)
+{
+    Q_ASSERT(m_store != nullptr);
+    initialize();
+}
+
+/**
+ * @brief 设置时间来源
+ * @param clock 时钟，为空时使用系统时钟
+ */
+void TransactionModel::setClock(const Clock* clock)
+{
+    m_clock = clock ? clock : Clock::system();
+    m_idGenerator.setClock(m_clock);
+
+    // 时钟换了，今日的范围和排行榜窗口可能不同，重新累计
+    startActivityDay();
+    m_activityRanking.clear();
+    for (const Transaction &transaction : std::as_const(m_transactions)) {
+        accumulateActivity(transaction);
+    }
+}
+
+/**
+ * @brief 加载交易记录，失败时初始化测试数据
+ */
+void TransactionModel::initialize()
+{
+    // 尝试从存储加载交易记录
+    // 如果加载失败，则初始化测试交易并保存
     if (!loadTransactions()) {
         qDebug() << "无法加载交易记录，初始化测试交易";
         initializeTestTransactions();
+        rebuildIndexes();
         saveTransactions(); // 保存初始化的测试交易
     }
 }
@@ -55,15 +101,168 @@ TransactionModel::~TransactionModel()
 void TransactionModel::addTransaction(const Transaction &transaction)
 {
     m_transactions.append(transaction);
+    Transaction &added = m_transactions.last();
+    if (added.id == 0) {
+        added.id = m_idGenerator.next();
+    } else {
+        m_idGenerator.observe(added.id);
+    }
+    indexTransaction(m_transactions.size() - 1);
     m_isDirty = true;
+    if (m_unsavedFrom < 0) {
+        m_unsavedFrom = m_transactions.size() - 1;
+    }
     
-    qDebug() << "新交易已添加: " << transaction.cardNumber
+    qDebug() << "新交易已添加: " << TransactionIdGenerator::toString(added.id) << transaction.cardNumber
              << "类型:" << static_cast<int>(transaction.type)
              << "金额:" << transaction.amount
              << "描述:" << transaction.description;
 
-    // 添加新交易后保存数据
-    saveTransactions();
+    // 批量登记时由 commitBatch() 统一保存
+    if (m_batchStart >= 0) {
+        return;
+    }
+
+    // 添加新交易后保存数据（数据库后端只写入尚未保存的行，包括之前写入失败的行）
+    persistNewTransactions();
+}
+
+/**
+ * @brief 批量添加交易记录并一次保存
+ * @param transactions 要添加的交易记录（按时间顺序）
+ */
+bool TransactionModel::addTransactions(const QVector<Transaction> &transactions)
+{
+    if (transactions.isEmpty()) {
+        return true;
+    }
+
+    const bool wasDirty = m_isDirty;
+    const int previousUnsavedFrom = m_unsavedFrom;
+    const int firstNewIndex = m_transactions.size();
+    m_transactions.reserve(firstNewIndex + transactions.size());
+    for (const Transaction &transaction : transactions) {
+        m_transactions.append(transaction);
+        Transaction &added = m_transactions.last();
+        if (added.id == 0) {
+            added.id = m_idGenerator.next();
+        } else {
+            m_idGenerator.observe(added.id);
+        }
+        indexTransaction(m_transactions.size() - 1);
+    }
+    m_isDirty = true;
+    if (m_unsavedFrom < 0) {
+        m_unsavedFrom = firstNewIndex;
+    }
+
+    qDebug() << "批量添加交易:" << transactions.size() << "条";
+
+    // 批量登记时由 commitBatch() 统一保存
+    if (m_batchStart >= 0) {
+        return true;
+    }
+    if (persistNewTransactions()) {
+        return true;
+    }
+
+    // 写入失败：撤销本次添加，由调用方决定如何处理，避免以后全量保存时把它们写进账本
+    qWarning() << "批量保存交易记录失败，已撤销:" << transactions.size() << "条";
+    m_transactions.resize(firstNewIndex);
+    rebuildIndexes();
+    m_isDirty = wasDirty;
+    m_unsavedFrom = previousUnsavedFrom;
+    return false;
+}
+
+/**
+ * @brief 开始批量登记
+ */
+void TransactionModel::beginBatch()
+{
+    if (m_batchStart < 0) {
+        m_batchStart = m_transactions.size();
+    }
+}
+
+/**
+ * @brief 结束批量登记，把批内新增的交易一次写入存储
+ * @return 如果成功保存（或批内没有新增交易）返回 true，否则返回 false
+ */
+bool TransactionModel::commitBatch()
+{
+    const int batchStart = m_batchStart;
+    m_batchStart = -1;
+    if (batchStart < 0 || m_unsavedFrom < 0) {
+        return true;
+    }
+
+    const int pending = m_transactions.size() - m_unsavedFrom;
+    if (!persistNewTransactions()) {
+        qWarning() << "批量保存交易记录失败:" << pending << "条";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 把尚未写入存储的新记录追加到存储，成功后输出到变更流
+ * @return 如果成功写入（或没有未写入的记录）返回 true，否则返回 false
+ */
+bool TransactionModel::persistNewTransactions()
+{
+    if (m_unsavedFrom < 0) {
+        return true;
+    }
+    if (!m_store->appendTransactions(m_transactions, m_unsavedFrom)) {
+        return false;
+    }
+    m_isDirty = false;
+    publishSavedTransactions();
+    return true;
+}
+
+/**
+ * @brief 未写入的新记录已随追加或全量保存写入存储：输出到变更流并清除标记
+ */
+void TransactionModel::publishSavedTransactions()
+{
+    if (m_changeFeed && m_unsavedFrom >= 0 && m_unsavedFrom < m_transactions.size()) {
+        m_changeFeed->transactionsAppended(m_transactions, m_unsavedFrom, m_transactions.size());
+    }
+    m_unsavedFrom = -1;
+}
+
+/**
+ * @brief 获取尚未写入存储的新记录的编号
+ * @return 交易编号
+ */
+QSet<quint64> TransactionModel::unsavedTransactionIds() const
+{
+    QSet<quint64> ids;
+    if (m_unsavedFrom >= 0) {
+        ids.reserve(m_transactions.size() - m_unsavedFrom);
+        for (int i = m_unsavedFrom; i < m_transactions.size(); ++i) {
+            ids.insert(m_transactions.at(i).id);
+        }
+    }
+    return ids;
+}
+
+/**
+ * @brief 删除记录后重新定位尚未写入存储的新记录
+ *
+ * 未写入的记录总在账本末尾，删除其他记录后仍在末尾，从末尾数出仍然存在的条数即可。
+ *
+ * @param unsavedIds 删除前未写入的记录编号
+ */
+void TransactionModel::relocateUnsavedTransactions(const QSet<quint64> &unsavedIds)
+{
+    int index = m_transactions.size();
+    while (index > 0 && unsavedIds.contains(m_transactions.at(index - 1).id)) {
+        --index;
+    }
+    m_unsavedFrom = index < m_transactions.size() ? index : -1;
 }
 
 /**
@@ -75,9 +274,12 @@ QVector<Transaction> TransactionModel::getTransactionsForCard(const QString &car
 {
     QVector<Transaction> result;
 
-    for (const auto &transaction : m_transactions) {
-        if (transaction.cardNumber == cardNumber) {
-            result.append(transaction);
+    const auto it = m_cardIndex.constFind(cardNumber);
+    if (it != m_cardIndex.constEnd()) {
+        result.reserve(it->size());
+        for (int index : *it) {
+            const Transaction &transaction = m_transactions.at(index);
+            result.append(transaction.cardNumber == cardNumber ? transaction : transaction.incomingLeg());
         }
     }
 
@@ -110,6 +312,255 @@ QVector<Transaction> TransactionModel::getRecentTransactions(const QString &card
     return transactions;
 }
 
+/**
+ * @brief 按交易编号查找交易记录
+ * @param id 交易编号
+ * @return 包含交易记录的optional对象，如果未找到则为empty
+ */
+std::optional<Transaction> TransactionModel::findTransaction(quint64 id) const
+{
+    const auto it = m_idIndex.constFind(id);
+    if (it == m_idIndex.constEnd()) {
+        return std::nullopt;
+    }
+    return m_transactions.at(it.value());
+}
+
+/**
+ * @brief 获取对方卡号为指定卡号的交易记录
+ * @param cardNumber 对方卡号
+ * @return 交易记录（按账本顺序）
+ */
+QVector<Transaction> TransactionModel::getTransactionsByCounterparty(const QString &cardNumber) const
+{
+    QVector<Transaction> result;
+    const auto it = m_counterpartyIndex.constFind(cardNumber);
+    if (it != m_counterpartyIndex.constEnd()) {
+        result.reserve(it->size());
+        for (int index : *it) {
+            result.append(m_transactions.at(index));
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 获取涉及指定卡号的全部转账记录（付款或收款）
+ * @param cardNumber 卡号
+ * @return 交易记录（按账本顺序）
+ */
+QVector<Transaction> TransactionModel::getTransfersInvolving(const QString &cardNumber) const
+{
+    static const QVector<int> empty;
+    const auto own = m_cardIndex.constFind(cardNumber);
+    const auto counterparty = m_counterpartyIndex.constFind(cardNumber);
+    const QVector<int> &ownRows = own != m_cardIndex.constEnd() ? *own : empty;
+    const QVector<int> &counterpartyRows = counterparty != m_counterpartyIndex.constEnd() ? *counterparty : empty;
+
+    // 两个索引都按下标递增，归并时跳过同时出现在两边的记录（双边转账的收款方）
+    QVector<Transaction> result;
+    auto append = [&](int index) {
+        const Transaction &transaction = m_transactions.at(index);
+        if (transaction.type == TransactionType::Transfer || transaction.type == TransactionType::TransferIn) {
+            result.append(transaction);
+        }
+    };
+    int i = 0;
+    int j = 0;
+    while (i < ownRows.size() || j < counterpartyRows.size()) {
+        if (j >= counterpartyRows.size() || (i < ownRows.size() && ownRows[i] < counterpartyRows[j])) {
+            append(ownRows[i++]);
+        } else if (i >= ownRows.size() || counterpartyRows[j] < ownRows[i]) {
+            append(counterpartyRows[j++]);
+        } else {
+            append(ownRows[i]);
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 在全部交易的描述中检索
+ * @param query 查询文本
+ * @param limit 最多返回的记录数
+ * @return 账本中的原始记录（按相关度降序）
+ */
+QVector<Transaction> TransactionModel::searchTransactions(const QString &query, int limit) const
+{
+    QVector<Transaction> result;
+    const QVector<DescriptionIndex::Hit> hits = m_descriptionIndex.search(query, limit);
+    result.reserve(hits.size());
+    for (const DescriptionIndex::Hit &hit : hits) {
+        result.append(m_transactions.at(hit.row));
+    }
+    return result;
+}
+
+/**
+ * @brief 在指定卡号的交易描述中检索
+ * @param cardNumber 卡号
+ * @param query 查询文本
+ * @param limit 最多返回的记录数
+ * @return 该卡号的交易记录（按相关度降序）
+ */
+QVector<Transaction> TransactionModel::searchTransactionsForCard(const QString &cardNumber, const QString &query,
+                                                                 int limit) const
+{
+    QVector<Transaction> result;
+    const auto it = m_cardIndex.constFind(cardNumber);
+    if (it == m_cardIndex.constEnd()) {
+        return result;
+    }
+
+    // 卡号索引按下标递增，可直接作为检索范围
+    const QVector<DescriptionIndex::Hit> hits = m_descriptionIndex.search(query, limit, &it.value());
+    result.reserve(hits.size());
+    for (const DescriptionIndex::Hit &hit : hits) {
+        const Transaction &transaction = m_transactions.at(hit.row);
+        result.append(transaction.cardNumber == cardNumber ? transaction : transaction.incomingLeg());
+    }
+    return result;
+}
+
+/**
+ * @brief 获取指定时间之后的所有交易记录
+ * @param since 起始时间（含）
+ * @return 交易记录（按账本顺序）
+ */
+QVector<Transaction> TransactionModel::getTransactionsSince(const QDateTime &since) const
+{
+    QVector<Transaction> result;
+    for (const auto &transaction : m_transactions) {
+        if (transaction.timestamp >= since) {
+            result.append(transaction);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 重建交易编号索引和卡号索引，并让编号生成器越过已有的最大编号
+ */
+void TransactionModel::rebuildIndexes()
+{
+    m_idIndex.clear();
+    m_idIndex.reserve(m_transactions.size());
+    m_cardIndex.clear();
+    m_counterpartyIndex.clear();
+    m_descriptionIndex.clear();
+    startActivityDay();
+    m_activityRanking.clear();
+
+    quint64 maxId = 0;
+    for (int i = 0; i < m_transactions.size(); ++i) {
+        indexTransaction(i);
+        maxId = qMax(maxId, m_transactions[i].id);
+    }
+
+    // 防止时钟回拨跨越重启后产生重复或倒退的编号
+    if (maxId != 0) {
+        m_idGenerator.observe(maxId);
+    }
+}
+
+/**
+ * @brief 将一条记录登记到交易编号索引和卡号索引
+ * @param index 记录在 m_transactions 中的下标
+ */
+void TransactionModel::indexTransaction(int index)
+{
+    const Transaction &transaction = m_transactions.at(index);
+    m_idIndex.insert(transaction.id, index);
+    m_cardIndex[transaction.cardNumber].append(index);
+    if (transaction.hasTargetLeg && transaction.targetCardNumber != transaction.cardNumber) {
+        m_cardIndex[transaction.targetCardNumber].append(index);
+    }
+    if (!transaction.targetCardNumber.isEmpty()) {
+        m_counterpartyIndex[transaction.targetCardNumber].append(index);
+    }
+    m_descriptionIndex.add(index, transaction.description);
+    accumulateActivity(transaction);
+}
+
+/**
+ * @brief 以时钟的当前日期重新开始今日交易汇总
+ */
+void TransactionModel::startActivityDay()
+{
+    const QDate today = m_clock->today();
+    m_todayActivity = DailyActivityTotals();
+    m_todayActivity.date = today;
+    m_activityDayStartMs = QDateTime(today, QTime(0, 0)).toMSecsSinceEpoch();
+    m_activityDayEndMs = QDateTime(today.addDays(1), QTime(0, 0)).toMSecsSinceEpoch();
+}
+
+/**
+ * @brief 将一条交易累加到今日交易汇总
+ * @param transaction 交易记录
+ */
+void TransactionModel::accumulateActivity(const Transaction &transaction)
+{
+    // 已跨过零点：从新的一天重新累计
+    if (m_clock->utcMs() >= m_activityDayEndMs) {
+        startActivityDay();
+    }
+    const qint64 ms = transaction.timestamp.toMSecsSinceEpoch();
+    if (ms >= m_activityDayStartMs && ms < m_activityDayEndMs) {
+        m_todayActivity.add(transaction);
+    }
+
+    switch (transaction.type) {
+    case TransactionType::Deposit:
+    case TransactionType::Withdrawal:
+    case TransactionType::Transfer:
+    case TransactionType::TransferIn:
+        m_activityRanking.record(transaction.cardNumber, ms, m_clock->utcMs());
+        if (transaction.hasTargetLeg) {
+            m_activityRanking.record(transaction.targetCardNumber, ms, m_clock->utcMs());
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 获取今日全行交易汇总
+ * @return 今日的存款、取款和转账笔数及金额
+ */
+DailyActivityTotals TransactionModel::todayActivity() const
+{
+    // 跨过零点后还没有新交易：今日汇总为空
+    const qint64 now = m_clock->utcMs();
+    if (now < m_activityDayStartMs || now >= m_activityDayEndMs) {
+        DailyActivityTotals empty;
+        empty.date = m_clock->today();
+        return empty;
+    }
+    return m_todayActivity;
+}
+
+/**
+ * @brief 以全量扫描核对今日交易汇总
+ * @return 不一致的字段描述，一致时为空
+ */
+QStringList TransactionModel::verifyTodayActivity() const
+{
+    return todayActivity().differences(DailyActivityTotals::compute(m_transactions, m_clock->today()));
+}
+
+/**
+ * @brief 获取最近 24 小时交易次数最多的卡号
+ * @param n 数量
+ * @return 按交易次数降序排列的卡号和次数
+ */
+QVector<LeaderboardEntry> TransactionModel::getMostActiveCards(int n) const
+{
+    return m_activityRanking.top(n, m_clock->utcMs());
+}
+
 /**
  * @brief 清除指定卡号的所有交易记录
  *
@@ -119,42 +570,113 @@ QVector<Transaction> TransactionModel::getRecentTransactions(const QString &card
  */
 void TransactionModel::clearTransactionsForCard(const QString &cardNumber)
 {
+    // 先补写之前写入失败的新记录，数据库后端按编号改写的记录必须已经在表中
+    if (m_batchStart < 0) {
+        persistNewTransactions();
+    }
+    const QSet<quint64> unsaved = unsavedTransactionIds();
+
     int beforeSize = m_transactions.size();
-    m_transactions.erase(
-        std::remove_if(m_transactions.begin(), m_transactions.end(),
-                      [&cardNumber](const Transaction &t) {
-                          return t.cardNumber == cardNumber;
-                      }),
-        m_transactions.end());
+    QVector<int> rewritten;
+    m_transactions = withoutCard(m_transactions, cardNumber, &rewritten);
+    relocateUnsavedTransactions(unsaved);
 
     int removed = beforeSize - m_transactions.size();
     
-    if (removed > 0) {
+    if (removed > 0 || !rewritten.isEmpty()) {
+        rebuildIndexes();
         m_isDirty = true;
-        qDebug() << "已清除" << removed << "条交易记录，卡号: " << cardNumber;
+        qDebug() << "已清除" << removed << "条交易记录，改写" << rewritten.size()
+                 << "条双边转账记录，卡号: " << cardNumber;
 
         // 清除后保存数据
-        saveTransactions();
+        if (m_store->removeTransactionsForCard(cardNumber, m_transactions, rewritten)) {
+            m_isDirty = false;
+            if (m_changeFeed) {
+                m_changeFeed->cardCleared(cardNumber);
+            }
+            // 仍未写入的新记录（数据库后端不会随删除写入）
+            if (m_batchStart < 0) {
+                persistNewTransactions();
+            }
+        }
     }
 }
 
 /**
- * @brief 保存交易记录到文件
- * @return 如果成功保存返回 true，否则返回 false
+ * @brief 删除指定编号的交易记录并全量保存
+ * @param ids 交易编号
+ * @return 如果成功保存（或没有需要删除的记录）返回 true，否则返回 false
  */
-bool TransactionModel::saveTransactions()
+bool TransactionModel::removeTransactions(const QSet<quint64> &ids)
 {
-    QJsonArray transactionsArray;
+    const QSet<quint64> unsaved = unsavedTransactionIds();
+    const int beforeSize = m_transactions.size();
+    m_transactions.erase(std::remove_if(m_transactions.begin(), m_transactions.end(),
+                                        [&ids](const Transaction &transaction) {
+                                            return ids.contains(transaction.id);
+                                        }),
+                         m_transactions.end());
+    if (m_transactions.size() == beforeSize) {
+        return true;
+    }
 
-    // 将所有交易记录转换为 JSON 数组
-    for (const auto &transaction : m_transactions) {
-        transactionsArray.append(transaction.toJson());
+    relocateUnsavedTransactions(unsaved);
+    rebuildIndexes();
+    m_isDirty = true;
+    qDebug() << "已删除" << beforeSize - m_transactions.size() << "条交易记录";
+    return saveTransactions();
+}
+
+/**
+ * @brief 从账本中去掉指定卡号的交易记录
+ * @param transactions 账本
+ * @param cardNumber 卡号
+ * @param rewritten 输出参数，可为空，追加被改写的记录在结果中的下标
+ * @return 剩余的交易记录
+ */
+QVector<Transaction> TransactionModel::withoutCard(const QVector<Transaction> &transactions,
+                                                   const QString &cardNumber, QVector<int> *rewritten)
+{
+    QVector<Transaction> remaining;
+    remaining.reserve(transactions.size());
+    for (const Transaction &transaction : transactions) {
+        if (transaction.hasTargetLeg && transaction.cardNumber == cardNumber
+            && transaction.targetCardNumber != cardNumber) {
+            // 付款方被删除：保留为收款方单独的转入记录
+            if (rewritten) {
+                rewritten->append(remaining.size());
+            }
+            remaining.append(transaction.incomingLeg());
+        } else if (transaction.hasTargetLeg && transaction.targetCardNumber == cardNumber
+                   && transaction.cardNumber != cardNumber) {
+            // 收款方被删除：保留为付款方单独的转账记录
+            Transaction detached = transaction;
+            detached.hasTargetLeg = false;
+            detached.targetBalanceAfter = 0.0;
+            if (rewritten) {
+                rewritten->append(remaining.size());
+            }
+            remaining.append(detached);
+        } else if (transaction.cardNumber != cardNumber) {
+            remaining.append(transaction);
+        }
     }
+    return remaining;
+}
 
-    // 使用持久化管理器保存数据
-    bool success = m_persistenceManager->saveToFile(m_filename, transactionsArray);
+/**
+ * @brief 保存交易记录到文件
+ * @return 如果成功保存返回 true，否则返回 false
+ */
+bool TransactionModel::saveTransactions()
+{
+    // 使用存储后端全量保存
+    bool success = m_store->saveTransactions(m_transactions);
     if (success) {
         m_isDirty = false;
+        // 之前追加失败的新记录随全量保存写入，同样输出到变更流
+        publishSavedTransactions();
         qDebug() << "成功保存" << m_transactions.size() << "条交易记录";
     }
     
@@ -167,23 +689,16 @@ bool TransactionModel::saveTransactions()
  */
 bool TransactionModel::loadTransactions()
 {
-    QJsonArray transactionsArray;
+    QVector<Transaction> transactions;
     
-    // 使用持久化管理器加载数据
-    if (!m_persistenceManager->loadFromFile(m_filename, transactionsArray)) {
+    // 使用存储后端加载数据
+    if (!m_store->loadTransactions(transactions)) {
         return false;
     }
 
-    // 清空当前交易记录列表
-    m_transactions.clear();
-
-    // 从 JSON 数组加载交易记录
-    for (const QJsonValue &value : transactionsArray) {
-        if (value.isObject()) {
-            Transaction transaction = Transaction::fromJson(value.toObject());
-            m_transactions.append(transaction);
-        }
-    }
+    m_transactions = std::move(transactions);
+    m_unsavedFrom = -1;
+    rebuildIndexes();
 
     qDebug() << "成功加载" << m_transactions.size() << "条交易记录";
     return true;
@@ -204,8 +719,9 @@ Transaction TransactionModel::createTransaction(const QString &cardNumber, Trans
                                             const QString &description, const QString &targetCard)
 {
     Transaction transaction;
+    transaction.id = m_idGenerator.next();
     transaction.cardNumber = cardNumber;
-    transaction.timestamp = QDateTime::currentDateTime();
+    transaction.timestamp = m_clock->nowUtc();
     transaction.type = type;
     transaction.amount = amount;
     transaction.balanceAfter = balanceAfter;
@@ -226,41 +742,40 @@ Transaction TransactionModel::createTransaction(const QString &cardNumber, Trans
  * @param balanceAfter 交易后余额
  * @param description 交易描述
  * @param targetCard 目标卡号 (转账时使用)
+ * @return 新交易的编号
  */
-void TransactionModel::recordTransaction(const QString &cardNumber, TransactionType type,
+quint64 TransactionModel::recordTransaction(const QString &cardNumber, TransactionType type,
                                       double amount, double balanceAfter,
                                       const QString &description, const QString &targetCard)
 {
     Transaction transaction = createTransaction(cardNumber, type, amount, balanceAfter, description, targetCard);
     addTransaction(transaction);
+    return transaction.id;
 }
 
 /**
- * @brief 记录转账目标账户的交易记录（存款类型）
+ * @brief 记录一笔双边转账
  *
- * 用于在转账成功后为收款方生成交易记录。
+ * 付款方和收款方共用一条记录和一个交易编号，记录同时登记在双方的卡号索引中。
  *
- * @param fromCardNumber 源卡号
- * @param fromCardHolderName 源持卡人姓名
- * @param toCardNumber 目标卡号
+ * @param fromCardNumber 付款卡号
+ * @param toCardNumber 收款卡号
  * @param amount 转账金额
- * @param balanceAfter 目标账户交易后余额
+ * @param fromBalanceAfter 付款方交易后余额
+ * @param toBalanceAfter 收款方交易后余额
+ * @param description 付款方一侧的交易描述
+ * @return 新交易的编号
  */
-void TransactionModel::recordTransferReceipt(const QString &fromCardNumber, const QString &fromCardHolderName,
-                                          const QString &toCardNumber, double amount, double balanceAfter)
+quint64 TransactionModel::recordTransfer(const QString &fromCardNumber, const QString &toCardNumber,
+                                      double amount, double fromBalanceAfter, double toBalanceAfter,
+                                      const QString &description)
 {
-    QString description = QString("收到来自%1（%2）的转账").arg(fromCardHolderName).arg(fromCardNumber.right(4));
-
-    Transaction receiverTransaction = createTransaction(
-        toCardNumber,
-        TransactionType::Deposit, // 收到的转账是存款
-        amount,
-        balanceAfter,
-        description,
-        fromCardNumber // 记录发送方卡号
-    );
-
-    addTransaction(receiverTransaction);
+    Transaction transaction = createTransaction(fromCardNumber, TransactionType::Transfer, amount,
+                                                fromBalanceAfter, description, toCardNumber);
+    transaction.hasTargetLeg = true;
+    transaction.targetBalanceAfter = toBalanceAfter;
+    addTransaction(transaction);
+    return transaction.id;
 }
 
 /**
@@ -282,7 +797,7 @@ QString TransactionModel::formatAmount(double amount) const
  */
 QString TransactionModel::formatDate(const QDateTime &dateTime) const
 {
-    return dateTime.toString("yyyy-MM-dd hh:mm:ss");
+    return dateTime.toLocalTime().toString("yyyy-MM-dd hh:mm:ss");
 }
 
 /**
@@ -301,6 +816,12 @@ QString TransactionModel::getTransactionTypeName(int type) const
             return "余额查询";
         case TransactionType::Transfer:
             return "转账";
+        case TransactionType::TransferIn:
+            return "转入";
+        case TransactionType::Interest:
+            return "利息";
+        case TransactionType::Fee:
+            return "管理费";
         case TransactionType::Other:
         default:
             return "其他";
@@ -319,7 +840,7 @@ void TransactionModel::initializeTestTransactions()
     QString testCard2 = "2345678901234567"; // 李四
 
     // 当前时间
-    QDateTime now = QDateTime::currentDateTime();
+    QDateTime now = m_clock->nowUtc();
 
     // 为张三添加一些测试交易
     // 1. 存款交易
@@ -342,7 +863,7 @@ void TransactionModel::initializeTestTransactions()
     withdraw1.description = "ATM 取款";
     m_transactions.append(withdraw1);
 
-    // 3. 转账交易 (转出方)
+    // 3. 转账交易（双边记录，李四一侧通过卡号索引读取）
     Transaction transfer1;
     transfer1.cardNumber = testCard1;
     transfer1.timestamp = now.addSecs(-1 * 24 * 3600); // 1 天前
@@ -351,21 +872,12 @@ void TransactionModel::initializeTestTransactions()
     transfer1.balanceAfter = 5000.0;
     transfer1.description = "转账至李四（4567）";
     transfer1.targetCardNumber = testCard2;
+    transfer1.hasTargetLeg = true;
+    transfer1.targetBalanceAfter = 10500.0;
     m_transactions.append(transfer1);
 
     // 为李四添加一些测试交易
-    // 1. 收到的转账
-    Transaction transfer2;
-    transfer2.cardNumber = testCard2;
-    transfer2.timestamp = now.addSecs(-1 * 24 * 3600); // 1 天前
-    transfer2.type = TransactionType::Deposit; // 收到的转账对收款方来说是存款
-    transfer2.amount = 500.0;
-    transfer2.balanceAfter = 10500.0;
-    transfer2.description = "收到来自张三（3456）的转账";
-    transfer2.targetCardNumber = testCard1; // 记录发送方卡号
-    m_transactions.append(transfer2);
-
-    // 2. 查询余额
+    // 1. 查询余额
     Transaction inquiry1;
     inquiry1.cardNumber = testCard2;
     inquiry1.timestamp = now.addSecs(-12 * 3600); // 12 小时前
@@ -375,6 +887,9 @@ void TransactionModel::initializeTestTransactions()
     inquiry1.description = "余额查询";
     m_transactions.append(inquiry1);
 
+    // 测试交易的时间戳在过去，按各自的时间戳分配编号
+    TransactionIdGenerator::assignMissingIds(m_transactions);
+
     m_isDirty = true;
     qDebug() << "已初始化" << m_transactions.size() << "条测试交易记录";
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
  * @file TransactionModel.h
  * @brief 交易数据模型头文件
  *
- * 定义了交易结构体和交易数据管理类 TransactionModel。
+ * 定义了交易数据管理类 TransactionModel（交易结构体见 Transaction.h）。
  * TransactionModel 负责交易数据的存储、加载、检索和格式化。
  */
 #pragma once
@@ -16,66 +16,20 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QLocale> // 用于格式化货币/数字
+#include <memory>
+#include <optional>
+#include <QHash>
+#include <QSet>
+#include "Transaction.h"
+#include "ITransactionStore.h"
 #include "JsonPersistenceManager.h"
+#include "Clock.h"
+#include "TransactionIdGenerator.h"
+#include "DescriptionIndex.h"
+#include "BankAggregates.h"
+#include "Leaderboards.h"
 
-/**
- * @brief 交易类型枚举
- */
-enum class TransactionType {
-    Deposit,        //!< 存款
-    Withdrawal,     //!< 取款
-    BalanceInquiry, //!< 余额查询
-    Transfer,       //!< 转账
-    Other           //!< 其他类型交易 (例如：登录、登出、PIN 码修改)
-};
-
-/**
- * @brief 交易数据结构体
- *
- * 存储单条交易的详细信息。
- */
-struct Transaction {
-    QString cardNumber;     //!< 交易涉及的卡号
-    QDateTime timestamp;    //!< 交易发生的时间戳
-    TransactionType type;   //!< 交易类型
-    double amount;          //!< 交易金额
-    double balanceAfter;    //!< 交易后的账户余额
-    QString description;    //!< 交易描述
-    QString targetCardNumber; //!< 目标卡号 (转账时记录对方卡号)
-
-    /**
-     * @brief 将 Transaction 对象转换为 QJsonObject
-     * @return 包含交易数据的 QJsonObject
-     */
-    QJsonObject toJson() const {
-        QJsonObject json;
-        json["cardNumber"] = cardNumber;
-        json["timestamp"] = timestamp.toString(Qt::ISODate); // 使用 ISO 格式以便可靠解析
-        json["type"] = static_cast<int>(type);
-        json["amount"] = amount;
-        json["balanceAfter"] = balanceAfter;
-        json["description"] = description;
-        json["targetCardNumber"] = targetCardNumber;
-        return json;
-    }
-
-    /**
-     * @brief 从 QJsonObject 创建 Transaction 对象
-     * @param json 包含交易数据的 QJsonObject
-     * @return 创建的 Transaction 对象
-     */
-    static Transaction fromJson(const QJsonObject &json) {
-        Transaction transaction;
-        transaction.cardNumber = json["cardNumber"].toString();
-        transaction.timestamp = QDateTime::fromString(json["timestamp"].toString(), Qt::ISODate);
-        transaction.type = static_cast<TransactionType>(json["type"].toInt());
-        transaction.amount = json["amount"].toDouble();
-        transaction.balanceAfter = json["balanceAfter"].toDouble();
-        transaction.description = json["description"].toString();
-        transaction.targetCardNumber = json["targetCardNumber"].toString();
-        return transaction;
-    }
-};
+class ChangeFeed;
 
 /**
  * @brief 交易数据模型类
@@ -97,21 +51,65 @@ public:
     explicit TransactionModel(JsonPersistenceManager* persistenceManager,
                             const QString& filename = "transactions.json",
                             QObject *parent = nullptr);
+    /**
+     * @brief 构造函数
+     * @param store 交易存储后端（所有权转移给 TransactionModel）
+     * @param parent 父对象
+     */
+    explicit TransactionModel(std::unique_ptr<ITransactionStore> store,
+                            QObject *parent = nullptr);
     /**
      * @brief 析构函数
      */
     ~TransactionModel();
 
+    /**
+     * @brief 设置时间来源
+     *
+     * 新交易的时间戳和交易编号取自该时钟（UTC）；模拟运行时可传入 VirtualClock。
+     *
+     * @param clock 时钟，为空时使用系统时钟
+     */
+    void setClock(const Clock* clock);
+
+    /**
+     * @brief 获取时间来源
+     * @return 时钟
+     */
+    const Clock* clock() const { return m_clock; }
+
+    /**
+     * @brief 设置变更数据捕获输出
+     *
+     * 设置后每次成功写入存储的新增交易（包括追加失败后随全量保存写入的交易）和按卡号清除都会写入变更流。
+     *
+     * @param changeFeed 变更流，为空时不输出
+     */
+    void setChangeFeed(ChangeFeed* changeFeed) { m_changeFeed = changeFeed; }
+
     // --- 核心交易操作 ---
     /**
      * @brief 添加交易记录到内存列表并保存
      * @param transaction 要添加的 Transaction 对象
      */
     void addTransaction(const Transaction &transaction);
+    /**
+     * @brief 批量添加交易记录并一次保存
+     *
+     * 用于批处理作业一次产生大量记录的场景：逐条建立索引，但只写一次存储、只输出一行日志。
+     * 写入存储失败时撤销本次添加的记录，内存中的账本与存储保持一致。
+     *
+     * @param transactions 要添加的交易记录（按时间顺序）
+     * @return 如果成功写入存储（批量登记中为已加入本批）返回 true，否则返回 false
+     */
+    bool addTransactions(const QVector<Transaction> &transactions);
     /**
      * @brief 获取指定卡号的所有交易记录
+     *
+     * 双边转账记录对付款方返回原记录，对收款方返回 Transaction::incomingLeg() 视图。
+     *
      * @param cardNumber 卡号
-     * @return 包含该卡号所有交易记录的 QVector
+     * @return 包含该卡号所有交易记录的 QVector（按账本顺序）
      */
     QVector<Transaction> getTransactionsForCard(const QString &cardNumber) const;
     /**
@@ -121,6 +119,83 @@ public:
      * @return 包含指定数量最近交易记录的 QVector
      */
     QVector<Transaction> getRecentTransactions(const QString &cardNumber, int count) const;
+    /**
+     * @brief 按交易编号查找交易记录
+     * @param id 交易编号
+     * @return 包含交易记录的optional对象，如果未找到则为empty
+     */
+    std::optional<Transaction> findTransaction(quint64 id) const;
+    /**
+     * @brief 获取对方卡号为指定卡号的交易记录
+     *
+     * 通过反向索引查找，不扫描账本。返回原始记录，记录的卡号为另一方。
+     *
+     * @param cardNumber 对方卡号
+     * @return 交易记录（按账本顺序）
+     */
+    QVector<Transaction> getTransactionsByCounterparty(const QString &cardNumber) const;
+    /**
+     * @brief 获取涉及指定卡号的全部转账记录（付款或收款）
+     *
+     * 合并卡号索引和反向索引中类型为转账或转入的原始记录，每条记录只出现一次。
+     * 旧格式中收款方单独保存的存款记录不包含在内，对应的转账记录已代表该笔资金流动。
+     *
+     * @param cardNumber 卡号
+     * @return 交易记录（按账本顺序）
+     */
+    QVector<Transaction> getTransfersInvolving(const QString &cardNumber) const;
+    /**
+     * @brief 获取今日全行交易汇总
+     *
+     * 每登记一条交易时增量累加，读取时不扫描账本。
+     *
+     * @return 今日的存款、取款和转账笔数及金额
+     */
+    DailyActivityTotals todayActivity() const;
+    /**
+     * @brief 以全量扫描核对今日交易汇总
+     * @return 不一致的字段描述，一致时为空
+     */
+    QStringList verifyTodayActivity() const;
+    /**
+     * @brief 获取最近 24 小时交易次数最多的卡号
+     *
+     * 排行榜在登记交易时增量维护，读取时只过期窗口外的事件并取前 N 名。
+     *
+     * @param n 数量
+     * @return 按交易次数降序排列的卡号和次数
+     */
+    QVector<LeaderboardEntry> getMostActiveCards(int n = 100) const;
+    /**
+     * @brief 在全部交易的描述中检索
+     *
+     * 使用增量维护的倒排索引（中日韩文字按二字词切分），查询中的所有词都必须出现。
+     *
+     * @param query 查询文本，例如"转账给 李四"
+     * @param limit 最多返回的记录数
+     * @return 账本中的原始记录（按相关度降序）
+     */
+    QVector<Transaction> searchTransactions(const QString &query, int limit = 50) const;
+    /**
+     * @brief 在指定卡号的交易描述中检索
+     * @param cardNumber 卡号
+     * @param query 查询文本
+     * @param limit 最多返回的记录数
+     * @return 该卡号的交易记录（按相关度降序，收款方一侧为转入视图）
+     */
+    QVector<Transaction> searchTransactionsForCard(const QString &cardNumber, const QString &query,
+                                                   int limit = 50) const;
+    /**
+     * @brief 获取全部交易记录
+     * @return 账本中的原始记录（按账本顺序，双边转账只出现一次）
+     */
+    const QVector<Transaction>& getAllTransactions() const { return m_transactions; }
+    /**
+     * @brief 获取指定时间之后的所有交易记录
+     * @param since 起始时间（含）
+     * @return 账本中的原始记录（按账本顺序，双边转账只出现一次）
+     */
+    QVector<Transaction> getTransactionsSince(const QDateTime &since) const;
 
     // --- 交易创建和记录 ---
     /**
@@ -147,33 +222,71 @@ public:
      * @param balanceAfter 交易后余额
      * @param description 交易描述
      * @param targetCard 目标卡号 (转账时使用)
+     * @return 新交易的编号
      */
-    void recordTransaction(const QString &cardNumber, TransactionType type,
+    quint64 recordTransaction(const QString &cardNumber, TransactionType type,
                           double amount, double balanceAfter,
                           const QString &description, const QString &targetCard = QString());
     /**
-     * @brief 记录转账目标账户的交易记录（存款类型）
+     * @brief 记录一笔双边转账
      *
-     * 用于在转账成功后为收款方生成交易记录。
+     * 付款方和收款方共用一条记录和一个交易编号，记录同时登记在双方的卡号索引中。
      *
-     * @param fromCardNumber 源卡号
-     * @param fromCardHolderName 源持卡人姓名
-     * @param toCardNumber 目标卡号
+     * @param fromCardNumber 付款卡号
+     * @param toCardNumber 收款卡号
      * @param amount 转账金额
-     * @param balanceAfter 目标账户交易后余额
+     * @param fromBalanceAfter 付款方交易后余额
+     * @param toBalanceAfter 收款方交易后余额
+     * @param description 付款方一侧的交易描述
+     * @return 新交易的编号
+     */
+    quint64 recordTransfer(const QString &fromCardNumber, const QString &toCardNumber,
+                        double amount, double fromBalanceAfter, double toBalanceAfter,
+                        const QString &description);
+
+    /**
+     * @brief 开始批量登记
+     *
+     * 在 commitBatch() 之前新增的交易只写入内存和索引，不逐条写入存储。
+     */
+    void beginBatch();
+    /**
+     * @brief 结束批量登记，把批内新增的交易一次写入存储
+     * @return 如果成功保存（或批内没有新增交易）返回 true，否则返回 false
      */
-    void recordTransferReceipt(const QString &fromCardNumber, const QString &fromCardHolderName,
-                              const QString &toCardNumber, double amount, double balanceAfter);
+    bool commitBatch();
 
     // --- 数据管理 ---
     /**
      * @brief 清除指定卡号的所有交易记录
      *
-     * 例如在删除账户时使用。
+     * 例如在删除账户时使用。涉及该卡的双边转账记录不会删除，而是改写为
+     * 只属于另一方的记录，另一方的交易历史保持完整。
      *
      * @param cardNumber 卡号
      */
     void clearTransactionsForCard(const QString &cardNumber);
+    /**
+     * @brief 从账本中去掉指定卡号的交易记录
+     *
+     * clearTransactionsForCard() 使用的改写规则，备用节点重放删除时也使用它，保证两边结果一致。
+     *
+     * @param transactions 账本
+     * @param cardNumber 卡号
+     * @param rewritten 输出参数，可为空，追加被改写的记录在结果中的下标
+     * @return 剩余的交易记录
+     */
+    static QVector<Transaction> withoutCard(const QVector<Transaction> &transactions,
+                                            const QString &cardNumber, QVector<int> *rewritten = nullptr);
+    /**
+     * @brief 删除指定编号的交易记录并全量保存
+     *
+     * 用于批处理作业在账本已写入、后续提交失败时撤销本批记录。
+     *
+     * @param ids 交易编号
+     * @return 如果成功保存（或没有需要删除的记录）返回 true，否则返回 false
+     */
+    bool removeTransactions(const QSet<quint64> &ids);
 
     // --- 持久化存储方法 ---
     /**
@@ -195,7 +308,7 @@ public:
      */
     QString formatAmount(double amount) const;
     /**
-     * @brief 格式化日期时间为字符串
+     * @brief 格式化日期时间为字符串（本地时间）
      * @param dateTime 日期时间对象
      * @return 格式化后的日期时间字符串
      */
@@ -215,15 +328,104 @@ private:
      */
     void initializeTestTransactions();
 
+    /**
+     * @brief 加载交易记录，失败时初始化测试数据
+     */
+    void initialize();
+
+    /**
+     * @brief 重建交易编号索引和卡号索引，并让编号生成器越过已有的最大编号
+     */
+    void rebuildIndexes();
+
+    /**
+     * @brief 将一条记录登记到交易编号索引和卡号索引
+     * @param index 记录在 m_transactions 中的下标
+     */
+    void indexTransaction(int index);
+
+    /**
+     * @brief 以时钟的当前日期重新开始今日交易汇总
+     */
+    void startActivityDay();
+
+    /**
+     * @brief 将一条交易累加到今日交易汇总（不是今天的交易忽略）和活跃卡号排行榜
+     * @param transaction 交易记录
+     */
+    void accumulateActivity(const Transaction &transaction);
+
+    /**
+     * @brief 把尚未写入存储的新记录追加到存储，成功后输出到变更流
+     *
+     * 之前追加失败的记录与新记录一起写入，数据库后端不会漏掉它们。
+     *
+     * @return 如果成功写入（或没有未写入的记录）返回 true，否则返回 false
+     */
+    bool persistNewTransactions();
+
+    /**
+     * @brief 未写入的新记录已写入存储：输出到变更流并清除标记
+     */
+    void publishSavedTransactions();
+
+    /**
+     * @brief 获取尚未写入存储的新记录的编号
+     * @return 交易编号
+     */
+    QSet<quint64> unsavedTransactionIds() const;
+
+    /**
+     * @brief 删除记录后重新定位尚未写入存储的新记录
+     * @param unsavedIds 删除前未写入的记录编号
+     */
+    void relocateUnsavedTransactions(const QSet<quint64> &unsavedIds);
+
     //!< 交易记录内存存储
     QVector<Transaction> m_transactions;
+
+    //!< 时间来源
+    const Clock* m_clock;
+
+    //!< 交易编号生成器
+    TransactionIdGenerator m_idGenerator;
+
+    //!< 交易编号到 m_transactions 下标的索引
+    QHash<quint64, int> m_idIndex;
+
+    //!< 卡号到 m_transactions 下标的索引（双边转账记录同时登记在付款方和收款方）
+    QHash<QString, QVector<int>> m_cardIndex;
+
+    //!< 对方卡号到 m_transactions 下标的反向索引（记录的 targetCardNumber）
+    QHash<QString, QVector<int>> m_counterpartyIndex;
+
+    //!< 交易描述的全文索引（文档为 m_transactions 下标）
+    DescriptionIndex m_descriptionIndex;
+
+    //!< 今日交易汇总
+    DailyActivityTotals m_todayActivity;
+
+    //!< 今日起始时间（UTC毫秒，本地零点）
+    qint64 m_activityDayStartMs = 0;
+
+    //!< 明日起始时间（UTC毫秒，本地零点）
+    qint64 m_activityDayEndMs = 0;
+
+    //!< 最近 24 小时的活跃卡号排行榜（双边转账两侧各计一次）
+    ActivityLeaderboard m_activityRanking;
     
-    //!< JSON持久化管理器
-    JsonPersistenceManager* m_persistenceManager;
-    
-    //!< 交易数据文件名
-    QString m_filename;
+    //!< 交易存储后端
+    std::unique_ptr<ITransactionStore> m_store;
     
     //!< 标记数据是否被修改
     bool m_isDirty;
+
+    //!< 批量登记中第一条新交易的下标，-1 表示不在批量登记中
+    int m_batchStart = -1;
+
+    //!< 第一条尚未写入存储的新交易的下标（之后的记录都未写入），-1 表示全部已写入
+    int m_unsavedFrom = -1;
+
+    //!< 变更数据捕获输出（可为空）
+    ChangeFeed* m_changeFeed = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,187 @@
+/**
+ * @file TransferGraph.cpp
+ * @brief 转账关系图实现
+ *
+ * 实现了TransferGraph类中定义的CSR构建和并行连通分量计算方法。
+ */
+#include "TransferGraph.h"
+#include <QDebug>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+//!< 每个并行分块至少包含的顶点数，小图直接单线程计算
+const int kMinVerticesPerChunk = 4096;
+
+} // namespace
+
+TransferGraph TransferGraph::build(const QVector<Transaction>& transactions)
+{
+    TransferGraph graph;
+
+    auto vertexOf = [&graph](const QString& cardNumber) {
+        auto found = graph.m_index.constFind(cardNumber);
+        if (found != graph.m_index.constEnd()) {
+            return found.value();
+        }
+        const int vertex = graph.m_cards.size();
+        graph.m_index.insert(cardNumber, vertex);
+        graph.m_cards.append(cardNumber);
+        return vertex;
+    };
+
+    // 收集无向边（较小编号在前），排序去重
+    QVector<std::pair<int, int>> edges;
+    QString from;
+    QString to;
+    for (const Transaction& transaction : transactions) {
+        if (!transferEdge(transaction, from, to)) {
+            continue;
+        }
+        const int u = vertexOf(from);
+        const int v = vertexOf(to);
+        edges.append(std::minmax(u, v));
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    // 统计度数，前缀和得到各顶点的起始位置，再填充邻居
+    const int vertices = graph.m_cards.size();
+    graph.m_offsets.fill(0, vertices + 1);
+    for (const auto& edge : edges) {
+        ++graph.m_offsets[edge.first + 1];
+        ++graph.m_offsets[edge.second + 1];
+    }
+    std::partial_sum(graph.m_offsets.begin(), graph.m_offsets.end(), graph.m_offsets.begin());
+
+    graph.m_neighbors.resize(edges.size() * 2);
+    QVector<int> cursor(graph.m_offsets.begin(), graph.m_offsets.end() - 1);
+    for (const auto& edge : edges) {
+        graph.m_neighbors[cursor[edge.first]++] = edge.second;
+        graph.m_neighbors[cursor[edge.second]++] = edge.first;
+    }
+
+    return graph;
+}
+
+bool TransferGraph::transferEdge(const Transaction& transaction, QString& from, QString& to)
+{
+    if (transaction.targetCardNumber.isEmpty() || transaction.targetCardNumber == transaction.cardNumber) {
+        return false;
+    }
+    if (transaction.type == TransactionType::Transfer) {
+        from = transaction.cardNumber;
+        to = transaction.targetCardNumber;
+        return true;
+    }
+    if (transaction.type == TransactionType::TransferIn) {
+        from = transaction.targetCardNumber;
+        to = transaction.cardNumber;
+        return true;
+    }
+    return false;
+}
+
+QVector<int> TransferGraph::componentLabels(int threads) const
+{
+    const int vertices = vertexCount();
+    if (threads <= 0) {
+        threads = qMax(1, QThread::idealThreadCount());
+    }
+
+    std::unique_ptr<std::atomic<int>[]> labels(new std::atomic<int>[vertices]);
+    for (int v = 0; v < vertices; ++v) {
+        labels[v].store(v, std::memory_order_relaxed);
+    }
+
+    // 把标签降到不大于 value（只会变小，并发写入时保留较小者）
+    auto lower = [&labels](int vertex, int value) {
+        int current = labels[vertex].load(std::memory_order_relaxed);
+        while (value < current) {
+            if (labels[vertex].compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    const int chunkCount = qBound(1, vertices / kMinVerticesPerChunk, threads * 4);
+    QVector<int> chunkIndices(chunkCount);
+    std::iota(chunkIndices.begin(), chunkIndices.end(), 0);
+
+    std::atomic<bool> changed{true};
+    auto propagateChunk = [&](int chunk) {
+        const int begin = int(qint64(vertices) * chunk / chunkCount);
+        const int end = int(qint64(vertices) * (chunk + 1) / chunkCount);
+        bool local = false;
+        for (int v = begin; v < end; ++v) {
+            int best = labels[v].load(std::memory_order_relaxed);
+            for (int i = m_offsets[v]; i < m_offsets[v + 1]; ++i) {
+                best = qMin(best, labels[m_neighbors[i]].load(std::memory_order_relaxed));
+            }
+            // 指针跳跃：沿标签链找到当前已知的最小标签
+            int next = labels[best].load(std::memory_order_relaxed);
+            while (next < best) {
+                best = next;
+                next = labels[best].load(std::memory_order_relaxed);
+            }
+            local |= lower(v, best);
+        }
+        if (local) {
+            changed.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    int rounds = 0;
+    while (changed.load(std::memory_order_relaxed)) {
+        changed.store(false, std::memory_order_relaxed);
+        if (chunkCount == 1) {
+            propagateChunk(0);
+        } else {
+            QtConcurrent::blockingMap(&pool, chunkIndices, propagateChunk);
+        }
+        ++rounds;
+    }
+
+    QVector<int> result(vertices);
+    for (int v = 0; v < vertices; ++v) {
+        result[v] = labels[v].load(std::memory_order_relaxed);
+    }
+
+    qDebug() << "转账关系图连通分量计算完成:" << vertices << "个顶点," << edgeCount() << "条边,"
+             << rounds << "轮," << chunkCount << "个分块";
+    return result;
+}
+
+QVector<QStringList> TransferGraph::components(int minSize, int threads) const
+{
+    const QVector<int> labels = componentLabels(threads);
+
+    QHash<int, QStringList> groups;
+    for (int v = 0; v < labels.size(); ++v) {
+        groups[labels[v]].append(m_cards.at(v));
+    }
+
+    QVector<QStringList> result;
+    for (auto it = groups.begin(); it != groups.end(); ++it) {
+        if (it.value().size() >= minSize) {
+            result.append(std::move(it.value()));
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const QStringList& a, const QStringList& b) {
+        if (a.size() != b.size()) {
+            return a.size() > b.size();
+        }
+        return a.first() < b.first();
+    });
+    return result;
+}
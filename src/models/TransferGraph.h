@@ -0,0 +1,103 @@
+/**
+ * @file TransferGraph.h
+ * @brief 转账关系图
+ *
+ * 以压缩稀疏行（CSR）形式保存卡号之间的转账关系，用于连通分量等图分析。
+ */
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "Transaction.h"
+
+/**
+ * @brief 转账关系图
+ *
+ * 顶点为卡号，两张卡之间发生过至少一次转账即有一条无向边（重复转账只保留一条边）。
+ * 邻接表按CSR存放：m_offsets[v] 到 m_offsets[v + 1] 是顶点 v 在 m_neighbors 中的邻居范围，
+ * 全部邻居连续存放，遍历时没有逐顶点的小块内存分配。
+ *
+ * 连通分量用并行最小标签传播计算：每轮把顶点分块交给线程池，各顶点取自身与邻居标签的
+ * 最小值（标签只会变小），再做指针跳跃缩短传播路径，直到一轮内没有标签变化。
+ */
+class TransferGraph {
+public:
+    /**
+     * @brief 从交易记录构建转账关系图
+     * @param transactions 交易记录（只使用转账和转入）
+     * @return 转账关系图
+     */
+    static TransferGraph build(const QVector<Transaction>& transactions);
+
+    /**
+     * @brief 判断交易记录是否代表一次转账，并取出付款方和收款方
+     * @param transaction 交易记录
+     * @param from 输出参数，付款卡号
+     * @param to 输出参数，收款卡号
+     * @return 是转账（且双方卡号有效）时返回true
+     */
+    static bool transferEdge(const Transaction& transaction, QString& from, QString& to);
+
+    /**
+     * @brief 获取顶点数
+     * @return 顶点数
+     */
+    int vertexCount() const { return m_cards.size(); }
+
+    /**
+     * @brief 获取无向边数
+     * @return 边数
+     */
+    int edgeCount() const { return m_neighbors.size() / 2; }
+
+    /**
+     * @brief 获取顶点对应的卡号
+     * @param vertex 顶点
+     * @return 卡号
+     */
+    const QString& cardAt(int vertex) const { return m_cards.at(vertex); }
+
+    /**
+     * @brief 获取卡号对应的顶点
+     * @param cardNumber 卡号
+     * @return 顶点，不存在时返回-1
+     */
+    int indexOf(const QString& cardNumber) const { return m_index.value(cardNumber, -1); }
+
+    /**
+     * @brief 获取顶点的度
+     * @param vertex 顶点
+     * @return 邻居数
+     */
+    int degree(int vertex) const { return m_offsets.at(vertex + 1) - m_offsets.at(vertex); }
+
+    /**
+     * @brief 计算每个顶点所属连通分量的标签
+     * @param threads 线程数，0 表示使用 QThread::idealThreadCount()
+     * @return 每个顶点的标签（分量中最小的顶点编号）
+     */
+    QVector<int> componentLabels(int threads = 0) const;
+
+    /**
+     * @brief 计算连通分量
+     * @param minSize 最小分量大小，更小的分量不返回
+     * @param threads 线程数，0 表示自动
+     * @return 各分量的卡号列表（按分量大小降序）
+     */
+    QVector<QStringList> components(int minSize = 2, int threads = 0) const;
+
+private:
+    //!< 顶点编号到卡号
+    QVector<QString> m_cards;
+
+    //!< 卡号到顶点编号
+    QHash<QString, int> m_index;
+
+    //!< 每个顶点的邻居起始位置（长度为顶点数 + 1）
+    QVector<int> m_offsets;
+
+    //!< 全部顶点的邻居（按顶点连续存放）
+    QVector<int> m_neighbors;
+};
@@ -0,0 +1,147 @@
+/**
+ * @file WithdrawalLimitTracker.cpp
+ * @brief 累计取款限额跟踪实现
+ *
+ * 实现了WithdrawalLimitTracker类中定义的滚动窗口计数和限额检查方法。
+ */
+#include "WithdrawalLimitTracker.h"
+#include <QDebug>
+#include <numeric>
+
+template <int Buckets>
+void WithdrawalLimitTracker::RollingSum<Buckets>::advance(qint64 slot)
+{
+    if (head < 0) {
+        head = slot;
+        return;
+    }
+    if (slot <= head) {
+        return;
+    }
+
+    // 最多清理一整圈
+    const qint64 steps = qMin<qint64>(slot - head, Buckets);
+    for (qint64 i = 1; i <= steps; ++i) {
+        amounts[(head + i) % Buckets] = 0.0;
+    }
+    head = slot;
+
+    // 重新求和而不是逐桶相减，避免浮点误差累积
+    total = std::accumulate(amounts.cbegin(), amounts.cend(), 0.0);
+}
+
+template <int Buckets>
+void WithdrawalLimitTracker::RollingSum<Buckets>::add(qint64 slot, double amount)
+{
+    advance(slot);
+    if (slot <= head - Buckets) {
+        return;
+    }
+    amounts[slot % Buckets] += amount;
+    total += amount;
+}
+
+WithdrawalLimitTracker::WithdrawalLimitTracker(const Clock* clock)
+    : WithdrawalLimitTracker(clock, Config())
+{
+}
+
+WithdrawalLimitTracker::WithdrawalLimitTracker(const Clock* clock, const Config& config)
+    : m_clock(clock ? clock : Clock::system())
+    , m_config(config)
+{
+}
+
+void WithdrawalLimitTracker::setClock(const Clock* clock)
+{
+    m_clock = clock ? clock : Clock::system();
+}
+
+OperationResult WithdrawalLimitTracker::check(const Account& account, double amount)
+{
+    // 没有近期取款记录的卡不创建计数器
+    const double hourTotal = hourlyTotal(account.cardNumber);
+    const double dayTotal = dailyTotal(account.cardNumber);
+
+    const double hourlyLimit = account.withdrawLimit * m_config.hourlyMultiple;
+    if (hourTotal + amount > hourlyLimit) {
+        return OperationResult::Failure(QString("超出每小时累计取款限额 %1，最近一小时已取 %2")
+                                        .arg(hourlyLimit).arg(hourTotal));
+    }
+
+    const double dailyLimit = account.withdrawLimit * m_config.dailyMultiple;
+    if (dayTotal + amount > dailyLimit) {
+        return OperationResult::Failure(QString("超出每日累计取款限额 %1，最近24小时已取 %2")
+                                        .arg(dailyLimit).arg(dayTotal));
+    }
+
+    return OperationResult::Success();
+}
+
+void WithdrawalLimitTracker::record(const QString& cardNumber, double amount)
+{
+    record(cardNumber, amount, m_clock->utcMs());
+}
+
+void WithdrawalLimitTracker::record(const QString& cardNumber, double amount, qint64 utcMs)
+{
+    CardCounters& counters = countersAt(cardNumber, m_clock->utcMs());
+    counters.hour.add(utcMs / HOUR_BUCKET_MS, amount);
+    counters.day.add(utcMs / DAY_BUCKET_MS, amount);
+}
+
+void WithdrawalLimitTracker::rebuild(const QVector<Transaction>& transactions)
+{
+    m_counters.clear();
+
+    const qint64 now = m_clock->utcMs();
+    const qint64 windowStart = now - 24 * DAY_BUCKET_MS;
+    int counted = 0;
+    for (const Transaction& transaction : transactions) {
+        if (!countsTowardLimit(transaction.type) || !transaction.timestamp.isValid()) {
+            continue;
+        }
+        const qint64 ms = transaction.timestamp.toMSecsSinceEpoch();
+        if (ms < windowStart || ms > now) {
+            continue;
+        }
+        record(transaction.cardNumber, transaction.amount, ms);
+        ++counted;
+    }
+
+    qDebug() << "累计取款计数器已从账本重建:" << m_counters.size() << "张卡," << counted << "笔交易";
+}
+
+void WithdrawalLimitTracker::forget(const QString& cardNumber)
+{
+    m_counters.remove(cardNumber);
+}
+
+double WithdrawalLimitTracker::hourlyTotal(const QString& cardNumber)
+{
+    if (!m_counters.contains(cardNumber)) {
+        return 0.0;
+    }
+    return countersAt(cardNumber, m_clock->utcMs()).hour.total;
+}
+
+double WithdrawalLimitTracker::dailyTotal(const QString& cardNumber)
+{
+    if (!m_counters.contains(cardNumber)) {
+        return 0.0;
+    }
+    return countersAt(cardNumber, m_clock->utcMs()).day.total;
+}
+
+bool WithdrawalLimitTracker::countsTowardLimit(TransactionType type)
+{
+    return type == TransactionType::Withdrawal || type == TransactionType::Transfer;
+}
+
+WithdrawalLimitTracker::CardCounters& WithdrawalLimitTracker::countersAt(const QString& cardNumber, qint64 nowMs)
+{
+    CardCounters& counters = m_counters[cardNumber];
+    counters.hour.advance(nowMs / HOUR_BUCKET_MS);
+    counters.day.advance(nowMs / DAY_BUCKET_MS);
+    return counters;
+}
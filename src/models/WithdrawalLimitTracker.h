@@ -0,0 +1,171 @@
+/**
+ * @file WithdrawalLimitTracker.h
+ * @brief 累计取款限额跟踪
+ *
+ * 按卡号维护滚动时间窗口内的累计取款（含转出）金额，用于检查每小时和每日累计限额。
+ */
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <array>
+#include "Account.h"
+#include "Clock.h"
+#include "OperationResult.h"
+#include "Transaction.h"
+
+/**
+ * @brief 累计取款限额跟踪
+ *
+ * 每张卡两个环形桶计数器：
+ * - 小时窗口：12个5分钟桶，覆盖最近60分钟
+ * - 日窗口：24个1小时桶，覆盖最近24小时
+ *
+ * 取款或转出成功后在当前桶中累加；检查时先把窗口推进到当前时间（最多清理一圈桶），
+ * 再读取窗口合计，因此每次检查和记录的开销与交易量无关。窗口以桶为粒度滚动，
+ * 最旧的一个桶整体过期。启动时从账本中最近24小时的交易重建。
+ *
+ * 累计限额按账户的单次取款限额的倍数计算，倍数由 Config 指定。
+ */
+class WithdrawalLimitTracker {
+public:
+    /**
+     * @brief 累计限额参数
+     */
+    struct Config {
+        double hourlyMultiple = 2.0;    //!< 每小时累计限额 = 单次限额 × 该倍数
+        double dailyMultiple = 5.0;     //!< 每日累计限额 = 单次限额 × 该倍数
+    };
+
+    /**
+     * @brief 构造函数，使用默认参数
+     * @param clock 时间来源
+     */
+    explicit WithdrawalLimitTracker(const Clock* clock = Clock::system());
+
+    /**
+     * @brief 构造函数
+     * @param clock 时间来源
+     * @param config 累计限额参数
+     */
+    WithdrawalLimitTracker(const Clock* clock, const Config& config);
+
+    /**
+     * @brief 设置时间来源
+     * @param clock 时钟，为空时使用系统时钟
+     */
+    void setClock(const Clock* clock);
+
+    /**
+     * @brief 检查本次取款后是否超出累计限额
+     * @param account 账户（使用其单次取款限额计算累计限额）
+     * @param amount 本次金额
+     * @return 操作结果
+     */
+    OperationResult check(const Account& account, double amount);
+
+    /**
+     * @brief 记录一笔成功的取款或转出（使用当前时间）
+     * @param cardNumber 卡号
+     * @param amount 金额
+     */
+    void record(const QString& cardNumber, double amount);
+
+    /**
+     * @brief 记录一笔取款或转出
+     * @param cardNumber 卡号
+     * @param amount 金额
+     * @param utcMs 发生时间（UTC毫秒），超出日窗口的记录被忽略
+     */
+    void record(const QString& cardNumber, double amount, qint64 utcMs);
+
+    /**
+     * @brief 从账本重建全部计数器
+     * @param transactions 交易记录（只统计取款和转出）
+     */
+    void rebuild(const QVector<Transaction>& transactions);
+
+    /**
+     * @brief 丢弃卡号的计数器
+     * @param cardNumber 卡号
+     */
+    void forget(const QString& cardNumber);
+
+    /**
+     * @brief 获取最近60分钟的累计金额
+     * @param cardNumber 卡号
+     * @return 累计金额
+     */
+    double hourlyTotal(const QString& cardNumber);
+
+    /**
+     * @brief 获取最近24小时的累计金额
+     * @param cardNumber 卡号
+     * @return 累计金额
+     */
+    double dailyTotal(const QString& cardNumber);
+
+    /**
+     * @brief 判断交易是否计入取款累计
+     * @param type 交易类型
+     * @return 取款和转出返回true
+     */
+    static bool countsTowardLimit(TransactionType type);
+
+private:
+    /**
+     * @brief 固定桶数的滚动窗口合计
+     * @tparam Buckets 桶数
+     */
+    template <int Buckets>
+    struct RollingSum {
+        std::array<double, Buckets> amounts{};  //!< 各桶金额
+        qint64 head = -1;                       //!< 最新桶的序号（时间 / 桶宽），-1表示尚未使用
+        double total = 0.0;                     //!< 窗口合计
+
+        /**
+         * @brief 把窗口推进到指定桶，清理滑出窗口的桶
+         * @param slot 桶序号
+         */
+        void advance(qint64 slot);
+
+        /**
+         * @brief 在指定桶中累加金额
+         * @param slot 桶序号（早于窗口的将被忽略）
+         * @param amount 金额
+         */
+        void add(qint64 slot, double amount);
+    };
+
+    //!< 小时窗口的桶宽（毫秒）
+    static const qint64 HOUR_BUCKET_MS = 5 * 60 * 1000;
+
+    //!< 日窗口的桶宽（毫秒）
+    static const qint64 DAY_BUCKET_MS = 60 * 60 * 1000;
+
+    /**
+     * @brief 单张卡的计数器
+     */
+    struct CardCounters {
+        RollingSum<12> hour;    //!< 最近60分钟
+        RollingSum<24> day;     //!< 最近24小时
+    };
+
+    /**
+     * @brief 获取卡号的计数器并推进到当前时间
+     * @param cardNumber 卡号
+     * @param nowMs 当前时间（UTC毫秒）
+     * @return 计数器
+     */
+    CardCounters& countersAt(const QString& cardNumber, qint64 nowMs);
+
+    //!< 时间来源
+    const Clock* m_clock;
+
+    //!< 累计限额参数
+    Config m_config;
+
+    //!< 卡号到计数器的映射
+    QHash<QString, CardCounters> m_counters;
+};
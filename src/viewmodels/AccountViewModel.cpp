@@ -28,6 +28,26 @@ AccountViewModel::AccountViewModel(QObject *parent)
     // 构造函数初始化成员变量，无复杂逻辑。
 }
 
+/**
+ * @brief 构造函数
+ * @param repository 账户存储库
+ * @param persistenceManager 数据目录的JSON持久化管理器
+ * @param parent 父对象
+ */
+AccountViewModel::AccountViewModel(std::unique_ptr<IAccountRepository> repository,
+                                   JsonPersistenceManager *persistenceManager, QObject *parent)
+    : QObject(parent)
+    , m_accountModel(std::move(repository), persistenceManager)
+    , m_transactionModel(nullptr)
+    , m_isLoggedIn(false)
+    , m_predictedBalance(0.0)
+    , m_isAdmin(false)
+    , m_cardNumber("")
+    , m_errorMessage("")
+    , m_multiDayPredictions()
+{
+}
+
 /**
  * @brief 设置交易数据模型引用
  * @param model 交易数据模型指针
@@ -40,6 +60,70 @@ void AccountViewModel::setTransactionModel(TransactionModel *model)
     m_accountModel.setTransactionModel(model);
 }
 
+/**
+ * @brief 设置时间来源
+ * @param clock 时钟
+ */
+void AccountViewModel::setClock(const Clock* clock)
+{
+    m_accountModel.setClock(clock);
+}
+
+/**
+ * @brief 校验账本与账户余额的一致性
+ * @param threads 线程数
+ * @return 校验报告
+ */
+LedgerReport AccountViewModel::verifyLedger(int threads) const
+{
+    return m_accountModel.verifyLedger(threads);
+}
+
+/**
+ * @brief 回测全部余额预测模型并选出默认模型
+ * @param horizonDays 预测天数
+ * @param threads 线程数
+ * @return 回测报告
+ */
+ForecastBacktestReport AccountViewModel::backtestForecasters(int horizonDays, int threads) const
+{
+    return m_accountModel.backtestForecasters(horizonDays, threads);
+}
+
+/**
+ * @brief 执行全部到期的定期转账
+ * @param batchSize 每批的指令数
+ * @return 执行结果
+ */
+StandingOrderRunReport AccountViewModel::runStandingOrders(int batchSize)
+{
+    const StandingOrderRunReport report = m_accountModel.runStandingOrders(batchSize);
+    if (report.executed > 0) {
+        emit bankSummaryChanged();
+        if (m_isLoggedIn) {
+            emit balanceChanged();
+        }
+    }
+    return report;
+}
+
+/**
+ * @brief 执行到期的批量计息与收费
+ * @param threads 线程数
+ * @return 作业结果
+ */
+AccrualReport AccountViewModel::runInterestAccrual(int threads)
+{
+    const AccrualReport report = m_accountModel.runInterestAccrual(threads);
+    if (report.interestPostings + report.feePostings > 0) {
+        emit bankSummaryChanged();
+        if (m_isLoggedIn) {
+            emit balanceChanged();
+        }
+    }
+    return report;
+}
+
 // --- 属性获取方法 ---
 
 /**
@@ -117,6 +201,18 @@ QString AccountViewModel::errorMessage() const
     return m_errorMessage;
 }
 
+/**
+ * @brief 获取最近一次取款、存款或转账的交易编号
+ *
+ * 在操作成功时由 OperationResult::transactionId 设置，不受定时作业随后写入的记录影响。
+ *
+ * @return 交易编号字符串，没有时返回空字符串
+ */
+QString AccountViewModel::completedTransactionId() const
+{
+    return m_completedTransactionId;
+}
+
 /**
  * @brief 获取管理员状态
  * @return 如果当前登录用户是管理员返回 true，否则返回 false
@@ -126,6 +222,15 @@ bool AccountViewModel::isAdmin() const
     return m_isAdmin;
 }
 
+/**
+ * @brief 获取全行汇总属性
+ * @return 总余额、账户数、锁定账户数和今日交易笔数及金额等
+ */
+QVariantMap AccountViewModel::bankSummary() const
+{
+    return m_accountModel.bankSummary();
+}
+
 /**
  * @brief 获取预测余额属性
  * @return 预测余额
@@ -168,6 +273,7 @@ bool AccountViewModel::login(const QString &pin)
 
     // 直接调用 Model 层执行登录
     LoginResult loginResult = m_accountModel.performLogin(m_cardNumber, pin);
+    emit bankSummaryChanged(); // 登录失败可能触发临时锁定
     if (loginResult.success) {
         m_isLoggedIn = true;
         m_isAdmin = loginResult.isAdmin;
@@ -217,6 +323,7 @@ bool AccountViewModel::adminLogin(const QString &cardNumber, const QString &pin)
     
     // 调用管理员登录方法
     LoginResult loginResult = m_accountModel.performAdminLogin(cardNumber, pin);
+    emit bankSummaryChanged(); // 登录失败可能触发临时锁定
     if (loginResult.success) {
         m_isLoggedIn = true;
         m_isAdmin = true; // 管理员登录，强制设置为管理员
@@ -244,6 +351,7 @@ bool AccountViewModel::adminLogin(const QString &cardNumber, const QString &pin)
 bool AccountViewModel::withdraw(double amount)
 {
     clearError();
+    setCompletedTransactionId(0);
 
     if (!m_isLoggedIn) {
         setErrorMessage("请先登录");
@@ -253,6 +361,9 @@ bool AccountViewModel::withdraw(double amount)
     // 直接调用Model层的方法，由Model层统一处理所有验证
     OperationResult withdrawResult = m_accountModel.withdrawAmount(m_cardNumber, amount);
     if (withdrawResult.success) {
+        // 回单使用本次取款在账本中的编号，而不是该卡最近的一笔交易
+        setCompletedTransactionId(withdrawResult.transactionId);
+
         // 通知余额变化
         emit balanceChanged();
         
@@ -271,6 +382,7 @@ bool AccountViewModel::withdraw(double amount)
 bool AccountViewModel::deposit(double amount)
 {
     clearError();
+    setCompletedTransactionId(0);
 
     if (!m_isLoggedIn) {
         setErrorMessage("请先登录");
@@ -280,6 +392,8 @@ bool AccountViewModel::deposit(double amount)
     // 直接调用Model层的方法，由Model层统一处理所有验证
     OperationResult depositResult = m_accountModel.depositAmount(m_cardNumber, amount);
     if (depositResult.success) {
+        setCompletedTransactionId(depositResult.transactionId);
+
         // 通知余额变化
         emit balanceChanged();
         
@@ -299,6 +413,7 @@ bool AccountViewModel::deposit(double amount)
 bool AccountViewModel::transfer(const QString &targetCard, double amount)
 {
     clearError();
+    setCompletedTransactionId(0);
 
     if (!m_isLoggedIn) {
         setErrorMessage("请先登录");
@@ -308,6 +423,8 @@ bool AccountViewModel::transfer(const QString &targetCard, double amount)
     // 直接调用Model层的方法，由Model层统一处理所有验证
     OperationResult transferResult = m_accountModel.transferAmount(m_cardNumber, targetCard, amount);
     if (transferResult.success) {
+        setCompletedTransactionId(transferResult.transactionId);
+
         // 通知余额变化
         emit balanceChanged();
         
@@ -318,6 +435,96 @@ bool AccountViewModel::transfer(const QString &targetCard, double amount)
     }
 }
 
+/**
+ * @brief 为当前卡号创建定期转账
+ * @param targetCard 目标卡号
+ * @param amount 每次转账金额
+ * @param frequency 周期（0 每天, 1 每周, 2 每月）
+ * @param dayOfMonth 每月执行日
+ * @param description 交易描述
+ * @return 如果创建成功返回 true，否则返回 false
+ */
+bool AccountViewModel::createStandingOrder(const QString &targetCard, double amount, int frequency,
+                                           int dayOfMonth, const QString &description)
+{
+    clearError();
+
+    if (!m_isLoggedIn) {
+        setErrorMessage("请先登录");
+        return false;
+    }
+    if (frequency < static_cast<int>(StandingOrderFrequency::Daily)
+        || frequency > static_cast<int>(StandingOrderFrequency::Monthly)) {
+        setErrorMessage("无效的转账周期");
+        return false;
+    }
+
+    StandingOrder order;
+    order.fromCardNumber = m_cardNumber;
+    order.toCardNumber = targetCard;
+    order.amount = amount;
+    order.frequency = static_cast<StandingOrderFrequency>(frequency);
+    order.dayOfMonth = dayOfMonth;
+    order.description = description;
+
+    OperationResult result = m_accountModel.addStandingOrder(order);
+    if (!result.success) {
+        setErrorMessage(result.errorMessage);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 取消当前卡号的定期转账
+ * @param orderId 指令编号
+ * @return 如果取消成功返回 true，否则返回 false
+ */
+bool AccountViewModel::cancelStandingOrder(const QString &orderId)
+{
+    clearError();
+
+    if (!m_isLoggedIn) {
+        setErrorMessage("请先登录");
+        return false;
+    }
+
+    OperationResult result = m_accountModel.cancelStandingOrder(orderId.toULongLong(), m_cardNumber);
+    if (!result.success) {
+        setErrorMessage(result.errorMessage);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 获取当前卡号的定期转账
+ * @return 定期转账列表
+ */
+QVariantList AccountViewModel::standingOrders() const
+{
+    QVariantList result;
+    if (!m_isLoggedIn) {
+        return result;
+    }
+
+    for (const StandingOrder& order : m_accountModel.getStandingOrders(m_cardNumber)) {
+        QVariantMap item;
+        item["id"] = QString::number(order.id);
+        item["targetCard"] = order.toCardNumber;
+        item["amount"] = order.amount;
+        item["frequency"] = static_cast<int>(order.frequency);
+        item["frequencyName"] = StandingOrder::frequencyName(order.frequency);
+        item["dayOfMonth"] = order.dayOfMonth;
+        item["nextRunDate"] = order.nextRunDate;
+        item["lastRunDate"] = order.lastRunDate;
+        item["lastError"] = order.lastError;
+        item["description"] = order.description;
+        result.append(item);
+    }
+    return result;
+}
+
 /**
  * @brief 验证转账目标卡号的有效性
  * @param targetCard 目标卡号
@@ -402,6 +609,7 @@ void AccountViewModel::logout()
         m_isAdmin = false;
         m_cardNumber.clear();
         m_errorMessage.clear();
+        setCompletedTransactionId(0);
 
         // 发出信号通知 UI
         emit isLoggedInChanged();
@@ -431,6 +639,19 @@ void AccountViewModel::clearError()
     }
 }
 
+/**
+ * @brief 设置最近一次取款、存款或转账在账本中的交易编号
+ * @param transactionId 交易编号，0 表示没有
+ */
+void AccountViewModel::setCompletedTransactionId(quint64 transactionId)
+{
+    const QString id = TransactionIdGenerator::toString(transactionId);
+    if (m_completedTransactionId != id) {
+        m_completedTransactionId = id;
+        emit completedTransactionIdChanged();
+    }
+}
+
 /**
  * @brief 设置当前的错误信息
  * @param message 错误信息字符串
@@ -822,6 +1043,72 @@ bool AccountViewModel::setWithdrawLimit(const QString &cardNumber, double limit)
     }
 }
 
+/**
+ * @brief 以全量重新计算核对全行汇总 (管理员权限)
+ * @return 如果汇总与全量计算一致返回 true，否则返回 false
+ */
+bool AccountViewModel::verifyBankSummary()
+{
+    clearError();
+
+    if (!checkAdminPermission("核对全行汇总需要管理员权限")) {
+        return false;
+    }
+
+    OperationResult result = m_accountModel.verifyAggregates();
+    if (!result.success) {
+        setErrorMessage("全行汇总不一致: " + result.errorMessage);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 获取余额最高的账户 (管理员权限)
+ * @param n 数量
+ * @return 列表，每项包含 cardNumber 和 balance
+ */
+QVariantList AccountViewModel::topBalances(int n)
+{
+    clearError();
+
+    QVariantList result;
+    if (!checkAdminPermission("查看余额排行需要管理员权限")) {
+        return result;
+    }
+
+    for (const LeaderboardEntry& entry : m_accountModel.getTopBalances(n)) {
+        QVariantMap item;
+        item["cardNumber"] = entry.cardNumber;
+        item["balance"] = entry.value;
+        result.append(item);
+    }
+    return result;
+}
+
+/**
+ * @brief 获取最近 24 小时交易次数最多的卡号 (管理员权限)
+ * @param n 数量
+ * @return 列表，每项包含 cardNumber 和 count
+ */
+QVariantList AccountViewModel::mostActiveCards(int n)
+{
+    clearError();
+
+    QVariantList result;
+    if (!checkAdminPermission("查看活跃卡号排行需要管理员权限")) {
+        return result;
+    }
+
+    for (const LeaderboardEntry& entry : m_accountModel.getMostActiveCards(n)) {
+        QVariantMap item;
+        item["cardNumber"] = entry.cardNumber;
+        item["count"] = qRound(entry.value);
+        result.append(item);
+    }
+    return result;
+}
+
 /**
  * @brief 处理操作结果，设置错误信息并发送完成信号
  * @param result 操作结果
@@ -833,6 +1120,8 @@ bool AccountViewModel::handleOperationResult(const OperationResult& result, cons
     if (result.success) {
         // 清除错误信息
         clearError();
+        // 账户或交易已变化，全行汇总随之更新
+        emit bankSummaryChanged();
         // 发送操作完成信号
         emit transactionCompleted(true, successMessage);
         return true;
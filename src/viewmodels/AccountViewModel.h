@@ -34,6 +34,8 @@ class AccountViewModel : public QObject
     Q_PROPERTY(bool isLoggedIn READ isLoggedIn NOTIFY isLoggedInChanged)
     Q_PROPERTY(QString errorMessage READ errorMessage NOTIFY errorMessageChanged)
     Q_PROPERTY(bool isAdmin READ isAdmin NOTIFY isAdminChanged)
+    Q_PROPERTY(QVariantMap bankSummary READ bankSummary NOTIFY bankSummaryChanged)
+    Q_PROPERTY(QString completedTransactionId READ completedTransactionId NOTIFY completedTransactionIdChanged)
 
 public:
     /**
@@ -42,6 +44,18 @@ public:
      */
     explicit AccountViewModel(QObject *parent = nullptr);
 
+    /**
+     * @brief 构造函数
+     *
+     * 用于在启动时选择账户数据的存储后端。
+     *
+     * @param repository 账户存储库（所有权转移给内部的 AccountModel）
+     * @param persistenceManager 数据目录的JSON持久化管理器（定期转账指令等）
+     * @param parent 父对象
+     */
+    AccountViewModel(std::unique_ptr<IAccountRepository> repository, JsonPersistenceManager *persistenceManager,
+                     QObject *parent = nullptr);
+
     /**
      * @brief 设置交易数据模型引用
      *
@@ -51,6 +65,47 @@ public:
      */
     void setTransactionModel(TransactionModel *model);
 
+    /**
+     * @brief 设置时间来源
+     * @param clock 时钟，为空时使用系统时钟
+     */
+    void setClock(const Clock* clock);
+
+    /**
+     * @brief 校验账本与账户余额的一致性
+     * @param threads 线程数，0 表示自动
+     * @return 校验报告
+     */
+    LedgerReport verifyLedger(int threads = 0) const;
+
+    /**
+     * @brief 回测全部余额预测模型并选出默认模型
+     * @param horizonDays 预测天数
+     * @param threads 线程数，0 表示自动
+     * @return 回测报告
+     */
+    ForecastBacktestReport backtestForecasters(int horizonDays = 7, int threads = 0) const;
+
+    /**
+     * @brief 执行全部到期的定期转账
+     *
+     * 由 AppController 的定时器定期调用，有转账执行时通知余额和全行汇总变化。
+     *
+     * @param batchSize 每批的指令数，不大于0时使用默认值
+     * @return 执行结果
+     */
+    StandingOrderRunReport runStandingOrders(int batchSize = 0);
+
+    /**
+     * @brief 执行到期的批量计息与收费
+     *
+     * 由 AppController 的定时器定期调用，每天只入账一次。
+     *
+     * @param threads 线程数，0 表示自动
+     * @return 作业结果
+     */
+    AccrualReport runInterestAccrual(int threads = 0);
+
     // --- 属性获取方法 ---
     QString cardNumber() const;
     QString holderName() const;
@@ -61,6 +116,8 @@ public:
     bool isLoggedIn() const;
     QString errorMessage() const;
     bool isAdmin() const;
+    QVariantMap bankSummary() const;
+    QString completedTransactionId() const;
 
     /**
      * @brief 设置当前卡号
@@ -120,6 +177,29 @@ public:
      * @return 目标卡号的持卡人姓名，如果无效返回空字符串
      */
     Q_INVOKABLE QString getTargetCardHolderName(const QString &targetCard);
+    /**
+     * @brief 为当前卡号创建定期转账
+     * @param targetCard 目标卡号
+     * @param amount 每次转账金额
+     * @param frequency 周期（0 每天, 1 每周, 2 每月）
+     * @param dayOfMonth 每月执行日（仅每月周期使用，超出月末时在月末执行）
+     * @param description 交易描述，为空时使用默认描述
+     * @return 如果创建成功返回 true，否则返回 false
+     */
+    Q_INVOKABLE bool createStandingOrder(const QString &targetCard, double amount, int frequency,
+                                         int dayOfMonth = 1, const QString &description = QString());
+    /**
+     * @brief 取消当前卡号的定期转账
+     * @param orderId 指令编号
+     * @return 如果取消成功返回 true，否则返回 false
+     */
+    Q_INVOKABLE bool cancelStandingOrder(const QString &orderId);
+    /**
+     * @brief 获取当前卡号的定期转账
+     * @return 列表，每项包含 id、targetCard、amount、frequency、frequencyName、dayOfMonth、
+     *         nextRunDate、lastRunDate、lastError 和 description
+     */
+    Q_INVOKABLE QVariantList standingOrders() const;
     /**
      * @brief 处理修改账户 PIN 码操作
      * @param currentPin 当前 PIN 码
@@ -210,6 +290,23 @@ public:
      * @return 如果成功设置返回 true，否则返回 false
      */
     Q_INVOKABLE bool setWithdrawLimit(const QString &cardNumber, double limit);
+    /**
+     * @brief 以全量重新计算核对全行汇总 (管理员权限)
+     * @return 如果汇总与全量计算一致返回 true，否则返回 false 并设置错误信息
+     */
+    Q_INVOKABLE bool verifyBankSummary();
+    /**
+     * @brief 获取余额最高的账户 (管理员权限)
+     * @param n 数量
+     * @return 列表，每项包含 cardNumber 和 balance
+     */
+    Q_INVOKABLE QVariantList topBalances(int n = 100);
+    /**
+     * @brief 获取最近 24 小时交易次数最多的卡号 (管理员权限)
+     * @param n 数量
+     * @return 列表，每项包含 cardNumber 和 count
+     */
+    Q_INVOKABLE QVariantList mostActiveCards(int n = 100);
 
 
 signals:
@@ -223,6 +320,8 @@ signals:
     void isLoggedInChanged();
     void errorMessageChanged();
     void isAdminChanged();
+    void bankSummaryChanged();
+    void completedTransactionIdChanged();
     /**
      * @brief 用户登出时发出的信号
      */
@@ -261,9 +360,16 @@ private:
      */
     bool handleOperationResult(const OperationResult& result, const QString& successMessage);
 
+    /**
+     * @brief 设置最近一次取款、存款或转账在账本中的交易编号
+     * @param transactionId 交易编号，0 表示没有
+     */
+    void setCompletedTransactionId(quint64 transactionId);
+
     // --- 私有成员变量 (支持 Q_PROPERTY) ---
     QString m_cardNumber;       //!< 当前登录的账户卡号
     QString m_errorMessage;     //!< 当前显示的错误信息
+    QString m_completedTransactionId; //!< 最近一次取款、存款或转账的交易编号，回单打印使用
     double m_predictedBalance;  //!< 预测余额
     QVariantMap m_multiDayPredictions; //!< 多日期预测余额
     bool m_isLoggedIn;          //!< 是否已登录
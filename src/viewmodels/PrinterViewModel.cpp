@@ -156,6 +156,11 @@ bool PrinterViewModel::printReceipt(
     const QString &targetCardHolder,
     const QString &transactionId)
 {
+    if (transactionId.isEmpty()) {
+        qWarning() << "缺少交易编号，拒绝打印" << transactionType << "回单";
+        return false;
+    }
+
     // 记录打印请求日志
     qDebug() << "打印" << transactionType << "回单"
              << "卡号:" << cardNumber
@@ -41,7 +41,7 @@ public:
      * @param holderName 持卡人姓名
      * @param amount 存款金额
      * @param balanceAfter 存款后余额
-     * @param transactionId 交易编号 (默认为空，由 Model 生成)
+     * @param transactionId 账本中的交易编号，为空时不打印
      * @return 如果打印成功返回 true，否则返回 false
      */
     Q_INVOKABLE bool printDepositReceipt(
@@ -50,7 +50,7 @@ public:
         const QString &holderName,
         double amount,
         double balanceAfter,
-        const QString &transactionId = QString()
+        const QString &transactionId
     );
 
     /**
@@ -63,7 +63,7 @@ public:
      * @param holderName 持卡人姓名
      * @param amount 取款金额
      * @param balanceAfter 取款后余额
-     * @param transactionId 交易编号 (默认为空，由 Model 生成)
+     * @param transactionId 账本中的交易编号，为空时不打印
      * @return 如果打印成功返回 true，否则返回 false
      */
     Q_INVOKABLE bool printWithdrawalReceipt(
@@ -72,7 +72,7 @@ public:
         const QString &holderName,
         double amount,
         double balanceAfter,
-        const QString &transactionId = QString()
+        const QString &transactionId
     );
 
     /**
@@ -87,7 +87,7 @@ public:
      * @param balanceAfter 转账后余额
      * @param targetCardNumber 转入卡号
      * @param targetCardHolder 转入持卡人姓名
-     * @param transactionId 交易编号 (默认为空，由 Model 生成)
+     * @param transactionId 账本中的交易编号，为空时不打印
      * @return 如果打印成功返回 true，否则返回 false
      */
     Q_INVOKABLE bool printTransferReceipt(
@@ -98,7 +98,7 @@ public:
         double balanceAfter,
         const QString &targetCardNumber,
         const QString &targetCardHolder,
-        const QString &transactionId = QString()
+        const QString &transactionId
     );
 
 private:
@@ -106,6 +106,7 @@ private:
      * @brief 通用打印回单方法
      *
      * 调用 PrinterModel 生成回单的 HTML 内容，并触发打印。此方法统一处理所有类型的回单打印。
+     * 没有交易编号的回单无法与账本对应，直接拒绝打印。
      *
      * @param bankName 银行名称
      * @param cardNumber 卡号
@@ -196,7 +196,7 @@ QString TransactionViewModel::formatDate(const QDateTime &dateTime) const
         return m_transactionModel->formatDate(dateTime);
     }
     qWarning() << "formatDate: TransactionModel未设置";
-    return dateTime.toString("yyyy-MM-dd hh:mm:ss");
+    return dateTime.toLocalTime().toString("yyyy-MM-dd hh:mm:ss");
 }
 
 /**
@@ -231,8 +231,11 @@ TransactionViewModel::TransactionViewType TransactionViewModel::convertTransacti
 {
     switch (modelType) {
         case TransactionType::Deposit:
+        case TransactionType::TransferIn: // 转入在界面上与存款一样显示为收入
+        case TransactionType::Interest:
             return TransactionViewType::Deposit;
         case TransactionType::Withdrawal:
+        case TransactionType::Fee:
             return TransactionViewType::Withdrawal;
         case TransactionType::BalanceInquiry:
             return TransactionViewType::BalanceInquiry;
@@ -0,0 +1,194 @@
+/**
+ * @file CardNumberTest.cpp
+ * @brief CardNumber 单元测试
+ *
+ * 以逐字符的标量实现为参照，用固定用例和随机输入检查 SWAR 解析的格式判断、整数值和 Luhn 校验。
+ */
+#include <QRandomGenerator>
+#include <QtTest>
+#include "models/Account.h"
+#include "models/CardNumber.h"
+
+namespace {
+
+//!< 每组随机输入的数量
+const int kFuzzIterations = 200000;
+
+/**
+ * @brief 逐字符的参照实现
+ * @param text 卡号
+ * @return 解析结果
+ */
+CardNumber::Parsed referenceParse(const QString& text)
+{
+    CardNumber::Parsed result;
+    if (text.size() != CardNumber::LENGTH) {
+        return result;
+    }
+    quint64 packed = 0;
+    int sum = 0;
+    for (int i = 0; i < CardNumber::LENGTH; ++i) {
+        const ushort c = text.at(i).unicode();
+        if (c < '0' || c > '9') {
+            return result;
+        }
+        // 从右数第2、4……位加倍，16位卡号中即从左数的偶数下标
+        int digit = c - '0';
+        packed = packed * 10 + digit;
+        if (i % 2 == 0) {
+            digit *= 2;
+            if (digit > 9) {
+                digit -= 9;
+            }
+        }
+        sum += digit;
+    }
+    result.wellFormed = true;
+    result.packed = packed;
+    result.luhnValid = sum % 10 == 0;
+    return result;
+}
+
+/**
+ * @brief 比较 SWAR 解析与参照实现的结果
+ * @param text 卡号
+ * @return 如果一致返回true
+ */
+bool matchesReference(const QString& text)
+{
+    const CardNumber::Parsed actual = CardNumber::parse(text);
+    const CardNumber::Parsed expected = referenceParse(text);
+    return actual.wellFormed == expected.wellFormed && actual.packed == expected.packed
+           && actual.luhnValid == expected.luhnValid;
+}
+
+/**
+ * @brief 转义输入，便于在失败信息中看清非 ASCII 字符
+ * @param text 输入
+ * @return 每个 UTF-16 单元的十六进制值
+ */
+QByteArray describe(const QString& text)
+{
+    QByteArray out;
+    for (const QChar& c : text) {
+        out += QByteArray::number(c.unicode(), 16) + ' ';
+    }
+    return out;
+}
+
+} // namespace
+
+/**
+ * @brief CardNumber 单元测试
+ */
+class CardNumberTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void knownNumbers_data();
+    void knownNumbers();
+    void everyPositionRejectsNonDigits();
+    void fuzzDigitStrings();
+    void fuzzMixedStrings();
+    void formatRoundTrip();
+};
+
+void CardNumberTest::knownNumbers_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<bool>("wellFormed");
+    QTest::addColumn<bool>("luhnValid");
+
+    QTest::newRow("visa test card") << "4111111111111111" << true << true;
+    QTest::newRow("mastercard test card") << "5555555555554444" << true << true;
+    QTest::newRow("all zeros") << "0000000000000000" << true << true;
+    QTest::newRow("bad check digit") << "4111111111111112" << true << false;
+    QTest::newRow("bundled test account") << "1234567890123456" << true << false;
+    QTest::newRow("all nines") << "9999999999999999" << true << false;
+    QTest::newRow("empty") << "" << false << false;
+    QTest::newRow("15 digits") << "411111111111111" << false << false;
+    QTest::newRow("17 digits") << "41111111111111111" << false << false;
+    QTest::newRow("space") << "4111 11111111111" << false << false;
+    QTest::newRow("fullwidth digit") << QString("411111111111111") + QChar(0xFF11) << false << false;
+    QTest::newRow("arabic-indic digit") << QChar(0x0664) + QString("111111111111111") << false << false;
+}
+
+void CardNumberTest::knownNumbers()
+{
+    QFETCH(QString, text);
+    QFETCH(bool, wellFormed);
+    QFETCH(bool, luhnValid);
+
+    const CardNumber::Parsed parsed = CardNumber::parse(text);
+    QCOMPARE(parsed.wellFormed, wellFormed);
+    QCOMPARE(parsed.luhnValid, luhnValid);
+    QCOMPARE(CardNumber::isWellFormed(text), wellFormed);
+    QCOMPARE(CardNumber::isValid(text), luhnValid);
+    QCOMPARE(Account::isValidCardNumber(text), wellFormed);
+    QVERIFY(matchesReference(text));
+}
+
+void CardNumberTest::everyPositionRejectsNonDigits()
+{
+    // 紧邻 '0'~'9' 的字符、高位不为零的字符以及各种非 ASCII 数字，逐个放到每个位置
+    const ushort probes[] = {0x0000, 0x002F, 0x003A, 0x003F, 0x0040, 0x0130, 0x1030, 0x3039,
+                             0xFF10, 0x0660, 0x0966, 0xFFFF, 0xFFF9, 0x0020};
+    for (int position = 0; position < CardNumber::LENGTH; ++position) {
+        for (ushort probe : probes) {
+            QString text("4111111111111111");
+            text[position] = QChar(probe);
+            QVERIFY2(!CardNumber::parse(text).wellFormed, describe(text).constData());
+            QVERIFY2(matchesReference(text), describe(text).constData());
+        }
+    }
+}
+
+void CardNumberTest::fuzzDigitStrings()
+{
+    // 全部为 ASCII 数字：检查整数值和 Luhn 校验（约十分之一的输入校验通过）
+    QRandomGenerator random(20240559);
+    int luhnValid = 0;
+    for (int i = 0; i < kFuzzIterations; ++i) {
+        QString text(CardNumber::LENGTH, Qt::Uninitialized);
+        for (int j = 0; j < CardNumber::LENGTH; ++j) {
+            text[j] = QChar('0' + random.bounded(10));
+        }
+        if (!matchesReference(text)) {
+            QFAIL(qPrintable(text));
+        }
+        luhnValid += CardNumber::isValid(text) ? 1 : 0;
+    }
+    QVERIFY(luhnValid > kFuzzIterations / 20 && luhnValid < kFuzzIterations / 5);
+}
+
+void CardNumberTest::fuzzMixedStrings()
+{
+    // 每个字符以 7/8 的概率为数字，否则为任意 UTF-16 单元；长度偶尔偏离16位
+    QRandomGenerator random(59);
+    for (int i = 0; i < kFuzzIterations; ++i) {
+        const int length = random.bounded(16) == 0 ? int(random.bounded(20)) : CardNumber::LENGTH;
+        QString text(length, Qt::Uninitialized);
+        for (int j = 0; j < length; ++j) {
+            text[j] = random.bounded(8) == 0 ? QChar(ushort(random.bounded(0x10000)))
+                                             : QChar('0' + random.bounded(10));
+        }
+        if (!matchesReference(text)) {
+            QFAIL(describe(text).constData());
+        }
+    }
+}
+
+void CardNumberTest::formatRoundTrip()
+{
+    QRandomGenerator random(16);
+    for (int i = 0; i < kFuzzIterations; ++i) {
+        QString text(CardNumber::LENGTH, Qt::Uninitialized);
+        for (int j = 0; j < CardNumber::LENGTH; ++j) {
+            text[j] = QChar('0' + random.bounded(10));
+        }
+        QCOMPARE(CardNumber::format(CardNumber::parse(text).packed), text);
+    }
+}
+
+QTEST_APPLESS_MAIN(CardNumberTest)
+#include "CardNumberTest.moc"
@@ -0,0 +1,409 @@
+/**
+ * @file ReplicationLagTest.cpp
+ * @brief 主备复制单元测试
+ *
+ * 主节点和备用节点各用一个临时数据目录，在同一进程中经本地套接字复制，检查：
+ * - 首次连接发送快照，之后持续应用变更，两边的数据一致
+ * - 逐笔写入和连续写入时每条变更的复制延迟（从写入主节点日志到备用节点组提交完成）
+ * - 重启的备用节点从进度续传；落后超出日志上限时改为快照追赶，日志字节数不超过上限
+ * - 提升后数据目录可以直接由主节点的存储类加载
+ *
+ * 两个节点共用一个事件循环，测得的延迟包含双方的写文件时间，偏保守。
+ */
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtTest>
+#include <algorithm>
+#include <memory>
+#include "models/JsonAccountRepository.h"
+#include "models/JsonPersistenceManager.h"
+#include "models/JsonTransactionStore.h"
+#include "models/ReplicatingAccountRepository.h"
+#include "models/ReplicatingTransactionStore.h"
+#include "models/ReplicationPrimary.h"
+#include "models/ReplicationStandby.h"
+#include "models/TransactionModel.h"
+
+namespace {
+
+//!< 测试账户数
+const int kAccounts = 200;
+
+//!< 逐笔写入的存款笔数
+const int kPacedDeposits = 200;
+
+//!< 连续写入的存款笔数
+const int kBurstDeposits = 2000;
+
+//!< 连续写入时每写入多少笔处理一次事件
+const int kBurstGroup = 20;
+
+//!< 逐笔写入时 p99 复制延迟的上限（毫秒）
+const qint64 kMaxPacedP99LagMs = 250;
+
+//!< 等待备用节点追上的超时（毫秒）
+const int kCatchUpTimeoutMs = 10000;
+
+//!< 测试日志上限时使用的日志字节数上限
+const qint64 kSmallLogBytes = 16 * 1024;
+
+/**
+ * @brief 生成测试账户
+ * @param index 序号
+ * @return 账户
+ */
+Account makeAccount(int index)
+{
+    static const QString salt = Account::generateSalt();
+    static const QString pinHash = Account::hashPin("123456", salt);
+
+    Account account;
+    account.cardNumber = "62" + QString::number(index).rightJustified(14, '0');
+    account.pinHash = pinHash;
+    account.salt = salt;
+    account.holderName = QString("测试用户%1").arg(index);
+    account.balance = 1000.0;
+    account.withdrawLimit = 5000.0;
+    return account;
+}
+
+/**
+ * @brief 主节点：复制装饰器包装的 JSON 存储，加上复制日志和复制服务
+ */
+struct PrimaryNode {
+    QTemporaryDir directory;                    //!< 数据目录
+    JsonPersistenceManager manager;             //!< 持久化管理器
+    ReplicationLog log;                         //!< 复制日志
+    ReplicatingAccountRepository repository;    //!< 账户存储库
+    TransactionModel transactions;              //!< 交易模型
+    ReplicationPrimary primary;                 //!< 复制服务
+
+    explicit PrimaryNode(qint64 logBytes)
+        : manager(nullptr, directory.path())
+        , log(logBytes)
+        , repository(std::make_unique<JsonAccountRepository>(&manager, "accounts.json"), &log)
+        , transactions(std::make_unique<ReplicatingTransactionStore>(
+                           std::make_unique<JsonTransactionStore>(&manager, "transactions.json"), &log))
+        , primary(&log, &repository, &transactions)
+    {
+        QVector<Account> accounts;
+        for (int i = 0; i < kAccounts; ++i) {
+            accounts.append(makeAccount(i));
+        }
+        repository.saveAccountsBatch(accounts);
+    }
+
+    /**
+     * @brief 存款：修改余额并记账，各产生一条变更
+     * @param index 存款序号
+     */
+    void deposit(int index)
+    {
+        const QString cardNumber = makeAccount(index % kAccounts).cardNumber;
+        Account account = *repository.findByCardNumber(cardNumber);
+        account.balance += 10.0;
+        repository.saveAccount(account);
+        transactions.recordTransaction(cardNumber, TransactionType::Deposit, 10.0, account.balance, "存款");
+    }
+};
+
+/**
+ * @brief 备用节点：独立的数据目录
+ */
+struct StandbyNode {
+    JsonPersistenceManager manager;     //!< 持久化管理器
+    ReplicationStandby standby;         //!< 备用节点
+
+    StandbyNode(const QString& dataPath, const QString& serverName)
+        : manager(nullptr, dataPath)
+        , standby(&manager, serverName)
+    {
+    }
+};
+
+/**
+ * @brief 记录每条变更的复制延迟
+ *
+ * 每次处理事件后读取备用节点已应用的序号，新应用的变更以当前时间减去写入主节点日志的时间为延迟。
+ */
+class LagProbe {
+public:
+    LagProbe(const ReplicationLog* log, const ReplicationStandby* standby)
+        : m_log(log), m_standby(standby), m_seenLsn(standby->status().appliedLsn)
+    {
+    }
+
+    /**
+     * @brief 处理一次事件并记录新应用的变更
+     */
+    void poll()
+    {
+        QCoreApplication::processEvents();
+        const quint64 applied = m_standby->status().appliedLsn;
+        const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+        for (quint64 lsn = qMax(m_seenLsn + 1, m_log->firstLsn()); lsn <= applied; ++lsn) {
+            m_samples.append(nowMs - m_log->entry(lsn).utcMs);
+        }
+        m_seenLsn = qMax(m_seenLsn, applied);
+    }
+
+    /**
+     * @brief 等待备用节点应用到指定序号
+     * @param lsn 序号
+     * @return 超时前应用到该序号返回true
+     */
+    bool waitFor(quint64 lsn)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (m_seenLsn < lsn) {
+            if (timer.elapsed() > kCatchUpTimeoutMs) {
+                return false;
+            }
+            poll();
+        }
+        return true;
+    }
+
+    /**
+     * @brief 获取延迟分位数
+     * @param fraction 分位（0 ~ 1）
+     * @return 延迟（毫秒）
+     */
+    qint64 percentile(double fraction)
+    {
+        if (m_samples.isEmpty()) {
+            return 0;
+        }
+        std::sort(m_samples.begin(), m_samples.end());
+        return m_samples.at(qMin(int(m_samples.size() * fraction), int(m_samples.size()) - 1));
+    }
+
+    int samples() const { return int(m_samples.size()); }
+
+private:
+    const ReplicationLog* m_log;
+    const ReplicationStandby* m_standby;
+    quint64 m_seenLsn;
+    QVector<qint64> m_samples;
+};
+
+/**
+ * @brief 生成本进程唯一的套接字名称
+ * @return 套接字名称
+ */
+QString uniqueServerName()
+{
+    static int counter = 0;
+    return QString("atm-replication-test-%1-%2").arg(QCoreApplication::applicationPid()).arg(++counter);
+}
+
+/**
+ * @brief 检查数据目录中的账户和账本与主节点一致
+ * @param dataPath 备用节点的数据目录
+ * @param primary 主节点
+ * @return 不一致之处的说明，一致时为空
+ */
+QString compareWithPrimary(const QString& dataPath, PrimaryNode& primary)
+{
+    JsonPersistenceManager manager(nullptr, dataPath);
+    JsonAccountRepository accounts(&manager, "accounts.json");
+    const QVector<Account> expectedAccounts = primary.repository.getAllAccounts();
+    if (accounts.getAllAccounts().size() != expectedAccounts.size()) {
+        return QString("备用节点有 %1 个账户，应为 %2 个")
+            .arg(accounts.getAllAccounts().size()).arg(expectedAccounts.size());
+    }
+    for (const Account& expected : expectedAccounts) {
+        const std::optional<Account> account = accounts.findByCardNumber(expected.cardNumber);
+        if (!account || account->balance != expected.balance) {
+            return QString("卡 %1 的余额不一致").arg(expected.cardNumber);
+        }
+    }
+
+    JsonTransactionStore store(&manager, "transactions.json");
+    QVector<Transaction> transactions;
+    store.loadTransactions(transactions);
+    const QVector<Transaction> expectedTransactions = primary.transactions.getAllTransactions();
+    if (transactions.size() != expectedTransactions.size()) {
+        return QString("备用节点有 %1 条交易，应为 %2 条").arg(transactions.size()).arg(expectedTransactions.size());
+    }
+    for (int i = 0; i < transactions.size(); ++i) {
+        if (transactions.at(i).id != expectedTransactions.at(i).id
+            || transactions.at(i).amount != expectedTransactions.at(i).amount) {
+            return QString("第 %1 条交易不一致").arg(i);
+        }
+    }
+    return QString();
+}
+
+} // namespace
+
+/**
+ * @brief 主备复制单元测试
+ */
+class ReplicationLagTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void snapshotThenStream();
+    void lagUnderLoad();
+    void resumeAndBoundedCatchUp();
+    void promote();
+};
+
+void ReplicationLagTest::initTestCase()
+{
+    // 每笔交易和每次保存都有调试输出，只保留延迟统计和警告
+    QLoggingCategory::setFilterRules("default.debug=false");
+}
+
+void ReplicationLagTest::snapshotThenStream()
+{
+    PrimaryNode primary(8 * 1024 * 1024);
+    const QString serverName = uniqueServerName();
+    QVERIFY(primary.primary.listen(serverName));
+    QTemporaryDir standbyDirectory;
+    StandbyNode node(standbyDirectory.path(), serverName);
+    node.standby.start();
+
+    LagProbe probe(&primary.log, &node.standby);
+    QVERIFY(probe.waitFor(primary.log.lastLsn()));
+    QCOMPARE(node.standby.status().snapshotsApplied, 1);
+    QCOMPARE(node.standby.status().accounts, int(primary.repository.getAllAccounts().size()));
+
+    for (int i = 0; i < 50; ++i) {
+        primary.deposit(i);
+    }
+    QVERIFY(probe.waitFor(primary.log.lastLsn()));
+    QCOMPARE(node.standby.status().snapshotsApplied, 1);
+    QCOMPARE(node.standby.status().transactions, int(primary.transactions.getAllTransactions().size()));
+    const QString difference = compareWithPrimary(standbyDirectory.path(), primary);
+    QVERIFY2(difference.isEmpty(), qPrintable(difference));
+
+    // 备用节点的确认到达后主节点没有未确认的变更
+    QTRY_COMPARE(primary.primary.status().lagRecords, quint64(0));
+}
+
+void ReplicationLagTest::lagUnderLoad()
+{
+    PrimaryNode primary(8 * 1024 * 1024);
+    const QString serverName = uniqueServerName();
+    QVERIFY(primary.primary.listen(serverName));
+    QTemporaryDir standbyDirectory;
+    StandbyNode node(standbyDirectory.path(), serverName);
+    node.standby.start();
+    QTRY_COMPARE(node.standby.status().appliedLsn, primary.log.lastLsn());
+
+    // 逐笔写入：每笔存款后等待备用节点应用
+    LagProbe paced(&primary.log, &node.standby);
+    for (int i = 0; i < kPacedDeposits; ++i) {
+        primary.deposit(i);
+        QVERIFY(paced.waitFor(primary.log.lastLsn()));
+    }
+    qInfo().noquote() << QString("逐笔写入 %1 条变更的复制延迟: p50 %2 ms, p99 %3 ms, 最大 %4 ms")
+                             .arg(paced.samples()).arg(paced.percentile(0.5)).arg(paced.percentile(0.99))
+                             .arg(paced.percentile(1.0));
+    QVERIFY2(paced.percentile(0.99) <= kMaxPacedP99LagMs,
+             qPrintable(QString("p99 复制延迟 %1 ms 超过 %2 ms").arg(paced.percentile(0.99)).arg(kMaxPacedP99LagMs)));
+
+    // 连续写入：主节点不等待确认，每写入一组处理一次事件，备用节点按批组提交
+    LagProbe burst(&primary.log, &node.standby);
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kBurstDeposits; ++i) {
+        primary.deposit(i);
+        if (i % kBurstGroup == kBurstGroup - 1) {
+            burst.poll();
+        }
+    }
+    QVERIFY(burst.waitFor(primary.log.lastLsn()));
+    qInfo().noquote() << QString("连续写入 %1 条变更用时 %2 ms，复制延迟: p50 %3 ms, p99 %4 ms, 最大 %5 ms")
+                             .arg(burst.samples()).arg(timer.elapsed()).arg(burst.percentile(0.5))
+                             .arg(burst.percentile(0.99)).arg(burst.percentile(1.0));
+    QCOMPARE(burst.samples(), 2 * kBurstDeposits);
+    QVERIFY(node.standby.status().maxLagMs >= 0);
+    const QString difference = compareWithPrimary(standbyDirectory.path(), primary);
+    QVERIFY2(difference.isEmpty(), qPrintable(difference));
+}
+
+void ReplicationLagTest::resumeAndBoundedCatchUp()
+{
+    PrimaryNode primary(kSmallLogBytes);
+    const QString serverName = uniqueServerName();
+    QVERIFY(primary.primary.listen(serverName));
+    QTemporaryDir standbyDirectory;
+    {
+        StandbyNode node(standbyDirectory.path(), serverName);
+        node.standby.start();
+        QTRY_COMPARE(node.standby.status().appliedLsn, primary.log.lastLsn());
+    }
+    QTRY_COMPARE(primary.primary.status().standbys, 0);
+
+    // 断开期间的变更仍在日志中：重启后从进度续传，不再发送快照
+    for (int i = 0; i < 5; ++i) {
+        primary.deposit(i);
+    }
+    const int snapshotsBefore = primary.primary.status().snapshotsSent;
+    {
+        StandbyNode node(standbyDirectory.path(), serverName);
+        node.standby.start();
+        QTRY_COMPARE(node.standby.status().appliedLsn, primary.log.lastLsn());
+        QCOMPARE(node.standby.status().snapshotsApplied, 0);
+        QCOMPARE(primary.primary.status().snapshotsSent, snapshotsBefore);
+    }
+    QTRY_COMPARE(primary.primary.status().standbys, 0);
+
+    // 断开期间的变更超出日志上限：日志只保留最近的变更，重启后改为快照追赶
+    const quint64 resumeLsn = primary.log.lastLsn();
+    for (int i = 0; i < 500; ++i) {
+        primary.deposit(i);
+        QVERIFY(primary.log.bytes() <= kSmallLogBytes);
+    }
+    QVERIFY(primary.log.firstLsn() > resumeLsn + 1);
+    {
+        StandbyNode node(standbyDirectory.path(), serverName);
+        node.standby.start();
+        QTRY_COMPARE(node.standby.status().appliedLsn, primary.log.lastLsn());
+        QCOMPARE(node.standby.status().snapshotsApplied, 1);
+        QCOMPARE(primary.primary.status().snapshotsSent, snapshotsBefore + 1);
+    }
+    const QString difference = compareWithPrimary(standbyDirectory.path(), primary);
+    QVERIFY2(difference.isEmpty(), qPrintable(difference));
+}
+
+void ReplicationLagTest::promote()
+{
+    QTemporaryDir standbyDirectory;
+    const QString serverName = uniqueServerName();
+    auto primary = std::make_unique<PrimaryNode>(8 * 1024 * 1024);
+    QVERIFY(primary->primary.listen(serverName));
+    StandbyNode node(standbyDirectory.path(), serverName);
+    QSignalSpy promoted(&node.standby, &ReplicationStandby::promoted);
+    node.standby.start();
+    for (int i = 0; i < 20; ++i) {
+        primary->deposit(i);
+    }
+    QTRY_COMPARE(node.standby.status().appliedLsn, primary->log.lastLsn());
+    QTRY_VERIFY(node.standby.status().connected);
+
+    // 主节点停止后提升，数据目录与主节点最后的状态一致
+    const QString difference = compareWithPrimary(standbyDirectory.path(), *primary);
+    QVERIFY2(difference.isEmpty(), qPrintable(difference));
+    const int transactions = int(primary->transactions.getAllTransactions().size());
+    primary.reset();
+    node.standby.promote();
+    QCOMPARE(promoted.count(), 1);
+    QVERIFY(node.standby.status().promoted);
+    QVERIFY(!node.standby.status().connected);
+
+    JsonPersistenceManager manager(nullptr, standbyDirectory.path());
+    TransactionModel model(&manager, "transactions.json");
+    QCOMPARE(int(model.getAllTransactions().size()), transactions);
+}
+
+QTEST_GUILESS_MAIN(ReplicationLagTest)
+#include "ReplicationLagTest.moc"
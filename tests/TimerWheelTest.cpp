@@ -0,0 +1,273 @@
+/**
+ * @file TimerWheelTest.cpp
+ * @brief TimerWheel 单元测试
+ *
+ * 检查定时器在各层边界和溢出列表中都恰好在到期刻度触发、取消和改期的语义，
+ * 并以"到期表 + 全量扫描"的参照实现对随机操作序列逐步核对。
+ */
+#include <QHash>
+#include <QRandomGenerator>
+#include <QtTest>
+#include <algorithm>
+#include "models/TimerWheel.h"
+
+namespace {
+
+//!< 随机序列的操作数
+const int kRandomOperations = 20000;
+
+//!< 最高层覆盖的刻度数，超出后进入溢出列表
+const qint64 kWheelSpan = qint64(1) << (TimerWheel::SLOT_BITS * TimerWheel::LEVELS);
+
+/**
+ * @brief 参照实现：到期表，推进时扫描全部定时器
+ */
+class ReferenceWheel {
+public:
+    explicit ReferenceWheel(qint64 currentTick) : m_currentTick(currentTick) {}
+
+    void schedule(quint64 id, qint64 dueTick) { m_dueTicks.insert(id, dueTick); }
+    bool cancel(quint64 id) { return m_dueTicks.remove(id) > 0; }
+    bool contains(quint64 id) const { return m_dueTicks.contains(id); }
+    int size() const { return m_dueTicks.size(); }
+    const QHash<quint64, qint64>& dueTicks() const { return m_dueTicks; }
+
+    /**
+     * @brief 推进并取出到期的定时器
+     * @param toTick 目标刻度
+     * @return 到期的定时器编号（升序）
+     */
+    QVector<quint64> advance(qint64 toTick)
+    {
+        m_currentTick = qMax(m_currentTick, toTick);
+        QVector<quint64> fired;
+        for (auto it = m_dueTicks.begin(); it != m_dueTicks.end();) {
+            if (it.value() <= m_currentTick) {
+                fired.append(it.key());
+                it = m_dueTicks.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        std::sort(fired.begin(), fired.end());
+        return fired;
+    }
+
+private:
+    qint64 m_currentTick;
+    QHash<quint64, qint64> m_dueTicks;
+};
+
+/**
+ * @brief 检查触发顺序按到期刻度不减
+ * @param fired 触发的定时器编号
+ * @param dueTicks 定时器编号到到期刻度
+ * @return 顺序正确返回true
+ */
+bool inDueOrder(const QVector<quint64>& fired, const QHash<quint64, qint64>& dueTicks)
+{
+    for (int i = 1; i < fired.size(); ++i) {
+        if (dueTicks.value(fired.at(i - 1)) > dueTicks.value(fired.at(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief TimerWheel 单元测试
+ */
+class TimerWheelTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void firesExactlyAtDueTick_data();
+    void firesExactlyAtDueTick();
+    void pastDueFiresOnNextAdvance();
+    void cancel();
+    void reschedule();
+    void firesInDueOrder();
+    void idleJump();
+    void randomOperationsMatchReference();
+};
+
+void TimerWheelTest::firesExactlyAtDueTick_data()
+{
+    QTest::addColumn<qint64>("start");
+    QTest::addColumn<qint64>("delay");
+
+    // 各层槽位边界两侧、最高层范围边界两侧（溢出列表），以及未对齐的起点
+    const qint64 boundaries[] = {1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 262145,
+                                 kWheelSpan - 1, kWheelSpan, kWheelSpan + 1};
+    for (qint64 start : {qint64(0), qint64(1000003)}) {
+        for (qint64 delay : boundaries) {
+            QTest::newRow(qPrintable(QString("start %1 delay %2").arg(start).arg(delay))) << start << delay;
+        }
+    }
+}
+
+void TimerWheelTest::firesExactlyAtDueTick()
+{
+    QFETCH(qint64, start);
+    QFETCH(qint64, delay);
+
+    TimerWheel wheel(start);
+    wheel.schedule(7, start + delay);
+    QVERIFY(wheel.advance(start + delay - 1).isEmpty());
+    QCOMPARE(wheel.currentTick(), start + delay - 1);
+    QVERIFY(wheel.contains(7));
+    QCOMPARE(wheel.advance(start + delay), QVector<quint64>{7});
+    QCOMPARE(wheel.size(), 0);
+}
+
+void TimerWheelTest::pastDueFiresOnNextAdvance()
+{
+    TimerWheel wheel(500);
+    wheel.schedule(1, 500);
+    wheel.schedule(2, 10);
+    wheel.schedule(3, 501);
+
+    // 目标刻度早于当前刻度：只取出已到期的定时器，当前刻度不后退
+    QVector<quint64> fired = wheel.advance(100);
+    std::sort(fired.begin(), fired.end());
+    QCOMPARE(fired, (QVector<quint64>{1, 2}));
+    QCOMPARE(wheel.currentTick(), qint64(500));
+    QCOMPARE(wheel.advance(501), QVector<quint64>{3});
+}
+
+void TimerWheelTest::cancel()
+{
+    TimerWheel wheel(0);
+    wheel.schedule(1, 10);
+    wheel.schedule(2, 5000);
+    wheel.schedule(3, kWheelSpan + 10);
+    QVERIFY(wheel.cancel(1));
+    QVERIFY(wheel.cancel(2));
+    QVERIFY(wheel.cancel(3));
+    QVERIFY(!wheel.cancel(3));
+    QVERIFY(!wheel.cancel(99));
+    QCOMPARE(wheel.size(), 0);
+
+    // 槽位中残留的旧项不会触发
+    wheel.schedule(4, kWheelSpan + 20);
+    QCOMPARE(wheel.advance(kWheelSpan + 20), QVector<quint64>{4});
+}
+
+void TimerWheelTest::reschedule()
+{
+    TimerWheel wheel(0);
+
+    // 改晚：原到期刻度不触发
+    wheel.schedule(1, 100);
+    wheel.schedule(1, 300000);
+    QCOMPARE(wheel.size(), 1);
+    QVERIFY(wheel.advance(299999).isEmpty());
+    QCOMPARE(wheel.advance(300000), QVector<quint64>{1});
+
+    // 改早：在新的到期刻度触发，原到期刻度不再触发
+    wheel.schedule(2, 310000);
+    wheel.schedule(2, 300100);
+    QVERIFY(wheel.advance(300099).isEmpty());
+    QCOMPARE(wheel.advance(300100), QVector<quint64>{2});
+    QVERIFY(wheel.advance(310000).isEmpty());
+
+    // 触发后再次安排同一编号
+    wheel.schedule(2, 310001);
+    QCOMPARE(wheel.advance(310001), QVector<quint64>{2});
+}
+
+void TimerWheelTest::firesInDueOrder()
+{
+    TimerWheel wheel(17);
+    QHash<quint64, qint64> dueTicks;
+    QRandomGenerator random(71);
+    for (quint64 id = 1; id <= 2000; ++id) {
+        const qint64 due = 17 + random.bounded(qint64(1000000));
+        wheel.schedule(id, due);
+        dueTicks.insert(id, due);
+    }
+    const QVector<quint64> fired = wheel.advance(17 + 1000000);
+    QCOMPARE(fired.size(), dueTicks.size());
+    QVERIFY(inDueOrder(fired, dueTicks));
+}
+
+void TimerWheelTest::idleJump()
+{
+    // 没有定时器时直接跳到目标刻度
+    TimerWheel wheel(0);
+    QVERIFY(wheel.advance(1000000000000LL).isEmpty());
+    QCOMPARE(wheel.currentTick(), 1000000000000LL);
+
+    wheel.schedule(1, 1000000000000LL + 5);
+    QVERIFY(wheel.advance(1000000000000LL + 4).isEmpty());
+    QCOMPARE(wheel.advance(1000000000000LL + 5), QVector<quint64>{1});
+}
+
+void TimerWheelTest::randomOperationsMatchReference()
+{
+    const qint64 start = 1000003;
+    TimerWheel wheel(start);
+    ReferenceWheel reference(start);
+    QRandomGenerator random(20240571);
+    quint64 nextId = 1;
+
+    // 延迟分布：大多落在低层，少数跨越高层或进入溢出列表，也有已过期的
+    const auto randomDelay = [&random]() -> qint64 {
+        switch (random.bounded(10)) {
+        case 0:
+            return -random.bounded(100);
+        case 1:
+            return random.bounded(qint64(300000));
+        case 2:
+            return random.bounded(20) == 0 ? kWheelSpan + random.bounded(qint64(100000)) : random.bounded(5000);
+        default:
+            return random.bounded(200);
+        }
+    };
+
+    for (int step = 0; step < kRandomOperations; ++step) {
+        const int op = random.bounded(20);
+        if (op < 10) {
+            const qint64 due = wheel.currentTick() + randomDelay();
+            wheel.schedule(nextId, due);
+            reference.schedule(nextId, due);
+            ++nextId;
+        } else if (op < 13) {
+            // 改期（编号可能已经触发或取消，此时相当于重新添加）
+            const quint64 id = 1 + random.bounded(quint64(nextId));
+            const qint64 due = wheel.currentTick() + randomDelay();
+            wheel.schedule(id, due);
+            reference.schedule(id, due);
+        } else if (op < 15) {
+            const quint64 id = 1 + random.bounded(quint64(nextId));
+            QCOMPARE(wheel.cancel(id), reference.cancel(id));
+        } else {
+            const qint64 to = wheel.currentTick() + (random.bounded(50) == 0 ? random.bounded(qint64(20000))
+                                                                            : random.bounded(qint64(100)));
+            // 参照实现推进前仍保存着这些定时器的到期刻度
+            QVector<quint64> fired = wheel.advance(to);
+            if (!inDueOrder(fired, reference.dueTicks())) {
+                QFAIL(qPrintable(QString("第 %1 步触发顺序错误").arg(step)));
+            }
+            std::sort(fired.begin(), fired.end());
+            if (fired != reference.advance(to)) {
+                QFAIL(qPrintable(QString("第 %1 步推进到 %2 时触发的定时器与参照实现不一致").arg(step).arg(to)));
+            }
+        }
+        if (wheel.size() != reference.size()) {
+            QFAIL(qPrintable(QString("第 %1 步定时器数不一致").arg(step)));
+        }
+    }
+
+    // 推进到最后一个定时器之后，全部触发
+    const qint64 end = wheel.currentTick() + kWheelSpan + 100000;
+    QVector<quint64> fired = wheel.advance(end);
+    std::sort(fired.begin(), fired.end());
+    QCOMPARE(fired, reference.advance(end));
+    QCOMPARE(wheel.size(), 0);
+}
+
+QTEST_APPLESS_MAIN(TimerWheelTest)
+#include "TimerWheelTest.moc"